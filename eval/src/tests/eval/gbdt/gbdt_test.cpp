@@ -409,6 +409,41 @@ TEST("require that fast forest evaluation is correct for all tree size categorie
 
 //-----------------------------------------------------------------------------
 
+TEST("require that fast forest batch evaluation matches single evaluation") {
+    for (size_t tree_size: std::vector<size_t>({7,30,127,300})) {
+        vespalib::string expression = Model().max_features(10).less_percent(100).make_forest(32, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            TEST_STATE(forest->impl_name().c_str());
+            size_t num_params = function->num_params();
+            size_t num_docs = 37;
+            size_t stride = 40;
+            std::vector<float> params(num_params * stride, 0.0f);
+            std::vector<double> expect;
+            auto ctx = forest->create_context();
+            for (size_t doc = 0; doc < num_docs; ++doc) {
+                std::vector<double> inputs(num_params);
+                for (size_t p = 0; p < num_params; ++p) {
+                    inputs[p] = (((doc + p) % 7) == 3)
+                                ? std::numeric_limits<double>::quiet_NaN()
+                                : (0.1 * ((doc * 7 + p * 3) % 11));
+                    params[p * stride + doc] = inputs[p];
+                }
+                expect.push_back(eval_ff(*forest, *ctx, inputs));
+            }
+            std::vector<double> results(num_docs, 0.0);
+            forest->eval_batch(*ctx, params.data(), stride, num_docs, results.data());
+            for (size_t doc = 0; doc < num_docs; ++doc) {
+                EXPECT_EQUAL(expect[doc], results[doc]);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST("require that GDBT expressions can be detected") {
     auto function = Function::parse("if((a<1),1.0,if((b in [1,2,3]),if((c in [1]),2.0,3.0),4.0))+"
                                     "if((d in [1]),10.0,if(!(e>=1),20.0,30.0))+"
@@ -137,6 +137,8 @@ TEST("require that value type can make spec") {
     EXPECT_EQUAL("tensor<float>(x{})", ValueType::tensor_type({{"x"}}, CellType::FLOAT).to_spec());
     EXPECT_EQUAL("tensor<float>(y[10])", ValueType::tensor_type({{"y", 10}}, CellType::FLOAT).to_spec());
     EXPECT_EQUAL("tensor<float>(x{},y[10],z[5])", ValueType::tensor_type({{"x"}, {"y", 10}, {"z", 5}}, CellType::FLOAT).to_spec());
+    EXPECT_EQUAL("tensor<bfloat16>(y[10])", ValueType::tensor_type({{"y", 10}}, CellType::BFLOAT16).to_spec());
+    EXPECT_EQUAL("tensor<int8>(x{},y[10])", ValueType::tensor_type({{"x"}, {"y", 10}}, CellType::INT8).to_spec());
 }
 
 //-----------------------------------------------------------------------------
@@ -149,6 +151,8 @@ TEST("require that value type spec can be parsed") {
     EXPECT_EQUAL(ValueType::tensor_type({{"x"}, {"y", 10}, {"z", 5}}), ValueType::from_spec("tensor(x{},y[10],z[5])"));
     EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}), ValueType::from_spec("tensor<double>(y[10])"));
     EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::FLOAT), ValueType::from_spec("tensor<float>(y[10])"));
+    EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::BFLOAT16), ValueType::from_spec("tensor<bfloat16>(y[10])"));
+    EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::INT8), ValueType::from_spec("tensor<int8>(y[10])"));
 }
 
 TEST("require that value type spec can be parsed with extra whitespace") {
@@ -258,6 +262,8 @@ TEST("require that value types preserve cell type") {
     EXPECT_TRUE(type("tensor(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<double>(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<float>(x[10])").cell_type() == CellType::FLOAT);
+    EXPECT_TRUE(type("tensor<bfloat16>(x[10])").cell_type() == CellType::BFLOAT16);
+    EXPECT_TRUE(type("tensor<int8>(x[10])").cell_type() == CellType::INT8);
 }
 
 TEST("require that dimension names can be obtained") {
@@ -376,6 +382,28 @@ TEST("require that cell type is handled correctly for join") {
     TEST_DO(verify_join(type("tensor<float>(x{})"), type("double"), type("tensor<float>(x{})")));
 }
 
+TEST("require that small cell types are joined as float unless combined with double") {
+    TEST_DO(verify_join(type("tensor<int8>(x[3])"), type("tensor<int8>(y[3])"), type("tensor<float>(x[3],y[3])")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x[3])"), type("tensor<bfloat16>(y[3])"), type("tensor<float>(x[3],y[3])")));
+    TEST_DO(verify_join(type("tensor<int8>(x[3])"), type("tensor<bfloat16>(y[3])"), type("tensor<float>(x[3],y[3])")));
+    TEST_DO(verify_join(type("tensor<int8>(x[3])"), type("tensor<float>(y[3])"), type("tensor<float>(x[3],y[3])")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x[3])"), type("tensor(y[3])"), type("tensor(x[3],y[3])")));
+    TEST_DO(verify_join(type("tensor<int8>(x[3])"), type("double"), type("tensor<float>(x[3])")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x{})"), type("double"), type("tensor<float>(x{})")));
+}
+
+TEST("require that small cell types are mapped and reduced as float") {
+    EXPECT_EQUAL(type("tensor<bfloat16>(x[3],y[5])").reduce({"y"}), type("tensor<float>(x[3])"));
+    EXPECT_EQUAL(type("tensor<int8>(x{},y[5])").reduce({"x"}), type("tensor<float>(y[5])"));
+    EXPECT_EQUAL(type("tensor<int8>(x[3],y[5])").reduce({}), type("double"));
+    EXPECT_EQUAL(type("tensor<bfloat16>(x[3])").map(), type("tensor<float>(x[3])"));
+    EXPECT_EQUAL(type("tensor<int8>(x{},y[5])").map(), type("tensor<float>(x{},y[5])"));
+    EXPECT_EQUAL(type("tensor<float>(x[3])").map(), type("tensor<float>(x[3])"));
+    EXPECT_EQUAL(type("tensor(x[3])").map(), type("tensor(x[3])"));
+    EXPECT_EQUAL(type("double").map(), type("double"));
+    EXPECT_TRUE(type("error").map().is_error());
+}
+
 void verify_not_joinable(const ValueType &a, const ValueType &b) {
     EXPECT_TRUE(ValueType::join(a, b).is_error());
     EXPECT_TRUE(ValueType::join(b, a).is_error());
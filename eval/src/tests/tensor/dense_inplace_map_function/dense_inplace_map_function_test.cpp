@@ -27,6 +27,8 @@ EvalFixture::ParamRepo make_params() {
         .add_mutable("_d", spec(5.0))
         .add_mutable("_x5", spec({x(5)}, N()))
         .add_mutable("_x5f", spec(float_cells({x(5)}), N()))
+        .add_mutable("_x5b", spec(bfloat16_cells({x(5)}), N()))
+        .add_mutable("_x5i", spec(int8_cells({x(5)}), N()))
         .add_mutable("_x5y3", spec({x(5),y(3)}, N()))
         .add_mutable("_x_m", spec({x({"a", "b", "c"})}, N()));
 }
@@ -76,4 +78,12 @@ TEST("require that optimization works for float cells") {
     TEST_DO(verify_optimized("map(_x5f,f(x)(x+10))", 1));
 }
 
+TEST("require that small cell types are mapped to float cells instead of in place") {
+    TEST_DO(verify_not_optimized("map(_x5b,f(x)(x+10))"));
+    TEST_DO(verify_not_optimized("map(_x5i,f(x)(x+10))"));
+    EvalFixture fixture(prod_engine, "map(_x5i,f(x)(x*0.5))", param_repo, true, true);
+    EXPECT_EQUAL(fixture.result().type(), "tensor<float>(x[5])");
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref("map(_x5i,f(x)(x*0.5))", param_repo));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
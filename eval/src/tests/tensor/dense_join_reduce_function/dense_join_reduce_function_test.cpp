@@ -0,0 +1,105 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_join_reduce_function.h>
+#include <vespa/eval/tensor/dense/dense_dot_product_function.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a3", spec({x(3)}, N()))
+        .add("a3f", spec(float_cells({x(3)}), N()))
+        .add("x3y5", spec({x(3),y(5)}, N()))
+        .add("x3y5f", spec(float_cells({x(3),y(5)}), N()))
+        .add("x3z4", spec({x(3),z(4)}, N()))
+        .add("y5z4", spec({y(5),z(4)}, N()))
+        .add("x3y5z4", spec({x(3),y(5),z(4)}, N()))
+        .add("x3y5z4f", spec(float_cells({x(3),y(5),z(4)}), N()))
+        .add("y5z4w2", spec({y(5),z(4),Domain("w", 2)}, N()))
+        .add("y_m", spec({y({"a","b"})}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t num_loops) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseJoinReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    EXPECT_TRUE(info[0]->result_is_mutable());
+    EXPECT_EQUAL(info[0]->loops().size(), num_loops);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseJoinReduceFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that join+reduce with arbitrary dimension layout can be optimized") {
+    TEST_DO(verify_optimized("reduce(x3y5z4*y5z4w2,sum,y,z)", 3));
+    TEST_DO(verify_optimized("reduce(x3y5z4*y5z4w2,sum,z)", 4));
+    TEST_DO(verify_optimized("reduce(x3y5z4*y5z4w2,sum,x,w)", 3));
+    TEST_DO(verify_optimized("reduce(x3z4*x3y5z4,sum,x)", 3));
+}
+
+TEST("require that join+reduce with any join function can be optimized") {
+    TEST_DO(verify_optimized("reduce(x3y5z4+y5z4w2,sum,y,z)", 3));
+    TEST_DO(verify_optimized("reduce(join(x3y5z4,y5z4w2,f(a,b)(a-b*2)),sum,z,w)", 4));
+}
+
+TEST("require that join+reduce into a scalar can be optimized") {
+    TEST_DO(verify_optimized("reduce(x3y5z4*y5z4w2,sum)", 3));
+    TEST_DO(verify_optimized("reduce(x3y5*x3z4,sum,x,y,z)", 3));
+}
+
+TEST("require that join+reduce works with mixed cell types") {
+    TEST_DO(verify_optimized("reduce(x3y5z4f*y5z4w2,sum,y,z)", 3));
+    TEST_DO(verify_optimized("reduce(x3y5f*x3y5z4f,sum,y)", 3));
+}
+
+TEST("require that join+reduce with adjacent reduced dimensions is combined into one loop") {
+    TEST_DO(verify_optimized("reduce(x3y5z4*x3y5z4,sum,y,z)", 2));
+}
+
+TEST("require that more specific optimizations are preferred") {
+    TEST_DO(verify_not_optimized("reduce(a3*a3f,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(x3y5z4*x3y5z4,sum,x,y,z)"));
+    TEST_DO(verify_not_optimized("reduce(x3y5*x3z4,sum,x)"));
+}
+
+TEST("require that non-sum aggregators and sparse tensors are not optimized") {
+    TEST_DO(verify_not_optimized("reduce(x3y5z4*y5z4w2,max,y,z)"));
+    TEST_DO(verify_not_optimized("reduce(x3y5z4*y5z4w2,prod,z)"));
+    TEST_DO(verify_not_optimized("reduce(a3*y_m,sum,x)"));
+}
+
+TEST("require that join+reduce function can be debug dumped") {
+    EvalFixture fixture(prod_engine, "reduce(x3y5z4*y5z4w2,sum,y,z)", param_repo, true);
+    auto info = fixture.find_all<DenseJoinReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    fprintf(stderr, "%s\n", info[0]->as_string().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,122 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+using vespalib::eval::SimpleTensorEngine;
+using vespalib::eval::TensorSpec;
+using vespalib::eval::Value;
+using vespalib::eval::ValueType;
+using vespalib::nbostream;
+using namespace vespalib::tensor;
+
+const vespalib::eval::TensorEngine &engine() { return DefaultTensorEngine::ref(); }
+
+TensorSpec mixed_spec() {
+    return TensorSpec("tensor(x{},y[2])")
+        .add({{"x","a"},{"y",0}}, 1)
+        .add({{"x","a"},{"y",1}}, 2)
+        .add({{"x","b"},{"y",0}}, 3)
+        .add({{"x","b"},{"y",1}}, 4);
+}
+
+TEST(MixedTensorTest, mixed_tensor_is_created_from_spec)
+{
+    auto value = engine().from_spec(mixed_spec());
+    auto mixed = dynamic_cast<const MixedTensor *>(value.get());
+    ASSERT_TRUE(mixed != nullptr);
+    EXPECT_EQ(2u, mixed->subspaces().size());
+    EXPECT_EQ(2u, mixed->subspace_size());
+    EXPECT_EQ(mixed_spec(), engine().to_spec(*value));
+}
+
+TEST(MixedTensorTest, builder_creates_sparse_and_dense_tensors_when_possible)
+{
+    SparseTensorAddressBuilder address;
+    address.add("a");
+    MixedTensorBuilder sparse_builder(ValueType::from_spec("tensor(x{})"));
+    sparse_builder.insert_subspace(address.getAddressRef()).first[0] = 5.0;
+    EXPECT_TRUE(dynamic_cast<const SparseTensor *>(sparse_builder.build().get()) != nullptr);
+    MixedTensorBuilder dense_builder(ValueType::from_spec("tensor(y[3])"));
+    EXPECT_TRUE(dynamic_cast<const DenseTensorView *>(dense_builder.build().get()) != nullptr);
+}
+
+TEST(MixedTensorTest, new_subspaces_are_zero_filled_and_existing_subspaces_are_reused)
+{
+    MixedTensorBuilder builder(ValueType::from_spec("tensor(x{},y[3])"));
+    SparseTensorAddressBuilder address;
+    address.add("a");
+    auto first = builder.insert_subspace(address.getAddressRef());
+    EXPECT_TRUE(first.second);
+    EXPECT_EQ(3u, first.first.size());
+    EXPECT_EQ(0.0, first.first[2]);
+    first.first[2] = 7.0;
+    auto second = builder.insert_subspace(address.getAddressRef());
+    EXPECT_FALSE(second.second);
+    EXPECT_EQ(7.0, second.first[2]);
+    address.clear();
+    address.add("b");
+    EXPECT_EQ(0u, builder.find_subspace(address.getAddressRef()).size());
+}
+
+TEST(MixedTensorTest, mixed_tensor_can_be_serialized_and_deserialized)
+{
+    for (const char *type: {"tensor(x{},y[2])", "tensor<float>(x{},y[2])"}) {
+        auto spec = mixed_spec();
+        TensorSpec typed_spec(type);
+        for (const auto &cell: spec.cells()) {
+            typed_spec.add(cell.first, cell.second);
+        }
+        auto value = engine().from_spec(typed_spec);
+        nbostream data;
+        engine().encode(*value, data);
+        nbostream simple_data(data.peek(), data.size());
+        auto decoded = engine().decode(data);
+        EXPECT_TRUE(dynamic_cast<const MixedTensor *>(decoded.get()) != nullptr);
+        EXPECT_EQ(typed_spec, engine().to_spec(*decoded));
+        auto simple = SimpleTensorEngine::ref().decode(simple_data);
+        EXPECT_EQ(typed_spec, SimpleTensorEngine::ref().to_spec(*simple));
+    }
+}
+
+TEST(MixedTensorTest, join_with_partially_overlapping_mapped_dimensions)
+{
+    auto lhs = engine().from_spec(TensorSpec("tensor(x{},y{},z[2])")
+                                  .add({{"x","a"},{"y","c"},{"z",0}}, 1)
+                                  .add({{"x","a"},{"y","c"},{"z",1}}, 2)
+                                  .add({{"x","b"},{"y","d"},{"z",0}}, 3)
+                                  .add({{"x","b"},{"y","d"},{"z",1}}, 4));
+    auto rhs = engine().from_spec(TensorSpec("tensor(y{},w{})")
+                                  .add({{"y","c"},{"w","e"}}, 10)
+                                  .add({{"y","c"},{"w","f"}}, 20)
+                                  .add({{"y","g"},{"w","e"}}, 30));
+    vespalib::Stash stash;
+    const Value &result = engine().join(*lhs, *rhs, [](double a, double b){ return (a * b); }, stash);
+    EXPECT_EQ(TensorSpec("tensor(w{},x{},y{},z[2])")
+              .add({{"w","e"},{"x","a"},{"y","c"},{"z",0}}, 10)
+              .add({{"w","e"},{"x","a"},{"y","c"},{"z",1}}, 20)
+              .add({{"w","f"},{"x","a"},{"y","c"},{"z",0}}, 20)
+              .add({{"w","f"},{"x","a"},{"y","c"},{"z",1}}, 40),
+              engine().to_spec(result));
+}
+
+TEST(MixedTensorTest, reduce_over_mapped_and_indexed_dimensions)
+{
+    auto value = engine().from_spec(mixed_spec());
+    vespalib::Stash stash;
+    EXPECT_EQ(TensorSpec("tensor(y[2])").add({{"y",0}}, 4).add({{"y",1}}, 6),
+              engine().to_spec(engine().reduce(*value, vespalib::eval::Aggr::SUM, {"x"}, stash)));
+    EXPECT_EQ(TensorSpec("tensor(x{})").add({{"x","a"}}, 2).add({{"x","b"}}, 4),
+              engine().to_spec(engine().reduce(*value, vespalib::eval::Aggr::MAX, {"y"}, stash)));
+    EXPECT_EQ(1.0, engine().reduce(*value, vespalib::eval::Aggr::MIN, {}, stash).as_double());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -218,4 +218,42 @@ TEST("test float cells for dense tensor") {
                               .add({{"x", 2}, {"y", 4}}, 3)));
 }
 
+TEST("test bfloat16 cells for dense tensor") {
+    TEST_DO(verify_serialized({0x06, 0x02, 0x01, 0x01, 0x78, 0x03,
+                               0x3f, 0x80,
+                               0x40, 0x40,
+                               0xbe, 0x20 },
+                              TensorSpec("tensor<bfloat16>(x[3])")
+                              .add({{"x", 0}}, 1)
+                              .add({{"x", 1}}, 3)
+                              .add({{"x", 2}}, -0.15625)));
+}
+
+TEST("test int8 cells for dense tensor") {
+    TEST_DO(verify_serialized({0x06, 0x03, 0x01, 0x01, 0x78, 0x03,
+                               0x01, 0x7f, 0xfd },
+                              TensorSpec("tensor<int8>(x[3])")
+                              .add({{"x", 0}}, 1)
+                              .add({{"x", 1}}, 127)
+                              .add({{"x", 2}}, -3)));
+}
+
+TEST("test int8 cells are rounded and clamped") {
+    TEST_DO(verify_serialized({0x06, 0x03, 0x01, 0x01, 0x78, 0x04,
+                               0x03, 0xfd, 0x7f, 0x80 },
+                              TensorSpec("tensor<int8>(x[4])")
+                              .add({{"x", 0}}, 2.6)
+                              .add({{"x", 1}}, -2.5)
+                              .add({{"x", 2}}, 300)
+                              .add({{"x", 3}}, -1000)));
+}
+
+TEST("test int8 cells for mixed tensor") {
+    TEST_DO(verify_serialized({0x07, 0x03, 0x01, 0x01, 0x78, 0x01, 0x01, 0x79, 0x02,
+                               0x01, 0x01, 0x61, 0x05, 0xfb },
+                              TensorSpec("tensor<int8>(x{},y[2])")
+                              .add({{"x", "a"}, {"y", 0}}, 5)
+                              .add({{"x", "a"}, {"y", 1}}, -5)));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -146,7 +147,9 @@ constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> batch_masks;
+    std::vector<double> batch_result2;
+    FixedContext(size_t num_trees) : masks(num_trees), batch_masks(), batch_result2() {}
 };
 
 template <typename T>
@@ -200,6 +203,8 @@ struct FixedForest : FastForest {
     vespalib::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t stride,
+                    size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -335,13 +340,76 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t stride,
+                           size_t num_docs, double *results) const
+{
+    if (num_docs == 0) {
+        return;
+    }
+    auto &ctx = static_cast<FixedContext<T>&>(context);
+    const T all_bits = ~T(0);
+    ctx.batch_masks.assign(_num_trees * num_docs, all_bits);
+    T *ctx_masks = &ctx.batch_masks[0];
+    const Mask *mask_pos = &_masks[0];
+    for (size_t param = 0; param < _mask_sizes.size(); ++param) {
+        const float *features = params + (param * stride);
+        float max_feature = -std::numeric_limits<float>::infinity();
+        bool has_nan = false;
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            if (std::isnan(features[doc])) {
+                has_nan = true;
+            } else {
+                max_feature = std::max(max_feature, features[doc]);
+            }
+        }
+        // masks are sorted on value; none beyond the largest feature value apply to any document
+        const Mask *end = mask_pos + _mask_sizes[param];
+        for (const Mask *pos = mask_pos; (pos < end) && !(max_feature < pos->value); ++pos) {
+            T *dst = ctx_masks + (pos->tree * num_docs);
+            for (size_t doc = 0; doc < num_docs; ++doc) {
+                dst[doc] &= (features[doc] >= pos->value) ? pos->bits : all_bits;
+            }
+        }
+        if (has_nan) {
+            const DMask *dpos = _default_masks.data() + _default_offsets[param];
+            const DMask *dend = _default_masks.data() + _default_offsets[param + 1];
+            for (; dpos < dend; ++dpos) {
+                T *dst = ctx_masks + (dpos->tree * num_docs);
+                for (size_t doc = 0; doc < num_docs; ++doc) {
+                    dst[doc] &= std::isnan(features[doc]) ? dpos->bits : all_bits;
+                }
+            }
+        }
+        mask_pos = end;
+    }
+    // same summation order as get_result to give the same results as eval
+    ctx.batch_result2.assign(num_docs, 0.0);
+    double *result2 = &ctx.batch_result2[0];
+    std::fill(results, results + num_docs, 0.0);
+    const float *leafs = &_padded_leafs[0];
+    uint32_t paired_trees = (_num_trees & ~uint32_t(3));
+    for (uint32_t tree = 0; tree < _num_trees; ++tree, leafs += _max_leafs) {
+        double *dst = ((tree < paired_trees) && ((tree & 1) != 0)) ? result2 : results;
+        const T *src = ctx_masks + (tree * num_docs);
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            dst[doc] += leafs[get_lsb(src[doc])];
+        }
+    }
+    for (size_t doc = 0; doc < num_docs; ++doc) {
+        results[doc] += result2[doc];
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
 
 struct MultiWordContext : FastForest::Context {
     std::vector<uint32_t> words;
-    MultiWordContext(size_t size) : words(size) {}
+    std::vector<uint32_t> batch_words;
+    MultiWordContext(size_t size) : words(size), batch_words() {}
 };
 
 struct MultiWordForest : FastForest {
@@ -418,6 +486,16 @@ struct MultiWordForest : FastForest {
         return Mask(cmp_node.value, offset, bits1, empty_cnt, bits2);
     }
 
+    // a mask (fixed or rle) expressed as whole words, used by batch evaluation
+    struct WordMask {
+        uint32_t offset;
+        uint32_t bits;
+        WordMask(uint32_t word_offset, uint32_t mask_bits)
+            : offset(word_offset), bits(mask_bits) {}
+    };
+
+    static void add_rle_word_masks(std::vector<WordMask> &dst, uint32_t byte_offset, const uint8_t *rle_mask);
+
     std::vector<Sizes>    _mask_sizes;
     std::vector<Mask>     _masks;
     std::vector<Sizes>    _default_offsets;
@@ -425,6 +503,10 @@ struct MultiWordForest : FastForest {
     std::vector<uint32_t> _tree_offsets;
     std::vector<float>    _leafs;
     uint32_t              _words_per_tree;
+    std::vector<uint32_t> _word_mask_offsets;
+    std::vector<WordMask> _word_masks;
+    std::vector<uint32_t> _default_word_mask_offsets;
+    std::vector<WordMask> _default_word_masks;
 
     MultiWordForest(const State &state);
     static FastForest::UP try_build(const State &state);
@@ -436,12 +518,36 @@ struct MultiWordForest : FastForest {
     static void apply_rle_masks(unsigned char *ctx_bytes, const DMask *pos, const DMask *end);
     static size_t find_leaf(const uint32_t *ctx_words);
     double get_result(const uint32_t *ctx_words) const;
+    static void apply_word_masks(uint32_t *ctx_words, size_t num_docs, const WordMask *pos, const WordMask *end,
+                                 const float *features, float value);
+    static void apply_default_word_masks(uint32_t *ctx_words, size_t num_docs, const WordMask *pos, const WordMask *end,
+                                         const float *features);
+    void apply_batch_masks(uint32_t *ctx_words, size_t num_docs, const Mask *pos, const Mask *end,
+                           const float *features, float max_feature) const;
 
     vespalib::string impl_name() const override { return "ff-multiword"; }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t stride,
+                    size_t num_docs, double *results) const override;
 };
 
+void
+MultiWordForest::add_rle_word_masks(std::vector<WordMask> &dst, uint32_t byte_offset, const uint8_t *rle_mask)
+{
+    uint32_t last = (byte_offset + rle_mask[1] + 1);
+    for (uint32_t byte = byte_offset; byte <= last; ) {
+        uint32_t word = (byte / word_size);
+        uint32_t bits = ~uint32_t(0);
+        for (; (byte <= last) && ((byte / word_size) == word); ++byte) {
+            uint8_t byte_bits = (byte == byte_offset) ? rle_mask[0] : ((byte == last) ? rle_mask[2] : 0);
+            uint32_t shift = ((byte % word_size) * bits_per_byte);
+            bits &= ~(uint32_t(0xff) << shift) | (uint32_t(byte_bits) << shift);
+        }
+        dst.emplace_back(word, bits);
+    }
+}
+
 MultiWordForest::MultiWordForest(const State &state)
     : _mask_sizes(),
       _masks(),
@@ -449,7 +555,11 @@ MultiWordForest::MultiWordForest(const State &state)
       _default_masks(),
       _tree_offsets(),
       _leafs(),
-      _words_per_tree(BitRange(0, state.max_leafs - 1).covered_words<uint32_t>())
+      _words_per_tree(BitRange(0, state.max_leafs - 1).covered_words<uint32_t>()),
+      _word_mask_offsets(),
+      _word_masks(),
+      _default_word_mask_offsets(),
+      _default_word_masks()
 {
     for (const auto &cmp_nodes: state.cmp_nodes) {
         std::vector<CmpNode> fixed;
@@ -493,6 +603,31 @@ MultiWordForest::MultiWordForest(const State &state)
             _leafs.push_back(leaf);
         }
     }
+    size_t mask_idx = 0;
+    size_t default_idx = 0;
+    for (size_t param = 0; param < _mask_sizes.size(); ++param) {
+        const Sizes &size = _mask_sizes[param];
+        for (size_t i = 0; i < (size.fixed + size.rle); ++i, ++mask_idx) {
+            const Mask &mask = _masks[mask_idx];
+            _word_mask_offsets.push_back(_word_masks.size());
+            if (i < size.fixed) {
+                _word_masks.emplace_back(mask.offset, mask.bits);
+            } else {
+                add_rle_word_masks(_word_masks, mask.offset, mask.rle_mask);
+            }
+        }
+        for (; default_idx < _default_offsets[param + 1].fixed; ++default_idx) {
+            const DMask &mask = _default_masks[default_idx];
+            _default_word_mask_offsets.push_back(_default_word_masks.size());
+            if (default_idx < _default_offsets[param].rle) {
+                _default_word_masks.emplace_back(mask.offset, mask.bits);
+            } else {
+                add_rle_word_masks(_default_word_masks, mask.offset, mask.rle_mask);
+            }
+        }
+    }
+    _word_mask_offsets.push_back(_word_masks.size());
+    _default_word_mask_offsets.push_back(_default_word_masks.size());
 }
 
 FastForest::UP
@@ -620,6 +755,95 @@ MultiWordForest::eval(Context &context, const float *params) const
     return get_result(ctx_words);
 }
 
+void
+MultiWordForest::apply_word_masks(uint32_t *ctx_words, size_t num_docs, const WordMask *pos, const WordMask *end,
+                                  const float *features, float value)
+{
+    for (; pos < end; ++pos) {
+        uint32_t *dst = ctx_words + (pos->offset * num_docs);
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            dst[doc] &= (features[doc] >= value) ? pos->bits : ~uint32_t(0);
+        }
+    }
+}
+
+void
+MultiWordForest::apply_default_word_masks(uint32_t *ctx_words, size_t num_docs, const WordMask *pos, const WordMask *end,
+                                          const float *features)
+{
+    for (; pos < end; ++pos) {
+        uint32_t *dst = ctx_words + (pos->offset * num_docs);
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            dst[doc] &= std::isnan(features[doc]) ? pos->bits : ~uint32_t(0);
+        }
+    }
+}
+
+void
+MultiWordForest::apply_batch_masks(uint32_t *ctx_words, size_t num_docs, const Mask *pos, const Mask *end,
+                                   const float *features, float max_feature) const
+{
+    // masks are sorted on value; none beyond the largest feature value apply to any document
+    for (; (pos < end) && !(max_feature < pos->value); ++pos) {
+        size_t mask_idx = (pos - &_masks[0]);
+        apply_word_masks(ctx_words, num_docs,
+                         _word_masks.data() + _word_mask_offsets[mask_idx],
+                         _word_masks.data() + _word_mask_offsets[mask_idx + 1],
+                         features, pos->value);
+    }
+}
+
+void
+MultiWordForest::eval_batch(Context &context, const float *params, size_t stride,
+                            size_t num_docs, double *results) const
+{
+    if (num_docs == 0) {
+        return;
+    }
+    auto &ctx = static_cast<MultiWordContext&>(context);
+    ctx.batch_words.assign(_words_per_tree * _tree_offsets.size() * num_docs, ~uint32_t(0));
+    uint32_t *ctx_words = &ctx.batch_words[0];
+    const Mask *mask_pos = &_masks[0];
+    for (size_t param = 0; param < _mask_sizes.size(); ++param) {
+        const Sizes &size = _mask_sizes[param];
+        const float *features = params + (param * stride);
+        float max_feature = -std::numeric_limits<float>::infinity();
+        bool has_nan = false;
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            if (std::isnan(features[doc])) {
+                has_nan = true;
+            } else {
+                max_feature = std::max(max_feature, features[doc]);
+            }
+        }
+        apply_batch_masks(ctx_words, num_docs, mask_pos, mask_pos + size.fixed, features, max_feature);
+        apply_batch_masks(ctx_words, num_docs, mask_pos + size.fixed, mask_pos + size.fixed + size.rle,
+                          features, max_feature);
+        if (has_nan) {
+            size_t begin = _default_offsets[param].fixed;
+            size_t end = _default_offsets[param + 1].fixed;
+            apply_default_word_masks(ctx_words, num_docs,
+                                     _default_word_masks.data() + _default_word_mask_offsets[begin],
+                                     _default_word_masks.data() + _default_word_mask_offsets[end],
+                                     features);
+        }
+        mask_pos += (size.fixed + size.rle);
+    }
+    std::fill(results, results + num_docs, 0.0);
+    const float *leafs = &_leafs[0];
+    for (size_t tree = 0; tree < _tree_offsets.size(); ++tree) {
+        const uint32_t *tree_words = ctx_words + (tree * _words_per_tree * num_docs);
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            size_t idx = 0;
+            const uint32_t *word = tree_words + doc;
+            for (; *word == 0; word += num_docs) {
+                idx += bits_per_word;
+            }
+            results[doc] += leafs[_tree_offsets[tree] + idx + get_lsb(*word)];
+        }
+    }
+}
+
 }
 
 //-----------------------------------------------------------------------------
@@ -36,6 +36,17 @@ public:
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+    /**
+     * Evaluate the forest for a block of 'num_docs' documents. The
+     * parameters are laid out parameter by parameter; the value of
+     * parameter p for document d is params[(p * stride) + d]. The
+     * masks of each parameter are applied to the tree states of all
+     * documents in the block before moving on to the next parameter,
+     * with the state of each tree word stored for all documents side
+     * by side. The result for document d is stored in results[d].
+     **/
+    virtual void eval_batch(Context &context, const float *params, size_t stride,
+                            size_t num_docs, double *results) const = 0;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
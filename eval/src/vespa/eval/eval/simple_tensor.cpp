@@ -24,11 +24,15 @@ namespace {
 
 constexpr uint32_t DOUBLE_CELL_TYPE = 0;
 constexpr uint32_t FLOAT_CELL_TYPE = 1;
+constexpr uint32_t BFLOAT16_CELL_TYPE = 2;
+constexpr uint32_t INT8_CELL_TYPE = 3;
 
 uint32_t cell_type_to_id(CellType cell_type) {
     switch (cell_type) {
     case CellType::DOUBLE: return DOUBLE_CELL_TYPE;
     case CellType::FLOAT: return FLOAT_CELL_TYPE;
+    case CellType::BFLOAT16: return BFLOAT16_CELL_TYPE;
+    case CellType::INT8: return INT8_CELL_TYPE;
     }
     abort();
 }
@@ -37,6 +41,28 @@ CellType id_to_cell_type(uint32_t id) {
     switch (id) {
     case DOUBLE_CELL_TYPE: return CellType::DOUBLE;
     case FLOAT_CELL_TYPE: return CellType::FLOAT;
+    case BFLOAT16_CELL_TYPE: return CellType::BFLOAT16;
+    case INT8_CELL_TYPE: return CellType::INT8;
+    }
+    abort();
+}
+
+void encode_cell(nbostream &output, CellType cell_type, double value) {
+    switch (cell_type) {
+    case CellType::DOUBLE: output << value; return;
+    case CellType::FLOAT: output << (float) value; return;
+    case CellType::BFLOAT16: output << BFloat16(value); return;
+    case CellType::INT8: output << Int8Float(value); return;
+    }
+    abort();
+}
+
+double decode_cell(nbostream &input, CellType cell_type) {
+    switch (cell_type) {
+    case CellType::DOUBLE: return input.readValue<double>();
+    case CellType::FLOAT: return input.readValue<float>();
+    case CellType::BFLOAT16: return input.readValue<BFloat16>();
+    case CellType::INT8: return input.readValue<Int8Float>();
     }
     abort();
 }
@@ -545,10 +571,7 @@ void decode_cells(nbostream &input, const ValueType &type, const TypeMeta meta,
             decode_cells(input, type, meta, address, n + 1, builder);
         }
     } else {
-        double value = (meta.cell_type == CellType::FLOAT)
-                       ? input.readValue<float>()
-                       : input.readValue<double>();
-        builder.set(address, value);
+        builder.set(address, decode_cell(input, meta.cell_type));
     }
 }
 
@@ -601,7 +624,7 @@ SimpleTensor::map(map_fun_t function) const
     for (auto &cell: cells) {
         cell.value = function(cell.value);
     }
-    return std::make_unique<SimpleTensor>(_type, std::move(cells));
+    return std::make_unique<SimpleTensor>(_type.map(), std::move(cells));
 }
 
 std::unique_ptr<SimpleTensor>
@@ -744,11 +767,7 @@ SimpleTensor::encode(const SimpleTensor &tensor, nbostream &output)
         encode_mapped_labels(output, meta, block.begin()->get().address);
         View subview(block, meta.indexed);
         for (auto cell = subview.first_range(); !cell.empty(); cell = subview.next_range(cell)) {
-            if (meta.cell_type == CellType::FLOAT) {
-                output << (float) cell.begin()->get().value;
-            } else {
-                output << cell.begin()->get().value;
-            }
+            encode_cell(output, meta.cell_type, cell.begin()->get().value);
         }
     }
 }
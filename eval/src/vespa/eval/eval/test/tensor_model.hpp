@@ -183,6 +183,14 @@ Layout float_cells(const Layout &layout) {
     return Layout(CellType::FLOAT, layout.domains);
 }
 
+Layout bfloat16_cells(const Layout &layout) {
+    return Layout(CellType::BFLOAT16, layout.domains);
+}
+
+Layout int8_cells(const Layout &layout) {
+    return Layout(CellType::INT8, layout.domains);
+}
+
 Domain x() { return Domain("x", {}); }
 Domain x(size_t size) { return Domain("x", size); }
 Domain x(const std::vector<vespalib::string> &keys) { return Domain("x", keys); }
@@ -23,6 +23,8 @@ CellType unify(CellType b) {
     switch (b) {
     case CellType::DOUBLE: return unify<A,double>();
     case CellType::FLOAT: return unify<A,float>();
+    case CellType::BFLOAT16: return unify<A,BFloat16>();
+    case CellType::INT8: return unify<A,Int8Float>();
     }
     abort();
 }
@@ -31,10 +33,17 @@ CellType unify(CellType a, CellType b) {
     switch (a) {
     case CellType::DOUBLE: return unify<double>(b);
     case CellType::FLOAT: return unify<float>(b);
+    case CellType::BFLOAT16: return unify<BFloat16>(b);
+    case CellType::INT8: return unify<Int8Float>(b);
     }
     abort();
 }
 
+// cell type of values computed from cells of the given type
+CellType decay(CellType cell_type) {
+    return unify(cell_type, cell_type);
+}
+
 size_t my_dimension_index(const std::vector<Dimension> &list, const vespalib::string &name) {
     for (size_t idx = 0; idx < list.size(); ++idx) {
         if (list[idx].name == name) {
@@ -200,6 +209,15 @@ ValueType::dimension_names() const
     return result;
 }
 
+ValueType
+ValueType::map() const
+{
+    if (!is_tensor()) {
+        return *this;
+    }
+    return tensor_type(_dimensions, decay(_cell_type));
+}
+
 ValueType
 ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
 {
@@ -220,7 +238,7 @@ ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
     if (removed != dimensions_in.size()) {
         return error_type();
     }
-    return tensor_type(std::move(result), _cell_type);
+    return tensor_type(std::move(result), decay(_cell_type));
 }
 
 ValueType
@@ -278,9 +296,9 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (lhs.is_error() || rhs.is_error()) {
         return error_type();
     } else if (lhs.is_double()) {
-        return rhs;
+        return rhs.map();
     } else if (rhs.is_double()) {
-        return lhs;
+        return lhs.map();
     }
     MyJoin result(lhs._dimensions, rhs._dimensions);
     if (result.mismatch) {
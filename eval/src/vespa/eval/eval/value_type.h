@@ -3,6 +3,8 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/int8float.h>
 #include <vector>
 
 namespace vespalib::eval {
@@ -16,7 +18,7 @@ class ValueType
 {
 public:
     enum class Type { ERROR, DOUBLE, TENSOR };
-    enum class CellType : char { FLOAT, DOUBLE };
+    enum class CellType : char { FLOAT, DOUBLE, BFLOAT16, INT8 };
     struct Dimension {
         using size_type = uint32_t;
         static constexpr size_type npos = -1;
@@ -69,6 +71,7 @@ public:
     }
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
 
+    ValueType map() const;
     ValueType reduce(const std::vector<vespalib::string> &dimensions_in) const;
     ValueType rename(const std::vector<vespalib::string> &from,
                      const std::vector<vespalib::string> &to) const;
@@ -93,15 +96,19 @@ std::ostream &operator<<(std::ostream &os, const ValueType &type);
 template <typename CT> inline bool check_cell_type(ValueType::CellType type);
 template <> inline bool check_cell_type<double>(ValueType::CellType type) { return (type == ValueType::CellType::DOUBLE); }
 template <> inline bool check_cell_type<float>(ValueType::CellType type) { return (type == ValueType::CellType::FLOAT); }
+template <> inline bool check_cell_type<BFloat16>(ValueType::CellType type) { return (type == ValueType::CellType::BFLOAT16); }
+template <> inline bool check_cell_type<Int8Float>(ValueType::CellType type) { return (type == ValueType::CellType::INT8); }
 
-template <typename LCT, typename RCT> struct UnifyCellTypes{};
+// double wins; everything else is computed (and stored) as float
+template <typename LCT, typename RCT> struct UnifyCellTypes { using type = float; };
+template <typename RCT> struct UnifyCellTypes<double, RCT> { using type = double; };
+template <typename LCT> struct UnifyCellTypes<LCT, double> { using type = double; };
 template <> struct UnifyCellTypes<double, double> { using type = double; };
-template <> struct UnifyCellTypes<double, float>  { using type = double; };
-template <> struct UnifyCellTypes<float,  double> { using type = double; };
-template <> struct UnifyCellTypes<float,  float>  { using type = float; };
 
 template <typename CT> inline ValueType::CellType get_cell_type();
 template <> inline ValueType::CellType get_cell_type<double>() { return ValueType::CellType::DOUBLE; }
 template <> inline ValueType::CellType get_cell_type<float>() { return ValueType::CellType::FLOAT; }
+template <> inline ValueType::CellType get_cell_type<BFloat16>() { return ValueType::CellType::BFLOAT16; }
+template <> inline ValueType::CellType get_cell_type<Int8Float>() { return ValueType::CellType::INT8; }
 
 } // namespace
@@ -16,6 +16,8 @@ const char *to_name(CellType cell_type) {
     switch (cell_type) {
     case CellType::DOUBLE: return "double";
     case CellType::FLOAT: return "float";
+    case CellType::BFLOAT16: return "bfloat16";
+    case CellType::INT8: return "int8";
     }
     abort();
 }
@@ -167,6 +169,10 @@ CellType parse_cell_type(ParseContext &ctx) {
     }
     if (cell_type == "float") {
         return CellType::FLOAT;
+    } else if (cell_type == "bfloat16") {
+        return CellType::BFLOAT16;
+    } else if (cell_type == "int8") {
+        return CellType::INT8;
     } else if (cell_type != "double") {
         ctx.fail();
     }
@@ -11,6 +11,7 @@
 #include "dense/dense_dot_product_function.h"
 #include "dense/dense_xw_product_function.h"
 #include "dense/dense_matmul_function.h"
+#include "dense/dense_join_reduce_function.h"
 #include "dense/dense_fast_rename_optimizer.h"
 #include "dense/dense_add_dimension_optimizer.h"
 #include "dense/dense_remove_dimension_optimizer.h"
@@ -19,6 +20,8 @@
 #include "dense/vector_from_doubles_function.h"
 #include "dense/dense_tensor_create_function.h"
 #include "dense/dense_tensor_peek_function.h"
+#include "mixed/mixed_tensor.h"
+#include "mixed/mixed_tensor_builder.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/tensor_spec.h>
@@ -72,11 +75,6 @@ const Value &to_simple(const Value &value, Stash &stash) {
 
 const Value &to_default(const Value &value, Stash &stash) {
     if (auto tensor = value.as_tensor()) {
-        if (auto simple = dynamic_cast<const eval::SimpleTensor *>(tensor)) {
-            if (!Tensor::supported({simple->type()})) {
-                return stash.create<WrappedSimpleTensor>(*simple);
-            }
-        }
         nbostream data;
         tensor->engine().encode(*tensor, data);
         return *stash.create<Value::UP>(default_engine().decode(data));
@@ -99,6 +97,21 @@ Value::UP to_value(std::unique_ptr<Tensor> tensor) {
     return std::make_unique<DoubleValue>(tensor->as_double());
 }
 
+// tensors wrapping simple tensors can only be evaluated by the fall-back engine
+
+bool needs_fallback(const Tensor &tensor) {
+    return (dynamic_cast<const WrappedSimpleTensor *>(&tensor) != nullptr);
+}
+
+// mixed tensor operations are used when the types are neither all dense nor all sparse
+
+const Tensor &to_mixed(const Tensor &tensor, Stash &stash) {
+    if (dynamic_cast<const MixedTensor *>(&tensor)) {
+        return tensor;
+    }
+    return *stash.create<std::unique_ptr<MixedTensor>>(MixedTensor::from(tensor));
+}
+
 const Value &fallback_join(const Value &a, const Value &b, join_fun_t function, Stash &stash) {
     return to_default(simple_engine().join(to_simple(a, stash), to_simple(b, stash), function, stash), stash);
 }
@@ -128,6 +141,32 @@ size_t calculate_cell_index(const ValueType &type, const TensorSpec::Address &ad
     return idx;
 }
 
+bool build_mixed_cell_address(const ValueType &type, const TensorSpec::Address &address,
+                              SparseTensorAddressBuilder &builder, size_t &cell_idx)
+{
+    if (type.dimensions().size() != address.size()) {
+        return false;
+    }
+    size_t d = 0;
+    builder.clear();
+    cell_idx = 0;
+    for (const auto &binding: address) {
+        const auto &dim = type.dimensions()[d++];
+        if (dim.name != binding.first) {
+            return false;
+        }
+        if (dim.is_mapped()) {
+            builder.add(binding.second.name);
+        } else if (binding.second.index < dim.size) {
+            cell_idx *= dim.size;
+            cell_idx += binding.second.index;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool build_cell_address(const ValueType &type, const TensorSpec::Address &address,
                         SparseTensorAddressBuilder &builder)
 {
@@ -180,7 +219,7 @@ struct CallDenseTensorBuilder {
             if (cell_idx == UNDEFINED_IDX) {
                 bad_spec(spec);
             }
-            builder.insertCell(cell_idx, cell.second);
+            builder.insertCell(cell_idx, cell.second.value);
         }
         return builder.build();
     }
@@ -209,6 +248,19 @@ DefaultTensorEngine::from_spec(const TensorSpec &spec) const
             }
         }
         return builder.build();
+    } else if (type.is_tensor()) {
+        MixedTensorBuilder builder(type);
+        SparseTensorAddressBuilder address_builder;
+        size_t cell_idx;
+        for (const auto &cell: spec.cells()) {
+            const auto &address = cell.first;
+            if (build_mixed_cell_address(type, address, address_builder, cell_idx)) {
+                builder.insert_subspace(address_builder.getAddressRef()).first[cell_idx] = cell.second;
+            } else {
+                bad_spec(spec);
+            }
+        }
+        return to_value(builder.build());
     }
     return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::create(spec));
 }
@@ -271,6 +323,7 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
         child.set(DenseDotProductFunction::optimize(child.get(), stash));
         child.set(DenseXWProductFunction::optimize(child.get(), stash));
         child.set(DenseMatMulFunction::optimize(child.get(), stash));
+        child.set(DenseJoinReduceFunction::optimize(child.get(), stash));
         child.set(DenseFastRenameOptimizer::optimize(child.get(), stash));
         child.set(DenseAddDimensionOptimizer::optimize(child.get(), stash));
         child.set(DenseRemoveDimensionOptimizer::optimize(child.get(), stash));
@@ -290,7 +343,7 @@ DefaultTensorEngine::map(const Value &a, map_fun_t function, Stash &stash) const
     if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (needs_fallback(my_a)) {
             return to_default(simple_engine().map(to_simple(a, stash), function, stash), stash);
         }
         CellFunctionFunAdapter cell_function(function);
@@ -309,12 +362,15 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         if (auto tensor_b = b.as_tensor()) {
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
-            if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
+            if (needs_fallback(my_a) || needs_fallback(my_b)) {
                 return fallback_join(a, b, function, stash);
             }
+            if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
+                return to_value(to_mixed(my_a, stash).join(function, my_b), stash);
+            }
             return to_value(my_a.join(function, my_b), stash);
         } else {
-            if (!tensor::Tensor::supported({my_a.type()})) {
+            if (needs_fallback(my_a)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindRightAdapter cell_function(function, b.as_double());
@@ -324,7 +380,7 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         if (auto tensor_b = b.as_tensor()) {
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
-            if (!tensor::Tensor::supported({my_b.type()})) {
+            if (needs_fallback(my_b)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindLeftAdapter cell_function(function, a.as_double());
@@ -345,9 +401,12 @@ DefaultTensorEngine::merge(const Value &a, const Value &b, join_fun_t function,
         assert(&tensor_b->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor_a);
         const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
-        if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
+        if (needs_fallback(my_a) || needs_fallback(my_b)) {
             return fallback_merge(a, b, function, stash);
         }
+        if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
+            return to_value(to_mixed(my_a, stash).merge(function, my_b), stash);
+        }
         return to_value(my_a.merge(function, my_b), stash);
     } else {
         return stash.create<DoubleValue>(function(a.as_double(), b.as_double()));
@@ -360,7 +419,7 @@ DefaultTensorEngine::reduce(const Value &a, Aggr aggr, const std::vector<vespali
     if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (needs_fallback(my_a)) {
             return fallback_reduce(a, aggr, dimensions, stash);
         }
         switch (aggr) {
@@ -400,7 +459,7 @@ template <typename OCT>
 struct CallAppendVector {
     template <typename CT>
     static void call(const ConstArrayRef<CT> &arr, OCT *&pos) {
-        for (CT cell: arr) { *pos++ = cell; }
+        for (CT cell: arr) { *pos++ = OCT(cell); }
     }
 };
 
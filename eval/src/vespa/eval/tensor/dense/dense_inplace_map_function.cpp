@@ -54,8 +54,10 @@ const TensorFunction &
 DenseInplaceMapFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
 {
     if (auto map = as<Map>(expr)) {
-        if (map->child().result_is_mutable() && map->result_type().is_dense()) {
-            assert(map->result_type().cell_type() == map->child().result_type().cell_type());
+        // small cell types are mapped to float cells, which can not be done in place
+        if (map->child().result_is_mutable() && map->result_type().is_dense() &&
+            (map->result_type().cell_type() == map->child().result_type().cell_type()))
+        {
             return stash.create<DenseInplaceMapFunction>(map->result_type(), map->child(), map->function());
         }
     }
@@ -0,0 +1,209 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_join_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <assert.h>
+
+namespace vespalib::tensor {
+
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::as;
+using eval::Aggr;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+using Loop = DenseJoinReduceFunction::Loop;
+
+namespace {
+
+struct CallFun {
+    join_fun_t function;
+    CallFun(join_fun_t function_in) : function(function_in) {}
+    double operator()(double a, double b) const { return function(a, b); }
+};
+
+struct MulFun {
+    MulFun(join_fun_t) {}
+    double operator()(double a, double b) const { return (a * b); }
+};
+
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+void my_inner_loop(const Loop &loop, const LCT *lhs, const RCT *rhs, OCT *dst, const Fun &fun) {
+    if (loop.dst_stride == 0) {
+        double result = 0.0;
+        if ((loop.lhs_stride == 1) && (loop.rhs_stride == 1)) {
+            for (size_t i = 0; i < loop.size; ++i) {
+                result += fun(lhs[i], rhs[i]);
+            }
+        } else {
+            for (size_t i = 0; i < loop.size; ++i) {
+                result += fun(*lhs, *rhs);
+                lhs += loop.lhs_stride;
+                rhs += loop.rhs_stride;
+            }
+        }
+        *dst += result;
+    } else if ((loop.dst_stride == 1) && (loop.lhs_stride == 1) && (loop.rhs_stride == 1)) {
+        for (size_t i = 0; i < loop.size; ++i) {
+            dst[i] += fun(lhs[i], rhs[i]);
+        }
+    } else {
+        for (size_t i = 0; i < loop.size; ++i) {
+            *dst += fun(*lhs, *rhs);
+            lhs += loop.lhs_stride;
+            rhs += loop.rhs_stride;
+            dst += loop.dst_stride;
+        }
+    }
+}
+
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+void my_loop(const Loop *loop, const Loop *inner, const LCT *lhs, const RCT *rhs, OCT *dst, const Fun &fun) {
+    if (loop == inner) {
+        my_inner_loop(*loop, lhs, rhs, dst, fun);
+    } else {
+        for (size_t i = 0; i < loop->size; ++i) {
+            my_loop(loop + 1, inner, lhs, rhs, dst, fun);
+            lhs += loop->lhs_stride;
+            rhs += loop->rhs_stride;
+            dst += loop->dst_stride;
+        }
+    }
+}
+
+template <typename LCT, typename RCT, typename Fun>
+void my_join_reduce_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const DenseJoinReduceFunction::Self &self = *((const DenseJoinReduceFunction::Self *)(param));
+    using OCT = typename eval::UnifyCellTypes<LCT,RCT>::type;
+    Fun fun(self.function);
+    auto lhs_cells = DenseTensorView::typify_cells<LCT>(state.peek(1));
+    auto rhs_cells = DenseTensorView::typify_cells<RCT>(state.peek(0));
+    if (self.result_type.is_double()) {
+        double result = 0.0;
+        my_loop(&self.loops.front(), &self.loops.back(), lhs_cells.cbegin(), rhs_cells.cbegin(), &result, fun);
+        state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+    } else {
+        auto dst_cells = state.stash.create_array<OCT>(self.dst_size);
+        my_loop(&self.loops.front(), &self.loops.back(), lhs_cells.cbegin(), rhs_cells.cbegin(), dst_cells.begin(), fun);
+        state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
+    }
+}
+
+template <typename Fun>
+struct MyJoinReduceOp {
+    template <typename LCT, typename RCT>
+    static auto get_fun() { return my_join_reduce_op<LCT,RCT,Fun>; }
+};
+
+eval::InterpretedFunction::op_function my_select(CellType lct, CellType rct, join_fun_t function) {
+    if (function == Mul::f) {
+        return select_2<MyJoinReduceOp<MulFun>>(lct, rct);
+    }
+    return select_2<MyJoinReduceOp<CallFun>>(lct, rct);
+}
+
+size_t stride_of(const ValueType &type, const vespalib::string &dimension) {
+    size_t idx = type.dimension_index(dimension);
+    if (idx == ValueType::Dimension::npos) {
+        return 0;
+    }
+    size_t stride = 1;
+    for (size_t i = idx + 1; i < type.dimensions().size(); ++i) {
+        stride *= type.dimensions()[i].size;
+    }
+    return stride;
+}
+
+bool can_combine(const Loop &outer, const Loop &inner) {
+    return ((outer.lhs_stride == (inner.lhs_stride * inner.size)) &&
+            (outer.rhs_stride == (inner.rhs_stride * inner.size)) &&
+            (outer.dst_stride == (inner.dst_stride * inner.size)));
+}
+
+std::vector<Loop> make_loops(const ValueType &lhs, const ValueType &rhs, const ValueType &result) {
+    ValueType joined = ValueType::join(lhs, rhs);
+    assert(joined.is_dense());
+    std::vector<Loop> loops;
+    for (const auto &dim: joined.dimensions()) {
+        Loop loop(dim.size, stride_of(lhs, dim.name), stride_of(rhs, dim.name), stride_of(result, dim.name));
+        if (!loops.empty() && can_combine(loops.back(), loop)) {
+            loops.back() = Loop(loops.back().size * loop.size, loop.lhs_stride, loop.rhs_stride, loop.dst_stride);
+        } else {
+            loops.push_back(loop);
+        }
+    }
+    return loops;
+}
+
+bool is_dense_or_double(const ValueType &type) {
+    return (type.is_dense() || type.is_double());
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseJoinReduceFunction::Self::Self(const eval::ValueType &result_type_in,
+                                    join_fun_t function_in,
+                                    const std::vector<Loop> &loops_in)
+    : result_type(result_type_in),
+      function(function_in),
+      loops(loops_in),
+      dst_size(result_type_in.dense_subspace_size())
+{
+}
+
+DenseJoinReduceFunction::Self::~Self() = default;
+
+DenseJoinReduceFunction::DenseJoinReduceFunction(const eval::ValueType &result_type,
+                                                 const eval::TensorFunction &lhs_in,
+                                                 const eval::TensorFunction &rhs_in,
+                                                 join_fun_t function_in)
+    : Super(result_type, lhs_in, rhs_in),
+      _function(function_in),
+      _loops(make_loops(lhs_in.result_type(), rhs_in.result_type(), result_type))
+{
+}
+
+DenseJoinReduceFunction::~DenseJoinReduceFunction() = default;
+
+eval::InterpretedFunction::Instruction
+DenseJoinReduceFunction::compile_self(Stash &stash) const
+{
+    Self &self = stash.create<Self>(result_type(), _function, _loops);
+    auto op = my_select(lhs().result_type().cell_type(), rhs().result_type().cell_type(), _function);
+    return eval::InterpretedFunction::Instruction(op, (uint64_t)(&self));
+}
+
+void
+DenseJoinReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitInt("num_loops", _loops.size());
+    for (const auto &loop: _loops) {
+        visitor.openStruct("loop", "Loop");
+        visitor.visitInt("size", loop.size);
+        visitor.visitInt("lhs_stride", loop.lhs_stride);
+        visitor.visitInt("rhs_stride", loop.rhs_stride);
+        visitor.visitInt("dst_stride", loop.dst_stride);
+        visitor.closeStruct();
+    }
+}
+
+const TensorFunction &
+DenseJoinReduceFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && (reduce->aggr() == Aggr::SUM) && is_dense_or_double(expr.result_type())) {
+        auto join = as<Join>(reduce->child());
+        if (join && join->lhs().result_type().is_dense() && join->rhs().result_type().is_dense()) {
+            return stash.create<DenseJoinReduceFunction>(expr.result_type(), join->lhs(), join->rhs(), join->function());
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
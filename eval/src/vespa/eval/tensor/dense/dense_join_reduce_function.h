@@ -0,0 +1,62 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function summing the result of joining two dense tensors
+ * over some (or all) of the joined dimensions, without creating the
+ * intermediate join result. The joined dimensions are turned into a
+ * list of nested loops, where adjacent dimensions with the same
+ * memory layout in both inputs and the output are combined into a
+ * single loop.
+ **/
+class DenseJoinReduceFunction : public eval::tensor_function::Op2
+{
+    using Super = eval::tensor_function::Op2;
+public:
+    using join_fun_t = ::vespalib::eval::tensor_function::join_fun_t;
+
+    struct Loop {
+        size_t size;
+        size_t lhs_stride;
+        size_t rhs_stride;
+        size_t dst_stride;
+        Loop(size_t size_in, size_t lhs_stride_in, size_t rhs_stride_in, size_t dst_stride_in)
+            : size(size_in), lhs_stride(lhs_stride_in), rhs_stride(rhs_stride_in), dst_stride(dst_stride_in) {}
+    };
+
+    struct Self {
+        eval::ValueType result_type;
+        join_fun_t function;
+        std::vector<Loop> loops;
+        size_t dst_size;
+        Self(const eval::ValueType &result_type_in, join_fun_t function_in, const std::vector<Loop> &loops_in);
+        ~Self();
+    };
+
+private:
+    join_fun_t _function;
+    std::vector<Loop> _loops;
+
+public:
+    DenseJoinReduceFunction(const eval::ValueType &result_type,
+                            const eval::TensorFunction &lhs_in,
+                            const eval::TensorFunction &rhs_in,
+                            join_fun_t function_in);
+    ~DenseJoinReduceFunction();
+
+    bool result_is_mutable() const override { return true; }
+
+    join_fun_t function() const { return _function; }
+    const std::vector<Loop> &loops() const { return _loops; }
+
+    eval::InterpretedFunction::Instruction compile_self(Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
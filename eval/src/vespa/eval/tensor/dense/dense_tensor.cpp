@@ -73,5 +73,7 @@ DenseTensor<CT>::operator==(const DenseTensor<RCT> &rhs) const
 
 template class DenseTensor<float>;
 template class DenseTensor<double>;
+template class DenseTensor<BFloat16>;
+template class DenseTensor<Int8Float>;
 
 }
@@ -38,5 +38,7 @@ DenseTensorModify<CT>::build()
 
 template class DenseTensorModify<float>;
 template class DenseTensorModify<double>;
+template class DenseTensorModify<BFloat16>;
+template class DenseTensorModify<Int8Float>;
 
 } // namespace
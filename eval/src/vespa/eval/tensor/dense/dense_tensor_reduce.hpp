@@ -23,8 +23,9 @@ public:
     template <typename T, typename Function>
     std::unique_ptr<DenseTensorView>
     reduceCells(ConstArrayRef<T> cellsIn, Function &&func) {
+        using OCT = typename eval::UnifyCellTypes<T,T>::type;
         size_t resultSize = calcCellsSize(_type);
-        std::vector<T> cellsOut(resultSize);
+        std::vector<OCT> cellsOut(resultSize);
         auto itr_in = cellsIn.cbegin();
         auto itr_out = cellsOut.begin();
         for (size_t outerDim = 0; outerDim < _outerDimSize; ++outerDim) {
@@ -45,7 +46,7 @@ public:
         }
         assert(itr_out == cellsOut.end());
         assert(itr_in == cellsIn.cend());
-        return std::make_unique<DenseTensor<T>>(std::move(_type), std::move(cellsOut));
+        return std::make_unique<DenseTensor<OCT>>(std::move(_type), std::move(cellsOut));
     }
 };
 
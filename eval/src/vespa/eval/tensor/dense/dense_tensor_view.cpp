@@ -196,20 +196,21 @@ struct CallApply {
     static Tensor::UP
     call(const ConstArrayRef<CT> &oldCells, const eval::ValueType &newType, const CellFunction &func)
     {
-        std::vector<CT> newCells;
+        using OCT = typename eval::UnifyCellTypes<CT,CT>::type;
+        std::vector<OCT> newCells;
         newCells.reserve(oldCells.size());
         for (const auto &cell : oldCells) {
-            CT nv = func.apply(cell);
+            OCT nv = func.apply(cell);
             newCells.push_back(nv);
         }
-        return std::make_unique<DenseTensor<CT>>(newType, std::move(newCells));
+        return std::make_unique<DenseTensor<OCT>>(newType, std::move(newCells));
     }
 };
 
 Tensor::UP
 DenseTensorView::apply(const CellFunction &func) const
 {
-    return dispatch_1<CallApply>(_cellsRef, _typeRef, func);
+    return dispatch_1<CallApply>(_cellsRef, _typeRef.map(), func);
 }
 
 bool
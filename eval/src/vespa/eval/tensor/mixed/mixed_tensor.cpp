@@ -0,0 +1,686 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_tensor.h"
+#include "mixed_tensor_builder.h"
+#include <vespa/eval/tensor/cell_values.h>
+#include <vespa/eval/tensor/tensor_address_builder.h>
+#include <vespa/eval/tensor/tensor_address_element_iterator.h>
+#include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/eval/tensor/dense/dense_tensor_address_mapper.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_decoder.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+
+using vespalib::eval::TensorSpec;
+using vespalib::eval::ValueType;
+
+namespace vespalib::tensor {
+
+namespace {
+
+using Subspaces = MixedTensor::Subspaces;
+using Labels = std::vector<vespalib::stringref>;
+
+/**
+ * The mapped and indexed dimensions of a tensor type, given as
+ * indexes into the (sorted) dimensions of the type.
+ */
+struct DimensionSplit {
+    std::vector<size_t> mapped;
+    std::vector<size_t> indexed;
+    explicit DimensionSplit(const ValueType &type) : mapped(), indexed() {
+        const auto &dims = type.dimensions();
+        for (size_t i = 0; i < dims.size(); ++i) {
+            if (dims[i].is_mapped()) {
+                mapped.push_back(i);
+            } else {
+                indexed.push_back(i);
+            }
+        }
+    }
+    ~DimensionSplit();
+};
+
+DimensionSplit::~DimensionSplit() = default;
+
+void decode_labels(SparseTensorAddressRef address, Labels &labels) {
+    labels.clear();
+    SparseTensorAddressDecoder decoder(address);
+    while (decoder.valid()) {
+        labels.push_back(decoder.decodeLabel());
+    }
+}
+
+size_t find_dimension(const ValueType &type, const std::vector<size_t> &dims, const vespalib::string &name) {
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (type.dimensions()[dims[i]].name == name) {
+            return i;
+        }
+    }
+    return ValueType::Dimension::npos;
+}
+
+/**
+ * Calculates for each cell in a dense subspace of the 'to' type
+ * the offset of the corresponding cell in a dense subspace of the
+ * 'from' type. Indexed dimensions in 'to' that are not in 'from'
+ * do not contribute to the offset.
+ */
+std::vector<uint32_t> make_dense_offsets(const ValueType &to, const ValueType &from) {
+    DimensionSplit to_split(to);
+    DimensionSplit from_split(from);
+    std::vector<size_t> sizes;
+    std::vector<size_t> strides;
+    for (size_t dim: to_split.indexed) {
+        const auto &to_dim = to.dimensions()[dim];
+        sizes.push_back(to_dim.size);
+        size_t stride = 0;
+        size_t from_idx = find_dimension(from, from_split.indexed, to_dim.name);
+        if (from_idx != ValueType::Dimension::npos) {
+            stride = 1;
+            for (size_t i = from_idx + 1; i < from_split.indexed.size(); ++i) {
+                stride *= from.dimensions()[from_split.indexed[i]].size;
+            }
+        }
+        strides.push_back(stride);
+    }
+    std::vector<uint32_t> offsets;
+    offsets.reserve(to.dense_subspace_size());
+    std::vector<size_t> address(sizes.size(), 0);
+    size_t offset = 0;
+    for (size_t i = 0, n = to.dense_subspace_size(); i < n; ++i) {
+        offsets.push_back(offset);
+        for (size_t d = sizes.size(); d-- > 0; ) {
+            offset += strides[d];
+            if (++address[d] < sizes[d]) {
+                break;
+            }
+            offset -= strides[d] * sizes[d];
+            address[d] = 0;
+        }
+    }
+    return offsets;
+}
+
+bool is_identity(const std::vector<uint32_t> &offsets) {
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * For each mapped dimension in the 'to' type, where to find the
+ * label among the mapped dimensions of one of the 'from' types.
+ */
+struct LabelSource {
+    bool from_lhs;
+    size_t idx;
+};
+
+std::vector<LabelSource> make_label_sources(const ValueType &to, const ValueType &lhs, const ValueType &rhs) {
+    DimensionSplit to_split(to);
+    DimensionSplit lhs_split(lhs);
+    DimensionSplit rhs_split(rhs);
+    std::vector<LabelSource> result;
+    for (size_t dim: to_split.mapped) {
+        const auto &name = to.dimensions()[dim].name;
+        size_t idx = find_dimension(lhs, lhs_split.mapped, name);
+        if (idx != ValueType::Dimension::npos) {
+            result.push_back({true, idx});
+        } else {
+            idx = find_dimension(rhs, rhs_split.mapped, name);
+            assert(idx != ValueType::Dimension::npos);
+            result.push_back({false, idx});
+        }
+    }
+    return result;
+}
+
+void copy_subspaces(const Subspaces &subspaces_in, Subspaces &subspaces, Stash &stash) {
+    subspaces.resize(subspaces_in.size() * 2);
+    for (const auto &subspace: subspaces_in) {
+        subspaces[SparseTensorAddressRef(subspace.first, stash)] = subspace.second;
+    }
+}
+
+template <typename CT>
+void round_cells(std::vector<double> &cells) {
+    for (double &cell: cells) {
+        cell = CT(cell);
+    }
+}
+
+void round_to_cell_type(const ValueType &type, std::vector<double> &cells) {
+    switch (type.cell_type()) {
+    case ValueType::CellType::DOUBLE: return;
+    case ValueType::CellType::FLOAT: return round_cells<float>(cells);
+    case ValueType::CellType::BFLOAT16: return round_cells<BFloat16>(cells);
+    case ValueType::CellType::INT8: return round_cells<Int8Float>(cells);
+    }
+}
+
+const MixedTensor &as_mixed(const Tensor &tensor, std::unique_ptr<MixedTensor> &space) {
+    if (auto mixed = dynamic_cast<const MixedTensor *>(&tensor)) {
+        return *mixed;
+    }
+    space = MixedTensor::from(tensor);
+    return *space;
+}
+
+/**
+ * Builds a mixed tensor from the cells visited.
+ */
+class MixedTensorFromVisitor : public TensorVisitor {
+private:
+    MixedTensorBuilder &_builder;
+    DimensionSplit _split;
+    SparseTensorAddressBuilder _address;
+public:
+    explicit MixedTensorFromVisitor(MixedTensorBuilder &builder)
+        : _builder(builder), _split(builder.type()), _address() {}
+    ~MixedTensorFromVisitor() override;
+    void visit(const TensorAddress &address, double value) override {
+        const auto &dims = _builder.type().dimensions();
+        TensorAddressElementIterator<TensorAddress> itr(address);
+        _address.clear();
+        uint32_t idx = 0;
+        for (size_t dim = 0; dim < dims.size(); ++dim) {
+            bool found = itr.skipToDimension(dims[dim].name);
+            if (dims[dim].is_mapped()) {
+                if (found) {
+                    _address.add(itr.label());
+                } else {
+                    _address.addUndefined();
+                }
+            } else {
+                assert(found);
+                uint32_t label = DenseTensorAddressMapper::mapLabelToNumber(itr.label());
+                assert(label < dims[dim].size);
+                idx = idx * dims[dim].size + label;
+            }
+            if (found) {
+                itr.next();
+            }
+        }
+        _builder.insert_subspace(_address.getAddressRef()).first[idx] = value;
+    }
+};
+
+MixedTensorFromVisitor::~MixedTensorFromVisitor() = default;
+
+/**
+ * Applies a join function to the cells matching the visited cell addresses.
+ * The visited addresses contain labels for both mapped and indexed dimensions.
+ */
+class MixedTensorModify : public TensorVisitor {
+private:
+    MixedTensorBuilder &_builder;
+    Tensor::join_fun_t _op;
+    SparseTensorAddressBuilder _address;
+public:
+    MixedTensorModify(MixedTensorBuilder &builder, Tensor::join_fun_t op)
+        : _builder(builder), _op(op), _address() {}
+    ~MixedTensorModify() override;
+    void visit(const TensorAddress &address, double value) override {
+        const auto &dims = _builder.type().dimensions();
+        TensorAddressElementIterator<TensorAddress> itr(address);
+        _address.clear();
+        uint32_t idx = 0;
+        for (const auto &dim: dims) {
+            if (!itr.skipToDimension(dim.name)) {
+                return;
+            }
+            if (dim.is_mapped()) {
+                _address.add(itr.label());
+            } else {
+                uint32_t label = DenseTensorAddressMapper::mapLabelToNumber(itr.label());
+                if (label == DenseTensorAddressMapper::BAD_LABEL || label >= dim.size) {
+                    return;
+                }
+                idx = idx * dim.size + label;
+            }
+            itr.next();
+        }
+        auto cells = _builder.find_subspace(_address.getAddressRef());
+        if (cells.size() != 0) {
+            cells[idx] = _op(cells[idx], value);
+        }
+    }
+};
+
+MixedTensorModify::~MixedTensorModify() = default;
+
+/**
+ * Removes the subspaces matching the visited addresses. The visited
+ * addresses only contain labels for the mapped dimensions.
+ */
+class MixedTensorRemove : public TensorVisitor {
+private:
+    const ValueType &_type;
+    Subspaces &_subspaces;
+    SparseTensorAddressBuilder _address;
+public:
+    MixedTensorRemove(const ValueType &type, Subspaces &subspaces)
+        : _type(type), _subspaces(subspaces), _address() {}
+    ~MixedTensorRemove() override;
+    void visit(const TensorAddress &address, double) override {
+        TensorAddressElementIterator<TensorAddress> itr(address);
+        _address.clear();
+        for (const auto &dim: _type.dimensions()) {
+            if (dim.is_mapped()) {
+                if (!itr.skipToDimension(dim.name)) {
+                    return;
+                }
+                _address.add(itr.label());
+                itr.next();
+            }
+        }
+        _subspaces.erase(_address.getAddressRef());
+    }
+};
+
+MixedTensorRemove::~MixedTensorRemove() = default;
+
+}
+
+MixedTensor::MixedTensor(ValueType &&type_in, Subspaces &&subspaces_in, std::vector<double> &&cells_in, Stash &&stash_in)
+    : _type(std::move(type_in)),
+      _subspace_size(_type.dense_subspace_size()),
+      _subspaces(std::move(subspaces_in)),
+      _cells(std::move(cells_in)),
+      _stash(std::move(stash_in))
+{
+    assert(_cells.size() == (_subspaces.size() * _subspace_size));
+    round_to_cell_type(_type, _cells);
+}
+
+MixedTensor::~MixedTensor() = default;
+
+std::unique_ptr<MixedTensor>
+MixedTensor::from(const Tensor &tensor)
+{
+    MixedTensorBuilder builder(tensor.type());
+    if (auto mixed = dynamic_cast<const MixedTensor *>(&tensor)) {
+        return std::unique_ptr<MixedTensor>(static_cast<MixedTensor *>(mixed->clone().release()));
+    } else if (auto sparse = dynamic_cast<const SparseTensor *>(&tensor)) {
+        builder.reserve(sparse->cells().size());
+        for (const auto &cell: sparse->cells()) {
+            builder.insert_subspace(cell.first).first[0] = cell.second;
+        }
+    } else if (auto dense = dynamic_cast<const DenseTensorView *>(&tensor)) {
+        SparseTensorAddressBuilder empty_address;
+        auto cells = builder.insert_subspace(empty_address.getAddressRef()).first;
+        const TypedCells &dense_cells = dense->cellsRef();
+        for (size_t i = 0; i < dense_cells.size; ++i) {
+            cells[i] = dense_cells.get(i);
+        }
+    } else {
+        MixedTensorFromVisitor visitor(builder);
+        tensor.accept(visitor);
+    }
+    return builder.build_mixed();
+}
+
+const ValueType &
+MixedTensor::type() const
+{
+    return _type;
+}
+
+double
+MixedTensor::as_double() const
+{
+    double result = 0.0;
+    for (double cell: _cells) {
+        result += cell;
+    }
+    return result;
+}
+
+Tensor::UP
+MixedTensor::apply(const CellFunction &func) const
+{
+    Stash stash(STASH_CHUNK_SIZE);
+    Subspaces subspaces;
+    copy_subspaces(_subspaces, subspaces, stash);
+    std::vector<double> cells;
+    cells.reserve(_cells.size());
+    for (double cell: _cells) {
+        cells.push_back(func.apply(cell));
+    }
+    return std::make_unique<MixedTensor>(_type.map(), std::move(subspaces), std::move(cells), std::move(stash));
+}
+
+Tensor::UP
+MixedTensor::join(join_fun_t function, const Tensor &arg) const
+{
+    std::unique_ptr<MixedTensor> space;
+    const MixedTensor &rhs = as_mixed(arg, space);
+    ValueType result_type = ValueType::join(_type, rhs._type);
+    assert(!result_type.is_error());
+    MixedTensorBuilder builder(result_type);
+    std::vector<uint32_t> lhs_offsets = make_dense_offsets(result_type, _type);
+    std::vector<uint32_t> rhs_offsets = make_dense_offsets(result_type, rhs._type);
+    bool identity = (is_identity(lhs_offsets) && is_identity(rhs_offsets));
+    auto join_subspace = [&](SparseTensorAddressRef address, uint32_t lhs_idx, uint32_t rhs_idx) {
+        auto dst = builder.insert_subspace(address).first;
+        const double *lhs_cells = subspace(lhs_idx).cbegin();
+        const double *rhs_cells = rhs.subspace(rhs_idx).cbegin();
+        if (identity) {
+            for (size_t i = 0; i < dst.size(); ++i) {
+                dst[i] = function(lhs_cells[i], rhs_cells[i]);
+            }
+        } else {
+            for (size_t i = 0; i < dst.size(); ++i) {
+                dst[i] = function(lhs_cells[lhs_offsets[i]], rhs_cells[rhs_offsets[i]]);
+            }
+        }
+    };
+    DimensionSplit lhs_split(_type);
+    DimensionSplit rhs_split(rhs._type);
+    bool same_mapped = (lhs_split.mapped.size() == rhs_split.mapped.size());
+    for (size_t i = 0; same_mapped && (i < lhs_split.mapped.size()); ++i) {
+        same_mapped = (_type.dimensions()[lhs_split.mapped[i]].name == rhs._type.dimensions()[rhs_split.mapped[i]].name);
+    }
+    if (same_mapped) {
+        builder.reserve(std::min(_subspaces.size(), rhs._subspaces.size()));
+        for (const auto &lhs_subspace: _subspaces) {
+            auto pos = rhs._subspaces.find(lhs_subspace.first);
+            if (pos != rhs._subspaces.end()) {
+                join_subspace(lhs_subspace.first, lhs_subspace.second, pos->second);
+            }
+        }
+        return builder.build();
+    }
+    // group rhs subspaces by their labels for the mapped dimensions shared with lhs
+    std::vector<std::pair<size_t, size_t>> overlap;
+    for (size_t i = 0; i < lhs_split.mapped.size(); ++i) {
+        size_t rhs_idx = find_dimension(rhs._type, rhs_split.mapped, _type.dimensions()[lhs_split.mapped[i]].name);
+        if (rhs_idx != ValueType::Dimension::npos) {
+            overlap.emplace_back(i, rhs_idx);
+        }
+    }
+    Labels labels;
+    SparseTensorAddressBuilder key;
+    hash_map<vespalib::string, std::vector<uint32_t>> rhs_groups;
+    std::vector<SparseTensorAddressRef> rhs_addresses(rhs._subspaces.size());
+    for (const auto &rhs_subspace: rhs._subspaces) {
+        rhs_addresses[rhs_subspace.second] = rhs_subspace.first;
+        decode_labels(rhs_subspace.first, labels);
+        key.clear();
+        for (const auto &dims: overlap) {
+            key.add(labels[dims.second]);
+        }
+        auto key_ref = key.getAddressRef();
+        rhs_groups[vespalib::string(static_cast<const char *>(key_ref.start()), key_ref.size())].push_back(rhs_subspace.second);
+    }
+    std::vector<LabelSource> label_sources = make_label_sources(result_type, _type, rhs._type);
+    Labels rhs_labels;
+    SparseTensorAddressBuilder address;
+    for (const auto &lhs_subspace: _subspaces) {
+        decode_labels(lhs_subspace.first, labels);
+        key.clear();
+        for (const auto &dims: overlap) {
+            key.add(labels[dims.first]);
+        }
+        auto key_ref = key.getAddressRef();
+        auto group = rhs_groups.find(vespalib::string(static_cast<const char *>(key_ref.start()), key_ref.size()));
+        if (group == rhs_groups.end()) {
+            continue;
+        }
+        for (uint32_t rhs_idx: group->second) {
+            decode_labels(rhs_addresses[rhs_idx], rhs_labels);
+            address.clear();
+            for (const auto &source: label_sources) {
+                address.add(source.from_lhs ? labels[source.idx] : rhs_labels[source.idx]);
+            }
+            join_subspace(address.getAddressRef(), lhs_subspace.second, rhs_idx);
+        }
+    }
+    return builder.build();
+}
+
+Tensor::UP
+MixedTensor::merge(join_fun_t function, const Tensor &arg) const
+{
+    std::unique_ptr<MixedTensor> space;
+    const MixedTensor &rhs = as_mixed(arg, space);
+    assert(_type.dimensions() == rhs._type.dimensions());
+    MixedTensorBuilder builder(ValueType::merge(_type, rhs._type));
+    builder.reserve(_subspaces.size() + rhs._subspaces.size());
+    for (const auto &lhs_subspace: _subspaces) {
+        auto dst = builder.insert_subspace(lhs_subspace.first).first;
+        auto lhs_cells = subspace(lhs_subspace.second);
+        auto pos = rhs._subspaces.find(lhs_subspace.first);
+        if (pos == rhs._subspaces.end()) {
+            std::copy(lhs_cells.begin(), lhs_cells.end(), dst.begin());
+        } else {
+            auto rhs_cells = rhs.subspace(pos->second);
+            for (size_t i = 0; i < dst.size(); ++i) {
+                dst[i] = function(lhs_cells[i], rhs_cells[i]);
+            }
+        }
+    }
+    for (const auto &rhs_subspace: rhs._subspaces) {
+        auto res = builder.insert_subspace(rhs_subspace.first);
+        if (res.second) {
+            auto rhs_cells = rhs.subspace(rhs_subspace.second);
+            std::copy(rhs_cells.begin(), rhs_cells.end(), res.first.begin());
+        }
+    }
+    return builder.build();
+}
+
+Tensor::UP
+MixedTensor::reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const
+{
+    ValueType result_type = _type.reduce(dimensions);
+    assert(!result_type.is_error());
+    MixedTensorBuilder builder(result_type);
+    DimensionSplit split(_type);
+    std::vector<size_t> kept_labels;
+    for (size_t i = 0; i < split.mapped.size(); ++i) {
+        const auto &name = _type.dimensions()[split.mapped[i]].name;
+        if (std::find(dimensions.begin(), dimensions.end(), name) == dimensions.end() && !dimensions.empty()) {
+            kept_labels.push_back(i);
+        }
+    }
+    // offset of the result cell for each cell in a dense subspace of this tensor
+    std::vector<uint32_t> offsets = make_dense_offsets(_type, result_type);
+    bool identity = is_identity(offsets);
+    std::vector<bool> first(builder.subspace_size());
+    Labels labels;
+    SparseTensorAddressBuilder address;
+    for (const auto &src_subspace: _subspaces) {
+        decode_labels(src_subspace.first, labels);
+        address.clear();
+        for (size_t idx: kept_labels) {
+            address.add(labels[idx]);
+        }
+        auto res = builder.insert_subspace(address.getAddressRef());
+        auto dst = res.first;
+        auto src = subspace(src_subspace.second);
+        if (res.second && identity) {
+            std::copy(src.begin(), src.end(), dst.begin());
+        } else if (res.second) {
+            std::fill(first.begin(), first.end(), true);
+            for (size_t i = 0; i < src.size(); ++i) {
+                uint32_t offset = offsets[i];
+                if (first[offset]) {
+                    dst[offset] = src[i];
+                    first[offset] = false;
+                } else {
+                    dst[offset] = op(dst[offset], src[i]);
+                }
+            }
+        } else {
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[offsets[i]] = op(dst[offsets[i]], src[i]);
+            }
+        }
+    }
+    return builder.build();
+}
+
+std::unique_ptr<Tensor>
+MixedTensor::modify(join_fun_t op, const CellValues &cellValues) const
+{
+    MixedTensorBuilder builder(_type);
+    builder.reserve(_subspaces.size());
+    for (const auto &subspace_in: _subspaces) {
+        auto cells = subspace(subspace_in.second);
+        std::copy(cells.begin(), cells.end(), builder.insert_subspace(subspace_in.first).first.begin());
+    }
+    MixedTensorModify modifier(builder, op);
+    cellValues.accept(modifier);
+    return builder.build_mixed();
+}
+
+std::unique_ptr<Tensor>
+MixedTensor::add(const Tensor &arg) const
+{
+    const MixedTensor *rhs = dynamic_cast<const MixedTensor *>(&arg);
+    if (!rhs || (_type != rhs->_type)) {
+        return Tensor::UP();
+    }
+    MixedTensorBuilder builder(_type);
+    builder.reserve(_subspaces.size() + rhs->_subspaces.size());
+    for (const auto &subspace_in: _subspaces) {
+        auto cells = subspace(subspace_in.second);
+        std::copy(cells.begin(), cells.end(), builder.insert_subspace(subspace_in.first).first.begin());
+    }
+    for (const auto &subspace_in: rhs->_subspaces) {
+        auto cells = rhs->subspace(subspace_in.second);
+        std::copy(cells.begin(), cells.end(), builder.insert_subspace(subspace_in.first).first.begin());
+    }
+    return builder.build_mixed();
+}
+
+std::unique_ptr<Tensor>
+MixedTensor::remove(const CellValues &cellAddresses) const
+{
+    Subspaces remaining(_subspaces);
+    MixedTensorRemove remover(_type, remaining);
+    cellAddresses.accept(remover);
+    MixedTensorBuilder builder(_type);
+    builder.reserve(remaining.size());
+    for (const auto &subspace_in: remaining) {
+        auto cells = subspace(subspace_in.second);
+        std::copy(cells.begin(), cells.end(), builder.insert_subspace(subspace_in.first).first.begin());
+    }
+    return builder.build_mixed();
+}
+
+bool
+MixedTensor::equals(const Tensor &arg) const
+{
+    const MixedTensor *rhs = dynamic_cast<const MixedTensor *>(&arg);
+    if (!rhs || (_type != rhs->_type) || (_subspaces.size() != rhs->_subspaces.size())) {
+        return false;
+    }
+    for (const auto &lhs_subspace: _subspaces) {
+        auto pos = rhs->_subspaces.find(lhs_subspace.first);
+        if (pos == rhs->_subspaces.end()) {
+            return false;
+        }
+        auto lhs_cells = subspace(lhs_subspace.second);
+        auto rhs_cells = rhs->subspace(pos->second);
+        if (!std::equal(lhs_cells.begin(), lhs_cells.end(), rhs_cells.begin())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Tensor::UP
+MixedTensor::clone() const
+{
+    Stash stash(STASH_CHUNK_SIZE);
+    Subspaces subspaces;
+    copy_subspaces(_subspaces, subspaces, stash);
+    std::vector<double> cells(_cells);
+    return std::make_unique<MixedTensor>(ValueType(_type), std::move(subspaces), std::move(cells), std::move(stash));
+}
+
+TensorSpec
+MixedTensor::toSpec() const
+{
+    TensorSpec result(_type.to_spec());
+    DimensionSplit split(_type);
+    const auto &dims = _type.dimensions();
+    TensorSpec::Address address;
+    Labels labels;
+    std::vector<size_t> indexes(split.indexed.size(), 0);
+    for (const auto &subspace_in: _subspaces) {
+        decode_labels(subspace_in.first, labels);
+        assert(labels.size() == split.mapped.size());
+        address.clear();
+        for (size_t i = 0; i < split.mapped.size(); ++i) {
+            address.emplace(dims[split.mapped[i]].name, TensorSpec::Label(labels[i]));
+        }
+        auto cells = subspace(subspace_in.second);
+        std::fill(indexes.begin(), indexes.end(), 0);
+        for (double cell: cells) {
+            for (size_t i = 0; i < split.indexed.size(); ++i) {
+                address.insert_or_assign(dims[split.indexed[i]].name, TensorSpec::Label(indexes[i]));
+            }
+            result.add(address, cell);
+            for (size_t i = indexes.size(); i-- > 0; ) {
+                if (++indexes[i] < dims[split.indexed[i]].size) {
+                    break;
+                }
+                indexes[i] = 0;
+            }
+        }
+    }
+    return result;
+}
+
+void
+MixedTensor::accept(TensorVisitor &visitor) const
+{
+    DimensionSplit split(_type);
+    const auto &dims = _type.dimensions();
+    TensorAddressBuilder addressBuilder;
+    Labels labels;
+    std::vector<size_t> indexes(split.indexed.size(), 0);
+    for (const auto &subspace_in: _subspaces) {
+        decode_labels(subspace_in.first, labels);
+        auto cells = subspace(subspace_in.second);
+        std::fill(indexes.begin(), indexes.end(), 0);
+        for (double cell: cells) {
+            addressBuilder.clear();
+            size_t mapped_idx = 0;
+            size_t indexed_idx = 0;
+            for (const auto &dim: dims) {
+                if (dim.is_mapped()) {
+                    const auto &label = labels[mapped_idx++];
+                    if (label.size() != 0u) {
+                        addressBuilder.add(dim.name, label);
+                    }
+                } else {
+                    addressBuilder.add(dim.name, make_string("%zu", indexes[indexed_idx++]));
+                }
+            }
+            visitor.visit(addressBuilder.build(), cell);
+            for (size_t i = indexes.size(); i-- > 0; ) {
+                if (++indexes[i] < dims[split.indexed[i]].size) {
+                    break;
+                }
+                indexes[i] = 0;
+            }
+        }
+    }
+}
+
+}
+
+VESPALIB_HASH_MAP_INSTANTIATE_H_E_M(vespalib::tensor::SparseTensorAddressRef, uint32_t, vespalib::hash<vespalib::tensor::SparseTensorAddressRef>,
+        std::equal_to<vespalib::tensor::SparseTensorAddressRef>, vespalib::hashtable_base::and_modulator);
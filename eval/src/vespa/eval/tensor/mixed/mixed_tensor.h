@@ -0,0 +1,70 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_ref.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/stash.h>
+
+namespace vespalib::tensor {
+
+/**
+ * A tensor with both mapped and indexed dimensions.
+ *
+ * Each unique combination of labels for the mapped dimensions
+ * identifies a dense subspace spanned by the indexed dimensions. The
+ * mapped part of the address is stored once per subspace (using the
+ * same compact serialized representation as SparseTensor), and the
+ * cells of each subspace are stored contiguously (last indexed
+ * dimension is nested innermost), which lets tensor operations work
+ * subspace by subspace.
+ */
+class MixedTensor : public Tensor
+{
+public:
+    using Subspaces = hash_map<SparseTensorAddressRef, uint32_t, hash<SparseTensorAddressRef>,
+            std::equal_to<SparseTensorAddressRef>, hashtable_base::and_modulator>;
+
+    static constexpr size_t STASH_CHUNK_SIZE = 16384u;
+
+private:
+    eval::ValueType _type;
+    size_t _subspace_size;
+    Subspaces _subspaces;
+    std::vector<double> _cells;
+    Stash _stash;
+
+public:
+    MixedTensor(eval::ValueType &&type_in, Subspaces &&subspaces_in, std::vector<double> &&cells_in, Stash &&stash_in);
+    ~MixedTensor() override;
+    const eval::ValueType &fast_type() const { return _type; }
+    size_t subspace_size() const { return _subspace_size; }
+    const Subspaces &subspaces() const { return _subspaces; }
+    ConstArrayRef<double> subspace(uint32_t idx) const {
+        return ConstArrayRef<double>(_cells.data() + (idx * _subspace_size), _subspace_size);
+    }
+
+    /**
+     * Create a mixed tensor with the same type and cells as the given
+     * tensor, which can be of any tensor implementation.
+     */
+    static std::unique_ptr<MixedTensor> from(const Tensor &tensor);
+
+    const eval::ValueType &type() const override;
+    double as_double() const override;
+    Tensor::UP apply(const CellFunction &func) const override;
+    Tensor::UP join(join_fun_t function, const Tensor &arg) const override;
+    Tensor::UP merge(join_fun_t function, const Tensor &arg) const override;
+    Tensor::UP reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const override;
+    std::unique_ptr<Tensor> modify(join_fun_t op, const CellValues &cellValues) const override;
+    std::unique_ptr<Tensor> add(const Tensor &arg) const override;
+    std::unique_ptr<Tensor> remove(const CellValues &cellAddresses) const override;
+    bool equals(const Tensor &arg) const override;
+    Tensor::UP clone() const override;
+    eval::TensorSpec toSpec() const override;
+    void accept(TensorVisitor &visitor) const override;
+};
+
+}
@@ -0,0 +1,104 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_tensor_builder.h"
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+using eval::ValueType;
+
+namespace {
+
+size_t num_mapped_dimensions(const ValueType &type) {
+    size_t result = 0;
+    for (const auto &dim: type.dimensions()) {
+        if (dim.is_mapped()) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+struct CallMakeDenseTensor {
+    template <typename CT>
+    static Tensor::UP
+    call(ValueType &&type, const std::vector<double> &cells) {
+        std::vector<CT> new_cells(cells.begin(), cells.end());
+        return std::make_unique<DenseTensor<CT>>(std::move(type), std::move(new_cells));
+    }
+};
+
+}
+
+MixedTensorBuilder::MixedTensorBuilder(const ValueType &type_in)
+    : _stash(MixedTensor::STASH_CHUNK_SIZE),
+      _type(type_in),
+      _subspace_size(type_in.dense_subspace_size()),
+      _subspaces(),
+      _cells()
+{
+    assert(!_type.is_error());
+}
+
+MixedTensorBuilder::~MixedTensorBuilder() = default;
+
+void
+MixedTensorBuilder::reserve(size_t num_subspaces)
+{
+    _subspaces.resize(num_subspaces * 2);
+    _cells.reserve(num_subspaces * _subspace_size);
+}
+
+std::pair<ArrayRef<double>, bool>
+MixedTensorBuilder::insert_subspace(SparseTensorAddressRef address)
+{
+    uint32_t idx = _subspaces.size();
+    auto res = _subspaces.insert(std::make_pair(address, idx));
+    if (res.second) {
+        // Replace key with own copy
+        res.first->first = SparseTensorAddressRef(address, _stash);
+        _cells.resize(_cells.size() + _subspace_size, 0.0);
+    } else {
+        idx = res.first->second;
+    }
+    return std::make_pair(ArrayRef<double>(_cells.data() + (idx * _subspace_size), _subspace_size), res.second);
+}
+
+ArrayRef<double>
+MixedTensorBuilder::find_subspace(SparseTensorAddressRef address)
+{
+    auto itr = _subspaces.find(address);
+    if (itr == _subspaces.end()) {
+        return ArrayRef<double>();
+    }
+    return ArrayRef<double>(_cells.data() + (itr->second * _subspace_size), _subspace_size);
+}
+
+Tensor::UP
+MixedTensorBuilder::build()
+{
+    size_t num_mapped = num_mapped_dimensions(_type);
+    if (num_mapped == 0) {
+        _cells.resize(_subspace_size, 0.0);
+        return dispatch_0<CallMakeDenseTensor>(_type.cell_type(), std::move(_type), _cells);
+    }
+    if (num_mapped == _type.dimensions().size()) {
+        SparseTensor::Cells cells;
+        cells.resize(_subspaces.size() * 2);
+        for (const auto &subspace: _subspaces) {
+            cells[subspace.first] = _cells[subspace.second];
+        }
+        return std::make_unique<SparseTensor>(std::move(_type), std::move(cells), std::move(_stash));
+    }
+    return build_mixed();
+}
+
+std::unique_ptr<MixedTensor>
+MixedTensorBuilder::build_mixed()
+{
+    return std::make_unique<MixedTensor>(std::move(_type), std::move(_subspaces), std::move(_cells), std::move(_stash));
+}
+
+}
@@ -0,0 +1,62 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "mixed_tensor.h"
+
+namespace vespalib::tensor {
+
+/**
+ * Utility class to build tensors one dense subspace at a time, to be
+ * used by tensor operations on mixed tensors.
+ *
+ * Subspaces are identified by the serialized labels of the mapped
+ * dimensions (in the order of the dimensions in the tensor type). A
+ * type without mapped dimensions has a single subspace with an empty
+ * address, and a type without indexed dimensions has subspaces of
+ * size 1.
+ */
+class MixedTensorBuilder
+{
+public:
+    using Subspaces = MixedTensor::Subspaces;
+
+private:
+    Stash _stash;
+    eval::ValueType _type;
+    size_t _subspace_size;
+    Subspaces _subspaces;
+    std::vector<double> _cells;
+
+public:
+    explicit MixedTensorBuilder(const eval::ValueType &type_in);
+    ~MixedTensorBuilder();
+
+    const eval::ValueType &type() const { return _type; }
+    size_t subspace_size() const { return _subspace_size; }
+    void reserve(size_t num_subspaces);
+
+    /**
+     * Returns the cells of the subspace with the given address and
+     * whether it was added by this call, in which case all its cells
+     * are 0.0. The returned cells are valid until the next subspace
+     * is added.
+     */
+    std::pair<ArrayRef<double>, bool> insert_subspace(SparseTensorAddressRef address);
+
+    /**
+     * Returns the cells of the subspace with the given address, or an
+     * empty array if the subspace does not exist.
+     */
+    ArrayRef<double> find_subspace(SparseTensorAddressRef address);
+
+    /**
+     * Returns a sparse or dense tensor if the type lacks indexed or
+     * mapped dimensions, otherwise a mixed tensor.
+     */
+    Tensor::UP build();
+
+    std::unique_ptr<MixedTensor> build_mixed();
+};
+
+}
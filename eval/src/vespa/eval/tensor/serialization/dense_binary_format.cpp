@@ -68,6 +68,12 @@ void decodeCells(CellType cell_type, nbostream &stream, size_t cellsSize, V &cel
     case CellType::FLOAT:
         decodeCells<float>(stream, cellsSize, cells);
         break;
+    case CellType::BFLOAT16:
+        decodeCells<BFloat16>(stream, cellsSize, cells);
+        break;
+    case CellType::INT8:
+        decodeCells<Int8Float>(stream, cellsSize, cells);
+        break;
     }
 }
 
@@ -86,6 +92,12 @@ DenseBinaryFormat::serialize(nbostream &stream, const DenseTensorView &tensor)
     case CellType::FLOAT:
         encodeCells<float>(stream, cells);
         break;
+    case CellType::BFLOAT16:
+        encodeCells<BFloat16>(stream, cells);
+        break;
+    case CellType::INT8:
+        encodeCells<Int8Float>(stream, cells);
+        break;
     }
 }
 
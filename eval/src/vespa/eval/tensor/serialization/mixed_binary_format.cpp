@@ -0,0 +1,141 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_binary_format.h"
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_decoder.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+using vespalib::nbostream;
+using vespalib::eval::ValueType;
+using CellType = vespalib::eval::ValueType::CellType;
+
+namespace vespalib::tensor {
+
+using Dimension = eval::ValueType::Dimension;
+
+namespace {
+
+size_t encodeDimensions(nbostream &stream, const ValueType &type) {
+    size_t numMapped = 0;
+    for (const auto &dimension : type.dimensions()) {
+        if (dimension.is_mapped()) {
+            ++numMapped;
+        }
+    }
+    stream.putInt1_4Bytes(numMapped);
+    for (const auto &dimension : type.dimensions()) {
+        if (dimension.is_mapped()) {
+            stream.writeSmallString(dimension.name);
+        }
+    }
+    stream.putInt1_4Bytes(type.dimensions().size() - numMapped);
+    for (const auto &dimension : type.dimensions()) {
+        if (dimension.is_indexed()) {
+            stream.writeSmallString(dimension.name);
+            stream.putInt1_4Bytes(dimension.size);
+        }
+    }
+    return numMapped;
+}
+
+template<typename T>
+void encodeSubspaces(nbostream &stream, size_t numMapped, const MixedTensor &tensor) {
+    if (numMapped > 0) {
+        stream.putInt1_4Bytes(tensor.subspaces().size());
+    }
+    for (const auto &subspace : tensor.subspaces()) {
+        SparseTensorAddressDecoder decoder(subspace.first);
+        while (decoder.valid()) {
+            stream.writeSmallString(decoder.decodeLabel());
+        }
+        for (double value : tensor.subspace(subspace.second)) {
+            stream << static_cast<T>(value);
+        }
+    }
+}
+
+size_t decodeDimensions(nbostream &stream, std::vector<Dimension> &dimensions) {
+    vespalib::string dimensionName;
+    size_t numMapped = stream.getInt1_4Bytes();
+    while (dimensions.size() < numMapped) {
+        stream.readSmallString(dimensionName);
+        dimensions.emplace_back(dimensionName);
+    }
+    size_t numIndexed = stream.getInt1_4Bytes();
+    for (size_t i = 0; i < numIndexed; ++i) {
+        stream.readSmallString(dimensionName);
+        size_t dimensionSize = stream.getInt1_4Bytes();
+        dimensions.emplace_back(dimensionName, dimensionSize);
+    }
+    return numMapped;
+}
+
+template<typename T>
+void decodeSubspaces(nbostream &stream, size_t numMapped, MixedTensorBuilder &builder) {
+    T cellValue = 0.0;
+    vespalib::string label;
+    SparseTensorAddressBuilder address;
+    size_t numSubspaces = (numMapped > 0) ? stream.getInt1_4Bytes() : 1;
+    builder.reserve(numSubspaces);
+    for (size_t i = 0; i < numSubspaces; ++i) {
+        address.clear();
+        for (size_t dimension = 0; dimension < numMapped; ++dimension) {
+            stream.readSmallString(label);
+            address.add(label);
+        }
+        for (double &cell : builder.insert_subspace(address.getAddressRef()).first) {
+            stream >> cellValue;
+            cell = cellValue;
+        }
+    }
+}
+
+}
+
+void
+MixedBinaryFormat::serialize(nbostream &stream, const MixedTensor &tensor)
+{
+    const auto &type = tensor.fast_type();
+    size_t numMapped = encodeDimensions(stream, type);
+    switch (type.cell_type()) {
+    case CellType::DOUBLE:
+        encodeSubspaces<double>(stream, numMapped, tensor);
+        break;
+    case CellType::FLOAT:
+        encodeSubspaces<float>(stream, numMapped, tensor);
+        break;
+    case CellType::BFLOAT16:
+        encodeSubspaces<BFloat16>(stream, numMapped, tensor);
+        break;
+    case CellType::INT8:
+        encodeSubspaces<Int8Float>(stream, numMapped, tensor);
+        break;
+    }
+}
+
+std::unique_ptr<Tensor>
+MixedBinaryFormat::deserialize(nbostream &stream, CellType cell_type)
+{
+    std::vector<Dimension> dimensions;
+    size_t numMapped = decodeDimensions(stream, dimensions);
+    MixedTensorBuilder builder(ValueType::tensor_type(std::move(dimensions), cell_type));
+    switch (cell_type) {
+    case CellType::DOUBLE:
+        decodeSubspaces<double>(stream, numMapped, builder);
+        break;
+    case CellType::FLOAT:
+        decodeSubspaces<float>(stream, numMapped, builder);
+        break;
+    case CellType::BFLOAT16:
+        decodeSubspaces<BFloat16>(stream, numMapped, builder);
+        break;
+    case CellType::INT8:
+        decodeSubspaces<Int8Float>(stream, numMapped, builder);
+        break;
+    }
+    return builder.build();
+}
+
+}
@@ -0,0 +1,27 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <memory>
+#include <vespa/eval/eval/value_type.h>
+
+namespace vespalib { class nbostream; }
+
+namespace vespalib::tensor {
+
+class MixedTensor;
+class Tensor;
+
+/**
+ * Class for serializing a mixed tensor (see format.txt).
+ */
+class MixedBinaryFormat
+{
+public:
+    using CellType = eval::ValueType::CellType;
+
+    static void serialize(nbostream &stream, const MixedTensor &tensor);
+    static std::unique_ptr<Tensor> deserialize(nbostream &stream, CellType cell_type);
+};
+
+}
@@ -94,6 +94,12 @@ size_t encodeCells(nbostream &stream, const Tensor &tensor, CellType cell_type)
     case CellType::FLOAT:
         return encodeCells<float>(stream, tensor);
         break;
+    case CellType::BFLOAT16:
+        return encodeCells<BFloat16>(stream, tensor);
+        break;
+    case CellType::INT8:
+        return encodeCells<Int8Float>(stream, tensor);
+        break;
     }
     return 0;
 }
@@ -126,6 +132,12 @@ void decodeCells(CellType cell_type, nbostream &stream, size_t dimensionsSize, s
     case CellType::FLOAT:
         decodeCells<float>(stream, dimensionsSize, cellsSize, builder);
         break;
+    case CellType::BFLOAT16:
+        decodeCells<BFloat16>(stream, dimensionsSize, cellsSize, builder);
+        break;
+    case CellType::INT8:
+        decodeCells<Int8Float>(stream, dimensionsSize, cellsSize, builder);
+        break;
     }
 }
 
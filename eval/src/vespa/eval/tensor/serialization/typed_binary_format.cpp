@@ -3,9 +3,11 @@
 #include "typed_binary_format.h"
 #include "sparse_binary_format.h"
 #include "dense_binary_format.h"
+#include "mixed_binary_format.h"
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
 #include <vespa/eval/eval/simple_tensor.h>
 #include <vespa/eval/tensor/wrapped_simple_tensor.h>
 
@@ -32,6 +34,8 @@ constexpr uint32_t MIXED_BINARY_FORMAT_WITH_CELLTYPE = 7u;
 
 constexpr uint32_t DOUBLE_VALUE_TYPE = 0;
 constexpr uint32_t FLOAT_VALUE_TYPE = 1;
+constexpr uint32_t BFLOAT16_VALUE_TYPE = 2;
+constexpr uint32_t INT8_VALUE_TYPE = 3;
 
 uint32_t cell_type_to_encoding(CellType cell_type) {
     switch (cell_type) {
@@ -39,6 +43,10 @@ uint32_t cell_type_to_encoding(CellType cell_type) {
         return DOUBLE_VALUE_TYPE;
     case CellType::FLOAT:
         return FLOAT_VALUE_TYPE;
+    case CellType::BFLOAT16:
+        return BFLOAT16_VALUE_TYPE;
+    case CellType::INT8:
+        return INT8_VALUE_TYPE;
     }
     abort();
 }
@@ -50,8 +58,12 @@ encoding_to_cell_type(uint32_t cell_encoding) {
         return CellType::DOUBLE;
     case FLOAT_VALUE_TYPE:
         return CellType::FLOAT;
+    case BFLOAT16_VALUE_TYPE:
+        return CellType::BFLOAT16;
+    case INT8_VALUE_TYPE:
+        return CellType::INT8;
     default:
-        throw IllegalArgumentException(make_string("Received unknown tensor value type = %u. Only 0(double), or 1(float) are legal.", cell_encoding));
+        throw IllegalArgumentException(make_string("Received unknown tensor value type = %u. Only 0(double), 1(float), 2(bfloat16) or 3(int8) are legal.", cell_encoding));
     }
 }
 
@@ -70,6 +82,14 @@ TypedBinaryFormat::serialize(nbostream &stream, const Tensor &tensor)
             stream.putInt1_4Bytes(cell_type_to_encoding(cell_type));
         }
         DenseBinaryFormat::serialize(stream, *denseTensor);
+    } else if (auto mixedTensor = dynamic_cast<const MixedTensor *>(&tensor)) {
+        if (default_cell_type) {
+            stream.putInt1_4Bytes(MIXED_BINARY_FORMAT_TYPE);
+        } else {
+            stream.putInt1_4Bytes(MIXED_BINARY_FORMAT_WITH_CELLTYPE);
+            stream.putInt1_4Bytes(cell_type_to_encoding(cell_type));
+        }
+        MixedBinaryFormat::serialize(stream, *mixedTensor);
     } else if (auto wrapped = dynamic_cast<const WrappedSimpleTensor *>(&tensor)) {
         eval::SimpleTensor::encode(wrapped->get(), stream);
     } else {
@@ -88,7 +108,6 @@ std::unique_ptr<Tensor>
 TypedBinaryFormat::deserialize(nbostream &stream)
 {
     auto cell_type = CellType::DOUBLE;
-    auto read_pos = stream.rp();
     auto formatId = stream.getInt1_4Bytes();
     switch (formatId) {
     case SPARSE_BINARY_FORMAT_WITH_CELLTYPE:
@@ -101,10 +120,11 @@ TypedBinaryFormat::deserialize(nbostream &stream)
         [[fallthrough]];
     case DENSE_BINARY_FORMAT_TYPE:
         return DenseBinaryFormat::deserialize(stream, cell_type);
-    case MIXED_BINARY_FORMAT_TYPE:
     case MIXED_BINARY_FORMAT_WITH_CELLTYPE:
-        stream.adjustReadPos(read_pos - stream.rp());
-        return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::decode(stream));
+        cell_type = encoding_to_cell_type(stream.getInt1_4Bytes());
+        [[fallthrough]];
+    case MIXED_BINARY_FORMAT_TYPE:
+        return MixedBinaryFormat::deserialize(stream, cell_type);
     default:
         throw IllegalArgumentException(make_string("Received unknown tensor format type = %du.", formatId));
     }
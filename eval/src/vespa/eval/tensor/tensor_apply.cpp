@@ -8,7 +8,7 @@ namespace vespalib::tensor {
 template <class TensorT>
 TensorApply<TensorT>::TensorApply(const TensorImplType &tensor,
                                   const CellFunction &func)
-    : Parent(tensor.fast_type())
+    : Parent(tensor.fast_type().map())
 {
     for (const auto &cell : tensor.cells()) {
         _builder.insertCell(cell.first, func.apply(cell.second));
@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/latch.h>
 #include <vespa/fnet/frt/frt.h>
 #include <mutex>
@@ -198,6 +199,8 @@ public:
                         FRT_METHOD(TestRPC::RPC_GetValue), this);
         rb.DefineMethod("test", "iibb", "i",
                         FRT_METHOD(TestRPC::RPC_Test), this);
+        rb.DefineMethod("echoData", "xX", "xX",
+                        FRT_METHOD(TestRPC::RPC_EchoData), this);
     }
 
     void RPC_Test(FRT_RPCRequest *req)
@@ -220,6 +223,19 @@ public:
         }
     }
 
+    void RPC_EchoData(FRT_RPCRequest *req)
+    {
+        FRT_Values &param = *req->GetParams();
+        FRT_Values &ret = *req->GetReturn();
+        ret.AddData(param[0]._data._buf, param[0]._data._len);
+        uint32_t len = param[1]._data_array._len;
+        FRT_DataValue *src = param[1]._data_array._pt;
+        FRT_DataValue *dst = ret.AddDataArray(len);
+        for (uint32_t i = 0; i < len; ++i) {
+            ret.SetData(&dst[i], src[i]._buf, src[i]._len);
+        }
+    }
+
     void RPC_Inc(FRT_RPCRequest *req)
     {
         req->GetReturn()->AddInt32(req->GetParams()->GetValue(0)._intval32 + 1);
@@ -258,6 +274,7 @@ private:
 
 public:
     FRT_Target &target() { return *_target; }
+    FNET_Transport &client_transport() { return *_client.supervisor().GetTransport(); }
     FRT_Target *make_bad_target() { return _client.supervisor().GetTarget("bogus address"); }
     RequestLatch &detached_req() { return _testRPC.detached_req(); }
     EchoTest &echo() { return _echoTest; }
@@ -420,6 +437,65 @@ TEST_F("require that parameters can be echoed as return values", Fixture()) {
     EXPECT_TRUE(req.get().GetParams()->Equals(req.get().GetReturn()));
 }
 
+TEST_F("require that large data values survive the round trip", Fixture()) {
+    auto make_data = [](size_t len, char seed) {
+        vespalib::string data;
+        for (size_t i = 0; i < len; ++i) {
+            data.push_back(char(seed + (i % 251)));
+        }
+        return data;
+    };
+    vespalib::string big = make_data(3 * 1024 * 1024, 1);
+    vespalib::string small = make_data(100, 2);
+    vespalib::string medium = make_data(64 * 1024, 3);
+    MyReq req("echoData");
+    FRT_Values &params = *req.get().GetParams();
+    params.AddData(big.data(), big.size());
+    FRT_DataValue *arr = params.AddDataArray(3);
+    params.SetData(&arr[0], medium.data(), medium.size());
+    params.SetData(&arr[1], small.data(), small.size());
+    params.SetData(&arr[2], big.data(), big.size());
+    f1.target().InvokeSync(req.borrow(), timeout);
+    ASSERT_TRUE(!req.get().IsError());
+    EXPECT_TRUE(req.get().GetReturn()->Equals(req.get().GetParams()));
+}
+
+struct BlockTransportThread : FNET_IExecutable {
+    vespalib::Gate blocked;
+    vespalib::Gate release;
+    void execute() override {
+        blocked.countDown();
+        release.await();
+    }
+};
+
+TEST_F("require that batched writes are used on busy connections", Fixture()) {
+    f1.client_transport().SetWriteBatching(2000, 0);
+    FNET_TransportMetrics before = f1.client_transport().get_metrics();
+    constexpr size_t num_reqs = 100;
+    std::vector<RequestLatch> latches(num_reqs);
+    // All requests are queued on the connection before its transport thread gets to write any of them.
+    BlockTransportThread blocker;
+    ASSERT_TRUE(f1.target().GetConnection()->Owner()->execute(&blocker));
+    blocker.blocked.await();
+    for (size_t i = 0; i < num_reqs; ++i) {
+        auto req = new FRT_RPCRequest();
+        req->SetMethodName("inc");
+        req->GetParams()->AddInt32(i);
+        f1.target().InvokeAsync(req, timeout, &latches[i]);
+    }
+    blocker.release.countDown();
+    for (size_t i = 0; i < num_reqs; ++i) {
+        MyReq req(latches[i].read());
+        EXPECT_EQUAL(req.get_int_ret(), i + 1);
+    }
+    FNET_TransportMetrics metrics = f1.client_transport().get_metrics() - before;
+    EXPECT_EQUAL(metrics.packets_written, num_reqs);
+    EXPECT_GREATER(metrics.bytes_per_write(), 0.0);
+    EXPECT_LESS(metrics.write_calls, num_reqs);
+    f1.client_transport().SetWriteBatching(0, 0);
+}
+
 TEST_MAIN() {
     crypto = my_crypto_engine();
     TEST_RUN_ALL();
@@ -6,6 +6,9 @@ FNET_Config::FNET_Config()
     : _iocTimeOut(0),
       _maxInputBufferSize(0x10000),
       _maxOutputBufferSize(0x10000),
+      _minZeroCopySize(0x4000),
+      _writeBatchDelay(0),
+      _writeBatchSize(0x10000),
       _tcpNoDelay(true)
 {
 }
@@ -14,6 +14,9 @@ public:
     uint32_t  _iocTimeOut;
     uint32_t  _maxInputBufferSize;
     uint32_t  _maxOutputBufferSize;
+    uint32_t  _minZeroCopySize;
+    uint32_t  _writeBatchDelay;  // micro-seconds, 0 means no batching
+    uint32_t  _writeBatchSize;   // bytes, 0 means no limit
     bool      _tcpNoDelay;
 
     FNET_Config();
@@ -9,6 +9,7 @@
 #include "config.h"
 #include "transport_thread.h"
 #include "transport.h"
+#include <sys/uio.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fnet");
@@ -252,6 +253,8 @@ FNET_Connection::handshake()
         EnableReadEvent(true);
         EnableWriteEvent(writePendingAfterConnect());
         _flags._framed = (_socket->min_read_buffer_size() > 1);
+        _gather.SetMinRefLen(GetConfig()->_minZeroCopySize);
+        _flags._gather = ((_gather.GetMinRefLen() > 0) && _socket->supports_write_vector());
         size_t chunk_size = std::max(size_t(FNET_READ_SIZE), _socket->min_read_buffer_size());
         ssize_t res = 0;
         do { // drain input pipeline
@@ -375,6 +378,8 @@ FNET_Connection::Write()
     size_t   chunk_size     = std::max(size_t(FNET_WRITE_SIZE), _socket->min_read_buffer_size());
     uint32_t my_write_work  = 0;
     int      writeCnt       = 0;     // write count
+    uint32_t packetCnt      = 0;     // encoded packet count
+    uint64_t writtenBytes   = 0;     // bytes written
     bool     broken         = false; // is this conn broken ?
     int      my_errno       = 0;     // sample and preserve errno
     ssize_t  res;                    // single write result
@@ -386,37 +391,53 @@ FNET_Connection::Write()
 
         // fill output buffer
 
-        while (_output.GetDataLen() < chunk_size) {
+        while (_output.GetDataLen() + _gather.GetRefLen() < chunk_size) {
             if (_myQueue.IsEmpty_NoLock())
                 break;
 
             packet = _myQueue.DequeuePacket_NoLock(&context);
             if (packet->IsRegularPacket()) { // ignore non-regular packets
-                _streamer->Encode(packet, context._value.INT, &_output);
+                ++packetCnt;
+                if (_flags._gather) {
+                    _streamer->EncodeGather(packet, context._value.INT, &_output, &_gather);
+                    if (_gather.TakePacket(packet)) {
+                        continue; // freed when referenced data is written
+                    }
+                } else {
+                    _streamer->Encode(packet, context._value.INT, &_output);
+                }
             }
             packet->Free();
         }
 
-        if (_output.GetDataLen() == 0) {
+        if (_output.GetDataLen() == 0 && _gather.IsEmpty()) {
             res = 0;
             break;
         }
 
         // write data
 
-        res = _socket->write(_output.GetData(), _output.GetDataLen());
+        if (_gather.IsEmpty()) {
+            res = _socket->write(_output.GetData(), _output.GetDataLen());
+        } else {
+            struct iovec iov[FNET_WRITE_IOV];
+            int iovcnt = _gather.GetIOVec(&_output, iov, FNET_WRITE_IOV);
+            res = _socket->write_vector(iov, iovcnt);
+        }
         my_errno = errno;
         writeCnt++;
         if (res > 0) {
-            _output.DataToDead((uint32_t)res);
+            writtenBytes += res;
+            _gather.DataToDead(&_output, res);
             _output.resetIfEmpty();
         }
     } while (res > 0 &&
              _output.GetDataLen() == 0 &&
+             _gather.IsEmpty() &&
              !_myQueue.IsEmpty_NoLock() &&
              writeCnt < FNET_WRITE_REDO);
 
-    if ((_output.GetDataLen() > 0)) {
+    if ((_output.GetDataLen() > 0) || !_gather.IsEmpty()) {
         ++my_write_work;
     }
 
@@ -429,6 +450,11 @@ FNET_Connection::Write()
         }
     }
 
+    if (writeCnt > 0) {
+        _lastWrite = Owner()->GetTimeSampler();
+        Owner()->CountWrites(packetCnt, writeCnt, writtenBytes);
+    }
+
     uint32_t maxSize = GetConfig()->_maxOutputBufferSize;
     if (maxSize > 0 && _output.GetBufSize() > maxSize) {
         _output.Shrink(maxSize);
@@ -481,11 +507,14 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _packetCode(0),
       _packetCHID(0),
       _writeWork(0),
+      _queuedBytes(0),
+      _lastWrite(),
       _currentID(1), // <-- NB
       _input(FNET_READ_SIZE * 2),
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _gather(),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -515,11 +544,14 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _packetCode(0),
       _packetCHID(0),
       _writeWork(0),
+      _queuedBytes(0),
+      _lastWrite(),
       _currentID(0),
       _input(FNET_READ_SIZE * 2),
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _gather(),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -700,6 +732,9 @@ FNET_Connection::PostPacket(FNET_Packet *packet, uint32_t chid)
     }
     writeWork = _writeWork;
     _writeWork++;
+    if ((GetConfig()->_writeBatchDelay > 0) && packet->IsRegularPacket()) {
+        _queuedBytes += packet->GetLength();
+    }
     _queue.QueuePacket_NoLock(packet, FNET_Context(chid));
     if ((writeWork == 0) && (_state == FNET_CONNECTED)) {
         AddRef_NoLock();
@@ -735,6 +770,7 @@ FNET_Connection::Close()
     _resolve_handler.reset();
     detach_selector();
     SetState(FNET_CLOSED);
+    _gather.Clear();
     _ioc_socket_fd = -1;
     if (!_flags._handshake_work_pending) {
         _socket.reset();
@@ -786,6 +822,7 @@ FNET_Connection::HandleWriteEvent()
         {
             std::unique_lock<std::mutex> guard(_ioc_lock);
             _queue.FlushPackets_NoLock(&_myQueue);
+            _queuedBytes = 0;
         }
         broken = !Write();
         break;
@@ -797,6 +834,21 @@ FNET_Connection::HandleWriteEvent()
     return !broken;
 }
 
+bool
+FNET_Connection::DeferWrite()
+{
+    const FNET_Config &config = *GetConfig();
+    if ((config._writeBatchDelay == 0) || (_state != FNET_CONNECTED)) {
+        return false;
+    }
+    time_point deadline = _lastWrite + std::chrono::microseconds(config._writeBatchDelay);
+    if (Owner()->GetTimeSampler() >= deadline) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(_ioc_lock);
+    return ((config._writeBatchSize == 0) || (_queuedBytes < config._writeBatchSize));
+}
+
 vespalib::string
 FNET_Connection::GetPeerSpec() const
 {
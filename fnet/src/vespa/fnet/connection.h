@@ -4,6 +4,7 @@
 
 #include "iocomponent.h"
 #include "databuffer.h"
+#include "gatherlist.h"
 #include "context.h"
 #include "channellookup.h"
 #include "packetqueue.h"
@@ -62,7 +63,8 @@ public:
         FNET_READ_SIZE  = 32768,
         FNET_READ_REDO  = 10,
         FNET_WRITE_SIZE = 32768,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_WRITE_IOV  = 64
     };
 
 private:
@@ -73,7 +75,8 @@ private:
             _callbackWait(false),
             _discarding(false),
             _framed(false),
-            _handshake_work_pending(false)
+            _handshake_work_pending(false),
+            _gather(false)
         { }
         bool _gotheader;
         bool _inCallback;
@@ -81,6 +84,7 @@ private:
         bool _discarding;
         bool _framed;
         bool _handshake_work_pending;
+        bool _gather;
     };
     struct ResolveHandler : public vespalib::AsyncResolver::ResultHandler {
         FNET_Connection *connection;
@@ -90,6 +94,7 @@ private:
         ~ResolveHandler();
     };
     using ResolveHandlerSP = std::shared_ptr<ResolveHandler>;
+    using time_point = FNET_Scheduler::clock::time_point;
     FNET_IPacketStreamer    *_streamer;        // custom packet streamer
     FNET_IServerAdapter     *_serverAdapter;   // only on server side
     FNET_Channel            *_adminChannel;    // only on client side
@@ -102,11 +107,14 @@ private:
     uint32_t                 _packetCode;      // packet code
     uint32_t                 _packetCHID;      // packet chid
     uint32_t                 _writeWork;       // pending write work
+    uint32_t                 _queuedBytes;     // bytes queued for batched write
+    time_point               _lastWrite;       // time of last write
     uint32_t                 _currentID;       // current channel ID
     FNET_DataBuffer          _input;           // input buffer
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
     FNET_DataBuffer          _output;          // output buffer
+    FNET_GatherList          _gather;          // data referenced by output
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
@@ -510,6 +518,18 @@ public:
      **/
     bool HandleWriteEvent() override;
 
+
+    /**
+     * Called by the transport layer to check whether writing may be
+     * postponed to batch output from more packets into a single
+     * write. Writing is only postponed on connections that wrote
+     * recently, for at most the configured write batch delay after
+     * that write, and until the configured write batch size is queued.
+     *
+     * @return true if writing should be postponed, false otherwise.
+     **/
+    bool DeferWrite() override;
+
     /**
      * @return Returns the size of this connection's output buffer.
      */
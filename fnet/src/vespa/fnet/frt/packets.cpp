@@ -36,8 +36,22 @@ FRT_RPCRequestPacket::GetLength()
 }
 
 
+uint32_t
+FRT_RPCRequestPacket::GetReferencedLength(const FNET_GatherList &gather)
+{
+    return _req->GetParams()->GetReferencedLength(gather);
+}
+
+
 void
 FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
+{
+    EncodeGather(dst, nullptr);
+}
+
+
+void
+FRT_RPCRequestPacket::EncodeGather(FNET_DataBuffer *dst, FNET_GatherList *gather)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
@@ -48,13 +62,13 @@ FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
         dst->WriteBytesFast(&tmp, sizeof(tmp));
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeCopy(dst);
+        _req->GetParams()->EncodeCopy(dst, gather);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
         dst->WriteInt32Fast(_req->GetMethodNameLen());
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeBig(dst);
+        _req->GetParams()->EncodeBig(dst, gather);
     }
 }
 
@@ -118,18 +132,32 @@ FRT_RPCReplyPacket::GetLength()
 }
 
 
+uint32_t
+FRT_RPCReplyPacket::GetReferencedLength(const FNET_GatherList &gather)
+{
+    return _req->GetReturn()->GetReferencedLength(gather);
+}
+
+
 void
 FRT_RPCReplyPacket::Encode(FNET_DataBuffer *dst)
+{
+    EncodeGather(dst, nullptr);
+}
+
+
+void
+FRT_RPCReplyPacket::EncodeGather(FNET_DataBuffer *dst, FNET_GatherList *gather)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
     uint32_t host_endian = FNET_Info::GetEndian();
 
     if (packet_endian == host_endian) {
-        _req->GetReturn()->EncodeCopy(dst);
+        _req->GetReturn()->EncodeCopy(dst, gather);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
-        _req->GetReturn()->EncodeBig(dst);
+        _req->GetReturn()->EncodeBig(dst, gather);
     }
 }
 
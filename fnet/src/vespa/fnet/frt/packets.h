@@ -60,6 +60,8 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeGather(FNET_DataBuffer *dst, FNET_GatherList *gather) override;
+    uint32_t GetReferencedLength(const FNET_GatherList &gather) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
@@ -76,6 +78,8 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeGather(FNET_DataBuffer *dst, FNET_GatherList *gather) override;
+    uint32_t GetReferencedLength(const FNET_GatherList &gather) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
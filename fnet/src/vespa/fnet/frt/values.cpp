@@ -2,6 +2,7 @@
 
 #include "values.h"
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/gatherlist.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <cassert>
 
@@ -72,6 +73,18 @@ private:
 using fnet::BlobRef;
 using fnet::LocalBlob;
 
+namespace {
+
+void writeData(FNET_DataBuffer *dst, FNET_GatherList *gather, const char *buf, uint32_t len) {
+    if (gather != nullptr) {
+        gather->WriteBytes(dst, buf, len);
+    } else {
+        dst->WriteBytesFast(buf, len);
+    }
+}
+
+}
+
 FRT_Values::FRT_Values(Stash &stash)
     : _maxValues(0),
       _numValues(0),
@@ -481,6 +494,29 @@ FRT_Values::GetLength()
 }
 
 
+uint32_t
+FRT_Values::GetReferencedLength(const FNET_GatherList &gather)
+{
+    uint32_t len = 0;
+    for (uint32_t i = 0; i < _numValues; i++) {
+        if (_typeString[i] == FRT_VALUE_DATA) {
+            if (gather.WillReference(_values[i]._data._len)) {
+                len += _values[i]._data._len;
+            }
+        } else if (_typeString[i] == FRT_VALUE_DATA_ARRAY) {
+            uint32_t       num = _values[i]._data_array._len;
+            FRT_DataValue *pt  = _values[i]._data_array._pt;
+            for (; num > 0; num--, pt++) {
+                if (gather.WillReference(pt->_len)) {
+                    len += pt->_len;
+                }
+            }
+        }
+    }
+    return len;
+}
+
+
 bool
 FRT_Values::DecodeCopy(FNET_DataBuffer *src, uint32_t len)
 {
@@ -1223,7 +1259,7 @@ error:
 
 
 void
-FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
+FRT_Values::EncodeCopy(FNET_DataBuffer *dst, FNET_GatherList *gather)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1340,8 +1376,8 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteBytesFast(&(_values[i]._data._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            writeData(dst, gather, _values[i]._data._buf,
+                      _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1352,7 +1388,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             dst->WriteBytesFast(&len, sizeof(len));
             for (; len > 0; len--, pt++) {
                 dst->WriteBytesFast(&(pt->_len), sizeof(uint32_t));
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                writeData(dst, gather, pt->_buf, pt->_len);
             }
         }
         break;
@@ -1365,7 +1401,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
 
 void
-FRT_Values::EncodeBig(FNET_DataBuffer *dst)
+FRT_Values::EncodeBig(FNET_DataBuffer *dst, FNET_GatherList *gather)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1487,8 +1523,8 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteInt32Fast(_values[i]._data._len);
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            writeData(dst, gather, _values[i]._data._buf,
+                      _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1499,7 +1535,7 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
             dst->WriteInt32Fast(len);
             for (; len > 0; len--, pt++) {
                 dst->WriteInt32Fast(pt->_len);
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                writeData(dst, gather, pt->_buf, pt->_len);
             }
         }
         break;
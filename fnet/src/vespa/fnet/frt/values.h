@@ -12,6 +12,7 @@ namespace fnet {
     struct BlobRef;
 }
 class FNET_DataBuffer;
+class FNET_GatherList;
 
 template <typename T>
 struct FRT_Array {
@@ -234,11 +235,12 @@ public:
     uint32_t GetType(uint32_t idx) { return _typeString[idx]; }
     void Print(uint32_t indent = 0);
     uint32_t GetLength();
+    uint32_t GetReferencedLength(const FNET_GatherList &gather);
     bool DecodeCopy(FNET_DataBuffer *dst, uint32_t len);
     bool DecodeBig(FNET_DataBuffer *dst, uint32_t len);
     bool DecodeLittle(FNET_DataBuffer *dst, uint32_t len);
-    void EncodeCopy(FNET_DataBuffer *dst);
-    void EncodeBig(FNET_DataBuffer *dst);
+    void EncodeCopy(FNET_DataBuffer *dst, FNET_GatherList *gather = nullptr);
+    void EncodeBig(FNET_DataBuffer *dst, FNET_GatherList *gather = nullptr);
     bool Equals(FRT_Values *values);
     static void Print(FRT_Value value, uint32_t type, uint32_t indent = 0);
     static bool Equals(FRT_Value a, FRT_Value b, uint32_t type);
@@ -0,0 +1,123 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "gatherlist.h"
+#include "databuffer.h"
+#include "packet.h"
+#include <algorithm>
+#include <sys/uio.h>
+
+FNET_GatherList::FNET_GatherList(uint32_t minRefLen)
+    : _entries(),
+      _minRefLen(minRefLen),
+      _bufLen(0),
+      _refLen(0)
+{
+}
+
+
+FNET_GatherList::~FNET_GatherList()
+{
+    Clear();
+}
+
+
+void
+FNET_GatherList::WriteBytes(FNET_DataBuffer *dst, const void *src, uint32_t len)
+{
+    if (!WillReference(len)) {
+        dst->WriteBytesFast(src, len);
+        return;
+    }
+    uint32_t bufLen = dst->GetDataLen() - _bufLen;
+    _entries.push_back(Entry{bufLen, static_cast<const char *>(src), len, nullptr});
+    _bufLen += bufLen;
+    _refLen += len;
+}
+
+
+bool
+FNET_GatherList::TakePacket(FNET_Packet *packet)
+{
+    if (_entries.empty() || (_entries.back()._owner != nullptr)) {
+        return false;
+    }
+    _entries.back()._owner = packet;
+    return true;
+}
+
+
+int
+FNET_GatherList::GetIOVec(FNET_DataBuffer *buf, struct iovec *iov, int maxCnt) const
+{
+    char *data = buf->GetData();
+    int cnt = 0;
+    for (const Entry &entry : _entries) {
+        if (entry._bufLen > 0) {
+            if (cnt == maxCnt) {
+                return cnt;
+            }
+            iov[cnt].iov_base = data;
+            iov[cnt++].iov_len = entry._bufLen;
+            data += entry._bufLen;
+        }
+        if (entry._len > 0) {
+            if (cnt == maxCnt) {
+                return cnt;
+            }
+            iov[cnt].iov_base = const_cast<char *>(entry._data);
+            iov[cnt++].iov_len = entry._len;
+        }
+    }
+    uint32_t tailLen = buf->GetDataLen() - _bufLen;
+    if ((tailLen > 0) && (cnt < maxCnt)) {
+        iov[cnt].iov_base = data;
+        iov[cnt++].iov_len = tailLen;
+    }
+    return cnt;
+}
+
+
+void
+FNET_GatherList::DataToDead(FNET_DataBuffer *buf, size_t len)
+{
+    while (!_entries.empty()) {
+        Entry &entry = _entries.front();
+        uint32_t bufLen = std::min(len, size_t(entry._bufLen));
+        buf->DataToDead(bufLen);
+        entry._bufLen -= bufLen;
+        _bufLen -= bufLen;
+        len -= bufLen;
+        if (entry._bufLen > 0) {
+            return;
+        }
+        uint32_t refLen = std::min(len, size_t(entry._len));
+        entry._data += refLen;
+        entry._len -= refLen;
+        _refLen -= refLen;
+        len -= refLen;
+        if (entry._len > 0) {
+            return;
+        }
+        FNET_Packet *owner = entry._owner;
+        _entries.pop_front();
+        if (owner != nullptr) {
+            owner->Free();
+        }
+    }
+    buf->DataToDead(len);
+}
+
+
+void
+FNET_GatherList::Clear()
+{
+    while (!_entries.empty()) {
+        FNET_Packet *owner = _entries.front()._owner;
+        _entries.pop_front();
+        if (owner != nullptr) {
+            owner->Free();
+        }
+    }
+    _bufLen = 0;
+    _refLen = 0;
+}
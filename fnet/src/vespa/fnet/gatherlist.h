@@ -0,0 +1,109 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+class FNET_DataBuffer;
+class FNET_Packet;
+struct iovec;
+
+/**
+ * Keeps track of large chunks of packet data that are referenced
+ * rather than copied when encoding packets into the output buffer of
+ * a connection. Each chunk is written to the network after the buffer
+ * data encoded before it was added, using a single gathering write
+ * for the buffer data and the chunks. Packets referencing chunks are
+ * owned by this object until all their data has been written.
+ **/
+class FNET_GatherList
+{
+private:
+    struct Entry {
+        uint32_t     _bufLen; // buffer data preceding the chunk
+        const char  *_data;   // unwritten part of the chunk
+        uint32_t     _len;    // unwritten length of the chunk
+        FNET_Packet *_owner;  // packet to free when written, if any
+    };
+
+    std::deque<Entry> _entries;
+    uint32_t          _minRefLen;
+    uint32_t          _bufLen;    // buffer data covered by entries
+    size_t            _refLen;    // unwritten referenced data
+
+    FNET_GatherList(const FNET_GatherList &);
+    FNET_GatherList &operator=(const FNET_GatherList &);
+
+public:
+    /**
+     * @param minRefLen smallest chunk to reference instead of copy
+     **/
+    FNET_GatherList(uint32_t minRefLen = 0x4000);
+    ~FNET_GatherList();
+
+    void SetMinRefLen(uint32_t minRefLen) { _minRefLen = minRefLen; }
+    uint32_t GetMinRefLen() const { return _minRefLen; }
+
+    bool IsEmpty() const { return _entries.empty(); }
+
+    /**
+     * @return whether data of the given length will be referenced
+     * instead of copied by @ref WriteBytes
+     **/
+    bool WillReference(uint32_t len) const {
+        return ((_minRefLen > 0) && (len >= _minRefLen));
+    }
+
+    /**
+     * @return number of referenced bytes not yet written
+     **/
+    size_t GetRefLen() const { return _refLen; }
+
+    /**
+     * Append data to the given buffer. Data large enough is referenced
+     * instead of copied, in which case it must stay valid until the
+     * packet being encoded is freed. The buffer must have room for
+     * the data, as with FNET_DataBuffer::WriteBytesFast.
+     *
+     * @param dst the buffer the packet is encoded into
+     * @param src the data to append
+     * @param len the length of the data
+     **/
+    void WriteBytes(FNET_DataBuffer *dst, const void *src, uint32_t len);
+
+    /**
+     * Take ownership of a packet that has just been encoded. The
+     * packet is only taken if it referenced any data, in which case
+     * it is freed when all its data has been written.
+     *
+     * @return true if the packet was taken
+     **/
+    bool TakePacket(FNET_Packet *packet);
+
+    /**
+     * Fill in the io vector to write with the data of the given buffer
+     * interleaved with the referenced chunks.
+     *
+     * @return number of io vector entries used
+     * @param buf the buffer the packets were encoded into
+     * @param iov the io vector to fill in
+     * @param maxCnt max number of io vector entries to use
+     **/
+    int GetIOVec(FNET_DataBuffer *buf, struct iovec *iov, int maxCnt) const;
+
+    /**
+     * Mark the given number of bytes as written. Written buffer data is
+     * moved to dead, and packets with all their data written are freed.
+     *
+     * @param buf the buffer the packets were encoded into
+     * @param len number of bytes written
+     **/
+    void DataToDead(FNET_DataBuffer *buf, size_t len);
+
+    /**
+     * Drop all references, freeing the packets owned by this object.
+     **/
+    void Clear();
+};
@@ -145,6 +145,13 @@ FNET_IOComponent::handle_handshake_act()
     return true;
 }
 
+bool
+FNET_IOComponent::DeferWrite()
+{
+    return false;
+}
+
+
 void
 FNET_IOComponent::CleanupHook()
 {
@@ -245,5 +245,17 @@ public:
      * @return false if broken, true otherwise.
      **/
     virtual bool HandleWriteEvent() = 0;
+
+
+    /**
+     * Called by the transport thread when this component has output
+     * to write, to check whether writing may be postponed in order to
+     * batch more output into fewer system calls. The check is
+     * repeated until it returns false, at which time the output is
+     * written. The default implementation never postpones writing.
+     *
+     * @return true if writing should be postponed, false otherwise.
+     **/
+    virtual bool DeferWrite();
 };
 
@@ -5,6 +5,7 @@
 #include "context.h"
 
 class FNET_DataBuffer;
+class FNET_GatherList;
 class FNET_Packet;
 
 /**
@@ -81,5 +82,23 @@ public:
      **/
     virtual void Encode(FNET_Packet *packet, uint32_t chid,
                         FNET_DataBuffer *dst) = 0;
+
+    /**
+     * This method is called to stream a packet to the given databuffer
+     * on connections able to write referenced data directly to the
+     * network. See @ref FNET_Packet::EncodeGather. The default
+     * implementation copies everything by calling @ref Encode.
+     *
+     * @param packet the packet to stream
+     * @param chid channel id for packet
+     * @param dst the target buffer for streaming
+     * @param gather gather list used to reference large payloads
+     **/
+    virtual void EncodeGather(FNET_Packet *packet, uint32_t chid,
+                              FNET_DataBuffer *dst, FNET_GatherList *gather)
+    {
+        (void) gather;
+        Encode(packet, chid, dst);
+    }
 };
 
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/string.h>
 
 class FNET_DataBuffer;
+class FNET_GatherList;
 
 /**
  * This is a general superclass of all packets. Packets are used to
@@ -136,6 +137,39 @@ public:
     virtual void Encode(FNET_DataBuffer *dst) = 0;
 
 
+    /**
+     * Encode this packet into a DataBuffer, letting large payloads be
+     * referenced by the given gather list instead of copied into the
+     * buffer. Packets referencing data are not freed until the data
+     * has been written, so the referenced data must stay valid and
+     * unmodified until the packet is freed. The databuffer only needs
+     * room for the data not referenced, see @ref GetReferencedLength.
+     * The default implementation copies everything by calling @ref
+     * Encode.
+     *
+     * @param dst the target databuffer
+     * @param gather gather list used to reference large payloads
+     **/
+    virtual void EncodeGather(FNET_DataBuffer *dst, FNET_GatherList *gather)
+    {
+        (void) gather;
+        Encode(dst);
+    }
+
+
+    /**
+     * @return number of bytes of the encoded packet that @ref
+     * EncodeGather will reference using the given gather list instead
+     * of copying them into the databuffer
+     * @param gather gather list used to reference large payloads
+     **/
+    virtual uint32_t GetReferencedLength(const FNET_GatherList &gather)
+    {
+        (void) gather;
+        return 0;
+    }
+
+
     /**
      * Decode data from the given DataBuffer and store that information
      * in this object. This method may only be called on regular
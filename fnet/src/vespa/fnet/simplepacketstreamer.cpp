@@ -66,3 +66,18 @@ FNET_SimplePacketStreamer::Encode(FNET_Packet *packet, uint32_t chid,
     packet->Encode(dst);
     dst->AssertValid();
 }
+
+
+void
+FNET_SimplePacketStreamer::EncodeGather(FNET_Packet *packet, uint32_t chid,
+                                        FNET_DataBuffer *dst, FNET_GatherList *gather)
+{
+    uint32_t len   = packet->GetLength();
+    uint32_t pcode = packet->GetPCODE();
+    dst->EnsureFree(len - packet->GetReferencedLength(*gather) + 3 * sizeof(uint32_t));
+    dst->WriteInt32Fast(len + 2 * sizeof(uint32_t));
+    dst->WriteInt32Fast(pcode);
+    dst->WriteInt32Fast(chid);
+    packet->EncodeGather(dst, gather);
+    dst->AssertValid();
+}
@@ -119,6 +119,14 @@ FNET_Transport::SetMaxOutputBufferSize(uint32_t bytes)
     }
 }
 
+void
+FNET_Transport::SetMinZeroCopySize(uint32_t bytes)
+{
+    for (const auto &thread: _threads) {
+        thread->SetMinZeroCopySize(bytes);
+    }
+}
+
 void
 FNET_Transport::SetTCPNoDelay(bool noDelay)
 {
@@ -127,6 +135,24 @@ FNET_Transport::SetTCPNoDelay(bool noDelay)
     }
 }
 
+void
+FNET_Transport::SetWriteBatching(uint32_t delayUs, uint32_t bytes)
+{
+    for (const auto &thread: _threads) {
+        thread->SetWriteBatching(delayUs, bytes);
+    }
+}
+
+FNET_TransportMetrics
+FNET_Transport::get_metrics() const
+{
+    FNET_TransportMetrics metrics;
+    for (const auto &thread: _threads) {
+        metrics += thread->get_metrics();
+    }
+    return metrics;
+}
+
 void
 FNET_Transport::sync()
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "context.h"
+#include "transport_metrics.h"
 #include <memory>
 #include <vector>
 #include <vespa/vespalib/net/async_resolver.h>
@@ -199,6 +200,17 @@ public:
      **/
     void SetMaxOutputBufferSize(uint32_t bytes);
 
+    /**
+     * Set the minimum size of data values written to the network
+     * directly from packet memory instead of being copied into the
+     * output buffer of the connection. This only affects connections
+     * where data is not transformed on its way to the socket (no
+     * tls); other connections always copy.
+     *
+     * @param bytes minimum data size in bytes. 0 means always copy.
+     **/
+    void SetMinZeroCopySize(uint32_t bytes);
+
     /**
      * Enable or disable use of the TCP_NODELAY flag with sockets
      * created by this transport object.
@@ -207,6 +219,30 @@ public:
      **/
     void SetTCPNoDelay(bool noDelay);
 
+    /**
+     * Enable batching of writes on busy connections. When a connection
+     * has written data less than the given delay ago, new packets are
+     * not written until the delay has passed since that write, or the
+     * given number of bytes has been queued, so that packets from many
+     * requests are written with a single system call. Idle connections
+     * write immediately, so batching only adds latency when there is
+     * enough traffic to benefit from it. This replaces the need for
+     * the Nagle algorithm on busy connections (see SetTCPNoDelay).
+     *
+     * @param delayUs max write delay in micro-seconds. 0 disables batching.
+     * @param bytes write anyway when this many bytes are queued. 0 means no limit.
+     **/
+    void SetWriteBatching(uint32_t delayUs, uint32_t bytes);
+
+    /**
+     * Obtain a snapshot of the output counters of all transport
+     * threads. Useful to see how many system calls are used per packet
+     * and how many bytes are written per system call.
+     *
+     * @return output counters summed over all transport threads
+     **/
+    FNET_TransportMetrics get_metrics() const;
+
     /**
      * Synchronize with all transport threads. This method will block
      * until all events posted before this method was invoked has been
@@ -0,0 +1,50 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Snapshot of the output counters of a transport layer, summed over
+ * all its transport threads. The counters are never reset; compare
+ * two snapshots to look at a time interval.
+ **/
+struct FNET_TransportMetrics
+{
+    uint64_t packets_written;  // packets encoded for writing
+    uint64_t write_calls;      // write system calls on sockets
+    uint64_t bytes_written;    // bytes written to sockets
+    uint64_t deferred_writes;  // writes postponed by write batching
+
+    FNET_TransportMetrics()
+        : packets_written(0),
+          write_calls(0),
+          bytes_written(0),
+          deferred_writes(0)
+    { }
+
+    FNET_TransportMetrics &operator+=(const FNET_TransportMetrics &rhs) {
+        packets_written += rhs.packets_written;
+        write_calls += rhs.write_calls;
+        bytes_written += rhs.bytes_written;
+        deferred_writes += rhs.deferred_writes;
+        return *this;
+    }
+
+    FNET_TransportMetrics operator-(const FNET_TransportMetrics &rhs) const {
+        FNET_TransportMetrics result;
+        result.packets_written = packets_written - rhs.packets_written;
+        result.write_calls = write_calls - rhs.write_calls;
+        result.bytes_written = bytes_written - rhs.bytes_written;
+        result.deferred_writes = deferred_writes - rhs.deferred_writes;
+        return result;
+    }
+
+    double write_calls_per_packet() const {
+        return (packets_written > 0) ? double(write_calls) / packets_written : 0.0;
+    }
+
+    double bytes_per_write() const {
+        return (write_calls > 0) ? double(bytes_written) / write_calls : 0.0;
+    }
+};
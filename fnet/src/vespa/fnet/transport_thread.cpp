@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/net/server_socket.h>
+#include <algorithm>
 #include <csignal>
 
 #include <vespa/log/log.h>
@@ -182,6 +183,47 @@ FNET_TransportThread::handle_close_cmd(FNET_IOComponent *ioc)
 }
 
 
+void
+FNET_TransportThread::handle_enable_write_cmd(FNET_IOComponent *ioc)
+{
+    ioc->EnableWriteEvent(true);
+    if (ioc->HandleWriteEvent()) {
+        ioc->SubRef();
+    } else {
+        handle_close_cmd(ioc);
+    }
+}
+
+
+void
+FNET_TransportThread::handle_deferred_writes()
+{
+    size_t keep = 0;
+    for (FNET_IOComponent *ioc : _deferredWrites) {
+        if (ioc->_flags._ioc_delete) {
+            ioc->SubRef();
+        } else if (ioc->DeferWrite()) {
+            _deferredWrites[keep++] = ioc;
+        } else {
+            handle_enable_write_cmd(ioc);
+        }
+    }
+    _deferredWrites.resize(keep);
+}
+
+
+FNET_TransportMetrics
+FNET_TransportThread::get_metrics() const
+{
+    FNET_TransportMetrics metrics;
+    metrics.packets_written = _packetsWritten.load(std::memory_order_relaxed);
+    metrics.write_calls = _writeCalls.load(std::memory_order_relaxed);
+    metrics.bytes_written = _bytesWritten.load(std::memory_order_relaxed);
+    metrics.deferred_writes = _deferredWriteCnt.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+
 extern "C" {
 
     static void pipehandler(int)
@@ -217,6 +259,11 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _selector(),
       _queue(),
       _myQueue(),
+      _deferredWrites(),
+      _packetsWritten(0),
+      _writeCalls(0),
+      _bytesWritten(0),
+      _deferredWriteCnt(0),
       _lock(),
       _cond(),
       _pseudo_thread(),
@@ -425,11 +472,12 @@ FNET_TransportThread::handle_wakeup()
             handle_add_cmd(context._value.IOC);
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_ENABLE_WRITE:
-            context._value.IOC->EnableWriteEvent(true);
-            if (context._value.IOC->HandleWriteEvent()) {
-                context._value.IOC->SubRef();
+            if (context._value.IOC->DeferWrite()) {
+                _deferredWrites.push_back(context._value.IOC);
+                _deferredWriteCnt.store(_deferredWriteCnt.load(std::memory_order_relaxed) + 1,
+                                        std::memory_order_relaxed);
             } else {
-                handle_close_cmd(context._value.IOC);
+                handle_enable_write_cmd(context._value.IOC);
             }
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_HANDSHAKE_ACT:
@@ -474,6 +522,12 @@ FNET_TransportThread::EventLoopIteration()
     int                 msTimeout = FNET_Scheduler::tick_ms.count();
 
     if (!IsShutDown()) {
+        // wake up in time for postponed writes
+        if (!_deferredWrites.empty()) {
+            int writeDelayMs = (_config._writeBatchDelay + 999) / 1000;
+            msTimeout = std::max(1, std::min(msTimeout, writeDelayMs));
+        }
+
         // obtain I/O events
         _selector.poll(msTimeout);
 
@@ -483,6 +537,11 @@ FNET_TransportThread::EventLoopIteration()
         // handle wakeup and io-events
         _selector.dispatch(*this);
 
+        // handle postponed writes
+        if (!_deferredWrites.empty()) {
+            handle_deferred_writes();
+        }
+
         // handle IOC time-outs
         if (_config._iocTimeOut > 0) {
             time_point oldest = (_now - std::chrono::milliseconds(_config._iocTimeOut));
@@ -525,6 +584,12 @@ FNET_TransportThread::EventLoopIteration()
         }
     }
 
+    // drop postponed writes
+    for (FNET_IOComponent *ioc : _deferredWrites) {
+        ioc->SubRef();
+    }
+    _deferredWrites.clear();
+
     // close and remove all I/O Components
     component = _componentsHead;
     while (component != nullptr) {
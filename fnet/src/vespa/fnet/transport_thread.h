@@ -6,6 +6,7 @@
 #include "config.h"
 #include "task.h"
 #include "packetqueue.h"
+#include "transport_metrics.h"
 #include <vespa/fastos/thread.h>
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/selector.h>
@@ -13,6 +14,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <vector>
 
 class FNET_Transport;
 class FNET_ControlPacket;
@@ -46,6 +48,11 @@ private:
     Selector                 _selector;       // I/O event generator
     FNET_PacketQueue_NoLock  _queue;          // outer event queue
     FNET_PacketQueue_NoLock  _myQueue;        // inner event queue
+    std::vector<FNET_IOComponent *> _deferredWrites; // IOCs with postponed writes
+    std::atomic<uint64_t>    _packetsWritten; // output counters
+    std::atomic<uint64_t>    _writeCalls;
+    std::atomic<uint64_t>    _bytesWritten;
+    std::atomic<uint64_t>    _deferredWriteCnt;
     std::mutex               _lock;           // used for synchronization
     std::condition_variable  _cond;           // used for synchronization
     std::recursive_mutex     _pseudo_thread;  // used after transport thread has shut down
@@ -149,6 +156,12 @@ private:
 
     void handle_add_cmd(FNET_IOComponent *ioc);
     void handle_close_cmd(FNET_IOComponent *ioc);
+    void handle_enable_write_cmd(FNET_IOComponent *ioc);
+
+    /**
+     * Perform postponed writes that may not be postponed any longer.
+     **/
+    void handle_deferred_writes();
 
     /**
      * This method is called to initialize the transport thread event
@@ -270,6 +283,34 @@ public:
     uint32_t GetNumIOComponents() { return _componentCnt; }
 
 
+    /**
+     * @return the time sampled at the start of the current event loop
+     * iteration. May only be called in the transport thread.
+     **/
+    time_point GetTimeSampler() const { return _now; }
+
+
+    /**
+     * Count output done by an I/O component. This method should only
+     * be called in the transport thread.
+     *
+     * @param packets number of packets encoded
+     * @param calls number of write system calls
+     * @param bytes number of bytes written
+     **/
+    void CountWrites(uint32_t packets, uint32_t calls, uint64_t bytes) {
+        _packetsWritten.store(_packetsWritten.load(std::memory_order_relaxed) + packets, std::memory_order_relaxed);
+        _writeCalls.store(_writeCalls.load(std::memory_order_relaxed) + calls, std::memory_order_relaxed);
+        _bytesWritten.store(_bytesWritten.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+    }
+
+
+    /**
+     * @return snapshot of the output counters of this transport thread
+     **/
+    FNET_TransportMetrics get_metrics() const;
+
+
     /**
      * Set the I/O Component timeout. Idle I/O Components with timeout
      * enabled (determined by calling the ShouldTimeOut method) will
@@ -314,6 +355,18 @@ public:
     void SetMaxOutputBufferSize(uint32_t bytes)
     { _config._maxOutputBufferSize = bytes; }
 
+    /**
+     * Set the minimum size of data values written to the network
+     * directly from packet memory instead of being copied into the
+     * output buffer of the connection. This only affects connections
+     * where data is not transformed on its way to the socket (no
+     * tls); other connections always copy.
+     *
+     * @param bytes minimum data size in bytes. 0 means always copy.
+     **/
+    void SetMinZeroCopySize(uint32_t bytes)
+    { _config._minZeroCopySize = bytes; }
+
     /**
      * Enable or disable use of the TCP_NODELAY flag with sockets
      * created by this transport object.
@@ -322,6 +375,24 @@ public:
      **/
     void SetTCPNoDelay(bool noDelay) { _config._tcpNoDelay = noDelay; }
 
+    /**
+     * Enable batching of writes on busy connections. When a connection
+     * has written data less than the given delay ago, new packets are
+     * not written until the delay has passed since that write, or the
+     * given number of bytes has been queued, so that packets from many
+     * requests are written with a single system call. Idle connections
+     * write immediately, so batching only adds latency when there is
+     * enough traffic to benefit from it. This replaces the need for
+     * the Nagle algorithm on busy connections (see SetTCPNoDelay).
+     *
+     * @param delayUs max write delay in micro-seconds. 0 disables batching.
+     * @param bytes write anyway when this many bytes are queued. 0 means no limit.
+     **/
+    void SetWriteBatching(uint32_t delayUs, uint32_t bytes) {
+        _config._writeBatchDelay = delayUs;
+        _config._writeBatchSize = bytes;
+    }
+
 
     /**
      * Add an I/O component to the working set of this transport
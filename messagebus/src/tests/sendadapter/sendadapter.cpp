@@ -7,12 +7,16 @@
 #include <vespa/messagebus/testlib/testserver.h>
 #include <vespa/messagebus/network/rpcsendv1.h>
 #include <vespa/messagebus/network/rpcsendv2.h>
+#include <vespa/messagebus/testlib/simplemessage.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("sendadapter_test");
 
 using namespace mbus;
+using vespalib::compression::ZStdDictionary;
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -224,4 +228,113 @@ TEST("test that we can send between multiple versions") {
     TEST_DO(testSendAdapters(data, {vespalib::Version(5, 0), vespalib::Version(6, 148), vespalib::Version(6, 149), vespalib::Version(9, 999)}));
 }
 
+TEST("test that zstd dictionaries are negotiated and used for messages and replies") {
+    using vespalib::compression::CompressionConfig;
+    CompressionConfig zstd(CompressionConfig::ZSTD, 3, 90, 1024);
+    Slobrok slobrok;
+    TestServer srcServer(MessageBusParams().setRetryPolicy(IRetryPolicy::SP()).addProtocol(std::make_shared<SimpleProtocol>()),
+                         RPCNetworkParams(slobrok.config()).setCompressionConfig(zstd));
+    TestServer dstServer(MessageBusParams().addProtocol(std::make_shared<SimpleProtocol>()),
+                         RPCNetworkParams(slobrok.config()).setIdentity(Identity("dst")).setCompressionConfig(zstd));
+    Receptor srcHandler;
+    Receptor dstHandler;
+    SourceSession::UP srcSession = srcServer.mb.createSourceSession(SourceSessionParams().setReplyHandler(srcHandler));
+    DestinationSession::UP dstSession = dstServer.mb.createDestinationSession(DestinationSessionParams().setName("session").setMessageHandler(dstHandler));
+    ASSERT_TRUE(srcServer.waitSlobrok("dst/session", 1u));
+    vespalib::Version version(9, 999);
+    srcServer.net.setVersion(version);
+    dstServer.net.setVersion(version);
+
+    for (size_t i = 0; i < 2 * RPCCompression::MIN_SAMPLES; ++i) {
+        if (i == RPCCompression::MIN_SAMPLES) {
+            // The dictionary is trained in the background, with messages sent without one meanwhile.
+            srcServer.net.sync();
+        }
+        string value = vespalib::make_string("message %zu for id:music:music::%zu with title 'title %zu'", i, i * 7919, i % 97);
+        ASSERT_TRUE(srcSession->send(std::make_unique<SimpleMessage>(value), Route::parse("dst/session")).isAccepted());
+        Message::UP msg = dstHandler.getMessage(TIMEOUT_SECS);
+        ASSERT_TRUE(msg);
+        EXPECT_EQUAL(value, static_cast<SimpleMessage &>(*msg).getValue());
+        auto reply = std::make_unique<SimpleReply>("reply to " + value);
+        reply->swapState(*msg);
+        dstSession->reply(std::move(reply));
+        Reply::UP received = srcHandler.getReply(TIMEOUT_SECS);
+        ASSERT_TRUE(received);
+        ASSERT_FALSE(received->hasErrors());
+        EXPECT_EQUAL("reply to " + value, static_cast<SimpleReply &>(*received).getValue());
+    }
+    auto srcSend = dynamic_cast<RPCSendV2 *>(srcServer.net.getSendAdapter(version));
+    auto dstSend = dynamic_cast<RPCSendV2 *>(dstServer.net.getSendAdapter(version));
+    ASSERT_TRUE(srcSend != nullptr);
+    ASSERT_TRUE(dstSend != nullptr);
+    EXPECT_EQUAL(1u, srcSend->getCompression().getNumDictionaries());
+    EXPECT_EQUAL(1u, dstSend->getCompression().getNumDictionaries());
+}
+
+namespace {
+
+std::vector<vespalib::string>
+makePayloads(const char *format, size_t count)
+{
+    std::vector<vespalib::string> payloads;
+    for (size_t i = 0; i < count; ++i) {
+        payloads.push_back(vespalib::make_string(format, i, i * 7919, i % 97));
+    }
+    return payloads;
+}
+
+ZStdDictionary::SP
+trainFrom(RPCCompression &compression, vespalib::ThreadStackExecutor &executor, const char *format, uint32_t type)
+{
+    for (const vespalib::string &payload : makePayloads(format, RPCCompression::MIN_SAMPLES)) {
+        EXPECT_FALSE(compression.getDictionary("simple", type, vespalib::ConstBufferRef(payload.data(), payload.size()), executor));
+    }
+    executor.sync();
+    vespalib::string payload = makePayloads(format, 1).back();
+    return compression.getDictionary("simple", type, vespalib::ConstBufferRef(payload.data(), payload.size()), executor);
+}
+
+}
+
+TEST("test that zstd dictionaries are trained in the background") {
+    vespalib::ThreadStackExecutor executor(1, 65536);
+    RPCCompression compression;
+    ZStdDictionary::SP dictionary = trainFrom(compression, executor, "message %zu for id:music:music::%zu with title 'title %zu'", 1);
+    ASSERT_TRUE(dictionary);
+    EXPECT_EQUAL(dictionary.get(), compression.findDictionary(dictionary->id()).get());
+    EXPECT_EQUAL(1u, compression.getNumDictionaries());
+}
+
+TEST("test that the least recently used received zstd dictionary is evicted") {
+    vespalib::ThreadStackExecutor executor(1, 65536);
+    RPCCompression trainer;
+    ZStdDictionary::SP first = trainFrom(trainer, executor, "message %zu for id:music:music::%zu with title 'title %zu'", 1);
+    ZStdDictionary::SP second = trainFrom(trainer, executor, "{\"n\":%zu,\"id\":\"id:books:books::%zu\",\"shelf\":%zu}", 2);
+    ZStdDictionary::SP third = trainFrom(trainer, executor, "<doc id=\"id:news:news::%zu\" rev=\"%zu\" tag=\"%zu\"/>", 3);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    ASSERT_TRUE(third);
+    ASSERT_NOT_EQUAL(first->id(), second->id());
+    ASSERT_NOT_EQUAL(first->id(), third->id());
+    ASSERT_NOT_EQUAL(second->id(), third->id());
+
+    RPCCompression receiver(2);
+    EXPECT_TRUE(receiver.addDictionary(first->content()));
+    EXPECT_TRUE(receiver.addDictionary(second->content()));
+    EXPECT_TRUE(receiver.findDictionary(first->id()));
+    ZStdDictionary::SP added = receiver.addDictionary(third->content());
+    ASSERT_TRUE(added);
+    EXPECT_EQUAL(third->id(), added->id());
+    EXPECT_EQUAL(2u, receiver.getNumDictionaries());
+    EXPECT_TRUE(receiver.findDictionary(first->id()));
+    EXPECT_FALSE(receiver.findDictionary(second->id()));
+    EXPECT_TRUE(receiver.findDictionary(third->id()));
+
+    // A peer sending the evicted dictionary again gets it registered again.
+    EXPECT_TRUE(receiver.addDictionary(second->content()));
+    EXPECT_TRUE(receiver.findDictionary(second->id()));
+    EXPECT_FALSE(receiver.findDictionary(first->id()));
+    EXPECT_EQUAL(2u, receiver.getNumDictionaries());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/messagebus/destinationsession.h>
 #include <vespa/messagebus/dynamicthrottlepolicy.h>
+#include <vespa/messagebus/errorcode.h>
+#include <vespa/messagebus/latencythrottlepolicy.h>
 #include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/routing/retrytransienterrorspolicy.h>
 #include <vespa/messagebus/routing/routingspec.h>
@@ -74,6 +76,8 @@ bool waitPending(SourceSession& session, uint32_t size)
 class Test : public vespalib::TestApp {
 private:
     uint32_t getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending);
+    uint32_t getWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity,
+                           uint32_t errorCode, uint32_t numRejected = 0);
 
 protected:
     void testMaxPendingCount();
@@ -83,6 +87,9 @@ protected:
     void testIdleTimePeriod();
     void testMinWindowSize();
     void testMaxWindowSize();
+    void testLatencyWindowSize();
+    void testLatencyBackOff();
+    void testLatencyIgnoresRejectedRtt();
 
 public:
     int Main() override;
@@ -100,6 +107,9 @@ Test::Main()
     testIdleTimePeriod();    TEST_FLUSH();
     testMinWindowSize();     TEST_FLUSH();
     testMaxWindowSize();     TEST_FLUSH();
+    testLatencyWindowSize(); TEST_FLUSH();
+    testLatencyBackOff();    TEST_FLUSH();
+    testLatencyIgnoresRejectedRtt(); TEST_FLUSH();
 
     TEST_DONE();
 }
@@ -356,3 +366,96 @@ Test::getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t
     printf("getWindowSize() = %d\n", ret);
     return ret;
 }
+
+void
+Test::testLatencyWindowSize()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    uint32_t windowSize = getWindowSize(policy, *timer, 100, ErrorCode::NONE);
+    ASSERT_TRUE(windowSize >= 50 && windowSize <= 200);
+    EXPECT_EQUAL(100000u, policy.getMinRttMicros());
+    EXPECT_EQUAL(windowSize, (uint32_t)policy.getWindowSizeMetric());
+
+    windowSize = getWindowSize(policy, *timer, 400, ErrorCode::NONE);
+    ASSERT_TRUE(windowSize >= 200 && windowSize <= 800);
+
+    windowSize = getWindowSize(policy, *timer, 50, ErrorCode::NONE);
+    ASSERT_TRUE(windowSize >= 25 && windowSize <= 100);
+    EXPECT_EQUAL(100000u, policy.getMinRttMicros());
+    EXPECT_LESS_EQUAL(policy.getRttMicros(), 200000u);
+}
+
+void
+Test::testLatencyBackOff()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+    policy.setMinWindowSize(10).setMaxWindowSize(150);
+
+    uint32_t windowSize = getWindowSize(policy, *timer, 1000, ErrorCode::NONE);
+    EXPECT_EQUAL(150u, windowSize);
+
+    windowSize = getWindowSize(policy, *timer, 1000, ErrorCode::SESSION_BUSY);
+    EXPECT_EQUAL(10u, windowSize);
+}
+
+void
+Test::testLatencyIgnoresRejectedRtt()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+    policy.setMinWindowSize(10).setMaxWindowSize(150);
+
+    uint32_t windowSize = getWindowSize(policy, *timer, 1000, ErrorCode::NONE);
+    EXPECT_EQUAL(150u, windowSize);
+    EXPECT_EQUAL(100000u, policy.getMinRttMicros());
+
+    // Rejections are replied to at once, but must not lower the unloaded round trip time.
+    windowSize = getWindowSize(policy, *timer, 1000, ErrorCode::NONE, 5);
+    EXPECT_EQUAL(10u, windowSize);
+    EXPECT_EQUAL(100000u, policy.getMinRttMicros());
+    EXPECT_EQUAL(100000u, policy.getRttMicros());
+}
+
+uint32_t
+Test::getWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity,
+                    uint32_t errorCode, uint32_t numRejected)
+{
+    SimpleMessage msg("foo");
+    SimpleReply reply("bar");
+    if (errorCode != ErrorCode::NONE) {
+        reply.addError(Error(errorCode, "error"));
+    }
+    SimpleReply rejected("baz");
+    rejected.addError(Error(ErrorCode::SESSION_BUSY, "busy"));
+
+    for (uint32_t i = 0; i < 999; ++i) {
+        uint32_t numPending = 0;
+        while (policy.canSend(msg, numPending)) {
+            policy.processMessage(msg);
+            ++numPending;
+        }
+        // The policy strips the send time from the context of each reply it processes.
+        for (uint32_t j = 0; j < numRejected && numPending > 0; ++j, --numPending) {
+            rejected.setContext(msg.getContext());
+            policy.processReply(rejected);
+        }
+
+        // Messages beyond the capacity of the recipient queue up and add to the round trip time.
+        uint64_t tripTime = (numPending <= capacity) ? 100 : 100 * numPending / capacity;
+        timer._millis += tripTime;
+
+        for( ; numPending > 0 ; --numPending) {
+            reply.setContext(msg.getContext());
+            policy.processReply(reply);
+        }
+    }
+    uint32_t ret = policy.getMaxPendingCount();
+    printf("getWindowSize() = %d\n", ret);
+    return ret;
+}
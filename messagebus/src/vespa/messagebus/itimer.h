@@ -2,6 +2,7 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 
 namespace mbus {
 
@@ -30,6 +31,14 @@ public:
      * @return The current value of the timer, in milliseconds.
      */
     virtual uint64_t getMilliTime() const = 0;
+
+    /**
+     * Returns the current value of the same timer, in microseconds. Timers
+     * without a finer resolution report milliseconds scaled up.
+     *
+     * @return The current value of the timer, in microseconds.
+     */
+    virtual uint64_t getMicroTime() const { return getMilliTime() * 1000; }
 };
 
 } // namespace mbus
@@ -0,0 +1,214 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "latencythrottlepolicy.h"
+#include "message.h"
+#include "steadytimer.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".latencythrottlepolicy");
+
+namespace mbus {
+
+namespace {
+
+// Send times are kept in the upper half of the message context, next to the size kept by the
+// static policy. Round trip times are computed modulo 2^32 microseconds, which is ample.
+uint64_t packContext(uint64_t size, uint32_t sendTime) {
+    return (uint64_t(sendTime) << 32) | (size & 0xffffffff);
+}
+
+}
+
+LatencyThrottlePolicy::LatencyThrottlePolicy()
+    : LatencyThrottlePolicy(std::make_unique<SteadyTimer>())
+{ }
+
+LatencyThrottlePolicy::LatencyThrottlePolicy(ITimer::UP timer) :
+    _timer(std::move(timer)),
+    _numReplies(0),
+    _numErrors(0),
+    _numRtts(0),
+    _sumRtt(0),
+    _periodMinRtt(0),
+    _minRtt(0),
+    _numPeriods(0),
+    _probeInterval(100),
+    _probe(Probe::NONE),
+    _probeWindowSize(0),
+    _timeOfLastMessage(_timer->getMilliTime()),
+    _idleTimePeriod(60000),
+    _rttTolerance(1.5),
+    _smoothing(0.2),
+    _windowSize(20),
+    _maxWindowSize(INT_MAX),
+    _minWindowSize(20),
+    _windowSizeBackOff(0.9),
+    _windowSizeMetric(_windowSize),
+    _minRttMetric(0),
+    _rttMetric(0)
+{ }
+
+LatencyThrottlePolicy::~LatencyThrottlePolicy() = default;
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setRttTolerance(double tolerance)
+{
+    _rttTolerance = std::max(1.0, tolerance);
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setSmoothing(double smoothing)
+{
+    _smoothing = std::max(0.01, std::min(1.0, smoothing));
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setWindowSizeBackOff(double windowSizeBackOff)
+{
+    _windowSizeBackOff = std::max(0.0, std::min(1.0, windowSizeBackOff));
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setProbeInterval(uint32_t interval)
+{
+    _probeInterval = interval;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setIdleTimePeriod(uint64_t period)
+{
+    _idleTimePeriod = period;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxWindowSize(double max)
+{
+    _maxWindowSize = max;
+    setWindowSize(_windowSize);
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMinWindowSize(double min)
+{
+    _minWindowSize = min;
+    setWindowSize(_windowSize);
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxPendingCount(uint32_t maxCount)
+{
+    StaticThrottlePolicy::setMaxPendingCount(maxCount);
+    _maxWindowSize = maxCount;
+    setWindowSize(_windowSize);
+    return *this;
+}
+
+void
+LatencyThrottlePolicy::setWindowSize(double windowSize)
+{
+    _windowSize = std::min(_maxWindowSize, std::max(_minWindowSize, windowSize));
+    _windowSizeMetric.store(_windowSize, std::memory_order_relaxed);
+}
+
+bool
+LatencyThrottlePolicy::canSend(const Message &msg, uint32_t pendingCount)
+{
+    if (!StaticThrottlePolicy::canSend(msg, pendingCount)) {
+        return false;
+    }
+    uint64_t time = _timer->getMilliTime();
+    if (time - _timeOfLastMessage > _idleTimePeriod) {
+        setWindowSize(std::min(_windowSize, (double) pendingCount + _minWindowSize));
+    }
+    _timeOfLastMessage = time;
+    return pendingCount < _windowSize;
+}
+
+void
+LatencyThrottlePolicy::processMessage(Message &msg)
+{
+    StaticThrottlePolicy::processMessage(msg);
+    uint64_t size = msg.getContext().value.UINT64;
+    msg.setContext(Context(packContext(size, _timer->getMicroTime())));
+}
+
+void
+LatencyThrottlePolicy::processReply(Reply &reply)
+{
+    uint64_t context = reply.getContext().value.UINT64;
+    uint32_t rtt = uint32_t(_timer->getMicroTime()) - uint32_t(context >> 32);
+    reply.setContext(Context(context & 0xffffffff));
+    StaticThrottlePolicy::processReply(reply);
+
+    // Errors are often returned without the message being queued, so their round trip times say
+    // nothing about the load on the recipient.
+    if (!reply.hasErrors()) {
+        rtt = std::max(rtt, 1u);
+        _sumRtt += rtt;
+        _periodMinRtt = (_numRtts == 0) ? rtt : std::min(_periodMinRtt, rtt);
+        ++_numRtts;
+    } else if (!reply.hasFatalErrors()) {
+        ++_numErrors;
+    }
+    if (++_numReplies >= _windowSize) {
+        resize();
+    }
+}
+
+void
+LatencyThrottlePolicy::resize()
+{
+    uint32_t rtt = (_numRtts > 0) ? _sumRtt / _numRtts : 0;
+    if (_numRtts > 0) {
+        _rttMetric.store(rtt, std::memory_order_relaxed);
+    }
+    switch (_probe) {
+    case Probe::DRAINING:
+        // Replies to messages sent before the window was reduced are still queued.
+        _probe = Probe::MEASURING;
+        break;
+    case Probe::MEASURING:
+        if (_numRtts > 0) {
+            _minRtt = _periodMinRtt;
+        }
+        _probe = Probe::NONE;
+        setWindowSize(_probeWindowSize);
+        break;
+    case Probe::NONE:
+        if (_numRtts > 0) {
+            _minRtt = (_minRtt == 0) ? _periodMinRtt : std::min(_minRtt, _periodMinRtt);
+        }
+        if (_numErrors > 0) {
+            setWindowSize(_windowSize * _windowSizeBackOff);
+        } else if (_numRtts > 0) {
+            double gradient = std::max(0.5, std::min(1.0, _rttTolerance * _minRtt / rtt));
+            double estimate = _windowSize * gradient + std::sqrt(_windowSize);
+            setWindowSize(_windowSize * (1 - _smoothing) + estimate * _smoothing);
+        }
+        LOG(debug, "WindowSize = %.2f, Rtt = %u us, MinRtt = %u us, Errors = %u",
+            _windowSize, rtt, _minRtt, _numErrors);
+        if ((_probeInterval > 0) && (++_numPeriods % _probeInterval == 0)) {
+            _probe = Probe::DRAINING;
+            _probeWindowSize = _windowSize;
+            setWindowSize(_windowSize / 2);
+        }
+        break;
+    }
+    _minRttMetric.store(_minRtt, std::memory_order_relaxed);
+    _numReplies = 0;
+    _numErrors = 0;
+    _numRtts = 0;
+    _sumRtt = 0;
+    _periodMinRtt = 0;
+}
+
+} // namespace mbus
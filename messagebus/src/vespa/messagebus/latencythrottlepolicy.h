@@ -0,0 +1,172 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "itimer.h"
+#include "staticthrottlepolicy.h"
+#include <atomic>
+
+namespace mbus {
+
+/**
+ * This is an implementation of the {@link ThrottlePolicy} that sizes the window of pending messages from the
+ * round trip time of the replies, rather than from throughput as the {@link DynamicThrottlePolicy} does.
+ *
+ * Once per window of replies, the average round trip time is compared to the lowest round trip time seen. As
+ * long as the ratio stays below the configured tolerance the window grows by roughly the square root of its
+ * size, and when it goes above the window shrinks by the same gradient. This keeps the queueing delay at the
+ * recipients bounded to a fraction of the unloaded round trip time, instead of probing until throughput
+ * drops. Transient errors make the window back off, and replies with errors are left out of the round trip
+ * times, since fast rejections would otherwise pull the lowest one below the unloaded latency. The lowest
+ * round trip time is measured anew at regular intervals by halving the window for a while, so that the
+ * policy follows changes in the unloaded latency.
+ *
+ * Use it by passing an instance to {@link SourceSessionParams#setThrottlePolicy}.
+ *
+ * <b>NOTE:</b> By context, "pending" is refering to the number of sent messages that have not been replied to
+ * yet.
+ */
+class LatencyThrottlePolicy: public StaticThrottlePolicy {
+private:
+    enum class Probe { NONE, DRAINING, MEASURING };
+
+    ITimer::UP  _timer;
+    uint32_t    _numReplies;
+    uint32_t    _numErrors;
+    uint32_t    _numRtts;
+    uint64_t    _sumRtt;
+    uint32_t    _periodMinRtt;
+    uint32_t    _minRtt;
+    uint32_t    _numPeriods;
+    uint32_t    _probeInterval;
+    Probe       _probe;
+    double      _probeWindowSize;
+    uint64_t    _timeOfLastMessage;
+    uint64_t    _idleTimePeriod;
+    double      _rttTolerance;
+    double      _smoothing;
+    double      _windowSize;
+    double      _maxWindowSize;
+    double      _minWindowSize;
+    double      _windowSizeBackOff;
+
+    std::atomic<double>   _windowSizeMetric;
+    std::atomic<uint32_t> _minRttMetric;
+    std::atomic<uint32_t> _rttMetric;
+
+    void resize();
+    void setWindowSize(double windowSize);
+
+public:
+    /**
+     * Convenience typedefs.
+     */
+    typedef std::unique_ptr<LatencyThrottlePolicy> UP;
+    typedef std::shared_ptr<LatencyThrottlePolicy> SP;
+
+    /**
+     * Constructs a new instance of this policy and sets the appropriate default values of member data.
+     */
+    LatencyThrottlePolicy();
+
+    /**
+     * Constructs a new instance of this class using the given clock to measure round trip times.
+     *
+     * @param timer The timer to use.
+     */
+    LatencyThrottlePolicy(ITimer::UP timer);
+    ~LatencyThrottlePolicy() override;
+
+    /**
+     * Sets how much the average round trip time may exceed the lowest one before the window shrinks. A
+     * value of 1.5 allows for a queueing delay of half the unloaded round trip time. Values below 1 are
+     * capped to 1.
+     *
+     * @param tolerance The ratio to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setRttTolerance(double tolerance);
+
+    /**
+     * Sets the weight given to each new window size estimate, in the (0, 1] range. The smaller the value,
+     * the slower but steadier the window size changes.
+     *
+     * @param smoothing The weight to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setSmoothing(double smoothing);
+
+    /**
+     * Sets the factor of window size to back off to when replies carry transient errors, such as timeouts
+     * or busy recipients. This value is capped to the [0, 1] range.
+     *
+     * @param windowSizeBackOff The back off to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setWindowSizeBackOff(double windowSizeBackOff);
+
+    /**
+     * Sets the number of window resizes between each time the lowest round trip time is measured anew.
+     * A value of 0 disables the measurement, so that the lowest round trip time ever seen is kept.
+     *
+     * @param interval The interval to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setProbeInterval(uint32_t interval);
+
+    /**
+     * Sets the idle time period for this client, in milliseconds. If nothing is sent throughout this time
+     * period, the window will retract.
+     *
+     * @param period The time period to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setIdleTimePeriod(uint64_t period);
+
+    /**
+     * Sets the maximium number of pending operations allowed at any time.
+     *
+     * @param max The max to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxWindowSize(double max);
+
+    /**
+     * Sets the minimium number of pending operations allowed at any time. This is also the initial window
+     * size.
+     *
+     * @param min The min to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMinWindowSize(double min);
+
+    /**
+     * Sets the maximum number of pending messages allowed.
+     *
+     * @param maxCount The max count.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxPendingCount(uint32_t maxCount);
+
+    double getMaxWindowSize() const { return _maxWindowSize; }
+    double getMinWindowSize() const { return _minWindowSize; }
+
+    /**
+     * Returns the maximum number of pending messages allowed.
+     *
+     * @return The max limit.
+     */
+    uint32_t getMaxPendingCount() const { return (uint32_t)_windowSize; }
+
+    /**
+     * The following metrics may be read from any thread while the policy is in use.
+     */
+    double getWindowSizeMetric() const { return _windowSizeMetric.load(std::memory_order_relaxed); }
+    uint32_t getMinRttMicros() const { return _minRttMetric.load(std::memory_order_relaxed); }
+    uint32_t getRttMicros() const { return _rttMetric.load(std::memory_order_relaxed); }
+
+    bool canSend(const Message &msg, uint32_t pendingCount) override;
+    void processMessage(Message &msg) override;
+    void processReply(Reply &reply) override;
+};
+
+} // namespace mbus
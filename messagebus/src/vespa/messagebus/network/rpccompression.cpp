@@ -0,0 +1,255 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "rpccompression.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
+using vespalib::make_string;
+
+namespace mbus {
+
+namespace {
+
+constexpr uint8_t MIN_LEVEL = 1;
+constexpr uint8_t MAX_LEVEL = 19;
+
+uint8_t clampLevel(uint32_t level) {
+    return std::max(MIN_LEVEL, std::min(MAX_LEVEL, static_cast<uint8_t>(std::min(level, 255u))));
+}
+
+}
+
+RPCCompression::RPCCompression()
+    : RPCCompression(MAX_RECEIVED_DICTIONARIES)
+{ }
+
+RPCCompression::RPCCompression(size_t maxReceivedDictionaries)
+    : _lock(),
+      _samples(),
+      _dictionaries(),
+      _receivedUse(),
+      _useCount(0),
+      _maxReceived(maxReceivedDictionaries),
+      _level(0),
+      _windowCount(0),
+      _windowNanos(0),
+      _windowSaved(0)
+{ }
+
+RPCCompression::~RPCCompression() = default;
+
+RPCCompression::ZStdDictionary::SP
+RPCCompression::getDictionary(vespalib::stringref protocol, uint32_t type, ConstBufferRef payload,
+                              vespalib::Executor &executor)
+{
+    SampleKey key(protocol, type);
+    std::vector<vespalib::string> toTrain;
+    {
+        std::lock_guard guard(_lock);
+        Samples &samples = _samples[key];
+        if (samples.dictionary || samples.failed || samples.training || (payload.size() > MAX_SAMPLE_SIZE)) {
+            return samples.dictionary;
+        }
+        samples.samples.emplace_back(payload.c_str(), payload.size());
+        if (samples.samples.size() < MIN_SAMPLES) {
+            return ZStdDictionary::SP();
+        }
+        toTrain.swap(samples.samples);
+        samples.training = true;
+    }
+    // Training takes far longer than sending a message, so it must not hold up the sender.
+    auto rejected = executor.execute(vespalib::makeLambdaTask([this, key, toTrain = std::move(toTrain)]() {
+        train(key, toTrain);
+    }));
+    if (rejected) {
+        std::lock_guard guard(_lock);
+        _samples[key].training = false;
+    }
+    return ZStdDictionary::SP();
+}
+
+void
+RPCCompression::train(const SampleKey &key, const std::vector<vespalib::string> &toTrain)
+{
+    std::vector<ConstBufferRef> refs;
+    size_t total = 0;
+    for (const vespalib::string &sample : toTrain) {
+        refs.emplace_back(sample.data(), sample.size());
+        total += sample.size();
+    }
+    size_t maxSize = std::max(size_t(1024), std::min(MAX_DICTIONARY_SIZE, total / 10));
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(refs, maxSize);
+    std::lock_guard guard(_lock);
+    Samples &samples = _samples[key];
+    samples.training = false;
+    if (dictionary) {
+        _dictionaries[dictionary->id()] = dictionary;
+        samples.dictionary = dictionary;
+    } else {
+        samples.failed = true;
+    }
+}
+
+RPCCompression::ZStdDictionary::SP
+RPCCompression::findDictionary(uint32_t id) const
+{
+    std::lock_guard guard(_lock);
+    auto found = _dictionaries.find(id);
+    if (found == _dictionaries.end()) {
+        return ZStdDictionary::SP();
+    }
+    auto received = _receivedUse.find(id);
+    if (received != _receivedUse.end()) {
+        received->second = ++_useCount;
+    }
+    return found->second;
+}
+
+RPCCompression::ZStdDictionary::SP
+RPCCompression::addDictionary(ConstBufferRef content)
+{
+    auto dictionary = std::make_shared<const ZStdDictionary>(content.c_str(), content.size());
+    if ( ! dictionary->valid()) {
+        return dictionary;
+    }
+    std::lock_guard guard(_lock);
+    auto found = _dictionaries.find(dictionary->id());
+    if (found != _dictionaries.end()) {
+        auto received = _receivedUse.find(dictionary->id());
+        if (received != _receivedUse.end()) {
+            received->second = ++_useCount;
+        }
+        return found->second;
+    }
+    if (_maxReceived == 0) {
+        return dictionary;
+    }
+    if (_receivedUse.size() >= _maxReceived) {
+        evictLeastRecentlyUsed();
+    }
+    _dictionaries[dictionary->id()] = dictionary;
+    _receivedUse[dictionary->id()] = ++_useCount;
+    return dictionary;
+}
+
+void
+RPCCompression::evictLeastRecentlyUsed()
+{
+    // Only done when a new dictionary is received, which is rare, so a linear scan will do.
+    auto oldest = std::min_element(_receivedUse.begin(), _receivedUse.end(),
+                                   [](const auto &a, const auto &b) { return a.second < b.second; });
+    _dictionaries.erase(oldest->first);
+    _receivedUse.erase(oldest);
+}
+
+uint8_t
+RPCCompression::getLevel(const CompressionConfig &config) const
+{
+    uint8_t level = _level.load(std::memory_order_relaxed);
+    return (level != 0) ? level : clampLevel(config.compressionLevel);
+}
+
+size_t
+RPCCompression::getNumDictionaries() const
+{
+    std::lock_guard guard(_lock);
+    return _dictionaries.size();
+}
+
+RPCCompression::CompressionConfig::Type
+RPCCompression::compress(const CompressionConfig &config, const ZStdDictionary *dictionary,
+                         ConstBufferRef input, DataBuffer &output)
+{
+    if (config.type != CompressionConfig::ZSTD) {
+        return vespalib::compression::compress(config, input, output, false);
+    }
+    uint8_t level = getLevel(config);
+    size_t minSize = (dictionary != nullptr) ? std::min(config.minSize, MIN_DICTIONARY_PAYLOAD) : config.minSize;
+    if (input.size() < minSize) {
+        output.writeBytes(input.c_str(), input.size());
+        return CompressionConfig::NONE;
+    }
+    auto start = std::chrono::steady_clock::now();
+    CompressionConfig::Type type = CompressionConfig::NONE;
+    size_t outputSize = input.size();
+    if (dictionary != nullptr) {
+        output.ensureFree(vespalib::compression::computeMaxCompressedsize(CompressionConfig::ZSTD, input.size()));
+        size_t compressedSize = output.getFreeLen();
+        if (dictionary->process(level, input.c_str(), input.size(), output.getFree(), compressedSize) &&
+            (compressedSize < ((input.size() * config.threshold) / 100)))
+        {
+            output.moveFreeToData(compressedSize);
+            outputSize = compressedSize;
+            type = CompressionConfig::ZSTD;
+        } else {
+            output.writeBytes(input.c_str(), input.size());
+        }
+    } else {
+        size_t before = output.getDataLen();
+        CompressionConfig tuned(config.type, level, config.threshold, 0);
+        type = vespalib::compression::compress(tuned, input, output, false);
+        outputSize = output.getDataLen() - before;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    tune(config, elapsed.count(), input.size(), outputSize);
+    return type;
+}
+
+void
+RPCCompression::tune(const CompressionConfig &config, uint64_t nanos, size_t inputSize, size_t outputSize)
+{
+    _windowNanos.fetch_add(nanos, std::memory_order_relaxed);
+    _windowSaved.fetch_add((inputSize > outputSize) ? (inputSize - outputSize) : 0, std::memory_order_relaxed);
+    if (_windowCount.fetch_add(1, std::memory_order_relaxed) + 1 != TUNING_WINDOW) {
+        return;
+    }
+    // Only the thread completing the window adjusts the level. Samples added by other threads
+    // while it does may end up in either window, which does not matter for an estimate.
+    uint64_t windowNanos = _windowNanos.exchange(0, std::memory_order_relaxed);
+    uint64_t windowSaved = _windowSaved.exchange(0, std::memory_order_relaxed);
+    _windowCount.store(0, std::memory_order_relaxed);
+    // Compression pays off as long as it takes less time than sending the bytes it saves.
+    double nanosPerSavedByte = double(windowNanos) / std::max(windowSaved, uint64_t(1));
+    uint8_t level = getLevel(config);
+    if ((nanosPerSavedByte > NETWORK_NS_PER_BYTE) && (level > MIN_LEVEL)) {
+        --level;
+    } else if ((nanosPerSavedByte * 4 < NETWORK_NS_PER_BYTE) && (level < MAX_LEVEL)) {
+        ++level;
+    }
+    _level.store(level, std::memory_order_relaxed);
+}
+
+void
+RPCCompression::decompress(CompressionConfig::Type type, uint32_t uncompressedSize, const ZStdDictionary *dictionary,
+                           ConstBufferRef input, DataBuffer &output) const
+{
+    uint32_t id = (type == CompressionConfig::ZSTD) ? ZStdDictionary::frameDictId(input.c_str(), input.size()) : 0;
+    if (id == 0) {
+        vespalib::compression::decompress(type, uncompressedSize, input, output, true);
+        return;
+    }
+    ZStdDictionary::SP found;
+    if ((dictionary == nullptr) || (dictionary->id() != id)) {
+        found = findDictionary(id);
+        dictionary = found.get();
+    }
+    if (dictionary == nullptr) {
+        throw std::runtime_error(make_string("No zstd dictionary with id %u is known", id));
+    }
+    output.ensureFree(uncompressedSize);
+    size_t decompressedSize = output.getFreeLen();
+    if ( ! dictionary->unprocess(input.c_str(), input.size(), output.getFree(), decompressedSize)) {
+        throw std::runtime_error(make_string("unprocess with dictionary %u failed had %zu, wanted %u",
+                                             id, input.size(), uncompressedSize));
+    }
+    output.moveFreeToData(decompressedSize);
+}
+
+} // namespace mbus
@@ -0,0 +1,128 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/messagebus/common.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace vespalib {
+    class DataBuffer;
+    class Executor;
+}
+
+namespace mbus {
+
+/**
+ * Implements the payload compression used by {@link RPCSendV2}. When the
+ * network is configured for zstd, the payloads of each message type are
+ * sampled until a dictionary can be trained for that type. Training is done
+ * by the network executor, and payloads are compressed without a dictionary
+ * until it is ready. Dictionaries are only used towards peers that have
+ * announced support for them, and their content travels with the requests
+ * until the peer has acknowledged or rejected it. Dictionaries received from
+ * peers are evicted least recently used first, and a peer sending with a
+ * dictionary that has been evicted is told that it is rejected. The compression level is
+ * adjusted from the observed cost of compression compared to the time it
+ * would take to send the bytes it saves.
+ *
+ * The executor given to getDictionary() must be drained before this is
+ * destructed, as RPCNetwork does when shutting down.
+ */
+class RPCCompression {
+public:
+    using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
+
+    /** The number of samples of a message type needed to train a dictionary. */
+    static constexpr size_t MIN_SAMPLES = 256;
+    /** Payloads larger than this are neither sampled nor compressed with a dictionary. */
+    static constexpr size_t MAX_SAMPLE_SIZE = 0x4000;
+    /** The largest dictionary to train. */
+    static constexpr size_t MAX_DICTIONARY_SIZE = 0x4000;
+    /** Payloads smaller than this are not compressed, even with a dictionary. */
+    static constexpr size_t MIN_DICTIONARY_PAYLOAD = 64;
+    /** The number of dictionaries received from peers to hold before evicting the least recently used. */
+    static constexpr size_t MAX_RECEIVED_DICTIONARIES = 256;
+    /** Estimated time to put a byte on the network, roughly 1 Gbit/s. */
+    static constexpr double NETWORK_NS_PER_BYTE = 8.0;
+    /** The number of compressions between each level adjustment. */
+    static constexpr uint32_t TUNING_WINDOW = 128;
+
+    RPCCompression();
+    explicit RPCCompression(size_t maxReceivedDictionaries);
+    RPCCompression(const RPCCompression &) = delete;
+    RPCCompression & operator = (const RPCCompression &) = delete;
+    ~RPCCompression();
+
+    /**
+     * Returns the dictionary to use for the given payload of a message type,
+     * recording the payload as a training sample while no dictionary exists.
+     * Once enough samples are recorded, a task training the dictionary is
+     * given to the executor.
+     */
+    ZStdDictionary::SP getDictionary(vespalib::stringref protocol, uint32_t type, vespalib::ConstBufferRef payload,
+                                     vespalib::Executor & executor);
+
+    /**
+     * Returns the known dictionary with the given id, trained here or
+     * received from a peer, or an empty pointer. A received dictionary
+     * is marked as used.
+     */
+    ZStdDictionary::SP findDictionary(uint32_t id) const;
+
+    /**
+     * Registers dictionary content received from a peer, evicting the least
+     * recently used received dictionary if too many are held. Returns the
+     * dictionary, which is not remembered if the content is not valid.
+     */
+    ZStdDictionary::SP addDictionary(vespalib::ConstBufferRef content);
+
+    /**
+     * Compresses the input into output according to the config, using the
+     * given dictionary if any. Returns the type of the output.
+     */
+    CompressionConfig::Type compress(const CompressionConfig & config, const ZStdDictionary * dictionary,
+                                     vespalib::ConstBufferRef input, vespalib::DataBuffer & output);
+
+    /**
+     * Decompresses the input into output. Frames that were compressed with a
+     * dictionary use the given one, or one found by the id in the frame.
+     * Uncompressed input is swapped into output instead of copied.
+     */
+    void decompress(CompressionConfig::Type type, uint32_t uncompressedSize, const ZStdDictionary * dictionary,
+                    vespalib::ConstBufferRef input, vespalib::DataBuffer & output) const;
+
+    uint8_t getLevel(const CompressionConfig & config) const;
+    size_t getNumDictionaries() const;
+
+private:
+    struct Samples {
+        std::vector<vespalib::string> samples;
+        ZStdDictionary::SP            dictionary;
+        bool                          training = false;
+        bool                          failed = false;
+    };
+    using SampleKey = std::pair<vespalib::string, uint32_t>;
+
+    void train(const SampleKey & key, const std::vector<vespalib::string> & samples);
+    void evictLeastRecentlyUsed();
+    void tune(const CompressionConfig & config, uint64_t nanos, size_t inputSize, size_t outputSize);
+
+    mutable std::mutex                       _lock;
+    std::map<SampleKey, Samples>             _samples;
+    std::map<uint32_t, ZStdDictionary::SP>   _dictionaries;
+    // Last use of each dictionary received from a peer.
+    mutable std::map<uint32_t, uint64_t>     _receivedUse;
+    mutable uint64_t                         _useCount;
+    const size_t                             _maxReceived;
+    std::atomic<uint8_t>                     _level;
+    std::atomic<uint32_t>                    _windowCount;
+    std::atomic<uint64_t>                    _windowNanos;
+    std::atomic<uint64_t>                    _windowSaved;
+};
+
+} // namespace mbus
@@ -9,6 +9,7 @@
 #include <vespa/messagebus/errorcode.h>
 #include <vespa/fnet/channel.h>
 #include <vespa/fnet/frt/reflection.h>
+#include <vespa/vespalib/component/vtag.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/lambdatask.h>
 
@@ -154,7 +155,8 @@ RPCSend::RequestDone(FRT_RPCRequest *req)
 void
 RPCSend::doRequestDone(FRT_RPCRequest *req) {
     SendContext::UP ctx(static_cast<SendContext*>(req->GetContext()._value.VOIDP));
-    const string &serviceName = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress()).getServiceName();
+    RPCServiceAddress &address = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress());
+    const string &serviceName = address.getServiceName();
     Reply::UP reply;
     Error error;
     Trace & trace = ctx->getTrace();
@@ -178,7 +180,7 @@ RPCSend::doRequestDone(FRT_RPCRequest *req) {
         }
     } else {
         FRT_Values &ret = *req->GetReturn();
-        reply = createReply(ret, serviceName, error, trace.getRoot());
+        reply = createReply(ret, address.getTarget(), serviceName, error, trace.getRoot());
     }
     if (trace.shouldTrace(TraceLevel::SEND_RECEIVE)) {
         trace.trace(TraceLevel::SEND_RECEIVE,
@@ -248,7 +250,7 @@ RPCSend::doHandleReply(const IProtocol * protocol, Reply::UP reply) {
         }
     }
     FRT_Values &ret = *req.GetReturn();
-    createResponse(ret, version, *reply, std::move(payload));
+    createResponse(ret, *req.GetParams(), version, *reply, std::move(payload));
     req.Return();
 }
 
@@ -258,7 +260,16 @@ RPCSend::invoke(FRT_RPCRequest *req)
     req->Detach();
     FRT_Values &args = *req->GetParams();
 
-    std::unique_ptr<Params> params = toParams(args);
+    std::unique_ptr<Params> params;
+    try {
+        params = toParams(args);
+    } catch (const std::exception & e) {
+        // E.g. compressed with a dictionary we no longer hold, the reply tells the sender to stop using it.
+        replyError(req, vespalib::Vtag::currentVersion, 0,
+                   Error(ErrorCode::TRANSIENT_ERROR, make_string("Failed to decode request at %s: %s",
+                                                                 _serverIdent.c_str(), e.what())));
+        return;
+    }
     IProtocol * protocol = _net->getOwner().getProtocol(params->getProtocol());
     if (protocol == nullptr) {
         replyError(req, params->getVersion(), params->getTraceLevel(),
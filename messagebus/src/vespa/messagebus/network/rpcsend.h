@@ -19,6 +19,7 @@ class Error;
 class Route;
 class Message;
 class RPCServiceAddress;
+class RPCTarget;
 class IProtocol;
 
 class PayLoadFiller
@@ -55,13 +56,14 @@ protected:
     string _serverIdent;
 
     virtual void build(FRT_ReflectionBuilder & builder) = 0;
-    virtual std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
-                                               Error & error, vespalib::TraceNode & rootTrace) const = 0;
+    virtual std::unique_ptr<Reply> createReply(const FRT_Values & response, RPCTarget & target,
+                                               const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const = 0;
     virtual void encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
-                               const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                               RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                                const PayLoadFiller &filler, duration timeRemaining) const = 0;
     virtual const char * getReturnSpec() const = 0;
-    virtual void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const = 0;
+    virtual void createResponse(FRT_Values & ret, const FRT_Values & args, const string & version,
+                                    Reply & reply, Blob payload) const = 0;
     virtual std::unique_ptr<Params> toParams(const FRT_Values &param) const = 0;
 
     void send(RoutingNode &recipient, const vespalib::Version &version,
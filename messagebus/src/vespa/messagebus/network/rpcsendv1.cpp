@@ -57,7 +57,7 @@ RPCSendV1::build(FRT_ReflectionBuilder & builder)
 
 void
 RPCSendV1::encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
-                         const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                         RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                          const PayLoadFiller &filler, duration timeRemaining) const
 {
 
@@ -115,7 +115,7 @@ RPCSendV1::toParams(const FRT_Values &args) const
 
 
 std::unique_ptr<Reply>
-RPCSendV1::createReply(const FRT_Values & ret, const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const
+RPCSendV1::createReply(const FRT_Values & ret, RPCTarget &, const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const
 {
     vespalib::Version version          = vespalib::Version(ret[0]._string._str);
     double            retryDelay       = ret[1]._double;
@@ -146,7 +146,7 @@ RPCSendV1::createReply(const FRT_Values & ret, const string & serviceName, Error
 }
 
 void
-RPCSendV1::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const {
+RPCSendV1::createResponse(FRT_Values & ret, const FRT_Values &, const string & version, Reply & reply, Blob payload) const {
     ret.AddString(version.c_str());
     ret.AddDouble(reply.getRetryDelay());
 
@@ -13,12 +13,13 @@ private:
     const char * getReturnSpec() const override;
     std::unique_ptr<Params> toParams(const FRT_Values &param) const override;
     void encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
-                       const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                       RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                        const PayLoadFiller &filler, duration timeRemaining) const override;
 
-    std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
-                                       Error & error, vespalib::TraceNode & rootTrace) const override;
-    void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const override;
+    std::unique_ptr<Reply> createReply(const FRT_Values & response, RPCTarget & target,
+                                       const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const override;
+    void createResponse(FRT_Values & ret, const FRT_Values & args, const string & version,
+                            Reply & reply, Blob payload) const override;
 };
 
 } // namespace mbus
@@ -3,6 +3,7 @@
 #include "rpcsendv2.h"
 #include "rpcnetwork.h"
 #include "rpcserviceaddress.h"
+#include "rpctarget.h"
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/messagebus/tracelevel.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -13,8 +14,7 @@
 
 using vespalib::make_string;
 using vespalib::compression::CompressionConfig;
-using vespalib::compression::decompress;
-using vespalib::compression::compress;
+using vespalib::compression::ZStdDictionary;
 using vespalib::DataBuffer;
 using vespalib::ConstBufferRef;
 using vespalib::stringref;
@@ -49,6 +49,13 @@ Memory SERVICE_F("service");
 
 }
 
+RPCSendV2::RPCSendV2()
+    : RPCSend(),
+      _compression(std::make_unique<RPCCompression>())
+{ }
+
+RPCSendV2::~RPCSendV2() = default;
+
 bool RPCSendV2::isCompatible(stringref method, stringref request, stringref response)
 {
     return  (method == METHOD_NAME) &&
@@ -61,16 +68,16 @@ RPCSendV2::build(FRT_ReflectionBuilder & builder)
 {
     builder.DefineMethod(METHOD_NAME, METHOD_PARAMS, METHOD_RETURN, FRT_METHOD(RPCSendV2::invoke), this);
     builder.MethodDesc("Send a message bus slime request and get a reply back.");
-    builder.ParamDesc("header_encoding", "0=raw, 6=lz4");
-    builder.ParamDesc("header_decoded_size", "Uncompressed header blob size");
-    builder.ParamDesc("header_payload", "The message header blob in slime");
-    builder.ParamDesc("body_encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("header_encoding", "0=raw, 7=body is compressed with the dictionary in the header");
+    builder.ParamDesc("header_decoded_size", "Id of the zstd dictionary used for the body");
+    builder.ParamDesc("header_payload", "The zstd dictionary content, empty once the recipient holds it");
+    builder.ParamDesc("body_encoding", "0=raw, 6=lz4, 7=zstd");
     builder.ParamDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ParamDesc("body_payload", "The message body blob in slime");
-    builder.ReturnDesc("header_encoding",  "0=raw, 6=lz4");
-    builder.ReturnDesc("header_decoded_size", "Uncompressed header blob size");
-    builder.ReturnDesc("header_payload", "The reply header blob in slime.");
-    builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("header_encoding",  "0=raw, 7=zstd dictionaries are accepted");
+    builder.ReturnDesc("header_decoded_size", "Id of the zstd dictionary now held by the recipient if 7, rejected by it if 0");
+    builder.ReturnDesc("header_payload", "Unused.");
+    builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4, 7=zstd");
     builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ReturnDesc("body_payload", "The reply body blob in slime.");
 }
@@ -100,15 +107,11 @@ private:
 
 void
 RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Route & route,
-                         const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                         RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                          const PayLoadFiller &filler, duration timeRemaining) const
 {
     FRT_Values &args = *req.GetParams();
     req.SetMethodName(METHOD_NAME);
-    // Place holder for auxillary data to be transfered later.
-    args.AddInt8(CompressionConfig::NONE);
-    args.AddInt32(0);
-    args.AddData("", 0);
 
     Slime slime;
     Cursor & root = slime.setObject();
@@ -126,8 +129,33 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
     OutputBuf rBuf(8192);
     BinaryFormat::encode(slime, rBuf);
     ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
+
+    CompressionConfig config = _net->getCompressionConfig();
+    RPCTarget & target = address.getTarget();
+    ZStdDictionary::SP dictionary;
+    if (config.type == CompressionConfig::ZSTD) {
+        dictionary = _compression->getDictionary(msg.getProtocol(), msg.getType(), toCompress, _net->getExecutor());
+        if (dictionary && ! target.acceptsDictionary(dictionary->id())) {
+            dictionary.reset();
+        }
+    }
+    // The header carries the dictionary used for the body, and its content until the recipient has it.
+    if (dictionary) {
+        args.AddInt8(CompressionConfig::ZSTD);
+        args.AddInt32(dictionary->id());
+        if (target.hasDictionary(dictionary->id())) {
+            args.AddData("", 0);
+        } else {
+            args.AddData(dictionary->content().c_str(), dictionary->content().size());
+        }
+    } else {
+        args.AddInt8(CompressionConfig::NONE);
+        args.AddInt32(0);
+        args.AddData("", 0);
+    }
+
     DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    CompressionConfig::Type type = _compression->compress(config, dictionary.get(), toCompress, buf);
 
     args.AddInt8(type);
     args.AddInt32(toCompress.size());
@@ -141,14 +169,18 @@ namespace {
 class ParamsV2 : public RPCSend::Params
 {
 public:
-    ParamsV2(const FRT_Values &arg)
+    ParamsV2(const FRT_Values &arg, RPCCompression & compression)
         : _slime()
     {
+        ZStdDictionary::SP dictionary;
+        if ((arg[0]._intval8 == CompressionConfig::ZSTD) && (arg[2]._data._len > 0)) {
+            dictionary = compression.addDictionary(ConstBufferRef(arg[2]._data._buf, arg[2]._data._len));
+        }
         uint8_t encoding = arg[3]._intval8;
         uint32_t uncompressedSize = arg[4]._intval32;
         DataBuffer uncompressed(arg[5]._data._buf, arg[5]._data._len);
         ConstBufferRef blob(arg[5]._data._buf, arg[5]._data._len);
-        decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
+        compression.decompress(CompressionConfig::toType(encoding), uncompressedSize, dictionary.get(), blob, uncompressed);
         assert(uncompressedSize == uncompressed.getDataLen());
         BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), _slime);
     }
@@ -183,18 +215,25 @@ private:
 std::unique_ptr<RPCSend::Params>
 RPCSendV2::toParams(const FRT_Values &args) const
 {
-    return std::make_unique<ParamsV2>(args);
+    return std::make_unique<ParamsV2>(args, *_compression);
 }
 
 std::unique_ptr<Reply>
-RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
+RPCSendV2::createReply(const FRT_Values & ret, RPCTarget & target, const string & serviceName,
                        Error & error, vespalib::TraceNode & rootTrace) const
 {
+    if (ret[0]._intval8 == CompressionConfig::ZSTD) {
+        target.dictionaryAcknowledged(true, ret[1]._intval32);
+    } else if (ret[1]._intval32 != 0) {
+        target.dictionaryRejected(ret[1]._intval32);
+    } else {
+        target.dictionaryAcknowledged(false, 0);
+    }
     uint8_t encoding = ret[3]._intval8;
     uint32_t uncompressedSize = ret[4]._intval32;
     DataBuffer uncompressed(ret[5]._data._buf, ret[5]._data._len);
     ConstBufferRef blob(ret[5]._data._buf, ret[5]._data._len);
-    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
+    _compression->decompress(CompressionConfig::toType(encoding), uncompressedSize, nullptr, blob, uncompressed);
     assert(uncompressedSize == uncompressed.getDataLen());
     Slime slime;
     BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
@@ -222,11 +261,23 @@ RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
 }
 
 void
-RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const
+RPCSendV2::createResponse(FRT_Values & ret, const FRT_Values & args, const string & version,
+                          Reply & reply, Blob payload) const
 {
-    // Place holder for auxillary data to be transfered later.
-    ret.AddInt8(CompressionConfig::NONE);
-    ret.AddInt32(0);
+    // A reply to a request compressed with a dictionary we hold is compressed with the same dictionary.
+    uint32_t requestDictionary = (args[0]._intval8 == CompressionConfig::ZSTD) ? args[1]._intval32 : 0;
+    ZStdDictionary::SP dictionary;
+    if (requestDictionary != 0) {
+        dictionary = _compression->findDictionary(requestDictionary);
+    }
+    if ((requestDictionary != 0) && ! dictionary) {
+        // The dictionary has been evicted, or could not be registered, so the sender must stop offering it.
+        ret.AddInt8(CompressionConfig::NONE);
+        ret.AddInt32(requestDictionary);
+    } else {
+        ret.AddInt8(CompressionConfig::ZSTD);
+        ret.AddInt32(dictionary ? dictionary->id() : 0);
+    }
     ret.AddData("", 0);
 
     Slime slime;
@@ -254,7 +305,7 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
     BinaryFormat::encode(slime, rBuf);
     ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
     DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    CompressionConfig::Type type = _compression->compress(_net->getCompressionConfig(), dictionary.get(), toCompress, buf);
 
     ret.AddInt8(type);
     ret.AddInt32(toCompress.size());
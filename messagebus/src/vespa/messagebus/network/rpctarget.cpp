@@ -12,7 +12,10 @@ RPCTarget::RPCTarget(const string &spec, FRT_Supervisor &orb) :
     _target(*_orb.GetTarget(spec.c_str())),
     _state(VERSION_NOT_RESOLVED),
     _version(),
-    _versionHandlers()
+    _versionHandlers(),
+    _peerDictionaries(false),
+    _peerDictionaryIds(),
+    _rejectedDictionaryIds()
 {
     // empty
 }
@@ -64,6 +67,37 @@ RPCTarget::isValid() const
     return false;
 }
 
+bool
+RPCTarget::acceptsDictionary(uint32_t id) const
+{
+    vespalib::MonitorGuard guard(_lock);
+    return _peerDictionaries && (_rejectedDictionaryIds.find(id) == _rejectedDictionaryIds.end());
+}
+
+bool
+RPCTarget::hasDictionary(uint32_t id) const
+{
+    vespalib::MonitorGuard guard(_lock);
+    return _peerDictionaryIds.find(id) != _peerDictionaryIds.end();
+}
+
+void
+RPCTarget::dictionaryAcknowledged(bool supported, uint32_t id)
+{
+    vespalib::MonitorGuard guard(_lock);
+    _peerDictionaries = supported;
+    if (supported && (id != 0)) {
+        _peerDictionaryIds.insert(id);
+    }
+}
+
+void
+RPCTarget::dictionaryRejected(uint32_t id)
+{
+    vespalib::MonitorGuard guard(_lock);
+    _rejectedDictionaryIds.insert(id);
+}
+
 void
 RPCTarget::RequestDone(FRT_RPCRequest *req)
 {
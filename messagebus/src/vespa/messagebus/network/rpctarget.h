@@ -6,6 +6,7 @@
 #include <vespa/fnet/frt/target.h>
 #include <vespa/vespalib/component/version.h>
 #include <vespa/vespalib/util/sync.h>
+#include <set>
 
 namespace mbus {
 
@@ -57,6 +58,9 @@ private:
     ResolveState      _state;
     Version_UP        _version;
     HandlerList       _versionHandlers;
+    bool              _peerDictionaries;
+    std::set<uint32_t> _peerDictionaryIds;
+    std::set<uint32_t> _rejectedDictionaryIds;
 
 public:
     /**
@@ -112,6 +116,35 @@ public:
      */
     const vespalib::Version &getVersion() const { return *_version; }
 
+    /**
+     * Returns whether the peer at the other end of this target has told us
+     * that it accepts payloads compressed with a dictionary, and has not
+     * rejected the dictionary with the given id.
+     */
+    bool acceptsDictionary(uint32_t id) const;
+
+    /**
+     * Returns whether the peer has acknowledged that it holds the
+     * dictionary with the given id, so that its content need not be sent.
+     */
+    bool hasDictionary(uint32_t id) const;
+
+    /**
+     * Records what a reply told us about the dictionary support of the
+     * peer. A dictionary id of 0 acknowledges nothing. Since a target never
+     * outlives its connection, this knowledge is per connection.
+     *
+     * @param supported Whether the peer accepts dictionary compression.
+     * @param id        The id of a dictionary the peer now holds, or 0.
+     */
+    void dictionaryAcknowledged(bool supported, uint32_t id);
+
+    /**
+     * Records that the peer could not register, or has evicted, the
+     * dictionary with the given id, so that it is no longer offered to it.
+     */
+    void dictionaryRejected(uint32_t id);
+
     // Implements FRT_IRequestWait.
     void RequestDone(FRT_RPCRequest *req) override;
 };
@@ -12,4 +12,10 @@ SteadyTimer::getMilliTime() const
     return vespalib::count_ms(steady_clock::now().time_since_epoch());
 }
 
+uint64_t
+SteadyTimer::getMicroTime() const
+{
+    return vespalib::count_us(steady_clock::now().time_since_epoch());
+}
+
 } // namespace mbus
@@ -14,6 +14,7 @@ class SteadyTimer : public ITimer {
 public:
     //TODO Return chrono::duration
     uint64_t getMilliTime() const override;
+    uint64_t getMicroTime() const override;
 };
 
 } // namespace mbus
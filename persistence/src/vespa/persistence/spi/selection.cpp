@@ -9,7 +9,8 @@ Selection::Selection(const DocumentSelection& docSel)
     : _documentSelection(docSel),
       _fromTimestamp(0),
       _toTimestamp(INT64_MAX),
-      _timestampSubset()
+      _timestampSubset(),
+      _requiredTermHashes()
 { }
 
 Selection::~Selection() { }
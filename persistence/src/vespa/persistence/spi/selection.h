@@ -20,11 +20,13 @@ class MetaData {
 class Selection {
 public:
     typedef std::vector<Timestamp> TimestampSubset;
+    typedef std::vector<uint64_t> TermHashes;
 private:
     DocumentSelection _documentSelection;
     Timestamp         _fromTimestamp;
     Timestamp         _toTimestamp;
     TimestampSubset   _timestampSubset;
+    TermHashes        _requiredTermHashes;
 
 public:
     Selection(const DocumentSelection& docSel);
@@ -65,6 +67,20 @@ public:
         return _timestampSubset;
     }
 
+    /**
+     * Hint that only documents containing all the given words, hashed by
+     * search::streaming::TermSummary, are of interest to the caller. A
+     * provider may skip documents it knows do not contain all the words,
+     * but is free to ignore the hint. The documents returned must still be
+     * matched by the caller.
+     */
+    void setRequiredTermHashes(const TermHashes& requiredTermHashes) {
+        _requiredTermHashes = requiredTermHashes;
+    }
+    const TermHashes& getRequiredTermHashes() const {
+        return _requiredTermHashes;
+    }
+
     Timestamp getFromTimestamp() const { return _fromTimestamp; }
     Timestamp getToTimestamp() const { return _toTimestamp; }
 
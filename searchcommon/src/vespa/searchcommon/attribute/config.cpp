@@ -14,6 +14,7 @@ Config::Config() :
     _isFilter(false),
     _fastAccess(false),
     _mutable(false),
+    _loadMapped(false),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
@@ -31,6 +32,7 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_, bool huge_)
       _isFilter(false),
       _fastAccess(false),
       _mutable(false),
+      _loadMapped(false),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
@@ -56,6 +58,7 @@ Config::operator==(const Config &b) const
            _isFilter == b._isFilter &&
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
+           _loadMapped == b._loadMapped &&
            _growStrategy == b._growStrategy &&
            _compactionStrategy == b._compactionStrategy &&
            _predicateParams == b._predicateParams &&
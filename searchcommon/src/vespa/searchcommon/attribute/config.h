@@ -51,6 +51,13 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if the saved attribute data should be memory mapped as
+     * initial backing store when loading, instead of being read and
+     * copied. Only used by single value numeric attributes.
+     */
+    bool loadMapped() const { return _loadMapped; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     Config & setHuge(bool v)                         { _huge = v; return *this;}
@@ -88,6 +95,7 @@ public:
 
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
+    Config & setLoadMapped(bool v) { _loadMapped = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -103,6 +111,7 @@ private:
     bool           _isFilter;
     bool           _fastAccess;
     bool           _mutable;
+    bool           _loadMapped;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
@@ -16,7 +16,11 @@ Status::Status()
       _lastSyncToken        (0),
       _updates              (0),
       _nonIdempotentUpdates (0),
-      _bitVectors(0)
+      _bitVectors(0),
+      _compactionSteps      (0),
+      _compactionBytesMoved (0),
+      _compactionStallTimeUs(0),
+      _compactionProgress   (1.0)
 {
 }
 
@@ -43,4 +47,14 @@ Status::updateStatistics(uint64_t numValues, uint64_t numUniqueValue, uint64_t a
     _onHoldMax       = std::max(_onHoldMax, onHold);
 }
 
+void
+Status::updateCompactionStatistics(uint64_t steps, uint64_t bytesMoved,
+                                   uint64_t stallTimeUs, double progress)
+{
+    _compactionSteps       = steps;
+    _compactionBytesMoved  = bytesMoved;
+    _compactionStallTimeUs = stallTimeUs;
+    _compactionProgress    = progress;
+}
+
 }
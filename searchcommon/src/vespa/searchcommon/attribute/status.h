@@ -13,6 +13,8 @@ public:
 
     void updateStatistics(uint64_t numValues, uint64_t numUniqueValue, uint64_t allocated,
                           uint64_t used, uint64_t dead, uint64_t onHold);
+    void updateCompactionStatistics(uint64_t steps, uint64_t bytesMoved,
+                                    uint64_t stallTimeUs, double progress);
 
     uint64_t getNumDocs()                  const { return _numDocs; }
     uint64_t getNumValues()                const { return _numValues; }
@@ -26,6 +28,10 @@ public:
     uint64_t getUpdateCount()              const { return _updates; }
     uint64_t getNonIdempotentUpdateCount() const { return _nonIdempotentUpdates; }
     uint32_t getBitVectors() const { return _bitVectors; }
+    uint64_t getCompactionSteps()          const { return _compactionSteps; }
+    uint64_t getCompactionBytesMoved()     const { return _compactionBytesMoved; }
+    uint64_t getCompactionStallTimeUs()    const { return _compactionStallTimeUs; }
+    double   getCompactionProgress()       const { return _compactionProgress; }
 
     void setNumDocs(uint64_t v)                  { _numDocs = v; }
     void incNumDocs()                            { ++_numDocs; }
@@ -51,6 +57,10 @@ private:
     uint64_t _updates;
     uint64_t _nonIdempotentUpdates;
     uint32_t _bitVectors;
+    uint64_t _compactionSteps;
+    uint64_t _compactionBytesMoved;
+    uint64_t _compactionStallTimeUs;
+    double   _compactionProgress;
 };
 
 }
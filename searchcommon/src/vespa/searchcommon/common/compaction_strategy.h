@@ -14,22 +14,30 @@ class CompactionStrategy
 private:
     double _maxDeadBytesRatio; // Max ratio of dead bytes before compaction
     double _maxDeadAddressSpaceRatio; // Max ratio of dead address space before compaction
+    uint32_t _maxDocsPerCompactionStep; // Max docs visited per compaction step (0 means unbounded)
 public:
+    static constexpr uint32_t DEFAULT_MAX_DOCS_PER_COMPACTION_STEP = 0x10000u;
+
     CompactionStrategy()
         : _maxDeadBytesRatio(0.2),
-          _maxDeadAddressSpaceRatio(0.2)
+          _maxDeadAddressSpaceRatio(0.2),
+          _maxDocsPerCompactionStep(DEFAULT_MAX_DOCS_PER_COMPACTION_STEP)
     {
     }
-    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio)
+    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio,
+                       uint32_t maxDocsPerCompactionStep = DEFAULT_MAX_DOCS_PER_COMPACTION_STEP)
         : _maxDeadBytesRatio(maxDeadBytesRatio),
-          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio)
+          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
+          _maxDocsPerCompactionStep(maxDocsPerCompactionStep)
     {
     }
     double getMaxDeadBytesRatio() const { return _maxDeadBytesRatio; }
     double getMaxDeadAddressSpaceRatio() const { return _maxDeadAddressSpaceRatio; }
+    uint32_t getMaxDocsPerCompactionStep() const { return _maxDocsPerCompactionStep; }
     bool operator==(const CompactionStrategy & rhs) const {
         return _maxDeadBytesRatio == rhs._maxDeadBytesRatio &&
-            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio;
+            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio &&
+            _maxDocsPerCompactionStep == rhs._maxDocsPerCompactionStep;
     }
     bool operator!=(const CompactionStrategy & rhs) const { return !(operator==(rhs)); }
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/growstrategy.h>
 #include <cstdint>
 
@@ -14,6 +15,7 @@ private:
     float    _docsGrowFactor;
     uint32_t _docsGrowDelta;
     float    _multiValueAllocGrowFactor;
+    vespalib::alloc::HugePagePolicy _hugePagePolicy;
 public:
     GrowStrategy()
         : GrowStrategy(1024, 0.5, 0, 0.2)
@@ -23,7 +25,8 @@ public:
         : _docsInitialCapacity(docsInitialCapacity),
           _docsGrowFactor(docsGrowPercent),
           _docsGrowDelta(docsGrowDelta),
-          _multiValueAllocGrowFactor(multiValueAllocGrowFactor)
+          _multiValueAllocGrowFactor(multiValueAllocGrowFactor),
+          _hugePagePolicy(vespalib::alloc::HugePagePolicy::DEFAULT)
     {
     }
 
@@ -36,18 +39,29 @@ public:
     float            getDocsGrowFactor() const { return _docsGrowFactor; }
     uint32_t          getDocsGrowDelta() const { return _docsGrowDelta; }
     float getMultiValueAllocGrowFactor() const { return _multiValueAllocGrowFactor; }
+    vespalib::alloc::HugePagePolicy getHugePagePolicy() const { return _hugePagePolicy; }
     void    setDocsInitialCapacity(uint32_t v) { _docsInitialCapacity = v; }
     void          setDocsGrowDelta(uint32_t v) { _docsGrowDelta = v; }
+    void setHugePagePolicy(vespalib::alloc::HugePagePolicy v) { _hugePagePolicy = v; }
 
     vespalib::GrowStrategy to_generic_strategy() const {
         return vespalib::GrowStrategy(_docsInitialCapacity, _docsGrowFactor, _docsGrowDelta);
     }
 
+    /**
+     * Returns an empty allocation to seed per document vectors with, so
+     * that they are backed by huge pages when requested.
+     */
+    vespalib::alloc::Alloc initialDocsAlloc() const {
+        return vespalib::alloc::Alloc::alloc(0, vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE, 0, _hugePagePolicy);
+    }
+
     bool operator==(const GrowStrategy & rhs) const {
         return _docsInitialCapacity == rhs._docsInitialCapacity &&
             _docsGrowFactor == rhs._docsGrowFactor &&
             _docsGrowDelta == rhs._docsGrowDelta &&
-            _multiValueAllocGrowFactor == rhs._multiValueAllocGrowFactor;
+            _multiValueAllocGrowFactor == rhs._multiValueAllocGrowFactor &&
+            _hugePagePolicy == rhs._hugePagePolicy;
     }
     bool operator!=(const GrowStrategy & rhs) const {
         return !(operator==(rhs));
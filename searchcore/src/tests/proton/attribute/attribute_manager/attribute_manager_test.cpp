@@ -234,6 +234,7 @@ struct ParallelAttributeManager
     std::shared_ptr<AttributeManager::SP> mgr;
     vespalib::ThreadStackExecutor masterExecutor;
     ExecutorThreadService master;
+    vespalib::ThreadStackExecutor sharedExecutor;
     AttributeManagerInitializer::SP initializer;
 
     ParallelAttributeManager(search::SerialNum configSerialNum, AttributeManager::SP baseAttrMgr,
@@ -252,10 +253,11 @@ ParallelAttributeManager::ParallelAttributeManager(search::SerialNum configSeria
       mgr(std::make_shared<AttributeManager::SP>()),
       masterExecutor(1, 128 * 1024),
       master(masterExecutor),
+      sharedExecutor(2, 128 * 1024),
       initializer(std::make_shared<AttributeManagerInitializer>(configSerialNum, documentMetaStoreInitTask,
                                                                 documentMetaStore, baseAttrMgr, attrCfg,
                                                                 attributeGrow, attributeGrowNumDocs,
-                                                                fastAccessAttributesOnly, master, mgr))
+                                                                fastAccessAttributesOnly, master, sharedExecutor, mgr))
 {
     documentMetaStore->setCommittedDocIdLimit(docIdLimit);
     vespalib::ThreadStackExecutor executor(3, 128 * 1024);
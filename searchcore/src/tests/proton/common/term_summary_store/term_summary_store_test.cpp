@@ -0,0 +1,124 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/base/field.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/searchcore/proton/common/term_summary_store.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using document::DataType;
+using document::Document;
+using document::DocumentId;
+using document::DocumentType;
+using document::Field;
+using document::StringFieldValue;
+using proton::TermSummaryStore;
+using search::streaming::TermSummary;
+
+using LidVector = TermSummaryStore::LidVector;
+using TermHashes = TermSummaryStore::TermHashes;
+
+namespace {
+
+uint64_t
+hash(const vespalib::string &term)
+{
+    uint64_t result(0);
+    ASSERT_TRUE(TermSummary::hashTerm(term, result));
+    return result;
+}
+
+}
+
+struct Fixture
+{
+    DocumentType     _docType;
+    TermSummaryStore _store;
+
+    Fixture()
+        : _docType("test"),
+          _store(64)
+    {
+        _docType.addField(Field("title", 1, *DataType::STRING, true));
+        _docType.addField(Field("body", 2, *DataType::STRING, true));
+    }
+    ~Fixture();
+
+    void put(uint32_t lid, const vespalib::string &title, const vespalib::string &body) {
+        Document doc(_docType, DocumentId(vespalib::make_string("id:test:test::%u", lid)));
+        doc.setValue("title", StringFieldValue(title));
+        doc.setValue("body", StringFieldValue(body));
+        _store.put(lid, doc);
+    }
+    LidVector filter(const LidVector &lids, const TermHashes &termHashes) const {
+        LidVector result(lids);
+        _store.filterLids(result, termHashes);
+        return result;
+    }
+};
+
+Fixture::~Fixture() = default;
+
+TEST_F("require that documents without all required terms are filtered away", Fixture)
+{
+    f.put(1, "The quick brown fox", "jumps over");
+    f.put(2, "the lazy dog", "sleeps");
+    EXPECT_EQUAL(LidVector({1, 2}), f.filter({1, 2}, {hash("the")}));
+    EXPECT_EQUAL(LidVector({1}), f.filter({1, 2}, {hash("fox")}));
+    EXPECT_EQUAL(LidVector({1}), f.filter({1, 2}, {hash("fox"), hash("jumps")}));
+    EXPECT_EQUAL(LidVector({2}), f.filter({1, 2}, {hash("dog"), hash("sleeps")}));
+    EXPECT_EQUAL(LidVector(), f.filter({1, 2}, {hash("fox"), hash("dog")}));
+}
+
+TEST_F("require that all lids are kept when there are no required terms", Fixture)
+{
+    f.put(1, "the quick brown fox", "");
+    EXPECT_EQUAL(LidVector({1, 2}), f.filter({1, 2}, {}));
+}
+
+TEST_F("require that documents without summary are never filtered away", Fixture)
+{
+    f.put(3, "the quick brown fox", "");
+    EXPECT_EQUAL(LidVector({1, 3, 100}), f.filter({1, 3, 100}, {hash("fox")}));
+    EXPECT_EQUAL(LidVector({1, 100}), f.filter({1, 3, 100}, {hash("dog")}));
+}
+
+TEST_F("require that removed summary is never filtered away", Fixture)
+{
+    f.put(1, "the quick brown fox", "");
+    EXPECT_EQUAL(LidVector(), f.filter({1}, {hash("dog")}));
+    f._store.remove(1);
+    EXPECT_EQUAL(LidVector({1}), f.filter({1}, {hash("dog")}));
+    f._store.remove(200);
+    EXPECT_EQUAL(LidVector({200}), f.filter({200}, {hash("dog")}));
+}
+
+TEST_F("require that put replaces previous summary", Fixture)
+{
+    f.put(1, "the quick brown fox", "");
+    f.put(1, "the lazy dog", "");
+    EXPECT_EQUAL(LidVector(), f.filter({1}, {hash("fox")}));
+    EXPECT_EQUAL(LidVector({1}), f.filter({1}, {hash("dog")}));
+}
+
+TEST_F("require that memory usage is tracked", Fixture)
+{
+    vespalib::MemoryUsage before = f._store.getMemoryUsage();
+    for (uint32_t lid = 1; lid < 1000; ++lid) {
+        f.put(lid, "the quick brown fox", vespalib::make_string("word%u", lid));
+    }
+    vespalib::MemoryUsage after = f._store.getMemoryUsage();
+    EXPECT_GREATER(after.allocatedBytes(), before.allocatedBytes());
+    EXPECT_GREATER(after.usedBytes(), before.usedBytes());
+    for (uint32_t lid = 1; lid < 1000; ++lid) {
+        f._store.remove(lid);
+    }
+    EXPECT_LESS(f._store.getMemoryUsage().usedBytes() - f._store.getMemoryUsage().deadBytes(),
+                after.usedBytes() - after.deadBytes());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/docsummary/docsumcontext.h>
 #include <vespa/searchcore/proton/docsummary/documentstoreadapter.h>
+#include <vespa/searchcore/proton/docsummary/summary_column_store.h>
 #include <vespa/searchcore/proton/docsummary/summarymanager.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/feedoperation/putoperation.h>
@@ -22,12 +23,15 @@
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/server/searchview.h>
 #include <vespa/searchcore/proton/server/summaryadapter.h>
+#include <vespa/searchcore/proton/test/dummy_document_store.h>
 #include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/searchlib/engine/docsumapi.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/tensor/tensor_attribute.h>
+#include <vespa/searchsummary/docsummary/summaryfieldconverter.h>
 #include <vespa/searchlib/transactionlog/nosyncproxy.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -300,11 +304,15 @@ private:
     bool assertSlime(const std::string &exp, const DocsumReply &reply, uint32_t id,bool relaxed = false);
 
     void requireThatAdapterHandlesAllFieldTypes();
+    void requireThatPlainFieldsAreWrittenAsConvertedFields();
     void requireThatAdapterHandlesMultipleDocuments();
+    void requireThatAdapterHandlesPrefetchedDocuments();
+    void requireThatAdapterReadsSummaryColumns();
     void requireThatAdapterHandlesDocumentIdField();
     void requireThatDocsumRequestIsProcessed();
     void requireThatRewritersAreUsed();
     void requireThatAttributesAreUsed();
+    void requireThatAttributeOnlySummaryDoesNotUseDocumentStore();
     void requireThatSummaryAdapterHandlesPutAndRemove();
     void requireThatAnnotationsAreUsed();
     void requireThatUrisAreUsed();
@@ -472,6 +480,125 @@ Test::requireThatAdapterHandlesAllFieldTypes()
 }
 
 
+/**
+ * Check that a docsum entry holds what the summary field converter
+ * output would have been packed as.
+ **/
+void
+assertEntryMatchesConverted(const FieldValue &converted, const ResEntry &entry)
+{
+    switch (entry._type) {
+    case RES_BYTE:
+    case RES_BOOL:
+        EXPECT_EQUAL(uint32_t(uint8_t(converted.getAsInt())), entry._intval);
+        break;
+    case RES_SHORT:
+        EXPECT_EQUAL(uint32_t(uint16_t(converted.getAsInt())), entry._intval);
+        break;
+    case RES_INT:
+        EXPECT_EQUAL(uint32_t(converted.getAsInt()), entry._intval);
+        break;
+    case RES_INT64:
+        EXPECT_EQUAL(uint64_t(converted.getAsLong()), entry._int64val);
+        break;
+    case RES_FLOAT:
+        EXPECT_EQUAL(double(converted.getAsFloat()), entry._doubleval);
+        break;
+    case RES_DOUBLE:
+        EXPECT_EQUAL(converted.getAsDouble(), entry._doubleval);
+        break;
+    case RES_STRING:
+    case RES_LONG_STRING:
+    case RES_XMLSTRING:
+    case RES_JSONSTRING:
+    {
+        vespalib::string exp = converted.getClass().inherits(LiteralFieldValueB::classId)
+                               ? vespalib::string(static_cast<const LiteralFieldValueB &>(converted).getValueRef())
+                               : converted.getAsString();
+        EXPECT_EQUAL(exp, vespalib::string(entry._stringval, entry._stringlen));
+        break;
+    }
+    case RES_DATA:
+    case RES_LONG_DATA:
+    {
+        std::pair<const char *, size_t> raw = converted.getAsRaw();
+        EXPECT_EQUAL(vespalib::string(raw.first, raw.second), vespalib::string(entry._dataval, entry._datalen));
+        break;
+    }
+    default:
+        TEST_ERROR("Unexpected docsum field type");
+    }
+}
+
+void
+Test::requireThatPlainFieldsAreWrittenAsConvertedFields()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT8));
+    s.addSummaryField(Schema::SummaryField("b", schema::DataType::INT16));
+    s.addSummaryField(Schema::SummaryField("c", schema::DataType::INT32));
+    s.addSummaryField(Schema::SummaryField("d", schema::DataType::INT64));
+    s.addSummaryField(Schema::SummaryField("e", schema::DataType::FLOAT));
+    s.addSummaryField(Schema::SummaryField("f", schema::DataType::DOUBLE));
+    s.addIndexField(Schema::IndexField("g", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("g", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("h", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("i", schema::DataType::RAW));
+    s.addSummaryField(Schema::SummaryField("j", schema::DataType::RAW));
+    s.addIndexField(Schema::IndexField("dynamicstring", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("dynamicstring", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("araw", schema::DataType::RAW, CollectionType::ARRAY));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0");
+    bc._bld.startSummaryField("a").addInt(-3).endField();
+    bc._bld.startSummaryField("b").addInt(-32768).endField();
+    bc._bld.startSummaryField("c").addInt(-7).endField();
+    bc._bld.startSummaryField("d").addInt(-2147483649L).endField();
+    bc._bld.startSummaryField("e").addFloat(1234.56).endField();
+    bc._bld.startSummaryField("f").addFloat(9876.54).endField();
+    bc._bld.startIndexField("g").addStr("foo").addStr("bar").addTermAnnotation("baz").endField();
+    bc._bld.startSummaryField("h").addStr("<bar>").endField();
+    bc._bld.startSummaryField("i").addStr("baz").endField();
+    bc._bld.startSummaryField("j").addRaw("q\0ux", 4).endField();
+    bc._bld.startIndexField("dynamicstring").addStr("foo").addStr("bar").addTermAnnotation("baz").endField();
+    bc._bld.startSummaryField("araw").
+        startElement().addRaw("x", 1).endElement().
+        startElement().addRaw("yz", 2).endElement().
+        endField();
+    bc.endDocument(0);
+
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, getResultConfig(), "class0",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class0"),
+                             getMarkupFields());
+    GeneralResultPtr res = getResult(dsa, 0);
+    Document::UP doc = bc._str.read(0, *bc._repo);
+    ASSERT_TRUE(doc);
+    const ResultClass *resultClass = dsa.getResultClass();
+    vespalib::string checked;
+    for (size_t i = 0; i < resultClass->GetNumEntries(); ++i) {
+        vespalib::string fieldName(resultClass->GetEntry(i)->_bindname);
+        if (!doc->getType().hasField(fieldName)) {
+            continue;
+        }
+        FieldValue::UP value = doc->getValue(fieldName);
+        ASSERT_TRUE(value);
+        bool markup = getMarkupFields().find(fieldName) != getMarkupFields().end();
+        FieldValue::UP converted = SummaryFieldConverter::convertSummaryField(markup, *value);
+        ASSERT_TRUE(converted);
+        TEST_STATE(fieldName.c_str());
+        assertEntryMatchesConverted(*converted, *res->GetEntry(fieldName.c_str()));
+        checked += (checked.empty() ? "" : ",") + fieldName;
+    }
+    EXPECT_EQUAL("a,b,c,d,e,f,g,h,i,j,dynamicstring,araw", checked);
+    // The markup field and the array go through the converter, and differ from the plain string value
+    EXPECT_NOT_EQUAL(doc->getValue("dynamicstring")->getAsString(),
+                     vespalib::string(res->GetEntry("dynamicstring")->_stringval,
+                                      res->GetEntry("dynamicstring")->_stringlen));
+    EXPECT_EQUAL("foo bar", std::string(res->GetEntry("g")->_stringval, res->GetEntry("g")->_stringlen));
+}
+
+
 void
 Test::requireThatAdapterHandlesMultipleDocuments()
 {
@@ -514,6 +641,102 @@ Test::requireThatAdapterHandlesMultipleDocuments()
 }
 
 
+void
+Test::requireThatAdapterHandlesPrefetchedDocuments()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").
+        startSummaryField("a").
+        addInt(1000).
+        endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").
+        startSummaryField("a").
+        addInt(2000).endField();
+    bc.endDocument(1);
+
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class1"),
+                             getMarkupFields());
+    dsa.prefetch({1, 2, 0});
+    { // doc 1
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(2000u, res->GetEntry("a")->_intval);
+    }
+    { // doc 2 (not found when prefetching)
+        DocsumStoreValue docsum = dsa.getMappedDocsum(2);
+        EXPECT_TRUE(docsum.pt() == nullptr);
+    }
+    { // doc 0
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+    }
+    { // doc 0 (again, not prefetched)
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+    }
+}
+
+void
+Test::requireThatAdapterReadsSummaryColumns()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("aa", schema::DataType::INT32));
+    s.addSummaryField(Schema::SummaryField("ab", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").
+        startSummaryField("aa").addInt(1000).endField().
+        startSummaryField("ab").addInt(2000).endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").
+        startSummaryField("aa").addInt(1001).endField().
+        startSummaryField("ab").addInt(2001).endField();
+    bc.endDocument(1);
+
+    SummaryColumnStore columnStore(bc._summaryExecutor, "summary", {"aa", "ab"},
+                                   LogDocumentStore::Config(DocumentStore::Config(), LogDataStore::Config()),
+                                   GrowStrategy(), TuneFileSummary(), bc._fileHeaderContext, bc._noTlSyncer,
+                                   nullptr, 0u);
+    // Only doc 0 is present in the columns, with values differing from the full store
+    bc._bld.startDocument("id:ns:searchdocument::0").
+        startSummaryField("aa").addInt(3000).endField().
+        startSummaryField("ab").addInt(4000).endField();
+    columnStore.put(bc._serialNum, 0, *bc._bld.endDocument());
+
+    DocumentStoreAdapter::Columns columns;
+    for (const auto &column : columnStore.getColumns()) {
+        columns.push_back({column.fieldName, column.store.get()});
+    }
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, getResultConfig(), "class2",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class2"),
+                             getMarkupFields(), columns);
+    { // doc 0 (from columns)
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(3000u, res->GetEntry("aa")->_intval);
+        EXPECT_EQUAL(4000u, res->GetEntry("ab")->_intval);
+    }
+    { // doc 1 (missing in columns, from full store)
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(1001u, res->GetEntry("aa")->_intval);
+        EXPECT_EQUAL(2001u, res->GetEntry("ab")->_intval);
+    }
+    dsa.prefetch({1, 0});
+    { // doc 0 (prefetched from columns)
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(3000u, res->GetEntry("aa")->_intval);
+        EXPECT_EQUAL(4000u, res->GetEntry("ab")->_intval);
+    }
+    { // doc 1 (prefetched from full store)
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(1001u, res->GetEntry("aa")->_intval);
+        EXPECT_EQUAL(2001u, res->GetEntry("ab")->_intval);
+    }
+}
+
 void
 Test::requireThatAdapterHandlesDocumentIdField()
 {
@@ -814,6 +1037,98 @@ Test::requireThatAttributesAreUsed()
 }
 
 
+/**
+ * Document store counting the reads and bulk visits done through it.
+ **/
+struct CountingDocumentStore : public proton::test::DummyDocumentStore
+{
+    const IDocumentStore &_store;
+    mutable uint32_t      _reads;
+    mutable uint32_t      _visits;
+
+    CountingDocumentStore(const IDocumentStore &store)
+        : _store(store),
+          _reads(0),
+          _visits(0)
+    {}
+    Document::UP read(DocumentIdT lid, const DocumentTypeRepo &repo) const override {
+        ++_reads;
+        return _store.read(lid, repo);
+    }
+    void visit(const LidVector &lids, const DocumentTypeRepo &repo, IDocumentVisitor &visitor) const override {
+        ++_visits;
+        _store.visit(lids, repo, visitor);
+    }
+    uint32_t getDocIdLimit() const override { return _store.getDocIdLimit(); }
+};
+
+void
+Test::requireThatAttributeOnlySummaryDoesNotUseDocumentStore()
+{
+    Schema s;
+    addField(s, "ba", schema::DataType::INT32, CollectionType::SINGLE);
+    addField(s, "bb", schema::DataType::FLOAT, CollectionType::SINGLE);
+    addField(s, "bc", schema::DataType::STRING, CollectionType::SINGLE);
+    addField(s, "bd", schema::DataType::INT32, CollectionType::ARRAY);
+    addField(s, "be", schema::DataType::FLOAT, CollectionType::ARRAY);
+    addField(s, "bf", schema::DataType::STRING, CollectionType::ARRAY);
+    addField(s, "bg", schema::DataType::INT32, CollectionType::WEIGHTEDSET);
+    addField(s, "bh", schema::DataType::FLOAT, CollectionType::WEIGHTEDSET);
+    addField(s, "bi", schema::DataType::STRING, CollectionType::WEIGHTEDSET);
+    addField(s, "bj", schema::DataType::TENSOR, CollectionType::SINGLE);
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    DBContext dc(bc._repo, getDocTypeName());
+    dc.put(*bc._bld.startDocument("id:ns:searchdocument::1").
+           startSummaryField("a").addInt(5).endField().
+           startAttributeField("ba").addInt(10).endField().
+           endDocument(),
+           1);
+    dc.put(*bc._bld.startDocument("id:ns:searchdocument::2").
+           startSummaryField("a").addInt(6).endField().
+           startAttributeField("ba").addInt(20).endField().
+           endDocument(),
+           2);
+
+    auto searchView = std::dynamic_pointer_cast<SearchView>(dc._ddb->getReadySubDB()->getSearchView());
+    ASSERT_TRUE(searchView);
+    const ISummaryManager::ISummarySetup::SP &summarySetup = searchView->getSummarySetup();
+    CountingDocumentStore store(dc._ddb->getReadySubDB()->getSummaryManager()->getBackingStore());
+    matching::SessionManager sessionMgr(16);
+    auto getDocsums = [&](const vespalib::string &resultClassName) {
+        DocsumRequest req;
+        req.resultClassName = resultClassName;
+        req.hits.push_back(DocsumRequest::Hit(gid1));
+        req.hits.back().docid = 1;
+        req.hits.push_back(DocsumRequest::Hit(gid2));
+        req.hits.back().docid = 2;
+        DocumentStoreAdapter dsa(store, *bc._repo, summarySetup->getResultConfig(), resultClassName,
+                                 bc.createFieldCacheRepo(summarySetup->getResultConfig())->getFieldCache(resultClassName),
+                                 getMarkupFields());
+        auto mctx = searchView->getMatchView()->createContext();
+        DocsumContext ctx(req, summarySetup->getDocsumWriter(), dsa,
+                          searchView->getMatchView()->getMatcher(req.ranking),
+                          mctx->getSearchContext(), mctx->getAttributeContext(),
+                          *summarySetup->getAttributeManager(), sessionMgr);
+        return ctx.getDocsums();
+    };
+
+    DocsumReply::UP rep = getDocsums("class3");
+    ASSERT_EQUAL(2u, rep->docsums.size());
+    EXPECT_EQUAL(10L, getSlime(*rep, 0, false).get()["ba"].asLong());
+    EXPECT_EQUAL(20L, getSlime(*rep, 1, false).get()["ba"].asLong());
+    EXPECT_EQUAL(0u, store._reads);
+    EXPECT_EQUAL(0u, store._visits);
+
+    // A class reading from the document store goes through the counting store
+    rep = getDocsums("class1");
+    ASSERT_EQUAL(2u, rep->docsums.size());
+    EXPECT_TRUE(assertSlime("{a:5}", *rep, 0, false));
+    EXPECT_TRUE(assertSlime("{a:6}", *rep, 1, false));
+    EXPECT_EQUAL(1u, store._visits);
+}
+
 void
 Test::requireThatSummaryAdapterHandlesPutAndRemove()
 {
@@ -1256,11 +1571,15 @@ Test::Main()
     }
     TEST_DO(requireThatSummaryAdapterHandlesPutAndRemove());
     TEST_DO(requireThatAdapterHandlesAllFieldTypes());
+    TEST_DO(requireThatPlainFieldsAreWrittenAsConvertedFields());
     TEST_DO(requireThatAdapterHandlesMultipleDocuments());
+    TEST_DO(requireThatAdapterHandlesPrefetchedDocuments());
+    TEST_DO(requireThatAdapterReadsSummaryColumns());
     TEST_DO(requireThatAdapterHandlesDocumentIdField());
     TEST_DO(requireThatDocsumRequestIsProcessed());
     TEST_DO(requireThatRewritersAreUsed());
     TEST_DO(requireThatAttributesAreUsed());
+    TEST_DO(requireThatAttributeOnlySummaryDoesNotUseDocumentStore());
     TEST_DO(requireThatAnnotationsAreUsed());
     TEST_DO(requireThatUrisAreUsed());
     TEST_DO(requireThatPositionsAreUsed());
@@ -282,6 +282,46 @@ struct Committer : public ICommitable {
     void commitAndWait() override { _commitAndWaitCount++; }
 };
 
+struct TermFilteringUnitDR : UnitDR {
+    using TermHashes = std::vector<uint64_t>;
+    bool                   dropOnFilter;
+    const Committer       *committer;
+    mutable TermHashes     filterTermHashes;
+    mutable size_t         filterCount;
+    mutable size_t         commitAndWaitCountAtFilter;
+    mutable bool           fetched;
+
+    TermFilteringUnitDR(const std::string &id, Timestamp t, Bucket b, bool drop, const Committer *c = nullptr)
+        : UnitDR(std::make_unique<Document>(*DataType::DOCUMENT, DocumentId(id)), t, b, false),
+          dropOnFilter(drop),
+          committer(c),
+          filterTermHashes(),
+          filterCount(0),
+          commitAndWaitCountAtFilter(0),
+          fetched(false)
+    {
+    }
+
+    void filterLidsByTerms(LidVector &lids, const TermHashes &termHashes) const override;
+    document::Document::UP getDocument(DocumentIdT lid) const override {
+        if (lid == docid) {
+            fetched = true;
+        }
+        return UnitDR::getDocument(lid);
+    }
+};
+
+void
+TermFilteringUnitDR::filterLidsByTerms(LidVector &lids, const TermHashes &termHashes) const
+{
+    ++filterCount;
+    filterTermHashes = termHashes;
+    commitAndWaitCountAtFilter = (committer != nullptr) ? committer->_commitAndWaitCount : 0;
+    if (dropOnFilter) {
+        lids.erase(std::remove(lids.begin(), lids.end(), docid), lids.end());
+    }
+}
+
 size_t getSize() {
     return sizeof(DocEntry);
 }
@@ -747,6 +787,69 @@ TEST("require that document selection and timestamp range works together") {
     TEST_DO(checkEntry(res, 1, DocumentId("id:ns:document::xxx4"), Timestamp(200)));
 }
 
+Selection selectRequiredTerms(const Selection::TermHashes &termHashes) {
+    Selection sel(DocumentSelection(""));
+    sel.setRequiredTermHashes(termHashes);
+    return sel;
+}
+
+TEST("require that lids are filtered by required terms before documents are fetched") {
+    DocumentIterator itr(bucket(5), document::AllFields(), selectRequiredTerms({17, 42}), newestV(), -1, false);
+    auto kept = std::make_shared<TermFilteringUnitDR>("id:ns:document::1", Timestamp(2), bucket(5), false);
+    auto dropped = std::make_shared<TermFilteringUnitDR>("id:ns:document::2", Timestamp(3), bucket(5), true);
+    itr.add(kept);
+    itr.add(dropped);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    EXPECT_EQUAL(1u, res.getEntries().size());
+    TEST_DO(checkEntry(res, 0, Document(*DataType::DOCUMENT, DocumentId("id:ns:document::1")), Timestamp(2)));
+    EXPECT_EQUAL(1u, kept->filterCount);
+    EXPECT_EQUAL(1u, dropped->filterCount);
+    EXPECT_TRUE(Selection::TermHashes({17, 42}) == dropped->filterTermHashes);
+    EXPECT_TRUE(kept->fetched);
+    EXPECT_FALSE(dropped->fetched);
+}
+
+TEST("require that lids are not filtered without required terms") {
+    DocumentIterator itr(bucket(5), document::AllFields(), selectAll(), newestV(), -1, false);
+    auto retriever = std::make_shared<TermFilteringUnitDR>("id:ns:document::1", Timestamp(2), bucket(5), true);
+    itr.add(retriever);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_EQUAL(1u, res.getEntries().size());
+    EXPECT_EQUAL(0u, retriever->filterCount);
+}
+
+TEST("require that lids are not filtered by required terms for meta-data only iteration") {
+    DocumentIterator itr(bucket(5), document::NoFields(), selectRequiredTerms({17}), newestV(), -1, false);
+    auto retriever = std::make_shared<TermFilteringUnitDR>("id:ns:document::1", Timestamp(2), bucket(5), true);
+    itr.add(retriever);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_EQUAL(1u, res.getEntries().size());
+    EXPECT_EQUAL(0u, retriever->filterCount);
+}
+
+TEST("require that lids are not filtered by required terms when a timestamp subset is given") {
+    Selection sel = selectTimestampSet(2, 3, 4);
+    sel.setRequiredTermHashes({17});
+    DocumentIterator itr(bucket(5), document::AllFields(), sel, newestV(), -1, false);
+    auto retriever = std::make_shared<TermFilteringUnitDR>("id:ns:document::1", Timestamp(2), bucket(5), true);
+    itr.add(retriever);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_EQUAL(1u, res.getEntries().size());
+    EXPECT_EQUAL(0u, retriever->filterCount);
+}
+
+TEST("require that commit and wait retriever commits before filtering by required terms") {
+    Committer committer;
+    auto retriever = std::make_shared<TermFilteringUnitDR>("id:ns:document::1", Timestamp(2), bucket(5), true, &committer);
+    DocumentIterator itr(bucket(5), document::AllFields(), selectRequiredTerms({17}), newestV(), -1, false);
+    itr.add(std::make_shared<CommitAndWaitDocumentRetriever>(retriever, committer));
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_EQUAL(0u, res.getEntries().size());
+    EXPECT_EQUAL(1u, retriever->filterCount);
+    EXPECT_EQUAL(1u, retriever->commitAndWaitCountAtFilter);
+}
+
 TEST("require that fieldset limits fields returned") {
     DocumentIterator itr(bucket(5), document::HeaderFields(), selectAll(), newestV(), -1, false);
     itr.add(doc_with_fields("id:ns:foo::xxx1", Timestamp(1),  bucket(5)));
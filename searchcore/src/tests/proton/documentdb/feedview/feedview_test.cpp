@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/common/commit_time_tracker.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
+#include <vespa/searchcore/proton/common/term_summary_store.h>
 #include <vespa/searchcore/proton/documentmetastore/lidreusedelayer.h>
 #include <vespa/searchcore/proton/index/i_index_writer.h>
 #include <vespa/searchcore/proton/server/executorthreadingservice.h>
@@ -24,6 +25,7 @@
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/time.h>
 
 #include <vespa/log/log.h>
@@ -40,6 +42,7 @@ using search::CacheStats;
 using search::DocumentMetaData;
 using search::IDestructorCallback;
 using search::SearchableStats;
+using search::streaming::TermSummary;
 using search::index::schema::CollectionType;
 using search::index::schema::DataType;
 using searchcorespi::IndexSearchable;
@@ -728,7 +731,8 @@ FixtureBase::populateBeforeCompactLidSpace()
 struct SearchableFeedViewFixture : public FixtureBase
 {
     SearchableFeedView fv;
-    SearchableFeedViewFixture(vespalib::duration visibilityDelay = 0ms) :
+    SearchableFeedViewFixture(vespalib::duration visibilityDelay = 0ms,
+                              TermSummaryStore::SP termSummaryStore = TermSummaryStore::SP()) :
         FixtureBase(visibilityDelay),
         fv(StoreOnlyFeedView::Context(sa,
                 sc._schema,
@@ -737,7 +741,8 @@ struct SearchableFeedViewFixture : public FixtureBase
                 sc.getRepo(),
                 _writeService,
                 _lidReuseDelayer,
-                _commitTimeTracker),
+                _commitTimeTracker,
+                std::move(termSummaryStore)),
            pc.getParams(),
            FastAccessFeedView::Context(aw, _docIdLimit),
            SearchableFeedView::Context(iw))
@@ -747,6 +752,40 @@ struct SearchableFeedViewFixture : public FixtureBase
     virtual IFeedView &getFeedView() override { return fv; }
 };
 
+struct TermSummaryFeedViewFixture : public SearchableFeedViewFixture
+{
+    vespalib::Gate _summaryGate;
+
+    TermSummaryFeedViewFixture()
+        : SearchableFeedViewFixture(0ms, std::make_shared<TermSummaryStore>(64)),
+          _summaryGate()
+    {
+    }
+    ~TermSummaryFeedViewFixture() override {
+        unblockSummaryThread();
+        sync();
+    }
+    // Term summaries must be up to date without waiting for the summary thread.
+    void blockSummaryThread() {
+        _writeService.summary().execute(vespalib::makeLambdaTask([this]() { _summaryGate.await(); }));
+    }
+    void unblockSummaryThread() {
+        _summaryGate.countDown();
+    }
+    DocumentContext docWithText(const vespalib::string &docId, uint64_t timestamp, const vespalib::string &text) {
+        DocumentContext docCtx(docId, timestamp, getBuilder());
+        docCtx.doc.reset(getBuilder().startDocument(docId).startSummaryField("s1").addStr(text).endField().endDocument().release());
+        return docCtx;
+    }
+    bool mayContain(uint32_t lid, const vespalib::string &term) const {
+        uint64_t hash(0);
+        ASSERT_TRUE(TermSummary::hashTerm(term, hash));
+        TermSummaryStore::LidVector lids({lid});
+        fv.getTermSummaryStore()->filterLids(lids, {hash});
+        return !lids.empty();
+    }
+};
+
 struct FastAccessFeedViewFixture : public FixtureBase
 {
     FastAccessFeedView fv;
@@ -1332,6 +1371,52 @@ TEST_F("require that move() notifies gid to lid change handler", SearchableFeedV
     TEST_DO(f.assertChangeHandler(dc2.gid(), 1u, 4u));
 }
 
+TEST_F("require that put() stores term summary without waiting for the summary thread", TermSummaryFeedViewFixture)
+{
+    f.blockSummaryThread();
+    f.putAndWait(f.docWithText("id:ns:searchdocument::1", 10, "the quick brown fox"));
+    EXPECT_TRUE(f.getMetaStore().validLid(1));
+    EXPECT_TRUE(f.mayContain(1, "fox"));
+    EXPECT_FALSE(f.mayContain(1, "dog"));
+    f.putAndWait(f.docWithText("id:ns:searchdocument::1", 20, "the lazy dog"));
+    EXPECT_FALSE(f.mayContain(1, "fox"));
+    EXPECT_TRUE(f.mayContain(1, "dog"));
+}
+
+TEST_F("require that update() drops term summary without waiting for the summary thread", TermSummaryFeedViewFixture)
+{
+    f.putAndWait(f.docWithText("id:ns:searchdocument::1", 10, "the quick brown fox"));
+    EXPECT_FALSE(f.mayContain(1, "dog"));
+    f.blockSummaryThread();
+    f.updateAndWait(f.doc1(20));
+    EXPECT_TRUE(f.mayContain(1, "dog"));
+}
+
+TEST_F("require that remove() drops term summary without waiting for the summary thread", TermSummaryFeedViewFixture)
+{
+    f.putAndWait(f.docWithText("id:ns:searchdocument::1", 10, "the quick brown fox"));
+    f.putAndWait(f.docWithText("id:ns:searchdocument::2", 11, "the lazy dog"));
+    EXPECT_FALSE(f.mayContain(1, "dog"));
+    f.blockSummaryThread();
+    f.removeAndWait(f.doc1(20));
+    EXPECT_FALSE(f.getMetaStore().validLid(1));
+    EXPECT_TRUE(f.mayContain(1, "dog"));
+    EXPECT_FALSE(f.mayContain(2, "fox"));
+}
+
+TEST_F("require that move() moves term summary without waiting for the summary thread", TermSummaryFeedViewFixture)
+{
+    DocumentContext dc2 = f.docWithText("id:ns:searchdocument::2", 11, "the lazy dog");
+    f.putAndWait(f.docWithText("id:ns:searchdocument::1", 10, "the quick brown fox"));
+    f.putAndWait(dc2);
+    f.removeAndWait(f.doc1(20));
+    f.blockSummaryThread();
+    f.moveAndWait(dc2, 2, 1);
+    EXPECT_TRUE(f.mayContain(1, "dog"));
+    EXPECT_FALSE(f.mayContain(1, "fox"));
+    EXPECT_TRUE(f.mayContain(2, "fox"));
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -2101,6 +2101,57 @@ TEST(DocumentMetaStoreTest, tracks_time_of_last_call_to_remove_batch)
     EXPECT_GT(after, stats.get_last_remove_batch());
 }
 
+TEST(DocumentMetaStoreTest, gid_to_lid_lookup_works_after_many_puts_and_removes)
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.constructFreeList();
+    constexpr uint32_t num_lids = 2000;
+    for (uint32_t lid = 1; lid <= num_lids; ++lid) {
+        addLid(dms, lid);
+    }
+    for (uint32_t lid = 2; lid <= num_lids; lid += 2) {
+        EXPECT_TRUE(dms.remove(lid));
+        dms.removeComplete(lid);
+    }
+    for (uint32_t lid = 1; lid <= num_lids; ++lid) {
+        GlobalId gid = createGid(lid);
+        if ((lid % 2) != 0) {
+            assertLidGidFound(lid, dms);
+            EXPECT_EQ(lid, dms.inspectExisting(gid).getLid());
+        } else {
+            assertLidGidNotFound(lid, dms);
+            EXPECT_FALSE(dms.inspectExisting(gid).ok());
+        }
+    }
+    dms.removeAllOldGenerations();
+    for (uint32_t lid = 2; lid <= num_lids; lid += 2) {
+        GlobalId gid = createGid(lid);
+        uint32_t added_lid = addGid(dms, gid, Timestamp(lid + timestampBias));
+        assertLid(added_lid, gid, dms);
+        EXPECT_EQ(added_lid, dms.inspectExisting(gid).getLid());
+    }
+    EXPECT_EQ(num_lids, dms.getNumUsedLids());
+}
+
+TEST(DocumentMetaStoreTest, gid_to_lid_lookup_works_after_move)
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.constructFreeList();
+    for (uint32_t lid = 1; lid <= 4; ++lid) {
+        addLid(dms, lid);
+    }
+    EXPECT_TRUE(dms.remove(2));
+    dms.removeComplete(2);
+    GlobalId gid = createGid(4);
+    uint32_t lid = 0;
+    dms.move(4, 2);
+    EXPECT_TRUE(dms.getLid(gid, lid));
+    EXPECT_EQ(2u, lid);
+    EXPECT_EQ(2u, dms.inspectExisting(gid).getLid());
+    EXPECT_EQ(2u, dms.inspect(gid).getLid());
+    EXPECT_FALSE(dms.validLid(4));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
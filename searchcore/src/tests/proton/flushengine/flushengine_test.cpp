@@ -1,7 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchcore/proton/flushengine/cachedflushtarget.h>
+#include <vespa/searchcore/proton/flushengine/disk_write_budget.h>
 #include <vespa/searchcore/proton/flushengine/flush_engine_explorer.h>
+#include <vespa/searchcore/proton/flushengine/flush_history.h>
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
 #include <vespa/searchcore/proton/flushengine/i_tls_stats_factory.h>
 #include <vespa/searchcore/proton/flushengine/threadedflushtarget.h>
@@ -295,6 +297,14 @@ public:
 
 };
 
+class UrgentTarget : public SimpleTarget {
+public:
+    UrgentTarget(const vespalib::string &name, search::SerialNum flushedSerial)
+        : SimpleTarget(name, flushedSerial)
+    {}
+    bool needUrgentFlush() const override { return true; }
+};
+
 class GCTarget : public SimpleTarget {
 public:
     GCTarget(const vespalib::string &name, search::SerialNum flushedSerial)
@@ -424,10 +434,11 @@ struct Fixture
     SimpleStrategy::SP strategy;
     FlushEngine engine;
 
-    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_)
+    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_,
+            flushengine::DiskWriteBudget::SP diskWriteBudget = flushengine::DiskWriteBudget::SP())
         : tlsStatsFactory(std::make_shared<SimpleTlsStatsFactory>()),
           strategy(strategy_),
-          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS)
+          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS, std::move(diskWriteBudget))
     {
     }
 
@@ -762,6 +773,64 @@ TEST_F("require that oldest serial is updated when finishing priority flush stra
 }
 
 
+TEST("require that disk write budget limits write rate")
+{
+    vespalib::steady_time now;
+    flushengine::DiskWriteBudget budget(1000, 2s, now);
+    EXPECT_TRUE(budget.enabled());
+    EXPECT_TRUE(budget.isAvailable(now));
+    budget.consume(5000, now);
+    EXPECT_FALSE(budget.isAvailable(now));
+    EXPECT_EQUAL(3000, vespalib::count_ms(budget.timeUntilAvailable(now)));
+    EXPECT_FALSE(budget.isAvailable(now + 2s));
+    EXPECT_TRUE(budget.isAvailable(now + 3s));
+    // Unused budget is capped by the burst size
+    now += 100s;
+    budget.consume(2500, now);
+    EXPECT_EQUAL(500, vespalib::count_ms(budget.timeUntilAvailable(now)));
+}
+
+TEST("require that disabled disk write budget is always available")
+{
+    flushengine::DiskWriteBudget budget(0, 10s);
+    EXPECT_FALSE(budget.enabled());
+    budget.consume(1000000000);
+    EXPECT_TRUE(budget.isAvailable());
+    EXPECT_TRUE(budget.timeUntilAvailable() == vespalib::duration::zero());
+}
+
+TEST("require that flush history estimates bytes to write from observed throughput")
+{
+    flushengine::FlushHistory history;
+    EXPECT_EQUAL(0u, history.estimateBytesToWrite("summary", 0));
+    EXPECT_EQUAL(4000u, history.estimateBytesToWrite("attribute", 4000));
+    history.recordFlush("attribute", 4000, 2s);
+    EXPECT_EQUAL(2000.0, history.getBytesPerSecond());
+    history.recordFlush("summary", 0, 3s);
+    EXPECT_EQUAL(2000.0, history.getBytesPerSecond());
+    EXPECT_EQUAL(6000u, history.estimateBytesToWrite("summary", 0));
+    EXPECT_EQUAL(100u, history.estimateBytesToWrite("summary", 100));
+    // Flushes of targets without own estimate does not change observed throughput
+    history.estimateBytesToWrite("summary", 0);
+    history.recordFlush("summary", 6000, 1s);
+    EXPECT_EQUAL(2000.0, history.getBytesPerSecond());
+}
+
+TEST_F("require that exhausted disk write budget only allows urgent flushes",
+       Fixture(2, 10, std::make_shared<SimpleStrategy>(), std::make_shared<flushengine::DiskWriteBudget>(1, 0s)))
+{
+    f.engine.getDiskWriteBudget()->consume(1000000);
+    auto normal = std::make_shared<SimpleTarget>("normal", 1);
+    auto urgent = std::make_shared<UrgentTarget>("urgent", 2);
+    f.addTargetToStrategy(normal);
+    f.addTargetToStrategy(urgent);
+    auto handler = std::make_shared<SimpleHandler>(Targets({normal, urgent}), "handler", 9);
+    f.putFlushHandler("handler", handler);
+    f.engine.start();
+    EXPECT_TRUE(urgent->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_FALSE(normal->_initDone.await(200));
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
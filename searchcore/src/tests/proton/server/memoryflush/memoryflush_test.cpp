@@ -13,6 +13,7 @@ using namespace searchcorespi;
 
 namespace{
 
+static constexpr uint64_t mebi = UINT64_C(1024) * UINT64_C(1024);
 static constexpr uint64_t gibi = UINT64_C(1024) * UINT64_C(1024) * UINT64_C(1024);
 
 }
@@ -44,16 +45,19 @@ private:
     SerialNum     _flushedSerial;
     system_time  _lastFlushTime;
     bool          _urgentFlush;
+    uint64_t      _bytesToWrite;
 public:
     MyFlushTarget(const vespalib::string &name, MemoryGain memoryGain,
                   DiskGain diskGain, SerialNum flushedSerial,
-                  system_time lastFlushTime, bool urgentFlush) :
+                  system_time lastFlushTime, bool urgentFlush,
+                  uint64_t bytesToWrite = 0) :
         test::DummyFlushTarget(name),
         _memoryGain(memoryGain),
         _diskGain(diskGain),
         _flushedSerial(flushedSerial),
         _lastFlushTime(lastFlushTime),
-        _urgentFlush(urgentFlush)
+        _urgentFlush(urgentFlush),
+        _bytesToWrite(bytesToWrite)
     {
     }
     // Implements IFlushTarget
@@ -62,6 +66,7 @@ public:
     virtual SerialNum getFlushedSerialNum() const override { return _flushedSerial; }
     virtual system_time getLastFlushTime() const override { return _lastFlushTime; }
     virtual bool needUrgentFlush() const override { return _urgentFlush; }
+    virtual uint64_t getApproxBytesToWriteToDisk() const override { return _bytesToWrite; }
 };
 
 struct StringList : public std::vector<vespalib::string> {
@@ -125,6 +130,12 @@ createTargetM(const vespalib::string &name, MemoryGain memoryGain)
     return std::make_shared<MyFlushTarget>(name, memoryGain, DiskGain(),SerialNum(), system_time(), false);
 }
 
+MyFlushTarget::SP
+createTargetMW(const vespalib::string &name, MemoryGain memoryGain, uint64_t bytesToWrite)
+{
+    return std::make_shared<MyFlushTarget>(name, memoryGain, DiskGain(), SerialNum(), system_time(), false, bytesToWrite);
+}
+
 MyFlushTarget::SP
 createTargetD(const vespalib::string &name, DiskGain diskGain, SerialNum serial = 0)
 {
@@ -180,6 +191,19 @@ requireThatWeCanOrderByMemoryGain()
     }
 }
 
+void
+requireThatMemoryGainIsOrderedPerByteWritten()
+{
+    ContextBuilder cb;
+    cb.add(createTargetMW("t1", MemoryGain(400 * mebi, 0), 4 * gibi))
+      .add(createTargetMW("t2", MemoryGain(200 * mebi, 0), 200 * mebi))
+      .add(createTargetMW("t3", MemoryGain(100 * mebi, 0), 0))
+      .add(createTargetMW("t4", MemoryGain(300 * mebi, 0), gibi));
+    MemoryFlush flush({1000, 20 * gibi, 1.0, 20, 1.0, minutes(1)});
+    EXPECT_TRUE(assertOrder(StringList().add("t3").add("t2").add("t4").add("t1"),
+                            flush.getFlushTargets(cb.list(), cb.tlsStats())));
+}
+
 int64_t milli = 1000000;
 
 void
@@ -323,6 +347,7 @@ requireThatOrderTypeIsPreserved()
 TEST_MAIN()
 {
     TEST_DO(requireThatWeCanOrderByMemoryGain());
+    TEST_DO(requireThatMemoryGainIsOrderedPerByteWritten());
     TEST_DO(requireThatWeCanOrderByDiskGainWithLargeValues());
     TEST_DO(requireThatWeCanOrderByDiskGainWithSmallValues());
     TEST_DO(requireThatWeCanOrderByAge());
@@ -150,7 +150,7 @@ logAttributeWrongType(const AttributeVector::SP &attr, const AttributeHeader &he
 }
 
 AttributeVector::SP
-AttributeInitializer::tryLoadAttribute() const
+AttributeInitializer::tryLoadAttribute(vespalib::Executor *executor) const
 {
     search::SerialNum serialNum = _attrDir->getFlushedSerialNum();
     vespalib::string attrFileName = _attrDir->getAttributeFileName(serialNum);
@@ -161,7 +161,7 @@ AttributeInitializer::tryLoadAttribute() const
             setupEmptyAttribute(attr, serialNum, header);
             return attr;
         }
-        if (!loadAttribute(attr, serialNum)) {
+        if (!loadAttribute(attr, serialNum, executor)) {
             return AttributeVector::SP();
         }
     } else {
@@ -172,12 +172,13 @@ AttributeInitializer::tryLoadAttribute() const
 
 bool
 AttributeInitializer::loadAttribute(const AttributeVectorSP &attr,
-                                    search::SerialNum serialNum) const
+                                    search::SerialNum serialNum,
+                                    vespalib::Executor *executor) const
 {
     assert(attr->hasLoadData());
     vespalib::Timer timer;
     EventLogger::loadAttributeStart(_documentSubDbName, attr->getName());
-    if (!attr->load()) {
+    if (!attr->load(executor)) {
         LOG(warning, "Could not load attribute vector '%s' from disk. Returning empty attribute vector",
             attr->getBaseFileName().c_str());
         return false;
@@ -230,10 +231,10 @@ AttributeInitializer::AttributeInitializer(const std::shared_ptr<AttributeDirect
 AttributeInitializer::~AttributeInitializer() = default;
 
 AttributeInitializerResult
-AttributeInitializer::init() const
+AttributeInitializer::init(vespalib::Executor *executor) const
 {
     if (!_attrDir->empty()) {
-        return AttributeInitializerResult(tryLoadAttribute());
+        return AttributeInitializerResult(tryLoadAttribute(executor));
     } else {
         return AttributeInitializerResult(createAndSetupEmptyAttribute());
     }
@@ -9,6 +9,7 @@
 #include <vespa/searchcommon/attribute/persistent_predicate_params.h>
 
 namespace search::attribute { class AttributeHeader; }
+namespace vespalib { class Executor; }
 
 namespace proton {
 
@@ -31,9 +32,9 @@ private:
     const uint64_t                  _currentSerialNum;
     const IAttributeFactory        &_factory;
 
-    AttributeVectorSP tryLoadAttribute() const;
+    AttributeVectorSP tryLoadAttribute(vespalib::Executor *executor) const;
 
-    bool loadAttribute(const AttributeVectorSP &attr, search::SerialNum serialNum) const;
+    bool loadAttribute(const AttributeVectorSP &attr, search::SerialNum serialNum, vespalib::Executor *executor) const;
 
     void setupEmptyAttribute(AttributeVectorSP &attr, search::SerialNum serialNum,
                              const search::attribute::AttributeHeader &header) const;
@@ -45,7 +46,11 @@ public:
                          const AttributeSpec &spec, uint64_t currentSerialNum, const IAttributeFactory &factory);
     ~AttributeInitializer();
 
-    AttributeInitializerResult init() const;
+    /**
+     * Initializes the attribute vector, loading it from disk if possible.
+     * The executor, if given, is used to parallelize loading of large attributes.
+     */
+    AttributeInitializerResult init(vespalib::Executor *executor = nullptr) const;
     uint64_t getCurrentSerialNum() const { return _currentSerialNum; }
 };
 
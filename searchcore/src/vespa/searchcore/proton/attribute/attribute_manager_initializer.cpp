@@ -23,18 +23,22 @@ private:
     AttributeInitializer::UP _initializer;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_result;
+    vespalib::Executor &_sharedExecutor;
 
 public:
     AttributeInitializerTask(AttributeInitializer::UP initializer,
                              DocumentMetaStore::SP documentMetaStore,
-                             InitializedAttributesResult &result)
+                             InitializedAttributesResult &result,
+                             vespalib::Executor &sharedExecutor)
         : _initializer(std::move(initializer)),
           _documentMetaStore(documentMetaStore),
-          _result(result)
+          _result(result),
+          _sharedExecutor(sharedExecutor)
     {}
 
     void run() override {
-        AttributeInitializerResult result = _initializer->init();
+        // Heavy load phases of large attributes are spread over the shared executor
+        AttributeInitializerResult result = _initializer->init(&_sharedExecutor);
         if (result) {
             AttributesInitializerBase::considerPadAttribute(*result.getAttribute(),
                                                             _initializer->getCurrentSerialNum(),
@@ -94,12 +98,14 @@ private:
     InitializerTask::SP _documentMetaStoreInitTask;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_attributesResult;
+    vespalib::Executor &_sharedExecutor;
 
 public:
     AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                      InitializerTask::SP documentMetaStoreInitTask,
                                      DocumentMetaStore::SP documentMetaStore,
-                                     InitializedAttributesResult &attributesResult);
+                                     InitializedAttributesResult &attributesResult,
+                                     vespalib::Executor &sharedExecutor);
     ~AttributeInitializerTasksBuilder();
     void add(AttributeInitializer::UP initializer) override;
 };
@@ -107,11 +113,13 @@ public:
 AttributeInitializerTasksBuilder::AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                                                    InitializerTask::SP documentMetaStoreInitTask,
                                                                    DocumentMetaStore::SP documentMetaStore,
-                                                                   InitializedAttributesResult &attributesResult)
+                                                                   InitializedAttributesResult &attributesResult,
+                                                                   vespalib::Executor &sharedExecutor)
     : _attrMgrInitTask(attrMgrInitTask),
       _documentMetaStoreInitTask(documentMetaStoreInitTask),
       _documentMetaStore(documentMetaStore),
-      _attributesResult(attributesResult)
+      _attributesResult(attributesResult),
+      _sharedExecutor(sharedExecutor)
 { }
 
 AttributeInitializerTasksBuilder::~AttributeInitializerTasksBuilder() = default;
@@ -121,7 +129,8 @@ AttributeInitializerTasksBuilder::add(AttributeInitializer::UP initializer) {
     InitializerTask::SP attributeInitTask =
             std::make_shared<AttributeInitializerTask>(std::move(initializer),
                                                        _documentMetaStore,
-                                                       _attributesResult);
+                                                       _attributesResult,
+                                                       _sharedExecutor);
     attributeInitTask->addDependency(_documentMetaStoreInitTask);
     _attrMgrInitTask.addDependency(attributeInitTask);
 }
@@ -145,6 +154,7 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
                                                          size_t attributeGrowNumDocs,
                                                          bool fastAccessAttributesOnly,
                                                          searchcorespi::index::IThreadService &master,
+                                                         vespalib::Executor &sharedExecutor,
                                                          std::shared_ptr<AttributeManager::SP> attrMgrResult)
     : _configSerialNum(configSerialNum),
       _documentMetaStore(documentMetaStore),
@@ -158,7 +168,7 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
       _attrMgrResult(attrMgrResult)
 {
     addDependency(documentMetaStoreInitTask);
-    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _attributesResult);
+    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _attributesResult, sharedExecutor);
     AttributeCollectionSpec::UP attrSpec = createAttributeSpec();
     _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, tasksBuilder);
 }
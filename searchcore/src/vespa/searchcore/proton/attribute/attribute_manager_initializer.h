@@ -11,6 +11,7 @@
 #include <vespa/config-attributes.h>
 
 namespace searchcorespi { namespace index { struct IThreadService; } }
+namespace vespalib { class Executor; }
 
 namespace proton {
 
@@ -43,6 +44,7 @@ public:
                                 size_t attributeGrowNumDocs,
                                 bool fastAccessAttributesOnly,
                                 searchcorespi::index::IThreadService &master,
+                                vespalib::Executor &sharedExecutor,
                                 std::shared_ptr<AttributeManager::SP> attrMgrResult);
 
     virtual void run() override;
@@ -0,0 +1,122 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "term_summary_store.h"
+#include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+
+namespace proton {
+
+namespace {
+
+constexpr size_t max_small_summary_size = 64;
+constexpr size_t small_page_size = 4 * 1024;
+constexpr size_t min_num_arrays_for_new_buffer = 8 * 1024;
+constexpr float alloc_grow_factor = 0.2;
+
+search::datastore::ArrayStoreConfig
+make_summary_store_config()
+{
+    return search::datastore::ArrayStore<uint64_t>::optimizedConfigForHugePage(max_small_summary_size,
+                                                                                vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                                                small_page_size,
+                                                                                min_num_arrays_for_new_buffer,
+                                                                                alloc_grow_factor).enable_free_lists(true);
+}
+
+}
+
+TermSummaryStore::TermSummaryStore(uint32_t bitsPerWord)
+    : _builder(bitsPerWord),
+      _genHandler(),
+      _refs(),
+      _committedSize(0),
+      _summaries(make_summary_store_config())
+{
+    _refs.setGeneration(_genHandler.getCurrentGeneration());
+}
+
+TermSummaryStore::~TermSummaryStore() = default;
+
+void
+TermSummaryStore::set(uint32_t lid, EntryRef ref)
+{
+    if (lid >= _refs.size()) {
+        if (!ref.valid()) {
+            return;
+        }
+        _refs.ensure_size(lid + 1);
+    }
+    EntryRef oldRef = _refs[lid];
+    if (!oldRef.valid() && !ref.valid()) {
+        return;
+    }
+    // Make the summary visible before the reference to it.
+    std::atomic_thread_fence(std::memory_order_release);
+    _refs[lid] = ref;
+    // Make the grown range and the reference visible before the new size.
+    _committedSize.store(_refs.size(), std::memory_order_release);
+    if (oldRef.valid()) {
+        _summaries.remove(oldRef);
+    }
+    commit();
+}
+
+void
+TermSummaryStore::commit()
+{
+    _summaries.transferHoldLists(_genHandler.getCurrentGeneration());
+    _genHandler.incGeneration();
+    _refs.setGeneration(_genHandler.getCurrentGeneration());
+    _genHandler.updateFirstUsedGeneration();
+    vespalib::GenerationHandler::generation_t firstUsed = _genHandler.getFirstUsedGeneration();
+    _summaries.trimHoldLists(firstUsed);
+    _refs.removeOldGenerations(firstUsed);
+}
+
+void
+TermSummaryStore::put(uint32_t lid, const document::Document &doc)
+{
+    _builder.addDocument(doc);
+    search::streaming::TermSummary::Bits bits = _builder.build();
+    set(lid, _summaries.add(bits));
+}
+
+void
+TermSummaryStore::remove(uint32_t lid)
+{
+    set(lid, EntryRef());
+}
+
+void
+TermSummaryStore::filterLids(LidVector &lids, const TermHashes &termHashes) const
+{
+    if (termHashes.empty()) {
+        return;
+    }
+    auto guard = _genHandler.takeGuard();
+    uint32_t numRefs = _committedSize.load(std::memory_order_acquire);
+    auto keep = [&](uint32_t lid) {
+        if (lid >= numRefs) {
+            return true;
+        }
+        EntryRef ref = _refs[lid];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!ref.valid()) {
+            return true;
+        }
+        auto bits = _summaries.get(ref);
+        return search::streaming::TermSummary::mayContainAll(&bits[0], bits.size(), termHashes);
+    };
+    lids.erase(std::remove_if(lids.begin(), lids.end(), [&](uint32_t lid) { return !keep(lid); }), lids.end());
+}
+
+vespalib::MemoryUsage
+TermSummaryStore::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage = _refs.getMemoryUsage();
+    usage.merge(_summaries.getMemoryUsage());
+    return usage;
+}
+
+}
@@ -0,0 +1,66 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/query/streaming/term_summary.h>
+#include <vespa/vespalib/datastore/array_store.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+
+namespace document { class Document; }
+
+namespace proton {
+
+/**
+ * In memory store of the term summaries (see search::streaming::TermSummary)
+ * of the documents in a sub database, indexed by lid. Used by streaming
+ * search to skip documents not containing all required query terms.
+ *
+ * There is a single writer (the master write thread). Readers can filter
+ * lids concurrently. Summaries are not persisted, thus documents written
+ * before a restart have no summary until they are written again, and
+ * documents without a summary are never filtered away.
+ */
+class TermSummaryStore
+{
+public:
+    using SP = std::shared_ptr<TermSummaryStore>;
+    using LidVector = std::vector<uint32_t>;
+    using TermHashes = std::vector<uint64_t>;
+
+private:
+    using EntryRef = search::datastore::EntryRef;
+    using SummaryStore = search::datastore::ArrayStore<uint64_t>;
+
+    search::streaming::TermSummaryBuilder _builder;
+    vespalib::GenerationHandler            _genHandler;
+    vespalib::RcuVector<EntryRef>          _refs;
+    // Number of initialized refs, readers never look beyond this.
+    std::atomic<uint32_t>                  _committedSize;
+    SummaryStore                           _summaries;
+
+    void set(uint32_t lid, EntryRef ref);
+    void commit();
+
+public:
+    TermSummaryStore(uint32_t bitsPerWord);
+    ~TermSummaryStore();
+
+    void put(uint32_t lid, const document::Document &doc);
+    /**
+     * Drops the summary for the given lid, after which it is never filtered.
+     * Used for removes, and for updates where the updated document is not
+     * available in the write thread.
+     */
+    void remove(uint32_t lid);
+
+    /**
+     * Removes the lids of documents known not to contain all the given term hashes.
+     */
+    void filterLids(LidVector &lids, const TermHashes &termHashes) const;
+    vespalib::MemoryUsage getMemoryUsage() const;
+};
+
+}
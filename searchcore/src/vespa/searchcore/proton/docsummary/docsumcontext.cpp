@@ -43,6 +43,17 @@ Memory MESSAGE("message");
 Memory DETAILS("details");
 Memory TIMEOUT("timeout");
 
+// Number of docsums fetched from the docsum store in one bulk operation
+constexpr uint32_t PREFETCH_BATCH_SIZE = 64;
+
+// Summary classes where all fields are generated (e.g. from
+// attributes) are written without touching the docsum store.
+bool
+usesDocsumStore(const IDocsumWriter::ResolveClassInfo &rci)
+{
+    return (!rci.mustSkip && !rci.allGenerated);
+}
+
 }
 
 void
@@ -61,6 +72,23 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocsums(uint32_t offset)
+{
+    std::vector<uint32_t> docIds;
+    uint32_t end = std::min(offset + PREFETCH_BATCH_SIZE, _docsumState._docsumcnt);
+    docIds.reserve(end - offset);
+    for (uint32_t i = offset; i < end; ++i) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    if (docIds.size() > 1) {
+        _docsumStore.prefetch(docIds);
+    }
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,7 +98,11 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    const bool useStore = usesDocsumStore(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        if (((i % PREFETCH_BATCH_SIZE) == 0) && useStore && !_request.expired()) {
+            prefetchDocsums(i);
+        }
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
         reply->docsums[i].docid = docId;
@@ -114,8 +146,12 @@ DocsumContext::createSlimeReply()
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
                                                                          _docsumStore.getSummaryClassId());
+    const bool useStore = usesDocsumStore(rci);
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
+        if (((i % PREFETCH_BATCH_SIZE) == 0) && useStore) {
+            prefetchDocsums(i);
+        }
         uint32_t docId = _docsumState._docsumbuf[i];
         Cursor & docSumC = array.addObject();
         ObjectSymbolInserter inserter(docSumC, docsumSym);
@@ -32,6 +32,7 @@ private:
     matching::SessionManager             & _sessionMgr;
 
     void initState();
+    void prefetchDocsums(uint32_t offset);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
@@ -2,7 +2,7 @@
 
 #include "documentstoreadapter.h"
 #include <vespa/searchsummary/docsummary/summaryfieldconverter.h>
-#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/fieldvalue/fieldvalues.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
@@ -21,6 +21,46 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+/**
+ * Check if the given field value can be written to the docsum blob
+ * as is, since the summary field converter would only make an
+ * identical copy of it. This only skips that copy; the field value
+ * is still taken from the deserialized document.
+ **/
+bool
+isPlainField(const FieldValue &value, bool markup)
+{
+    const uint32_t classId = value.getClass().id();
+    if (classId == StringFieldValue::classId) {
+        return !markup;
+    }
+    return ((classId == IntFieldValue::classId) ||
+            (classId == LongFieldValue::classId) ||
+            (classId == ShortFieldValue::classId) ||
+            (classId == BoolFieldValue::classId) ||
+            (classId == FloatFieldValue::classId) ||
+            (classId == DoubleFieldValue::classId) ||
+            (classId == RawFieldValue::classId) ||
+            (classId == TensorFieldValue::classId));
+}
+
+/**
+ * Collects documents visited by a bulk read from the document store.
+ * Documents are served from and added to the document cache as for
+ * single reads. The visit cache is not used, as it caches the exact
+ * set of visited lids, which differs between requests.
+ **/
+class PrefetchVisitor : public search::IDocumentVisitor
+{
+private:
+    vespalib::hash_map<uint32_t, Document::UP> &_docs;
+public:
+    PrefetchVisitor(vespalib::hash_map<uint32_t, Document::UP> &docs) : _docs(docs) {}
+    void visit(uint32_t lid, DocumentUP doc) override { _docs[lid] = std::move(doc); }
+    bool allowVisitCaching() const override { return false; }
+    bool populateCache() const override { return true; }
+};
+
 }
 
 bool
@@ -130,6 +170,12 @@ DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
             continue;
         }
         LOG(spam, "writeField(%s): value(%s), type(%d)", fieldName.c_str(), fieldValue->toString().c_str(), entry->_type);
+        if (isPlainField(*fieldValue, markup)) {
+            if (!writeField(*fieldValue, entry->_type)) {
+                LOG(warning, "Error while writing field '%s' for docId %u", fieldName.c_str(), docId);
+            }
+            continue;
+        }
         FieldValue::UP convertedFieldValue = SummaryFieldConverter::convertSummaryField(markup, *fieldValue);
         if (convertedFieldValue) {
             if (!writeField(*convertedFieldValue, entry->_type)) {
@@ -149,7 +195,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const ResultConfig & resultConfig,
                      const vespalib::string & resultClassName,
                      const FieldCache::CSP & fieldCache,
-                     const std::set<vespalib::string> &markupFields)
+                     const std::set<vespalib::string> &markupFields,
+                     Columns columns)
     : _docStore(docStore),
       _repo(repo),
       _resultConfig(resultConfig),
@@ -157,12 +204,72 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                    LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _columns(std::move(columns)),
+      _prefetched()
 {
 }
 
 DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 
+void
+DocumentStoreAdapter::mergeColumn(Document &doc, const Document &columnDoc, const vespalib::string &fieldName)
+{
+    const Field &field = doc.getField(fieldName);
+    FieldValue::UP value = columnDoc.getValue(field);
+    if (value) {
+        doc.setValue(field, *value);
+    }
+}
+
+/**
+ * Assembles the summary document from the column stores. Returns an
+ * empty pointer if any column is missing the document, in which case
+ * the full document store must be used.
+ **/
+Document::UP
+DocumentStoreAdapter::readColumns(uint32_t docId)
+{
+    Document::UP document;
+    for (const Column &column : _columns) {
+        Document::UP columnDoc = column.store->read(docId, _repo);
+        if ( ! columnDoc) {
+            return Document::UP();
+        }
+        if ( ! document) {
+            document = std::move(columnDoc);
+        } else {
+            mergeColumn(*document, *columnDoc, column.fieldName);
+        }
+    }
+    return document;
+}
+
+void
+DocumentStoreAdapter::prefetchColumns(const std::vector<uint32_t> &docIds)
+{
+    vespalib::hash_map<uint32_t, Document::UP> columnDocs;
+    PrefetchVisitor visitor(columnDocs);
+    bool first = true;
+    for (const Column &column : _columns) {
+        columnDocs.clear();
+        column.store->visit(docIds, _repo, visitor);
+        for (uint32_t docId : docIds) {
+            Document::UP &document = _prefetched[docId];
+            auto itr = columnDocs.find(docId);
+            Document::UP columnDoc = (itr != columnDocs.end()) ? std::move(itr->second) : Document::UP();
+            if (first) {
+                document = std::move(columnDoc);
+            } else if (document && columnDoc) {
+                mergeColumn(*document, *columnDoc, column.fieldName);
+            } else {
+                document.reset();
+            }
+        }
+        first = false;
+    }
+}
+
 DocsumStoreValue
 DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
 {
@@ -170,7 +277,19 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto itr = _prefetched.find(docId);
+    if (itr != _prefetched.end()) {
+        document = std::move(itr->second);
+        _prefetched.erase(itr);
+    } else {
+        if ( ! _columns.empty()) {
+            document = readColumns(docId);
+        }
+        if ( ! document) {
+            document = _docStore.read(docId, _repo);
+        }
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return DocsumStoreValue();
@@ -186,4 +305,29 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen, std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> &docIds)
+{
+    _prefetched.clear();
+    for (uint32_t docId : docIds) {
+        _prefetched[docId] = Document::UP();
+    }
+    std::vector<uint32_t> missing;
+    if (_columns.empty()) {
+        missing = docIds;
+    } else {
+        prefetchColumns(docIds);
+        for (uint32_t docId : docIds) {
+            if ( ! _prefetched[docId]) {
+                missing.push_back(docId);
+            }
+        }
+    }
+    // documents not found in the store are kept as empty entries to avoid reading them again
+    PrefetchVisitor visitor(_prefetched);
+    if ( ! missing.empty()) {
+        _docStore.visit(missing, _repo, visitor);
+    }
+}
+
 } // namespace proton
@@ -8,11 +8,22 @@
 #include <vespa/searchsummary/docsummary/resultpacker.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
 class DocumentStoreAdapter : public search::docsummary::IDocsumStore
 {
+public:
+    /**
+     * A column store holding documents with only the given summary field.
+     **/
+    struct Column {
+        vespalib::string               fieldName;
+        const search::IDocumentStore * store;
+    };
+    using Columns = std::vector<Column>;
+
 private:
     const search::IDocumentStore           & _docStore;
     const document::DocumentTypeRepo       & _repo;
@@ -21,6 +32,8 @@ private:
     search::docsummary::ResultPacker         _resultPacker;
     FieldCache::CSP                          _fieldCache;
     const std::set<vespalib::string>       & _markupFields;
+    Columns                                  _columns;
+    vespalib::hash_map<uint32_t, std::unique_ptr<document::Document>> _prefetched;
 
     bool
     writeStringField(const char * buf,
@@ -34,13 +47,18 @@ private:
     void
     convertFromSearchDoc(document::Document &doc, uint32_t docId);
 
+    void mergeColumn(document::Document &doc, const document::Document &columnDoc, const vespalib::string &fieldName);
+    std::unique_ptr<document::Document> readColumns(uint32_t docId);
+    void prefetchColumns(const std::vector<uint32_t> &docIds);
+
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
                          const document::DocumentTypeRepo &repo,
                          const search::docsummary::ResultConfig &resultConfig,
                          const vespalib::string &resultClassName,
                          const FieldCache::CSP &fieldCache,
-                         const std::set<vespalib::string> &markupFields);
+                         const std::set<vespalib::string> &markupFields,
+                         Columns columns = Columns());
     ~DocumentStoreAdapter();
 
     const search::docsummary::ResultClass *getResultClass() const {
@@ -49,6 +67,7 @@ public:
 
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t> &docIds) override;
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
@@ -0,0 +1,177 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "summary_column_store.h"
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.docsummary.summary_column_store");
+
+using document::Document;
+using search::LogDocumentStore;
+
+namespace proton {
+
+namespace {
+
+Document
+makeColumnDocument(const Document &doc, const vespalib::string &fieldName)
+{
+    Document columnDoc(doc.getType(), doc.getId());
+    const document::DocumentType &docType = doc.getType();
+    if (docType.hasField(fieldName)) {
+        const document::Field &field = docType.getField(fieldName);
+        document::FieldValue::UP value = doc.getValue(field);
+        if (value) {
+            columnDoc.setValue(field, *value);
+        }
+    }
+    return columnDoc;
+}
+
+void
+removeUnwantedColumns(const vespalib::string &columnDir, const std::vector<vespalib::string> &fieldNames)
+{
+    if ( ! vespalib::isDirectory(columnDir)) {
+        return;
+    }
+    for (const auto &entry : vespalib::listDirectory(columnDir)) {
+        if (std::find(fieldNames.begin(), fieldNames.end(), entry) == fieldNames.end()) {
+            LOG(info, "Removing summary column '%s' in '%s' as it is no longer wanted", entry.c_str(), columnDir.c_str());
+            vespalib::rmdir(columnDir + "/" + entry, true);
+        }
+    }
+}
+
+}
+
+SummaryColumnStore::SummaryColumnStore(vespalib::ThreadExecutor &executor,
+                                       const vespalib::string &baseDir,
+                                       const std::vector<vespalib::string> &fieldNames,
+                                       const LogDocumentStore::Config &config,
+                                       const search::GrowStrategy &growStrategy,
+                                       const search::TuneFileSummary &tuneFileSummary,
+                                       const search::common::FileHeaderContext &fileHeaderContext,
+                                       search::transactionlog::SyncProxy &tlSyncer,
+                                       std::shared_ptr<search::IBucketizer> bucketizer,
+                                       uint64_t initialSyncToken)
+    : _columns(),
+      _repoLock(),
+      _repo()
+{
+    vespalib::string columnDir(getColumnDir(baseDir));
+    removeUnwantedColumns(columnDir, fieldNames);
+    for (const auto &fieldName : fieldNames) {
+        vespalib::string dir(columnDir + "/" + fieldName);
+        bool created = ! vespalib::isDirectory(dir);
+        vespalib::mkdir(dir, true);
+        auto store = std::make_shared<LogDocumentStore>(executor, dir, config, growStrategy, tuneFileSummary,
+                                                        fileHeaderContext, tlSyncer, bucketizer);
+        if (created && initialSyncToken > 0) {
+            // An empty column has all documents up to now missing, which are then read from the full store.
+            store->flush(store->initFlush(initialSyncToken));
+        }
+        _columns.push_back({fieldName, std::move(store)});
+    }
+}
+
+SummaryColumnStore::~SummaryColumnStore() = default;
+
+vespalib::string
+SummaryColumnStore::getColumnDir(const vespalib::string &baseDir)
+{
+    return baseDir + "/column";
+}
+
+const search::IDocumentStore *
+SummaryColumnStore::getStore(const vespalib::string &fieldName) const
+{
+    for (const auto &column : _columns) {
+        if (column.fieldName == fieldName) {
+            return column.store.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+SummaryColumnStore::setRepo(std::shared_ptr<const document::DocumentTypeRepo> repo)
+{
+    std::lock_guard<std::mutex> guard(_repoLock);
+    _repo = std::move(repo);
+}
+
+void
+SummaryColumnStore::put(uint64_t syncToken, uint32_t lid, const Document &doc)
+{
+    for (const auto &column : _columns) {
+        if (syncToken >= column.store->tentativeLastSyncToken()) {
+            column.store->write(syncToken, lid, makeColumnDocument(doc, column.fieldName));
+        }
+    }
+}
+
+void
+SummaryColumnStore::put(uint64_t syncToken, uint32_t lid, const vespalib::nbostream &os)
+{
+    if (_columns.empty()) {
+        return;
+    }
+    std::shared_ptr<const document::DocumentTypeRepo> repo;
+    {
+        std::lock_guard<std::mutex> guard(_repoLock);
+        repo = _repo;
+    }
+    if ( ! repo) {
+        // Not able to split the document, let it be read from the full store.
+        LOG(warning, "No document type repo, removing lid %u from summary columns", lid);
+        remove(syncToken, lid);
+        return;
+    }
+    vespalib::nbostream copy(os.peek(), os.size());
+    Document doc(*repo, copy);
+    put(syncToken, lid, doc);
+}
+
+void
+SummaryColumnStore::remove(uint64_t syncToken, uint32_t lid)
+{
+    for (const auto &column : _columns) {
+        if (syncToken >= column.store->tentativeLastSyncToken()) {
+            column.store->remove(syncToken, lid);
+        }
+    }
+}
+
+void
+SummaryColumnStore::compactLidSpace(uint32_t wantedDocIdLimit)
+{
+    for (const auto &column : _columns) {
+        if (wantedDocIdLimit < column.store->getDocIdLimit()) {
+            column.store->compactLidSpace(wantedDocIdLimit);
+        }
+    }
+}
+
+void
+SummaryColumnStore::reconfigure(const LogDocumentStore::Config &config)
+{
+    for (const auto &column : _columns) {
+        column.store->reconfigure(config);
+    }
+}
+
+uint64_t
+SummaryColumnStore::getOldestSyncToken(uint64_t syncToken) const
+{
+    for (const auto &column : _columns) {
+        syncToken = std::min(syncToken, column.store->lastSyncToken());
+    }
+    return syncToken;
+}
+
+}
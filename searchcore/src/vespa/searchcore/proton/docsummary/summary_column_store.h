@@ -0,0 +1,85 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/docstore/logdocumentstore.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <mutex>
+#include <vector>
+
+namespace document { class Document; class DocumentTypeRepo; }
+namespace search { class IBucketizer; }
+namespace search::common { class FileHeaderContext; }
+namespace search::transactionlog { class SyncProxy; }
+namespace vespalib { class nbostream; class ThreadExecutor; }
+
+namespace proton {
+
+/**
+ * Columnar layout for selected summary fields. Each column is a log
+ * document store holding documents with only that field set, stored
+ * below <baseDir>/column/<fieldName>. Summary classes only needing
+ * column fields read these stores, thus only decompressing chunks with
+ * the wanted field values instead of chunks of full documents.
+ *
+ * Each column tracks its own sync token, and writes older than what a
+ * column already has are ignored. A document missing in a column is
+ * read from the full document store.
+ */
+class SummaryColumnStore
+{
+public:
+    struct Column {
+        vespalib::string                         fieldName;
+        std::shared_ptr<search::LogDocumentStore> store;
+    };
+    using Columns = std::vector<Column>;
+
+private:
+    Columns                                           _columns;
+    mutable std::mutex                                _repoLock;
+    std::shared_ptr<const document::DocumentTypeRepo> _repo;
+
+public:
+    /**
+     * Opens the columns for the given fields. Columns not existing are
+     * created with the given initial sync token, and directories of
+     * columns no longer wanted are removed.
+     */
+    SummaryColumnStore(vespalib::ThreadExecutor &executor,
+                       const vespalib::string &baseDir,
+                       const std::vector<vespalib::string> &fieldNames,
+                       const search::LogDocumentStore::Config &config,
+                       const search::GrowStrategy &growStrategy,
+                       const search::TuneFileSummary &tuneFileSummary,
+                       const search::common::FileHeaderContext &fileHeaderContext,
+                       search::transactionlog::SyncProxy &tlSyncer,
+                       std::shared_ptr<search::IBucketizer> bucketizer,
+                       uint64_t initialSyncToken);
+    ~SummaryColumnStore();
+
+    static vespalib::string getColumnDir(const vespalib::string &baseDir);
+
+    bool empty() const { return _columns.empty(); }
+    const Columns &getColumns() const { return _columns; }
+    const search::IDocumentStore *getStore(const vespalib::string &fieldName) const;
+
+    /**
+     * Sets the repo used to deserialize documents written as streams.
+     */
+    void setRepo(std::shared_ptr<const document::DocumentTypeRepo> repo);
+
+    void put(uint64_t syncToken, uint32_t lid, const document::Document &doc);
+    void put(uint64_t syncToken, uint32_t lid, const vespalib::nbostream &os);
+    void remove(uint64_t syncToken, uint32_t lid);
+    void compactLidSpace(uint32_t wantedDocIdLimit);
+    void reconfigure(const search::LogDocumentStore::Config &config);
+
+    /**
+     * Returns the lowest sync token persisted by any column, or the
+     * given sync token if there are no columns.
+     */
+    uint64_t getOldestSyncToken(uint64_t syncToken) const;
+};
+
+}
@@ -39,8 +39,9 @@ public:
 
 }
 
-SummaryCompactTarget::SummaryCompactTarget(searchcorespi::index::IThreadService & summaryService, IDocumentStore & docStore)
-    : IFlushTarget("summary.compact", Type::GC, Component::DOCUMENT_STORE),
+SummaryCompactTarget::SummaryCompactTarget(searchcorespi::index::IThreadService & summaryService, IDocumentStore & docStore,
+                                           const vespalib::string & name)
+    : IFlushTarget(name, Type::GC, Component::DOCUMENT_STORE),
       _summaryService(summaryService),
       _docStore(docStore),
       _lastStats()
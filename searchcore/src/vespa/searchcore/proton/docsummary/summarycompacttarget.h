@@ -20,7 +20,8 @@ private:
     FlushStats _lastStats;
 
 public:
-    SummaryCompactTarget(searchcorespi::index::IThreadService & summaryService, search::IDocumentStore & docStore);
+    SummaryCompactTarget(searchcorespi::index::IThreadService & summaryService, search::IDocumentStore & docStore,
+                         const vespalib::string & name = "summary.compact");
 
     // Implements IFlushTarget
     virtual MemoryGain getApproxMemoryGain() const override;
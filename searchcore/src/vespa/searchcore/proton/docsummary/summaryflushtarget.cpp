@@ -47,8 +47,9 @@ public:
 }
 
 SummaryFlushTarget::SummaryFlushTarget(IDocumentStore & docStore,
-                                       searchcorespi::index::IThreadService & summaryService)
-    : IFlushTarget("summary.flush", Type::SYNC, Component::DOCUMENT_STORE),
+                                       searchcorespi::index::IThreadService & summaryService,
+                                       const vespalib::string & name)
+    : IFlushTarget(name, Type::SYNC, Component::DOCUMENT_STORE),
       _docStore(docStore),
       _summaryService(summaryService),
       _lastStats()
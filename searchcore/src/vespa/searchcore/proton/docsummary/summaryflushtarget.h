@@ -21,7 +21,8 @@ private:
 
 public:
     SummaryFlushTarget(search::IDocumentStore & docStore,
-                       searchcorespi::index::IThreadService & summaryService);
+                       searchcorespi::index::IThreadService & summaryService,
+                       const vespalib::string & name = "summary.flush");
 
     // Implements IFlushTarget
     virtual MemoryGain getApproxMemoryGain() const override;
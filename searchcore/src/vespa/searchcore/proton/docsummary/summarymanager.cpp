@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "summarymanager.h"
-#include "documentstoreadapter.h"
+#include "summary_column_store.h"
 #include "summarycompacttarget.h"
 #include "summaryflushtarget.h"
 #include <vespa/config/print/ostreamconfigwriter.h>
@@ -83,7 +83,7 @@ SummaryManager::SummarySetup::
 SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName, const SummaryConfig & summaryCfg,
              const SummarymapConfig & summarymapCfg, const JuniperrcConfig & juniperCfg,
              search::IAttributeManager::SP attributeMgr, search::IDocumentStore::SP docStore,
-             std::shared_ptr<const DocumentTypeRepo> repo)
+             std::shared_ptr<const DocumentTypeRepo> repo, std::shared_ptr<const SummaryColumnStore> columnStore)
     : _docsumWriter(),
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _juniperProps(juniperCfg),
@@ -92,7 +92,8 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
       _docStore(std::move(docStore)),
       _fieldCacheRepo(),
       _repo(repo),
-      _markupFields()
+      _markupFields(),
+      _columnStore(std::move(columnStore))
 {
     auto resultConfig = std::make_unique<ResultConfig>();
     if (!resultConfig->ReadConfig(summaryCfg, make_string("SummaryManager(%s)", baseDir.c_str()).c_str())) {
@@ -130,10 +131,42 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
     }
 }
 
+/**
+ * Returns the summary columns to read for the given result class, or
+ * no columns if any field read from the document is not a column.
+ */
+DocumentStoreAdapter::Columns
+SummaryManager::SummarySetup::getColumns(const vespalib::string &resultClassName) const
+{
+    DocumentStoreAdapter::Columns columns;
+    if (_columnStore->empty()) {
+        return columns;
+    }
+    const ResultConfig &resultConfig = *_docsumWriter->GetResultConfig();
+    const ResultClass *resultClass = resultConfig.LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()));
+    FieldCache::CSP fieldCache = _fieldCacheRepo->getFieldCache(resultClassName);
+    if (resultClass == nullptr || fieldCache->size() != resultClass->GetNumEntries()) {
+        return columns;
+    }
+    for (size_t i = 0; i < resultClass->GetNumEntries(); ++i) {
+        const vespalib::string fieldName(resultClass->GetEntry(i)->_bindname);
+        if (fieldCache->getField(i) == nullptr || _docsumWriter->isGenerated(fieldName)) {
+            continue;
+        }
+        const IDocumentStore *store = _columnStore->getStore(fieldName);
+        if (store == nullptr) {
+            return DocumentStoreAdapter::Columns();
+        }
+        columns.push_back({fieldName, store});
+    }
+    return columns;
+}
+
 IDocsumStore::UP
 SummaryManager::SummarySetup::createDocsumStore(const vespalib::string &resultClassName) {
     return std::make_unique<DocumentStoreAdapter>(*_docStore, *_repo, getResultConfig(), resultClassName,
-                                                  _fieldCacheRepo->getFieldCache(resultClassName), _markupFields);
+                                                  _fieldCacheRepo->getFieldCache(resultClassName), _markupFields,
+                                                  getColumns(resultClassName));
 }
 
 
@@ -142,54 +175,84 @@ SummaryManager::createSummarySetup(const SummaryConfig & summaryCfg, const Summa
                                    const JuniperrcConfig & juniperCfg, const std::shared_ptr<const DocumentTypeRepo> &repo,
                                    const search::IAttributeManager::SP &attributeMgr)
 {
+    _columnStore->setRepo(repo);
     return std::make_shared<SummarySetup>(_baseDir, _docTypeName, summaryCfg, summarymapCfg,
-                                          juniperCfg, attributeMgr, _docStore, repo);
+                                          juniperCfg, attributeMgr, _docStore, repo, _columnStore);
 }
 
 SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDocumentStore::Config & storeConfig,
                                const search::GrowStrategy & growStrategy, const vespalib::string &baseDir,
                                const DocTypeName &docTypeName, const TuneFileSummary &tuneFileSummary,
                                const FileHeaderContext &fileHeaderContext, search::transactionlog::SyncProxy &tlSyncer,
-                               search::IBucketizer::SP bucketizer)
+                               search::IBucketizer::SP bucketizer, const std::vector<vespalib::string> &columnFields)
     : _baseDir(baseDir),
       _docTypeName(docTypeName),
       _docStore(),
+      _columnStore(),
       _tuneFileSummary(tuneFileSummary),
       _currentSerial(0u)
 {
     _docStore = std::make_shared<LogDocumentStore>(executor, baseDir, storeConfig, growStrategy, tuneFileSummary,
-                                                   fileHeaderContext, tlSyncer, std::move(bucketizer));
+                                                   fileHeaderContext, tlSyncer, bucketizer);
+    _columnStore = std::make_shared<SummaryColumnStore>(executor, baseDir, columnFields, storeConfig, growStrategy,
+                                                        tuneFileSummary, fileHeaderContext, tlSyncer,
+                                                        std::move(bucketizer), _docStore->lastSyncToken());
 }
 
 SummaryManager::~SummaryManager() = default;
 
+// Operations older than what the document store already has are only replayed for the summary columns.
+
 void
 SummaryManager::putDocument(uint64_t syncToken, search::DocumentIdT lid, const Document & doc)
 {
-    _docStore->write(syncToken, lid, doc);
+    if (syncToken >= _docStore->tentativeLastSyncToken()) {
+        _docStore->write(syncToken, lid, doc);
+    }
+    _columnStore->put(syncToken, lid, doc);
     _currentSerial = syncToken;
 }
 
 void
 SummaryManager::putDocument(uint64_t syncToken, search::DocumentIdT lid, const vespalib::nbostream & doc)
 {
-    _docStore->write(syncToken, lid, doc);
+    if (syncToken >= _docStore->tentativeLastSyncToken()) {
+        _docStore->write(syncToken, lid, doc);
+    }
+    _columnStore->put(syncToken, lid, doc);
     _currentSerial = syncToken;
 }
 
 void
 SummaryManager::removeDocument(uint64_t syncToken, search::DocumentIdT lid)
 {
-    _docStore->remove(syncToken, lid);
+    if (syncToken >= _docStore->tentativeLastSyncToken()) {
+        _docStore->remove(syncToken, lid);
+    }
+    _columnStore->remove(syncToken, lid);
     _currentSerial = syncToken;
 }
 
+void
+SummaryManager::compactLidSpace(uint32_t wantedDocIdLimit)
+{
+    _docStore->compactLidSpace(wantedDocIdLimit);
+    _columnStore->compactLidSpace(wantedDocIdLimit);
+}
+
+uint64_t
+SummaryManager::getOldestSyncToken() const
+{
+    return _columnStore->getOldestSyncToken(_docStore->lastSyncToken());
+}
+
 namespace {
 
 IFlushTarget::SP
-createShrinkLidSpaceFlushTarget(searchcorespi::index::IThreadService & summaryService, IDocumentStore::SP docStore)
+createShrinkLidSpaceFlushTarget(searchcorespi::index::IThreadService & summaryService, IDocumentStore::SP docStore,
+                                const vespalib::string &name = "summary.shrink")
 {
-    return std::make_shared<ShrinkSummaryLidSpaceFlushTarget>("summary.shrink",
+    return std::make_shared<ShrinkSummaryLidSpaceFlushTarget>(name,
                                                        IFlushTarget::Type::GC,
                                                        IFlushTarget::Component::DOCUMENT_STORE,
                                                        docStore->lastSyncToken(),
@@ -208,12 +271,19 @@ IFlushTarget::List SummaryManager::getFlushTargets(searchcorespi::index::IThread
         ret.push_back(std::make_shared<SummaryCompactTarget>(summaryService, getBackingStore()));
     }
     ret.push_back(createShrinkLidSpaceFlushTarget(summaryService, _docStore));
+    for (const auto &column : _columnStore->getColumns()) {
+        vespalib::string prefix("summary.column." + column.fieldName);
+        ret.push_back(std::make_shared<SummaryFlushTarget>(*column.store, summaryService, prefix + ".flush"));
+        ret.push_back(std::make_shared<SummaryCompactTarget>(summaryService, *column.store, prefix + ".compact"));
+        ret.push_back(createShrinkLidSpaceFlushTarget(summaryService, column.store, prefix + ".shrink"));
+    }
     return ret;
 }
 
 void SummaryManager::reconfigure(const LogDocumentStore::Config & config) {
     auto & docStore = dynamic_cast<LogDocumentStore &> (*_docStore);
     docStore.reconfigure(config);
+    _columnStore->reconfigure(config);
 }
 
 } // namespace proton
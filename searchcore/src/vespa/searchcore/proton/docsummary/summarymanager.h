@@ -3,6 +3,7 @@
 
 #include "isummarymanager.h"
 #include "fieldcacherepo.h"
+#include "documentstoreadapter.h"
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcorespi/flush/iflushtarget.h>
@@ -20,6 +21,8 @@ class Fast_NormalizeWordFolder;
 
 namespace proton {
 
+class SummaryColumnStore;
+
 class SummaryManager : public ISummaryManager
 {
 public:
@@ -34,6 +37,9 @@ public:
         FieldCacheRepo::UP                    _fieldCacheRepo;
         const std::shared_ptr<const document::DocumentTypeRepo>  _repo;
         std::set<vespalib::string>            _markupFields;
+        std::shared_ptr<const SummaryColumnStore> _columnStore;
+
+        DocumentStoreAdapter::Columns getColumns(const vespalib::string &resultClassName) const;
     public:
         SummarySetup(const vespalib::string & baseDir,
                      const DocTypeName & docTypeName,
@@ -42,7 +48,8 @@ public:
                      const vespa::config::search::summary::JuniperrcConfig & juniperCfg,
                      search::IAttributeManager::SP attributeMgr,
                      search::IDocumentStore::SP docStore,
-                     std::shared_ptr<const document::DocumentTypeRepo> repo);
+                     std::shared_ptr<const document::DocumentTypeRepo> repo,
+                     std::shared_ptr<const SummaryColumnStore> columnStore);
 
         search::docsummary::IDocsumWriter & getDocsumWriter() const override { return *_docsumWriter; }
         search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
@@ -58,6 +65,7 @@ private:
     vespalib::string               _baseDir;
     DocTypeName                    _docTypeName;
     std::shared_ptr<search::IDocumentStore> _docStore;
+    std::shared_ptr<SummaryColumnStore> _columnStore;
     const search::TuneFileSummary  _tuneFileSummary;
     uint64_t                       _currentSerial;
 
@@ -71,12 +79,14 @@ public:
                    const search::TuneFileSummary &tuneFileSummary,
                    const search::common::FileHeaderContext &fileHeaderContext,
                    search::transactionlog::SyncProxy &tlSyncer,
-                   std::shared_ptr<search::IBucketizer> bucketizer);
+                   std::shared_ptr<search::IBucketizer> bucketizer,
+                   const std::vector<vespalib::string> &columnFields = std::vector<vespalib::string>());
     ~SummaryManager() override;
 
     void putDocument(uint64_t syncToken, search::DocumentIdT lid, const document::Document & doc);
     void putDocument(uint64_t syncToken, search::DocumentIdT lid, const vespalib::nbostream & doc);
     void removeDocument(uint64_t syncToken, search::DocumentIdT lid);
+    void compactLidSpace(uint32_t wantedDocIdLimit);
     searchcorespi::IFlushTarget::List getFlushTargets(searchcorespi::index::IThreadService & summaryService);
 
     ISummarySetup::SP
@@ -87,6 +97,12 @@ public:
                        const search::IAttributeManager::SP &attributeMgr) override;
 
     search::IDocumentStore & getBackingStore() override { return *_docStore; }
+    const SummaryColumnStore & getColumnStore() const { return *_columnStore; }
+    /**
+     * Returns the lowest sync token persisted by the document store or
+     * any of the summary columns.
+     */
+    uint64_t getOldestSyncToken() const;
     void reconfigure(const search::LogDocumentStore::Config & config);
 };
 
@@ -17,6 +17,7 @@ SummaryManagerInitializer(const search::GrowStrategy &grow,
                           const search::common::FileHeaderContext &fileHeaderContext,
                           search::transactionlog::SyncProxy &tlSyncer,
                           IBucketizerSP bucketizer,
+                          const std::vector<vespalib::string> &columnFields,
                           std::shared_ptr<SummaryManager::SP> result)
     : proton::initializer::InitializerTask(),
       _grow(grow),
@@ -29,6 +30,7 @@ SummaryManagerInitializer(const search::GrowStrategy &grow,
       _fileHeaderContext(fileHeaderContext),
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
+      _columnFields(columnFields),
       _result(std::move(result))
 { }
 
@@ -42,7 +44,7 @@ SummaryManagerInitializer::run()
     EventLogger::loadDocumentStoreStart(_subDbName);
     *_result = std::make_shared<SummaryManager>
                (_summaryExecutor, _storeCfg, _grow, _baseDir, _docTypeName,
-                _tuneFile, _fileHeaderContext, _tlSyncer, _bucketizer);
+                _tuneFile, _fileHeaderContext, _tlSyncer, _bucketizer, _columnFields);
     EventLogger::loadDocumentStoreComplete(_subDbName, vespalib::count_ms(timer.elapsed()));
 }
 
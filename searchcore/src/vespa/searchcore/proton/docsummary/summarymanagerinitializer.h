@@ -26,6 +26,7 @@ class SummaryManagerInitializer : public initializer::InitializerTask
     const search::common::FileHeaderContext &_fileHeaderContext;
     search::transactionlog::SyncProxy       &_tlSyncer;
     const IBucketizerSP                      _bucketizer;
+    const std::vector<vespalib::string>      _columnFields;
     std::shared_ptr<SummaryManager::SP>      _result;
 
 public:
@@ -42,6 +43,7 @@ public:
                               const search::common::FileHeaderContext & fileHeaderContext,
                               search::transactionlog::SyncProxy &tlSyncer,
                               IBucketizerSP bucketizer,
+                              const std::vector<vespalib::string> &columnFields,
                               std::shared_ptr<SummaryManager::SP> result);
     ~SummaryManagerInitializer() override;
     void run() override;
@@ -183,6 +183,7 @@ DocumentMetaStore::insert(DocId lid, const RawDocumentMetaData &metaData)
     // flush writes to meta store rcu vector before new entry is visible
     // from frozen root or lid based scan
     std::atomic_thread_fence(std::memory_order_release);
+    _gidToLidIndex.insert(metaData.getGid(), lid);
     _lidAlloc.registerLid(lid);
     updateUncommittedDocIdLimit(lid);
     incGeneration();
@@ -206,6 +207,7 @@ DocumentMetaStore::onUpdateStat()
     usage.incAllocatedBytes(bvSize);
     usage.incUsedBytes(bvSize);
     usage.merge(_gidToLidMap.getMemoryUsage());
+    usage.merge(_gidToLidIndex.getMemoryUsage());
     // the free lists are not taken into account here
     updateStatistics(_metaDataStore.size(),
                      _metaDataStore.size(),
@@ -252,13 +254,14 @@ DocumentMetaStore::readNextDoc(documentmetastore::Reader & reader, TreeType::Bui
     meta.setDocSize(reader.getNextDocSize());
     meta.setTimestamp(reader.getNextTimestamp());
     treeBuilder.insert(lid, BTreeNoLeafData());
+    _gidToLidIndex.insert(meta.getGid(), lid);
     assert(!validLid(lid));
     _lidAlloc.registerLid(lid);
     return lid;
 }
 
 bool
-DocumentMetaStore::onLoad()
+DocumentMetaStore::onLoad(vespalib::Executor *)
 {
     documentmetastore::Reader reader(openDAT());
     unload();
@@ -266,6 +269,8 @@ DocumentMetaStore::onLoad()
     size_t docIdLimit = reader.getDocIdLimit();
     _metaDataStore.unsafe_reserve(std::max(numElems, docIdLimit));
     TreeType::Builder treeBuilder(_gidToLidMap.getAllocator());
+    _gidToLidIndex.clear();
+    _gidToLidIndex.reserve(numElems);
     assert(docIdLimit > 0); // lid 0 is reserved
     ensureSpace(docIdLimit - 1);
 
@@ -301,11 +306,12 @@ DocumentMetaStore::onLoad()
 }
 
 bool
-DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId,
-                                const TreeType::Iterator &itr, bool found)
+DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId, bool found)
 {
     bool success = true;
 #if 0
+    KeyComp comp(gid, _metaDataStore, *_gidCompare);
+    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID, comp);
     TreeType::Iterator p = itr;
     --p;
     if (p.valid()) {
@@ -346,7 +352,6 @@ DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId,
 #else
     (void) gid;
     (void) bucketId;
-    (void) itr;
     (void) found;
 #endif
     return success;
@@ -443,6 +448,7 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwner::SP bucketDB,
                      grow.getDocsGrowDelta(),
                      getGenerationHolder()),
       _gidToLidMap(),
+      _gidToLidIndex(_metaDataStore),
       _lidAlloc(_metaDataStore.size(),
                 _metaDataStore.capacity(),
                 getGenerationHolder()),
@@ -475,12 +481,9 @@ DocumentMetaStore::inspectExisting(const GlobalId &gid) const
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
-    KeyComp comp(gid, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (found) {
-        res.setLid(itr.getKey());
+    DocId lid = _gidToLidIndex.find(gid);
+    if (lid != 0u) {
+        res.setLid(lid);
         res.fillPrev(_metaDataStore[res.getLid()].getTimestamp());
         res.markSuccess();
     }
@@ -492,16 +495,13 @@ DocumentMetaStore::inspect(const GlobalId &gid)
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
-    KeyComp comp(gid, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (!found) {
+    DocId lid = _gidToLidIndex.find(gid);
+    if (lid == 0u) {
         DocId myLid = peekFreeLid();
         res.setLid(myLid);
         res.markSuccess();
     } else {
-        res.setLid(itr.getKey());
+        res.setLid(lid);
         res.fillPrev(_metaDataStore[res.getLid()].getTimestamp());
         res.markSuccess();
     }
@@ -517,11 +517,9 @@ DocumentMetaStore::put(const GlobalId &gid,
 {
     Result res;
     RawDocumentMetaData metaData(gid, bucketId, timestamp, docSize);
-    KeyComp comp(metaData, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (!checkBuckets(gid, bucketId, itr, found)) {
+    DocId foundLid = _gidToLidIndex.find(gid);
+    bool found = (foundLid != 0u);
+    if (!checkBuckets(gid, bucketId, found)) {
         // Failure
     } else if (!found) {
         if (validLid(lid)) {
@@ -546,7 +544,7 @@ DocumentMetaStore::put(const GlobalId &gid,
             res.setLid(lid);
             res.markSuccess();
         }
-    } else if (lid != itr.getKey()) {
+    } else if (lid != foundLid) {
         throw IllegalStateException(
                 make_string(
                         "document meta data store"
@@ -556,7 +554,7 @@ DocumentMetaStore::put(const GlobalId &gid,
                         " gid found, but using another lid '%u'",
                         lid,
                         gid.toString().c_str(),
-                        itr.getKey()));
+                        foundLid));
     } else {
         res.setLid(lid);
         res.fillPrev(_metaDataStore[lid].getTimestamp());
@@ -604,6 +602,7 @@ DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
                         " document with lid '%u' and gid '%s'",
                         lid, gid.toString().c_str()));
     }
+    _gidToLidIndex.remove(gid, lid);
     _lidAlloc.unregisterLid(lid);
     RawDocumentMetaData &oldMetaData = _metaDataStore[lid];
     bucketGuard->remove(oldMetaData.getGid(),
@@ -649,6 +648,7 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid)
     assert(it.getKey() == fromLid);
     _gidToLidMap.thaw(it);
     it.writeKey(toLid);
+    _gidToLidIndex.move(gid, fromLid, toLid);
     _lidAlloc.moveLidEnd(fromLid, toLid);
     incGeneration();
 }
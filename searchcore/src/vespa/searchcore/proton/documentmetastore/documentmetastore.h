@@ -5,6 +5,7 @@
 #include "gid_compare.h"
 #include "document_meta_store_adapter.h"
 #include "documentmetastoreattribute.h"
+#include "gid_to_lid_hash_index.h"
 #include "lid_allocator.h"
 #include "lid_gid_key_comparator.h"
 #include "lid_hold_list.h"
@@ -65,6 +66,9 @@ private:
 
     MetaDataStore       _metaDataStore;
     TreeType            _gidToLidMap;
+    // Used for gid -> lid lookups by the writer thread. Readers use the
+    // frozen view of the tree, which only exposes committed changes.
+    documentmetastore::GidToLidHashIndex _gidToLidIndex;
     documentmetastore::LidAllocator _lidAlloc;
     IGidCompare::SP     _gidCompare;
     BucketDBOwner::SP   _bucketDB;
@@ -86,12 +90,11 @@ private:
     void onGenerationChange(generation_t generation) override;
     void removeOldGenerations(generation_t firstUsed) override;
     std::unique_ptr<search::AttributeSaver> onInitSave(vespalib::stringref fileName) override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool
     checkBuckets(const GlobalId &gid,
                  const BucketId &bucketId,
-                 const TreeType::Iterator &itr,
                  bool found);
 
     template <typename TreeView>
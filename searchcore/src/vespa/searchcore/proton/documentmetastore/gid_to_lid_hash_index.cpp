@@ -0,0 +1,178 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "gid_to_lid_hash_index.h"
+#include <cassert>
+#include <cstring>
+
+namespace proton::documentmetastore {
+
+namespace {
+
+constexpr size_t MIN_CAPACITY = 64u;
+
+}
+
+GidToLidHashIndex::Table::Table(size_t capacity)
+    : _alloc(vespalib::alloc::Alloc::alloc(capacity * sizeof(Slot))),
+      _mask(capacity - 1)
+{
+    assert((capacity & _mask) == 0);
+    memset(_alloc.get(), 0, capacity * sizeof(Slot));
+}
+
+GidToLidHashIndex::Table::~Table() = default;
+
+uint64_t
+GidToLidHashIndex::hash(const GlobalId &gid)
+{
+    uint32_t nums[GlobalId::LENGTH / sizeof(uint32_t)];
+    memcpy(nums, gid.get(), sizeof(nums));
+    uint64_t h = ((uint64_t(nums[1]) << 32) | nums[2]) ^ (uint64_t(nums[0]) * 0x9e3779b97f4a7c15ul);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdul;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t
+GidToLidHashIndex::wantedCapacity(size_t numEntries)
+{
+    // Keep load factor (including tombstones) below 3/4.
+    size_t capacity = MIN_CAPACITY;
+    while (capacity * 3 <= numEntries * 4) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+GidToLidHashIndex::GidToLidHashIndex(const MetaDataStore &metaDataStore)
+    : _table(std::make_unique<Table>(MIN_CAPACITY)),
+      _metaDataStore(metaDataStore),
+      _size(0),
+      _tombstones(0)
+{
+}
+
+GidToLidHashIndex::~GidToLidHashIndex() = default;
+
+uint32_t
+GidToLidHashIndex::find(const GlobalId &gid) const
+{
+    const Table &table = *_table;
+    uint64_t h = hash(gid);
+    uint64_t wantedHashBits = (h >> 32);
+    for (size_t idx = h & table.mask(); ; idx = (idx + 1) & table.mask()) {
+        uint64_t slot = table[idx];
+        if (slot == EMPTY) {
+            return 0u;
+        }
+        uint32_t lid = slot;
+        if (lid != 0u && (slot >> 32) == wantedHashBits && _metaDataStore[lid].getGid() == gid) {
+            return lid;
+        }
+    }
+}
+
+GidToLidHashIndex::Slot &
+GidToLidHashIndex::findSlot(const GlobalId &gid, uint32_t lid)
+{
+    Table &table = *_table;
+    uint64_t h = hash(gid);
+    uint64_t wanted = makeSlot(h, lid);
+    for (size_t idx = h & table.mask(); ; idx = (idx + 1) & table.mask()) {
+        uint64_t slot = table[idx];
+        assert(slot != EMPTY);
+        if (slot == wanted) {
+            return table[idx];
+        }
+    }
+}
+
+void
+GidToLidHashIndex::insert(const GlobalId &gid, uint32_t lid)
+{
+    assert(lid != 0u);
+    if ((_size + _tombstones + 1) * 4 >= _table->capacity() * 3) {
+        rehash(wantedCapacity(_size + 1));
+    }
+    Table &table = *_table;
+    uint64_t h = hash(gid);
+    for (size_t idx = h & table.mask(); ; idx = (idx + 1) & table.mask()) {
+        uint64_t slot = table[idx];
+        if (slot == EMPTY || slot == TOMBSTONE) {
+            if (slot == TOMBSTONE) {
+                --_tombstones;
+            }
+            table[idx] = makeSlot(h, lid);
+            ++_size;
+            return;
+        }
+    }
+}
+
+void
+GidToLidHashIndex::remove(const GlobalId &gid, uint32_t lid)
+{
+    findSlot(gid, lid) = TOMBSTONE;
+    --_size;
+    ++_tombstones;
+}
+
+void
+GidToLidHashIndex::move(const GlobalId &gid, uint32_t fromLid, uint32_t toLid)
+{
+    assert(toLid != 0u);
+    findSlot(gid, fromLid) = makeSlot(hash(gid), toLid);
+}
+
+void
+GidToLidHashIndex::rehash(size_t capacity)
+{
+    auto table = std::make_unique<Table>(capacity);
+    const Table &oldTable = *_table;
+    for (size_t oldIdx = 0; oldIdx < oldTable.capacity(); ++oldIdx) {
+        uint64_t slot = oldTable[oldIdx];
+        uint32_t lid = slot;
+        if (lid == 0u) {
+            continue;
+        }
+        uint64_t h = hash(_metaDataStore[lid].getGid());
+        size_t idx = h & table->mask();
+        while ((*table)[idx] != EMPTY) {
+            idx = (idx + 1) & table->mask();
+        }
+        (*table)[idx] = slot;
+    }
+    _table = std::move(table);
+    _tombstones = 0;
+}
+
+void
+GidToLidHashIndex::reserve(size_t numEntries)
+{
+    size_t capacity = wantedCapacity(numEntries);
+    if (capacity > _table->capacity()) {
+        rehash(capacity);
+    }
+}
+
+void
+GidToLidHashIndex::clear()
+{
+    _table = std::make_unique<Table>(MIN_CAPACITY);
+    _size = 0;
+    _tombstones = 0;
+}
+
+vespalib::MemoryUsage
+GidToLidHashIndex::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage;
+    size_t slotBytes = sizeof(Slot);
+    usage.incAllocatedBytes(_table->capacity() * slotBytes);
+    usage.incUsedBytes((_size + _tombstones) * slotBytes);
+    usage.incDeadBytes(_tombstones * slotBytes);
+    return usage;
+}
+
+}
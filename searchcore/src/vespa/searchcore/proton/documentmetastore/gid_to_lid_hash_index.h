@@ -0,0 +1,83 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "raw_document_meta_data.h"
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+namespace proton::documentmetastore {
+
+/**
+ * Open addressing hash index mapping from gid to lid. This avoids the
+ * chain of meta data store lookups performed when searching the gid
+ * ordered lid tree, which is still used for bucket ordered iteration.
+ *
+ * Each slot holds a lid and 32 bits of the gid hash, thus most probes
+ * are resolved without touching the meta data store.
+ *
+ * The index reflects the latest written state and is only accessed by
+ * the writer thread (inspect and put). Readers must use the frozen
+ * view of the gid ordered lid tree, which only exposes committed
+ * changes.
+ */
+class GidToLidHashIndex
+{
+public:
+    using GlobalId = document::GlobalId;
+    using MetaDataStore = vespalib::RcuVectorBase<RawDocumentMetaData>;
+
+private:
+    using Slot = uint64_t;
+
+    class Table {
+        vespalib::alloc::Alloc _alloc;
+        size_t                 _mask;
+    public:
+        Table(size_t capacity);
+        ~Table();
+        size_t capacity() const { return _mask + 1; }
+        size_t mask() const { return _mask; }
+        Slot &operator[](size_t idx) { return static_cast<Slot *>(_alloc.get())[idx]; }
+        const Slot &operator[](size_t idx) const { return static_cast<const Slot *>(_alloc.get())[idx]; }
+    };
+
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr uint64_t TOMBSTONE = uint64_t(1) << 32;
+
+    std::unique_ptr<Table> _table;
+    const MetaDataStore   &_metaDataStore;
+    size_t                 _size;
+    size_t                 _tombstones;
+
+    static uint64_t hash(const GlobalId &gid);
+    static uint64_t makeSlot(uint64_t hashValue, uint32_t lid) { return ((hashValue >> 32) << 32) | lid; }
+    static size_t wantedCapacity(size_t numEntries);
+    Slot &findSlot(const GlobalId &gid, uint32_t lid);
+    void rehash(size_t capacity);
+
+public:
+    GidToLidHashIndex(const MetaDataStore &metaDataStore);
+    ~GidToLidHashIndex();
+
+    /**
+     * Returns the lid for the given gid, or 0 if not found.
+     */
+    uint32_t find(const GlobalId &gid) const;
+
+    /**
+     * Inserts the given gid -> lid mapping. The gid must not already be
+     * present and the meta data for the lid must have been written.
+     */
+    void insert(const GlobalId &gid, uint32_t lid);
+    void remove(const GlobalId &gid, uint32_t lid);
+    void move(const GlobalId &gid, uint32_t fromLid, uint32_t toLid);
+    void reserve(size_t numEntries);
+    void clear();
+
+    size_t size() const { return _size; }
+    vespalib::MemoryUsage getMemoryUsage() const;
+};
+
+}
@@ -5,6 +5,11 @@
 namespace proton {
 
 CachedFlushTarget::CachedFlushTarget(const IFlushTarget::SP &target)
+    : CachedFlushTarget(target, target->getApproxBytesToWriteToDisk())
+{
+}
+
+CachedFlushTarget::CachedFlushTarget(const IFlushTarget::SP &target, uint64_t approxBytesToWriteToDisk)
     : IFlushTarget(target->getName(), target->getType(), target->getComponent()),
       _target(target),
       _flushedSerialNum(target->getFlushedSerialNum()),
@@ -12,7 +17,7 @@ CachedFlushTarget::CachedFlushTarget(const IFlushTarget::SP &target)
       _memoryGain(target->getApproxMemoryGain()),
       _diskGain(target->getApproxDiskGain()),
       _needUrgentFlush(target->needUrgentFlush()),
-      _approxBytesToWriteToDisk(target->getApproxBytesToWriteToDisk())
+      _approxBytesToWriteToDisk(approxBytesToWriteToDisk)
 {
     // empty
 }
@@ -32,6 +32,12 @@ public:
      */
     CachedFlushTarget(const IFlushTarget::SP &target);
 
+    /**
+     * Constructs a new instance of this class, using the given estimate
+     * of bytes to write instead of asking the target.
+     */
+    CachedFlushTarget(const IFlushTarget::SP &target, uint64_t approxBytesToWriteToDisk);
+
     /**
      * Returns the decorated flush target. This should not be used for anything
      * but testing, as invoking a method on the returned target beats the
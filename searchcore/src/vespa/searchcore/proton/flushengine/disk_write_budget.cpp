@@ -0,0 +1,64 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "disk_write_budget.h"
+#include <algorithm>
+
+namespace proton::flushengine {
+
+DiskWriteBudget::DiskWriteBudget(uint64_t bytesPerSecond, vespalib::duration burst, vespalib::steady_time now)
+    : _lock(),
+      _bytesPerSecond(bytesPerSecond),
+      _capacity(bytesPerSecond * vespalib::to_s(burst)),
+      _tokens(_capacity),
+      _lastRefill(now)
+{
+}
+
+DiskWriteBudget::~DiskWriteBudget() = default;
+
+void
+DiskWriteBudget::refill(const std::lock_guard<std::mutex> &, vespalib::steady_time now)
+{
+    if (now > _lastRefill) {
+        _tokens = std::min(_capacity, _tokens + vespalib::to_s(now - _lastRefill) * _bytesPerSecond);
+        _lastRefill = now;
+    }
+}
+
+bool
+DiskWriteBudget::isAvailable(vespalib::steady_time now)
+{
+    if ( ! enabled()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    refill(guard, now);
+    return (_tokens >= 0.0);
+}
+
+void
+DiskWriteBudget::consume(uint64_t bytes, vespalib::steady_time now)
+{
+    if ( ! enabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    refill(guard, now);
+    _tokens -= bytes;
+}
+
+vespalib::duration
+DiskWriteBudget::timeUntilAvailable(vespalib::steady_time now)
+{
+    if ( ! enabled()) {
+        return vespalib::duration::zero();
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    refill(guard, now);
+    if (_tokens >= 0.0) {
+        return vespalib::duration::zero();
+    }
+    return vespalib::from_s(-_tokens / _bytesPerSecond);
+}
+
+}
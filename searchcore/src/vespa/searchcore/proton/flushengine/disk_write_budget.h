@@ -0,0 +1,41 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <memory>
+#include <mutex>
+
+namespace proton::flushengine {
+
+/**
+ * Token bucket limiting the rate of bytes written to disk by flushes,
+ * fusion and document store compaction. The bucket is refilled at
+ * the configured rate up to a burst capacity. A write may start as
+ * long as the bucket is not in debt, and is charged in full, thus
+ * large writes delay the following ones until the debt is repaid.
+ * A rate of 0 disables the budget.
+ */
+class DiskWriteBudget
+{
+    mutable std::mutex    _lock;
+    const double          _bytesPerSecond;
+    const double          _capacity;
+    double                _tokens;
+    vespalib::steady_time _lastRefill;
+
+    void refill(const std::lock_guard<std::mutex> &guard, vespalib::steady_time now);
+public:
+    using SP = std::shared_ptr<DiskWriteBudget>;
+
+    DiskWriteBudget(uint64_t bytesPerSecond, vespalib::duration burst,
+                    vespalib::steady_time now = vespalib::steady_clock::now());
+    ~DiskWriteBudget();
+
+    bool enabled() const { return _bytesPerSecond > 0.0; }
+    bool isAvailable(vespalib::steady_time now = vespalib::steady_clock::now());
+    void consume(uint64_t bytes, vespalib::steady_time now = vespalib::steady_clock::now());
+    vespalib::duration timeUntilAvailable(vespalib::steady_time now = vespalib::steady_clock::now());
+};
+
+}
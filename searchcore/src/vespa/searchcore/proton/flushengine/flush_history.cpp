@@ -0,0 +1,47 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_history.h"
+
+namespace proton::flushengine {
+
+namespace {
+
+// Weight of the latest observation in the smoothed write throughput.
+constexpr double THROUGHPUT_ALPHA = 0.2;
+
+}
+
+FlushHistory::FlushHistory()
+    : _entries(),
+      _bytesPerSecond(0.0)
+{
+}
+
+FlushHistory::~FlushHistory() = default;
+
+uint64_t
+FlushHistory::estimateBytesToWrite(const vespalib::string &name, uint64_t targetEstimate)
+{
+    Entry &entry = _entries[name];
+    entry.hasOwnEstimate = (targetEstimate != 0u);
+    if (entry.hasOwnEstimate) {
+        return targetEstimate;
+    }
+    return vespalib::to_s(entry.lastDuration) * _bytesPerSecond;
+}
+
+void
+FlushHistory::recordFlush(const vespalib::string &name, uint64_t estimatedBytes, vespalib::duration duration)
+{
+    Entry &entry = _entries[name];
+    entry.lastDuration = duration;
+    double seconds = vespalib::to_s(duration);
+    if (entry.hasOwnEstimate && estimatedBytes != 0u && seconds > 0.0) {
+        double observed = estimatedBytes / seconds;
+        _bytesPerSecond = (_bytesPerSecond > 0.0)
+                          ? (_bytesPerSecond * (1.0 - THROUGHPUT_ALPHA) + observed * THROUGHPUT_ALPHA)
+                          : observed;
+    }
+}
+
+}
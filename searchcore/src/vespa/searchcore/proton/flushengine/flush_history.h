@@ -0,0 +1,45 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <map>
+
+namespace proton::flushengine {
+
+/**
+ * History of completed flushes, used by the flush engine to estimate
+ * the number of bytes a flush will write to disk.
+ *
+ * The observed write throughput is tracked for targets reporting
+ * their own estimate. For targets not able to estimate their write
+ * cost (reporting 0), the duration of their last flush multiplied by
+ * the observed throughput is used instead.
+ *
+ * Not thread safe, the flush engine serializes access.
+ */
+class FlushHistory
+{
+    struct Entry {
+        bool               hasOwnEstimate;
+        vespalib::duration lastDuration;
+        Entry() : hasOwnEstimate(false), lastDuration(vespalib::duration::zero()) { }
+    };
+    std::map<vespalib::string, Entry> _entries;
+    double                            _bytesPerSecond;
+
+public:
+    FlushHistory();
+    ~FlushHistory();
+
+    /**
+     * Returns the estimated bytes to write when flushing the named
+     * target, given the estimate reported by the target itself.
+     */
+    uint64_t estimateBytesToWrite(const vespalib::string &name, uint64_t targetEstimate);
+    void recordFlush(const vespalib::string &name, uint64_t estimatedBytes, vespalib::duration duration);
+    double getBytesPerSecond() const { return _bytesPerSecond; }
+};
+
+}
@@ -60,7 +60,8 @@ FlushEngine::FlushMeta::~FlushMeta() = default;
 
 FlushEngine::FlushInfo::FlushInfo()
     : FlushMeta("", 0),
-      _target()
+      _target(),
+      _estimatedBytes(0)
 {
 }
 
@@ -69,12 +70,14 @@ FlushEngine::FlushInfo::~FlushInfo() = default;
 
 FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination)
     : FlushMeta(destination, taskId),
-      _target(target)
+      _target(target),
+      _estimatedBytes(target->getApproxBytesToWriteToDisk())
 {
 }
 
 FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
-                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS)
+                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                         flushengine::DiskWriteBudget::SP diskWriteBudget)
     : _closed(false),
       _maxConcurrent(numThreads),
       _idleIntervalMS(idleIntervalMS),
@@ -91,7 +94,11 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _strategyLock(),
       _strategyCond(),
       _tlsStatsFactory(std::move(tlsStatsFactory)),
-      _pendingPrune()
+      _pendingPrune(),
+      _diskWriteBudget(diskWriteBudget
+                       ? std::move(diskWriteBudget)
+                       : std::make_shared<flushengine::DiskWriteBudget>(0, vespalib::duration::zero())),
+      _flushHistory()
 { }
 
 FlushEngine::~FlushEngine()
@@ -157,12 +164,24 @@ FlushEngine::wait(size_t minimumWaitTimeIfReady)
     return !_closed;
 }
 
+uint32_t
+FlushEngine::getIdleWaitTimeMS() const
+{
+    vespalib::duration budgetWait = _diskWriteBudget->timeUntilAvailable();
+    if (budgetWait > vespalib::duration::zero()) {
+        // Check again as soon as the disk write budget allows another flush.
+        int64_t budgetWaitMS = std::max(INT64_C(1), vespalib::count_ms(budgetWait));
+        return std::min(int64_t(_idleIntervalMS), budgetWaitMS);
+    }
+    return _idleIntervalMS;
+}
+
 void
 FlushEngine::Run(FastOS_ThreadInterface *, void *)
 {
     bool shouldIdle = false;
     vespalib::string prevFlushName;
-    while (wait(shouldIdle ? _idleIntervalMS : 0)) {
+    while (wait(shouldIdle ? getIdleWaitTimeMS() : 0)) {
         shouldIdle = false;
         if (prune()) {
             continue; // Prune attempted on one or more handlers
@@ -176,7 +195,7 @@ FlushEngine::Run(FastOS_ThreadInterface *, void *)
             shouldIdle = true;
         }
         LOG(debug, "Making another wait(idle=%s, timeMS=%d) last was '%s'",
-            shouldIdle ? "true" : "false", shouldIdle ? _idleIntervalMS : 0, prevFlushName.c_str());
+            shouldIdle ? "true" : "false", shouldIdle ? getIdleWaitTimeMS() : 0, prevFlushName.c_str());
     }
     _executor.sync();
     prune();
@@ -239,8 +258,10 @@ FlushEngine::getTargetList(bool includeFlushingTargets) const
             for (const IFlushTarget::SP & target : lst) {
                 LOG(spam, "Checking target '%s' with flushedSerialNum = %" PRIu64,
                     target->getName().c_str(), target->getFlushedSerialNum());
-                if (!isFlushing(guard, FlushContext::createName(handler, *target)) || includeFlushingTargets) {
-                    ret.push_back(std::make_shared<FlushContext>(it.second, std::make_shared<CachedFlushTarget>(target), serial));
+                vespalib::string name(FlushContext::createName(handler, *target));
+                if (!isFlushing(guard, name) || includeFlushingTargets) {
+                    uint64_t bytesToWrite = _flushHistory.estimateBytesToWrite(name, target->getApproxBytesToWriteToDisk());
+                    ret.push_back(std::make_shared<FlushContext>(it.second, std::make_shared<CachedFlushTarget>(target, bytesToWrite), serial));
                 } else {
                     LOG(debug, "Target '%s' with flushedSerialNum = %" PRIu64 " already has a flush going. Local last serial = %" PRIu64 ".",
                         target->getName().c_str(), target->getFlushedSerialNum(), serial);
@@ -270,7 +291,12 @@ FlushContext::SP
 FlushEngine::initNextFlush(const FlushContext::List &lst)
 {
     FlushContext::SP ctx;
+    bool budgetAvailable = _diskWriteBudget->isAvailable();
     for (const FlushContext::SP & it : lst) {
+        if ( ! budgetAvailable && ! it->getTarget()->needUrgentFlush()) {
+            LOG(debug, "Disk write budget exhausted, postponing flush of target '%s'.", it->getName().c_str());
+            continue;
+        }
         if (LOG_WOULD_LOG(event)) {
             EventLogger::flushInit(it->getName());
         }
@@ -342,6 +368,7 @@ FlushEngine::initFlush(const FlushContext &ctx)
         EventLogger::flushStart(ctx.getName(), mgain.getBefore(), mgain.getAfter(), mgain.gain(),
                                 ctx.getTarget()->getFlushedSerialNum() + 1, ctx.getHandler()->getCurrentSerialNumber());
     }
+    _diskWriteBudget->consume(ctx.getTarget()->getApproxBytesToWriteToDisk());
     return initFlush(ctx.getHandler(), ctx.getTarget());
 }
 
@@ -360,6 +387,7 @@ FlushEngine::flushDone(const FlushContext &ctx, uint32_t taskId)
     }
     LOG(debug, "FlushEngine::flushDone(taskId='%d') took '%f' secs", taskId, vespalib::to_s(duration));
     std::lock_guard<std::mutex> guard(_lock);
+    _flushHistory.recordFlush(ctx.getName(), _flushing[taskId]._estimatedBytes, duration);
     _flushing.erase(taskId);
     assert(ctx.getHandler());
     if (_handlers.hasHandler(ctx.getHandler())) {
@@ -1,7 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "disk_write_budget.h"
 #include "flushcontext.h"
+#include "flush_history.h"
 #include "iflushstrategy.h"
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchcore/proton/common/doctypename.h>
@@ -43,6 +45,7 @@ private:
         ~FlushInfo();
 
         IFlushTarget::SP  _target;
+        uint64_t          _estimatedBytes;
     };
     typedef std::map<uint32_t, FlushInfo> FlushMap;
     typedef HandlerMap<IFlushHandler> FlushHandlerMap;
@@ -63,6 +66,8 @@ private:
     std::condition_variable        _strategyCond;
     std::shared_ptr<flushengine::ITlsStatsFactory> _tlsStatsFactory;
     std::set<IFlushHandler::SP>    _pendingPrune;
+    flushengine::DiskWriteBudget::SP _diskWriteBudget;
+    mutable flushengine::FlushHistory _flushHistory;
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
     std::pair<FlushContext::List,bool> getSortedTargetList();
@@ -75,6 +80,7 @@ private:
     void flushDone(const FlushContext &ctx, uint32_t taskId);
     bool canFlushMore(const std::unique_lock<std::mutex> &guard) const;
     bool wait(size_t minimumWaitTimeIfReady);
+    uint32_t getIdleWaitTimeMS() const;
     bool isFlushing(const std::lock_guard<std::mutex> &guard, const vespalib::string & name) const;
 
     friend class FlushTask;
@@ -95,9 +101,14 @@ public:
      * @param strategy   The flushing strategy to use.
      * @param numThreads The number of worker threads to use.
      * @param idleInterval The interval between when flushes are checked whne there are no one progressing.
+     * @param diskWriteBudget The budget for bytes written to disk by flushes.
+     *                        Urgent flushes and priority strategies are not
+     *                        held back by the budget, but are charged to it.
+     *                        No budget means unlimited.
      */
     FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
-                IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS);
+                IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                flushengine::DiskWriteBudget::SP diskWriteBudget = flushengine::DiskWriteBudget::SP());
 
     /**
      * Destructor. Waits for all pending tasks to complete.
@@ -161,6 +172,8 @@ public:
     FlushMetaSet getCurrentlyFlushingSet() const;
 
     void setStrategy(IFlushStrategy::SP strategy);
+
+    const flushengine::DiskWriteBudget::SP &getDiskWriteBudget() const { return _diskWriteBudget; }
 };
 
 } // namespace proton
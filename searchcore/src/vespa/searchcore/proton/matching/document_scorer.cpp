@@ -1,9 +1,11 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_scorer.h"
+#include <algorithm>
 #include <cassert>
 
 using search::feature_t;
+using search::fef::FeatureExecutor;
 using search::fef::FeatureResolver;
 using search::fef::RankProgram;
 using search::fef::LazyValue;
@@ -21,12 +23,24 @@ extractScoreFeature(const RankProgram &rankProgram)
     return resolver.resolve(0);
 }
 
+FeatureExecutor *
+extractBatchExecutor(const LazyValue &scoreFeature)
+{
+    FeatureExecutor *executor = scoreFeature.executor();
+    if ((executor != nullptr) && executor->supports_batch()) {
+        return executor;
+    }
+    return nullptr;
+}
+
 }
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _batchExecutor(extractBatchExecutor(_scoreFeature)),
+      _batchScores()
 {
 }
 
@@ -36,4 +50,28 @@ DocumentScorer::score(uint32_t docId)
     return doScore(docId);
 }
 
+void
+DocumentScorer::scoreBatch(vespalib::ArrayRef<Hit> hits)
+{
+    if (_batchExecutor == nullptr) {
+        for (auto &hit : hits) {
+            hit.second = doScore(hit.first);
+        }
+        return;
+    }
+    _batchScores.resize(BATCH_SIZE);
+    for (size_t offset = 0; offset < hits.size(); offset += BATCH_SIZE) {
+        size_t numDocs = std::min(BATCH_SIZE, hits.size() - offset);
+        for (size_t i = 0; i < numDocs; ++i) {
+            uint32_t docId = hits[offset + i].first;
+            _searchItr.unpack(docId);
+            _batchExecutor->gather_batch(docId, i);
+        }
+        _batchExecutor->execute_batch(vespalib::ArrayRef<feature_t>(_batchScores.data(), numDocs));
+        for (size_t i = 0; i < numDocs; ++i) {
+            hits[offset + i].second = _batchScores[i];
+        }
+    }
+}
+
 }
@@ -13,14 +13,22 @@ namespace matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking match data.
  * The calculateScore() function is always called in increasing docId order.
+ * If the executor producing the score supports batch evaluation,
+ * scoreBatch() will evaluate blocks of documents in one go.
  */
 class DocumentScorer : public search::queryeval::HitCollector::DocumentScorer
 {
 private:
+    using Hit = search::queryeval::HitCollector::Hit;
+
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    search::fef::FeatureExecutor *_batchExecutor;
+    std::vector<search::feature_t> _batchScores;
 
 public:
+    static constexpr size_t BATCH_SIZE = 64;
+
     DocumentScorer(search::fef::RankProgram &rankProgram,
                    search::queryeval::SearchIterator &searchItr);
 
@@ -30,6 +38,7 @@ public:
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+    void scoreBatch(vespalib::ArrayRef<Hit> hits) override;
 };
 
 } // namespace proton::matching
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "attribute_metrics.h"
+#include <vespa/searchcommon/attribute/status.h>
 
 namespace proton {
 
@@ -8,10 +9,33 @@ using Entry = AttributeMetrics::Entry;
 
 AttributeMetrics::Entry::Entry(const vespalib::string &attrName)
     : metrics::MetricSet("attribute", {{"field", attrName}}, "Metrics for a given attribute vector", nullptr),
-      memoryUsage(this)
+      memoryUsage(this),
+      compaction(this)
 {
 }
 
+AttributeMetrics::Entry::~Entry() = default;
+
+AttributeMetrics::Entry::CompactionMetrics::CompactionMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("compaction", {}, "Compaction metrics for a given attribute vector", parent),
+      steps("steps", {}, "The number of bounded compaction steps performed", this),
+      bytesMoved("bytes_moved", {}, "The number of bytes moved by compaction", this),
+      stallTime("stall_time", {}, "The time (in seconds) the write thread has spent in compaction steps", this),
+      progress("progress", {}, "The progress (0.0-1.0) of the ongoing compaction (1.0 when idle)", this)
+{
+}
+
+AttributeMetrics::Entry::CompactionMetrics::~CompactionMetrics() = default;
+
+void
+AttributeMetrics::Entry::CompactionMetrics::update(const search::attribute::Status &status)
+{
+    steps.set(status.getCompactionSteps());
+    bytesMoved.set(status.getCompactionBytesMoved());
+    stallTime.set(status.getCompactionStallTimeUs() / 1000000.0);
+    progress.set(status.getCompactionProgress());
+}
+
 AttributeMetrics::AttributeMetrics(metrics::MetricSet *parent)
     : _parent(parent),
       _attributes()
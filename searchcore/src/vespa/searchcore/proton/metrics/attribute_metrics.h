@@ -5,6 +5,8 @@
 #include <vespa/metrics/metrics.h>
 #include "memory_usage_metrics.h"
 
+namespace search::attribute { class Status; }
+
 namespace proton {
 
 class AttributeMetrics
@@ -12,8 +14,19 @@ class AttributeMetrics
 public:
     struct Entry : public metrics::MetricSet {
         using SP = std::shared_ptr<Entry>;
+        struct CompactionMetrics : public metrics::MetricSet {
+            metrics::LongValueMetric steps;
+            metrics::LongValueMetric bytesMoved;
+            metrics::DoubleValueMetric stallTime;
+            metrics::DoubleValueMetric progress;
+            CompactionMetrics(metrics::MetricSet *parent);
+            ~CompactionMetrics() override;
+            void update(const search::attribute::Status &status);
+        };
         MemoryUsageMetrics memoryUsage;
+        CompactionMetrics compaction;
         Entry(const vespalib::string &attrName);
+        ~Entry() override;
     };
 private:
     using Map = std::map<vespalib::string, Entry::SP>;
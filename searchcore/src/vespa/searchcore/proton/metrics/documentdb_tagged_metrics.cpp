@@ -32,6 +32,7 @@ DocumentDBTaggedMetrics::SubDBMetrics::SubDBMetrics(const vespalib::string &name
     : MetricSet(name, {}, "Sub database metrics", parent),
       lidSpace(this),
       documentStore(this),
+      termSummary(this),
       attributes(this)
 {
 }
@@ -78,6 +79,14 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::DocumentStoreMetric
 
 DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::~DocumentStoreMetrics() = default;
 
+DocumentDBTaggedMetrics::SubDBMetrics::TermSummaryMetrics::TermSummaryMetrics(MetricSet *parent)
+    : MetricSet("term_summary", {}, "Term summary metrics for this document sub DB", parent),
+      memoryUsage(this)
+{
+}
+
+DocumentDBTaggedMetrics::SubDBMetrics::TermSummaryMetrics::~TermSummaryMetrics() = default;
+
 DocumentDBTaggedMetrics::AttributeMetrics::AttributeMetrics(MetricSet *parent)
     : MetricSet("attribute", {}, "Attribute vector metrics for this document db", parent),
       resourceUsage(this),
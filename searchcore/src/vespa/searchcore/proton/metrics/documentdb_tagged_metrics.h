@@ -72,8 +72,17 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             ~DocumentStoreMetrics() override;
         };
 
+        struct TermSummaryMetrics : metrics::MetricSet
+        {
+            MemoryUsageMetrics memoryUsage;
+
+            TermSummaryMetrics(metrics::MetricSet *parent);
+            ~TermSummaryMetrics() override;
+        };
+
         LidSpaceMetrics lidSpace;
         DocumentStoreMetrics documentStore;
+        TermSummaryMetrics termSummary;
         proton::AttributeMetrics attributes;
 
         SubDBMetrics(const vespalib::string &name, metrics::MetricSet *parent);
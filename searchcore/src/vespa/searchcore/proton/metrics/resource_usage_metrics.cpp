@@ -12,7 +12,10 @@ ResourceUsageMetrics::ResourceUsageMetrics(metrics::MetricSet *parent)
       memoryUtilization("memory_utilization", {}, "The relative amount of memory used compared to the memory resource limit", this),
       memoryMappings("memory_mappings", {}, "The number of mapped memory areas", this),
       openFileDescriptors("open_file_descriptors", {}, "The number of open files", this),
-      feedingBlocked("feeding_blocked", {}, "Whether feeding is blocked due to resource limits being reached (value is either 0 or 1)", this)
+      feedingBlocked("feeding_blocked", {}, "Whether feeding is blocked due to resource limits being reached (value is either 0 or 1)", this),
+      hugePagesExplicitBytes("hugepages_explicit_bytes", {}, "The number of bytes currently mapped using explicit huge pages", this),
+      hugePagesTransparentBytes("hugepages_transparent_bytes", {}, "The number of bytes currently mapped with transparent huge pages advised", this),
+      hugePagesFallbacks("hugepages_fallbacks", {}, "The number of explicit huge page allocations that fell back to transparent huge pages", this)
 {
 }
 
@@ -18,6 +18,9 @@ struct ResourceUsageMetrics : metrics::MetricSet
     metrics::LongValueMetric memoryMappings;
     metrics::LongValueMetric openFileDescriptors;
     metrics::LongValueMetric feedingBlocked;
+    metrics::LongValueMetric hugePagesExplicitBytes;
+    metrics::LongValueMetric hugePagesTransparentBytes;
+    metrics::LongValueMetric hugePagesFallbacks;
 
     ResourceUsageMetrics(metrics::MetricSet *parent);
     ~ResourceUsageMetrics();
@@ -266,6 +266,11 @@ DocumentIterator::fetchCompleteSource(const IDocumentRetriever & source, Iterate
         }
     }
     LOG(debug, "metadata count after filtering: %zu", lidsToFetch.size());
+    const auto &termHashes = _selection.getRequiredTermHashes();
+    if (!_metaOnly && !termHashes.empty() && _selection.getTimestampSubset().empty()) {
+        source.filterLidsByTerms(lidsToFetch, termHashes);
+        LOG(debug, "metadata count after term filtering: %zu", lidsToFetch.size());
+    }
 
     if ( _metaOnly ) {
         for (uint32_t lid : lidsToFetch) {
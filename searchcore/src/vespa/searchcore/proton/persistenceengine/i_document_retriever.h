@@ -47,6 +47,15 @@ public:
     virtual void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const = 0;
 
     virtual CachedSelect::SP parseSelect(const vespalib::string &selection) const = 0;
+
+    /**
+     * Removes the lids of documents known not to contain all the given words,
+     * hashed by search::streaming::TermSummary. The default is to keep all lids.
+     */
+    virtual void filterLidsByTerms(LidVector &lids, const std::vector<uint64_t> &termHashes) const {
+        (void) lids;
+        (void) termHashes;
+    }
 };
 
 class DocumentRetrieverBaseForTest : public IDocumentRetriever {
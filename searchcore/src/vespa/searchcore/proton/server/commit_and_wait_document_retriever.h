@@ -58,6 +58,11 @@ public:
     uint32_t getDocIdLimit() const override {
         return _retriever->getDocIdLimit();
     }
+    void filterLidsByTerms(LidVector &lids, const std::vector<uint64_t> &termHashes) const override {
+        // Filter against the same committed state as the documents are visited in
+        _commit.commitAndWait();
+        _retriever->filterLidsByTerms(lids, termHashes);
+    }
 };
 
 } // namespace proton
@@ -66,19 +66,39 @@ namespace {
 constexpr uint32_t indexing_thread_stack_size = 128 * 1024;
 
 using Allocation = ProtonConfig::Documentdb::Allocation;
+
+vespalib::alloc::HugePagePolicy
+makeHugePagePolicy(Allocation::Hugepages hugepages)
+{
+    switch (hugepages) {
+    case Allocation::Hugepages::TRANSPARENT:
+        return vespalib::alloc::HugePagePolicy::TRANSPARENT;
+    case Allocation::Hugepages::EXPLICIT:
+        return vespalib::alloc::HugePagePolicy::EXPLICIT;
+    default:
+        return vespalib::alloc::HugePagePolicy::DEFAULT;
+    }
+}
+
 GrowStrategy
 makeGrowStrategy(uint32_t docsInitialCapacity, const Allocation &allocCfg)
 {
-    return GrowStrategy(docsInitialCapacity, allocCfg.growfactor, allocCfg.growbias, allocCfg.multivaluegrowfactor);
+    GrowStrategy growStrategy(docsInitialCapacity, allocCfg.growfactor, allocCfg.growbias, allocCfg.multivaluegrowfactor);
+    growStrategy.setHugePagePolicy(makeHugePagePolicy(allocCfg.hugepages));
+    return growStrategy;
 }
 
 DocumentSubDBCollection::Config
-makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const Allocation & allocCfg, size_t numSearcherThreads) {
+makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const ProtonConfig::Documentdb & docDbCfg,
+                size_t numSearcherThreads) {
+    const Allocation & allocCfg = docDbCfg.allocation;
     size_t initialNumDocs(allocCfg.initialnumdocs);
     GrowStrategy searchableGrowth = makeGrowStrategy(initialNumDocs * distCfg.searchablecopies, allocCfg);
     GrowStrategy removedGrowth = makeGrowStrategy(std::max(1024ul, initialNumDocs/100), allocCfg);
     GrowStrategy notReadyGrowth = makeGrowStrategy(initialNumDocs * (distCfg.redundancy - distCfg.searchablecopies), allocCfg);
-    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount, numSearcherThreads);
+    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount,
+                                           numSearcherThreads, docDbCfg.summary.columnfields,
+                                           docDbCfg.termsummary.bitsperword);
 }
 
 index::IndexConfig
@@ -169,7 +189,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _subDBs(*this, *this, _feedHandler, _docTypeName, _writeService, warmupExecutor, fileHeaderContext,
               metricsWireService, getMetrics(), queryLimiter, clock, _configMutex, _baseDir,
               makeSubDBConfig(protonCfg.distribution,
-                              findDocumentDB(protonCfg.documentdb, docTypeName.getName())->allocation,
+                              *findDocumentDB(protonCfg.documentdb, docTypeName.getName()),
                               protonCfg.numsearcherthreads),
               hwInfo),
       _maintenanceController(_writeService.master(), sharedExecutor, _docTypeName),
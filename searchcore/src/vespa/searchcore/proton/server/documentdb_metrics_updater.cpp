@@ -81,10 +81,12 @@ struct TempAttributeMetric
 {
     MemoryUsage memoryUsage;
     uint64_t    bitVectors;
+    search::attribute::Status status;
 
     TempAttributeMetric()
         : memoryUsage(),
-          bitVectors(0)
+          bitVectors(0),
+          status()
     {}
 };
 
@@ -109,13 +111,15 @@ isNotReadySubDB(const IDocumentSubDB *subDb, const DocumentSubDBCollection &subD
 
 void
 fillTempAttributeMetrics(TempAttributeMetrics &metrics, const vespalib::string &attrName,
-                         const MemoryUsage &memoryUsage, uint32_t bitVectors)
+                         const MemoryUsage &memoryUsage, uint32_t bitVectors,
+                         const search::attribute::Status &status)
 {
     metrics.total.memoryUsage.merge(memoryUsage);
     metrics.total.bitVectors += bitVectors;
     TempAttributeMetric &m = metrics.attrs[attrName];
     m.memoryUsage.merge(memoryUsage);
     m.bitVectors += bitVectors;
+    m.status = status;
 }
 
 void
@@ -136,9 +140,9 @@ fillTempAttributeMetrics(TempAttributeMetrics &totalMetrics,
                 const search::attribute::Status &status = attr->getStatus();
                 MemoryUsage memoryUsage(status.getAllocated(), status.getUsed(), status.getDead(), status.getOnHold());
                 uint32_t bitVectors = status.getBitVectors();
-                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors);
+                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors, status);
                 if (subMetrics != nullptr) {
-                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors);
+                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors, status);
                 }
             }
         }
@@ -152,6 +156,7 @@ updateAttributeMetrics(AttributeMetrics &metrics, const TempAttributeMetrics &tm
         auto entry = metrics.get(attr.first);
         if (entry) {
             entry->memoryUsage.update(attr.second.memoryUsage);
+            entry->compaction.update(attr.second.status);
         }
     }
 }
@@ -268,6 +273,13 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDB
     updateDocumentStoreMetrics(metrics.notReady.documentStore, subDBs.getNotReadySubDB(), lastDocStoreCacheStats.notReadySubDb, totalStats);
 }
 
+void
+updateTermSummaryMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDBCollection &subDBs, TotalStats &totalStats)
+{
+    updateMemoryUsageMetrics(metrics.ready.termSummary.memoryUsage, subDBs.getReadySubDB()->getTermSummaryMemoryUsage(), totalStats);
+    updateMemoryUsageMetrics(metrics.notReady.termSummary.memoryUsage, subDBs.getNotReadySubDB()->getTermSummaryMemoryUsage(), totalStats);
+}
+
 template <typename MetricSetType>
 void
 updateLidSpaceMetrics(MetricSetType &metrics, const search::IDocumentMetaStore &metaStore)
@@ -294,6 +306,7 @@ DocumentDBMetricsUpdater::updateMetrics(DocumentDBTaggedMetrics &metrics)
     updateSessionCacheMetrics(metrics, _sessionManager);
     updateDocumentsMetrics(metrics, _subDBs);
     updateDocumentStoreMetrics(metrics, _subDBs, _lastDocStoreCacheStats, totalStats);
+    updateTermSummaryMetrics(metrics, _subDBs, totalStats);
     updateMiscMetrics(metrics, threadingServiceStats);
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
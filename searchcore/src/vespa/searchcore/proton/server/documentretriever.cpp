@@ -34,8 +34,9 @@ DocumentRetriever
                     const Schema &schema,
                     const IDocumentMetaStoreContext &meta_store,
                     const IAttributeManager &attr_manager,
-                    const IDocumentStore &doc_store)
-    : DocumentRetrieverBase(docTypeName, repo, meta_store, true),
+                    const IDocumentStore &doc_store,
+                    TermSummaryStore::SP termSummaryStore)
+    : DocumentRetrieverBase(docTypeName, repo, meta_store, true, std::move(termSummaryStore)),
       _schema(schema),
       _attr_manager(attr_manager),
       _doc_store(doc_store),
@@ -22,7 +22,8 @@ public:
                       const search::index::Schema &schema,
                       const IDocumentMetaStoreContext &meta_store,
                       const search::IAttributeManager &attr_manager,
-                      const search::IDocumentStore &doc_store);
+                      const search::IDocumentStore &doc_store,
+                      TermSummaryStore::SP termSummaryStore = TermSummaryStore::SP());
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
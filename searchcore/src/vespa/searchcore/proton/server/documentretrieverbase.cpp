@@ -15,11 +15,13 @@ DocumentRetrieverBase::DocumentRetrieverBase(
         const DocTypeName &docTypeName,
         const document::DocumentTypeRepo &repo,
         const IDocumentMetaStoreContext &meta_store,
-        bool hasFields)
+        bool hasFields,
+        TermSummaryStore::SP termSummaryStore)
     : IDocumentRetriever(),
       _docTypeName(docTypeName),
       _repo(repo),
       _meta_store(meta_store),
+      _termSummaryStore(std::move(termSummaryStore)),
       _selectCache(256u),
       _lock(),
       _emptyDoc(),
@@ -32,6 +34,14 @@ DocumentRetrieverBase::DocumentRetrieverBase(
 
 DocumentRetrieverBase::~DocumentRetrieverBase() = default;
 
+void
+DocumentRetrieverBase::filterLidsByTerms(LidVector &lids, const std::vector<uint64_t> &termHashes) const
+{
+    if (_termSummaryStore) {
+        _termSummaryStore->filterLids(lids, termHashes);
+    }
+}
+
 const document::DocumentTypeRepo &
 DocumentRetrieverBase::getDocumentTypeRepo() const {
     return _repo;
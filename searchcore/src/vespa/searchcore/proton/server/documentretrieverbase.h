@@ -4,6 +4,7 @@
 
 #include <vespa/searchcore/proton/persistenceengine/i_document_retriever.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
+#include <vespa/searchcore/proton/common/term_summary_store.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/lrucache_map.h>
 #include <vespa/searchlib/attribute/iattributemanager.h>
@@ -16,6 +17,7 @@ class DocumentRetrieverBase : public IDocumentRetriever
     const DocTypeName                &_docTypeName;
     const document::DocumentTypeRepo &_repo;
     const IDocumentMetaStoreContext  &_meta_store;
+    const TermSummaryStore::SP        _termSummaryStore;
 
     using SelectCache = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, CachedSelect::SP>>;
 
@@ -30,7 +32,8 @@ public:
     DocumentRetrieverBase(const DocTypeName &docTypeName,
                           const document::DocumentTypeRepo &repo,
                           const IDocumentMetaStoreContext &meta_store,
-                          bool hasFields);
+                          bool hasFields,
+                          TermSummaryStore::SP termSummaryStore = TermSummaryStore::SP());
     ~DocumentRetrieverBase();
 
     const document::DocumentTypeRepo &getDocumentTypeRepo() const override;
@@ -40,6 +43,7 @@ public:
     CachedSelect::SP parseSelect(const vespalib::string &selection) const override;
     ReadGuard getReadGuard() const override { return _meta_store.getReadGuard(); }
     uint32_t getDocIdLimit() const override { return _meta_store.getReadGuard()->get().getCommittedDocIdLimit(); }
+    void filterLidsByTerms(LidVector &lids, const std::vector<uint64_t> &termHashes) const override;
 };
 
 }  // namespace proton
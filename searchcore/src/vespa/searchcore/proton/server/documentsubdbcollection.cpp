@@ -20,12 +20,16 @@ using vespalib::makeLambdaTask;
 namespace proton {
 
 DocumentSubDBCollection::Config::Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads)
+                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads,
+                                        std::vector<vespalib::string> summaryColumnFields,
+                                        uint32_t termSummaryBitsPerWord)
     : _readyGrowth(ready),
       _notReadyGrowth(notReady),
       _removedGrowth(removed),
       _fixedAttributeTotalSkew(fixedAttributeTotalSkew),
-      _numSearchThreads(numSearchThreads)
+      _numSearchThreads(numSearchThreads),
+      _summaryColumnFields(std::move(summaryColumnFields)),
+      _termSummaryBitsPerWord(termSummaryBitsPerWord)
 { }
 
 DocumentSubDBCollection::DocumentSubDBCollection(
@@ -67,7 +71,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                     FastAccessDocSubDB::Config(
                             StoreOnlyDocSubDB::Config(docTypeName, "0.ready", baseDir,
                                     cfg.getReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                    _readySubDbId, SubDbType::READY),
+                                    _readySubDbId, SubDbType::READY, cfg.getSummaryColumnFields(),
+                                    cfg.getTermSummaryBitsPerWord()),
                             true, true, false),
                     cfg.getNumSearchThreads()),
                 SearchableDocSubDB::Context(
@@ -85,7 +90,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                 FastAccessDocSubDB::Config(
                         StoreOnlyDocSubDB::Config(docTypeName, "2.notready", baseDir,
                                 cfg.getNotReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                _notReadySubDbId, SubDbType::NOTREADY),
+                                _notReadySubDbId, SubDbType::NOTREADY, std::vector<vespalib::string>(),
+                                cfg.getTermSummaryBitsPerWord()),
                         true, true, true),
                 FastAccessDocSubDB::Context(context, metrics.notReady.attributes, metricsWireService)));
 }
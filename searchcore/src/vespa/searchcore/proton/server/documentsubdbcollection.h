@@ -6,6 +6,7 @@
 #include <vespa/searchcore/proton/common/hw_info.h>
 #include <vespa/searchcommon/common/growstrategy.h>
 #include <vespa/searchlib/common/serialnum.h>
+#include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/varholder.h>
 #include <mutex>
 
@@ -60,18 +61,24 @@ public:
     public:
         using GrowStrategy = search::GrowStrategy;
         Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-               size_t fixedAttributeTotalSkew, size_t numSearchThreads);
+               size_t fixedAttributeTotalSkew, size_t numSearchThreads,
+               std::vector<vespalib::string> summaryColumnFields = std::vector<vespalib::string>(),
+               uint32_t termSummaryBitsPerWord = 0);
         GrowStrategy getReadyGrowth() const { return _readyGrowth; }
         GrowStrategy getNotReadyGrowth() const { return _notReadyGrowth; }
         GrowStrategy getRemovedGrowth() const { return _removedGrowth; }
         size_t getNumSearchThreads() const { return _numSearchThreads; }
         size_t getFixedAttributeTotalSkew() const { return _fixedAttributeTotalSkew; }
+        const std::vector<vespalib::string> &getSummaryColumnFields() const { return _summaryColumnFields; }
+        uint32_t getTermSummaryBitsPerWord() const { return _termSummaryBitsPerWord; }
     private:
         const GrowStrategy _readyGrowth;
         const GrowStrategy _notReadyGrowth;
         const GrowStrategy _removedGrowth;
         const size_t       _fixedAttributeTotalSkew;
         const size_t       _numSearchThreads;
+        const std::vector<vespalib::string> _summaryColumnFields;
+        const uint32_t     _termSummaryBitsPerWord;
     };
 
 private:
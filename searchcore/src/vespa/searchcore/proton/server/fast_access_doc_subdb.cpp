@@ -80,6 +80,7 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                          _attributeGrowNumDocs,
                                                          _fastAccessAttributesOnly,
                                                          _writeService.master(),
+                                                         _writeService.shared(),
                                                          attrMgrResult);
 }
 
@@ -28,7 +28,8 @@ FastAccessDocSubDBConfigurer::reconfigureFeedView(const FastAccessFeedView::SP &
                     repo,
                     curr->getWriteService(),
                     curr->getLidReuseDelayer(),
-                    curr->getCommitTimeTracker()),
+                    curr->getCommitTimeTracker(),
+                    curr->getTermSummaryStore()),
             curr->getPersistentParams(),
             FastAccessFeedView::Context(writer,
                     curr->getDocIdLimit()))));
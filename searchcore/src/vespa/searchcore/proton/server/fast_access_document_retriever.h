@@ -27,7 +27,8 @@ public:
                             *feedView->getSchema(),
                             *feedView->getDocumentMetaStore(),
                             *attrMgr,
-                            feedView->getDocumentStore()),
+                            feedView->getDocumentStore(),
+                            feedView->getTermSummaryStore()),
           _feedView(feedView),
           _attrMgr(attrMgr)
     { }
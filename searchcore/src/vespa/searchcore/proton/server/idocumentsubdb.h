@@ -6,6 +6,7 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/searchlib/util/searchable_stats.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/memoryusage.h>
 
 namespace search::index { class Schema; }
 
@@ -111,6 +112,7 @@ public:
     virtual void pruneRemovedFields(SerialNum serialNum) = 0;
     virtual void setIndexSchema(const SchemaSP &schema, SerialNum serialNum) = 0;
     virtual search::SearchableStats getSearchableStats() const = 0;
+    virtual vespalib::MemoryUsage getTermSummaryMemoryUsage() const = 0;
     virtual std::unique_ptr<IDocumentRetriever> getDocumentRetriever() = 0;
 
     virtual matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const = 0;
@@ -122,6 +122,17 @@ computeGain(const IFlushTarget::DiskGain & gain) {
     return std::max(INT64_C(100000000), std::max(gain.getBefore(), gain.getAfter()));
 }
 
+/*
+ * Memory freed per byte written to disk. Small flushes are dominated by
+ * fixed costs, thus the number of bytes written is capped from below.
+ */
+double
+memoryGainPerByteWritten(const IFlushTarget &target) {
+    constexpr uint64_t minBytesToWrite = 1024 * 1024;
+    uint64_t bytesToWrite = std::max(minBytesToWrite, target.getApproxBytesToWriteToDisk());
+    return double(target.getApproxMemoryGain().gain()) / bytesToWrite;
+}
+
 }
 
 FlushContext::List
@@ -230,8 +241,14 @@ MemoryFlush::CompareTarget::operator()(const FlushContext::SP &lfc, const FlushC
     }
 
     switch (_order) {
-    case MEMORY:
+    case MEMORY: {
+        double lhsGainPerByte = memoryGainPerByteWritten(lhs);
+        double rhsGainPerByte = memoryGainPerByteWritten(rhs);
+        if (lhsGainPerByte != rhsGainPerByte) {
+            return (lhsGainPerByte > rhsGainPerByte);
+        }
         return (lhs.getApproxMemoryGain().gain() > rhs.getApproxMemoryGain().gain());
+    }
     case TLSSIZE: {
         const flushengine::TlsStats &lhsTlsStats = _tlsStatsMap.getTlsStats(lfc->getHandler()->getName());
         const flushengine::TlsStats &rhsTlsStats = _tlsStatsMap.getTlsStats(rfc->getHandler()->getName());
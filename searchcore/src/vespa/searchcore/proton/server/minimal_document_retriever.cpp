@@ -15,8 +15,9 @@ MinimalDocumentRetriever::MinimalDocumentRetriever(
         const std::shared_ptr<const DocumentTypeRepo> repo,
         const IDocumentMetaStoreContext &meta_store,
         const IDocumentStore &doc_store,
-        bool hasFields)
-    : DocumentRetrieverBase(docTypeName, *repo, meta_store, hasFields),
+        bool hasFields,
+        TermSummaryStore::SP termSummaryStore)
+    : DocumentRetrieverBase(docTypeName, *repo, meta_store, hasFields, std::move(termSummaryStore)),
       _repo(repo),
       _doc_store(doc_store) {
 }
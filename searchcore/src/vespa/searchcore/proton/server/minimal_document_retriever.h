@@ -24,7 +24,8 @@ public:
                              const std::shared_ptr<const document::DocumentTypeRepo> repo,
                              const IDocumentMetaStoreContext &meta_store,
                              const search::IDocumentStore &doc_store,
-                             bool hasFields);
+                             bool hasFields,
+                             TermSummaryStore::SP termSummaryStore = TermSummaryStore::SP());
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
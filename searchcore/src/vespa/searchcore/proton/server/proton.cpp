@@ -28,6 +28,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/random.h>
@@ -284,8 +285,11 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _protonDiskLayout = std::make_unique<ProtonDiskLayout>(protonConfig.basedir, protonConfig.tlsspec);
     vespalib::chdir(protonConfig.basedir);
     _tls->start();
+    auto diskWriteBudget = std::make_shared<flushengine::DiskWriteBudget>(flush.diskwrite.bandwidth,
+                                                                          vespalib::from_s(flush.diskwrite.burst));
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
-                                                 strategy, flush.maxconcurrent, flush.idleinterval*1000);
+                                                 strategy, flush.maxconcurrent, flush.idleinterval*1000,
+                                                 std::move(diskWriteBudget));
     _metricsEngine->addExternalMetrics(_summaryEngine->getMetrics());
 
     char tmp[1024];
@@ -731,6 +735,10 @@ Proton::updateMetrics(const vespalib::MonitorGuard &)
         metrics.resourceUsage.memoryMappings.set(usageFilter.getMemoryStats().getMappingsCount());
         metrics.resourceUsage.openFileDescriptors.set(countOpenFiles());
         metrics.resourceUsage.feedingBlocked.set((usageFilter.acceptWriteOperation() ? 0.0 : 1.0));
+        vespalib::alloc::HugePageStats hugePageStats = vespalib::alloc::getHugePageStats();
+        metrics.resourceUsage.hugePagesExplicitBytes.set(hugePageStats.explicitBytes);
+        metrics.resourceUsage.hugePagesTransparentBytes.set(hugePageStats.transparentBytes);
+        metrics.resourceUsage.hugePagesFallbacks.set(hugePageStats.fallbacks);
     }
     {
         ContentProtonMetrics::ProtonExecutorMetrics &metrics = _metricsEngine->root().executor;
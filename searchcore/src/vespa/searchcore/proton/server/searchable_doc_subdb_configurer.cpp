@@ -51,7 +51,8 @@ SearchableDocSubDBConfigurer::reconfigureFeedView(const IIndexWriter::SP &indexW
                     curr->getGidToLidChangeHandler(),
                     repo,
                     curr->getWriteService(),
-                    curr->getLidReuseDelayer(), curr->getCommitTimeTracker()),
+                    curr->getLidReuseDelayer(), curr->getCommitTimeTracker(),
+                    curr->getTermSummaryStore()),
             curr->getPersistentParams(),
             FastAccessFeedView::Context(attrWriter, curr->getDocIdLimit()),
             SearchableFeedView::Context(indexWriter)));
@@ -10,6 +10,7 @@
 #include "storeonlydocsubdb.h"
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/bucketdb/ibucketdbhandlerinitializer.h>
+#include <vespa/searchcore/proton/docsummary/summary_column_store.h>
 #include <vespa/searchcore/proton/docsummary/summaryflushtarget.h>
 #include <vespa/searchcore/proton/docsummary/summarymanagerinitializer.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastoreinitializer.h>
@@ -59,14 +60,18 @@ IIndexWriter::SP nullIndexWriter;
 StoreOnlyDocSubDB::Config::Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                                   const vespalib::string &baseDir,
                                   const search::GrowStrategy &attributeGrow, size_t attributeGrowNumDocs,
-                                  uint32_t subDbId, SubDbType subDbType)
+                                  uint32_t subDbId, SubDbType subDbType,
+                                  const std::vector<vespalib::string> &summaryColumnFields,
+                                  uint32_t termSummaryBitsPerWord)
     : _docTypeName(docTypeName),
       _subName(subName),
       _baseDir(baseDir + "/" + subName),
       _attributeGrow(attributeGrow),
       _attributeGrowNumDocs(attributeGrowNumDocs),
       _subDbId(subDbId),
-      _subDbType(subDbType)
+      _subDbType(subDbType),
+      _summaryColumnFields(summaryColumnFields),
+      _termSummaryBitsPerWord(termSummaryBitsPerWord)
 { }
 StoreOnlyDocSubDB::Config::~Config() = default;
 
@@ -103,6 +108,10 @@ StoreOnlyDocSubDB::StoreOnlyDocSubDB(const Config &cfg, const Context &ctx)
       _metaStoreCtx(),
       _attributeGrow(cfg._attributeGrow),
       _attributeGrowNumDocs(cfg._attributeGrowNumDocs),
+      _summaryColumnFields(cfg._summaryColumnFields),
+      _termSummaryStore((cfg._termSummaryBitsPerWord > 0 && cfg._subDbType != SubDbType::REMOVED)
+                        ? std::make_shared<TermSummaryStore>(cfg._termSummaryBitsPerWord)
+                        : TermSummaryStore::SP()),
       _flushedDocumentMetaStoreSerialNum(0u),
       _flushedDocumentStoreSerialNum(0u),
       _dms(),
@@ -168,11 +177,15 @@ StoreOnlyDocSubDB::hasDocument(const document::DocumentId &id)
 
 namespace {
 
-void docStoreReplayDone(search::IDocumentStore &docStore, uint32_t docIdLimit)
+void summaryReplayDone(SummaryManager &summaryMgr, uint32_t docIdLimit)
 {
-    if (docIdLimit < docStore.getDocIdLimit()) {
-        docStore.compactLidSpace(docIdLimit);
+    search::IDocumentStore &docStore = summaryMgr.getBackingStore();
+    if (docIdLimit <= docStore.getDocIdLimit()) {
+        summaryMgr.compactLidSpace(docIdLimit);
         docStore.shrinkLidSpace();
+        for (const auto &column : summaryMgr.getColumnStore().getColumns()) {
+            column.store->shrinkLidSpace();
+        }
     }
 }
 
@@ -184,10 +197,9 @@ StoreOnlyDocSubDB::onReplayDone()
     _dms->constructFreeList();
     _dms->shrinkLidSpace();
     uint32_t docIdLimit = _dms->getCommittedDocIdLimit();
-    auto &docStore = _rSummaryMgr->getBackingStore();
     std::promise<void> promise;
     auto future = promise.get_future();
-    _writeService.summary().execute(makeLambdaTask([&]() { docStoreReplayDone(docStore, docIdLimit); promise.set_value(); }));
+    _writeService.summary().execute(makeLambdaTask([&]() { summaryReplayDone(*_rSummaryMgr, docIdLimit); promise.set_value(); }));
     future.wait();
 }
 
@@ -202,7 +214,7 @@ StoreOnlyDocSubDB::onReprocessDone(SerialNum)
 SerialNum
 StoreOnlyDocSubDB::getOldestFlushedSerial()
 {
-    SerialNum lowest(_iSummaryMgr->getBackingStore().lastSyncToken());
+    SerialNum lowest(_rSummaryMgr->getOldestSyncToken());
     lowest = std::min(lowest, _dmsFlushTarget->getFlushedSerialNum());
     lowest = std::min(lowest, _dmsShrinkTarget->getFlushedSerialNum());
     return lowest;
@@ -230,7 +242,8 @@ createSummaryManagerInitializer(const search::LogDocumentStore::Config & storeCf
     vespalib::string baseDir(_baseDir + "/summary");
     return std::make_shared<SummaryManagerInitializer>
         (grow, baseDir, getSubDbName(), _docTypeName, _writeService.shared(),
-         storeCfg, tuneFile, _fileHeaderContext, _tlSyncer, std::move(bucketizer), std::move(result));
+         storeCfg, tuneFile, _fileHeaderContext, _tlSyncer, std::move(bucketizer), _summaryColumnFields,
+         std::move(result));
 }
 
 void
@@ -238,7 +251,7 @@ StoreOnlyDocSubDB::setupSummaryManager(SummaryManager::SP summaryManager)
 {
     _rSummaryMgr = std::move(summaryManager);
     _iSummaryMgr = _rSummaryMgr; // Upcast allowed with std::shared_ptr
-    _flushedDocumentStoreSerialNum = _iSummaryMgr->getBackingStore().lastSyncToken();
+    _flushedDocumentStoreSerialNum = _rSummaryMgr->getOldestSyncToken();
     _summaryAdapter.reset(new SummaryAdapter(_rSummaryMgr));
 }
 
@@ -343,7 +356,7 @@ StoreOnlyDocSubDB::getStoreOnlyFeedViewContext(const DocumentDBConfig &configSna
 {
     return StoreOnlyFeedView::Context(getSummaryAdapter(), configSnapshot.getSchemaSP(), _metaStoreCtx,
                                       *_gidToLidChangeHandler, configSnapshot.getDocumentTypeRepoSP(), _writeService,
-                                      *_lidReuseDelayer, _commitTimeTracker);
+                                      *_lidReuseDelayer, _commitTimeTracker, _termSummaryStore);
 }
 
 StoreOnlyFeedView::PersistentParams
@@ -464,12 +477,18 @@ StoreOnlyDocSubDB::getSearchableStats() const
     return search::SearchableStats();
 }
 
+vespalib::MemoryUsage
+StoreOnlyDocSubDB::getTermSummaryMemoryUsage() const
+{
+    return _termSummaryStore ? _termSummaryStore->getMemoryUsage() : vespalib::MemoryUsage();
+}
+
 IDocumentRetriever::UP
 StoreOnlyDocSubDB::getDocumentRetriever()
 {
     return std::make_unique<MinimalDocumentRetriever>(_docTypeName, _iFeedView.get()->getDocumentTypeRepo(),
                                                       *_metaStoreCtx, _iSummaryMgr->getBackingStore(),
-                                                      _subDbType != SubDbType::REMOVED);
+                                                      _subDbType != SubDbType::REMOVED, _termSummaryStore);
 }
 
 MatchingStats
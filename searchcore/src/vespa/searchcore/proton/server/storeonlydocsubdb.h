@@ -96,10 +96,14 @@ public:
         const size_t _attributeGrowNumDocs;
         const uint32_t _subDbId;
         const SubDbType _subDbType;
+        const std::vector<vespalib::string> _summaryColumnFields;
+        const uint32_t _termSummaryBitsPerWord;
 
         Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                const vespalib::string &baseDir, const search::GrowStrategy &attributeGrow,
-               size_t attributeGrowNumDocs, uint32_t subDbId, SubDbType subDbType);
+               size_t attributeGrowNumDocs, uint32_t subDbId, SubDbType subDbType,
+               const std::vector<vespalib::string> &summaryColumnFields = std::vector<vespalib::string>(),
+               uint32_t termSummaryBitsPerWord = 0);
         ~Config();
     };
 
@@ -139,6 +143,9 @@ protected:
     IDocumentMetaStoreContext::SP _metaStoreCtx;
     const search::GrowStrategy    _attributeGrow;
     const size_t                  _attributeGrowNumDocs;
+    const std::vector<vespalib::string> _summaryColumnFields;
+    // Term summaries used by streaming search, null when disabled.
+    TermSummaryStore::SP          _termSummaryStore;
     // The following two serial numbers reflect state at program startup
     // and are used by replay logic.
     SerialNum                     _flushedDocumentMetaStoreSerialNum;
@@ -236,6 +243,7 @@ public:
     void pruneRemovedFields(SerialNum serialNum) override;
     void setIndexSchema(const Schema::SP &schema, SerialNum serialNum) override;
     search::SearchableStats getSearchableStats() const override;
+    vespalib::MemoryUsage getTermSummaryMemoryUsage() const override;
     IDocumentRetriever::UP getDocumentRetriever() override;
     matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const override;
     void close() override;
@@ -198,6 +198,7 @@ StoreOnlyFeedView::StoreOnlyFeedView(const Context &ctx, const PersistentParams
       _lidReuseDelayer(ctx._lidReuseDelayer),
       _commitTimeTracker(ctx._commitTimeTracker),
       _pendingLidTracker(),
+      _termSummaryStore(ctx._termSummaryStore),
       _schema(ctx._schema),
       _writeService(ctx._writeService),
       _params(params),
@@ -280,6 +281,9 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
          putOp.getSubDbId(), putOp.getLid(), putOp.getPrevSubDbId(), putOp.getPrevLid(),
          _params._subDbId, doc->toString(true).size(), doc->toString(true).c_str());
 
+    if (putOp.getValidDbdId(_params._subDbId)) {
+        putTermSummary(putOp.getLid(), *doc);
+    }
     PendingNotifyRemoveDone pendingNotifyRemoveDone = adjustMetaStore(putOp, docId);
     considerEarlyAck(token);
 
@@ -385,6 +389,18 @@ void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneT
                 _pendingLidTracker.consume(lid);
             }));
 }
+// Term summaries are written in the master thread before the meta store exposes the document, so a reader
+// never filters a lid using a summary that does not cover the document it can see.
+void StoreOnlyFeedView::putTermSummary(Lid lid, const Document &doc) {
+    if (_termSummaryStore) {
+        _termSummaryStore->put(lid, doc);
+    }
+}
+void StoreOnlyFeedView::removeTermSummary(Lid lid) {
+    if (_termSummaryStore) {
+        _termSummaryStore->remove(lid);
+    }
+}
 void StoreOnlyFeedView::heartBeatSummary(SerialNum serialNum) {
     summaryExecutor().execute(
             makeLambdaTask([serialNum, this] {
@@ -425,6 +441,9 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
          _params._docTypeName.toString().c_str(), serialNum,
          upd.getId().toString().c_str(), lid);
 
+    // The updated document is not available here, so the term summary is dropped before the update is
+    // visible, also for attribute only updates.
+    removeTermSummary(lid);
     if (useDocumentMetaStore(serialNum)) {
         Lid storedLid;
         bool lookupOk = lookupDocId(docId, storedLid);
@@ -586,6 +605,7 @@ StoreOnlyFeedView::internalRemove(FeedToken token, SerialNum serialNum,
                                           std::move(pendingNotifyRemoveDone), (explicitReuseLid ? lid : 0u),
                                           std::move(moveDoneCtx));
     removeSummary(serialNum, lid, onWriteDone);
+    removeTermSummary(lid);
     bool immediateCommit = _commitTimeTracker.needCommit();
     removeAttributes(serialNum, lid, immediateCommit, onWriteDone);
     removeIndexedFields(serialNum, lid, immediateCommit, onWriteDone);
@@ -665,6 +685,9 @@ StoreOnlyFeedView::removeDocuments(const RemoveDocumentsOperation &op, bool remo
             removeSummary(serialNum, lid, onWriteDone);
         }
     }
+    for (const auto &lid : lidsToRemove) {
+        removeTermSummary(lid);
+    }
     return lidsToRemove.size();
 }
 
@@ -728,6 +751,9 @@ StoreOnlyFeedView::handleMove(const MoveOperation &moveOp, IDestructorCallback::
          moveOp.getSubDbId(), moveOp.getLid(), moveOp.getPrevSubDbId(), moveOp.getPrevLid(),
          _params._subDbId, doc->toString(true).size(), doc->toString(true).c_str());
 
+    if (moveOp.getValidDbdId(_params._subDbId)) {
+        putTermSummary(moveOp.getLid(), *doc);
+    }
     PendingNotifyRemoveDone pendingNotifyRemoveDone = adjustMetaStore(moveOp, docId);
     bool docAlreadyExists = moveOp.getValidPrevDbdId(_params._subDbId);
     if (moveOp.getValidDbdId(_params._subDbId)) {
@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/attribute/ifieldupdatecallback.h>
 #include <vespa/searchcore/proton/common/feeddebugger.h>
+#include <vespa/searchcore/proton/common/term_summary_store.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastorecontext.h>
 #include <vespa/searchcore/proton/feedoperation/lidvectorcontext.h>
@@ -81,6 +82,7 @@ public:
         searchcorespi::index::IThreadingService &_writeService;
         documentmetastore::ILidReuseDelayer     &_lidReuseDelayer;
         CommitTimeTracker                       &_commitTimeTracker;
+        TermSummaryStore::SP                     _termSummaryStore;
 
         Context(const ISummaryAdapter::SP &summaryAdapter,
                 const search::index::Schema::SP &schema,
@@ -89,7 +91,8 @@ public:
                 const std::shared_ptr<const document::DocumentTypeRepo> &repo,
                 searchcorespi::index::IThreadingService &writeService,
                 documentmetastore::ILidReuseDelayer &lidReuseDelayer,
-                CommitTimeTracker &commitTimeTracker)
+                CommitTimeTracker &commitTimeTracker,
+                TermSummaryStore::SP termSummaryStore = TermSummaryStore::SP())
             : _summaryAdapter(summaryAdapter),
               _schema(schema),
               _documentMetaStoreContext(documentMetaStoreContext),
@@ -97,7 +100,8 @@ public:
               _repo(repo),
               _writeService(writeService),
               _lidReuseDelayer(lidReuseDelayer),
-              _commitTimeTracker(commitTimeTracker)
+              _commitTimeTracker(commitTimeTracker),
+              _termSummaryStore(std::move(termSummaryStore))
         {}
     };
 
@@ -146,6 +150,7 @@ private:
     documentmetastore::ILidReuseDelayer     &_lidReuseDelayer;
     CommitTimeTracker                       &_commitTimeTracker;
     PendingLidTracker                        _pendingLidTracker;
+    const TermSummaryStore::SP               _termSummaryStore;
 
 protected:
     const search::index::Schema::SP          _schema;
@@ -162,6 +167,8 @@ private:
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
+    void putTermSummary(Lid lid, const Document &doc);
+    void removeTermSummary(Lid lid);
 
 
     bool useDocumentStore(SerialNum replaySerialNum) const {
@@ -236,6 +243,7 @@ public:
     documentmetastore::ILidReuseDelayer &getLidReuseDelayer() { return _lidReuseDelayer; }
     CommitTimeTracker &getCommitTimeTracker() { return _commitTimeTracker; }
     IGidToLidChangeHandler &getGidToLidChangeHandler() const { return _gidToLidChangeHandler; }
+    const TermSummaryStore::SP &getTermSummaryStore() const { return _termSummaryStore; }
 
     const std::shared_ptr<const document::DocumentTypeRepo> &getDocumentTypeRepo() const override { return _repo; }
     const ISimpleDocumentMetaStore *getDocumentMetaStorePtr() const override;
@@ -13,7 +13,7 @@ namespace proton {
 
 SummaryAdapter::SummaryAdapter(const SummaryManager::SP &mgr)
     : _mgr(mgr),
-      _lastSerial(_mgr->getBackingStore().lastSyncToken())
+      _lastSerial(_mgr->getOldestSyncToken())
 {}
 
 SummaryAdapter::~SummaryAdapter() {}
@@ -82,7 +82,7 @@ SummaryAdapter::get(const DocumentIdT lid, const DocumentTypeRepo &repo)
 
 void
 SummaryAdapter::compactLidSpace(uint32_t wantedDocIdLimit) {
-    _mgr->getBackingStore().compactLidSpace(wantedDocIdLimit);
+    _mgr->compactLidSpace(wantedDocIdLimit);
 }
 
 } // namespace proton
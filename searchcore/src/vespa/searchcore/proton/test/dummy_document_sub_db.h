@@ -82,6 +82,9 @@ struct DummyDocumentSubDb : public IDocumentSubDB
     search::SearchableStats getSearchableStats() const override {
         return search::SearchableStats();
     }
+    vespalib::MemoryUsage getTermSummaryMemoryUsage() const override {
+        return vespalib::MemoryUsage();
+    }
     IDocumentRetriever::UP getDocumentRetriever() override {
         return IDocumentRetriever::UP();
     }
@@ -23,6 +23,7 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <cmath>
+#include <fstream>
 #include <iostream>
 
 #include <vespa/log/log.h>
@@ -128,6 +129,30 @@ createAttribute(stringref attrName, const search::attribute::Config &cfg)
     return search::AttributeFactory::createAttribute(baseFileName(attrName), cfg);
 }
 
+string
+readFile(const string &fileName)
+{
+    std::ifstream is(fileName.c_str(), std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return string(content.data(), content.size());
+}
+
+bool
+isFileMapped(const string &fileName)
+{
+    string suffix = "/" + fileName.substr(fileName.rfind('/') + 1);
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        if (line.size() >= suffix.size() &&
+            line.compare(line.size() - suffix.size(), suffix.size(), suffix.c_str()) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 vespalib::string
 replace_suffix(AttributeVector &v, const vespalib::string &suffix)
 {
@@ -183,6 +208,7 @@ private:
     void testMemorySaver(const AttributePtr & a);
 
     void testReload();
+    void testLoadMapped();
     void testHasLoadData();
     void testMemorySaver();
 
@@ -504,6 +530,59 @@ void AttributeTest::testReload(const AttributePtr & a)
 }
 
 
+void AttributeTest::testLoadMapped()
+{
+    const uint32_t numDocs = 5000;
+    AttributePtr a = createAttribute("lmint32_1", Config(BasicType::INT32, CollectionType::SINGLE));
+    addDocs(a, numDocs);
+    auto & ia = static_cast<IntegerAttribute &>(*a);
+    for (uint32_t doc = 0; doc < numDocs; ++doc) {
+        EXPECT_TRUE(ia.update(doc, doc * 3));
+    }
+    a->commit();
+
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setLoadMapped(true);
+    AttributePtr b = createAttribute("lmint32_2", cfg);
+    AttributePtr c = createAttribute("lmint32_3", a->getConfig());
+    EXPECT_TRUE(a->save(b->getBaseFileName()));
+    EXPECT_TRUE(a->save(c->getBaseFileName()));
+    string datFile = b->getBaseFileName() + ".dat";
+    string saved = readFile(datFile);
+    EXPECT_FALSE(isFileMapped(datFile));
+
+    EXPECT_TRUE(c->load());
+    EXPECT_FALSE(isFileMapped(c->getBaseFileName() + ".dat"));
+    EXPECT_TRUE(b->load());
+    EXPECT_TRUE(isFileMapped(datFile));
+    EXPECT_EQUAL(numDocs, b->getNumDocs());
+    EXPECT_EQUAL(30, b->getInt(10));
+    EXPECT_EQUAL(3 * (numDocs - 1), b->getInt(numDocs - 1));
+
+    // First update touches a private copy of the page, the file is left intact
+    auto & ib = static_cast<IntegerAttribute &>(*b);
+    EXPECT_TRUE(ib.update(10, 42));
+    b->commit();
+    EXPECT_EQUAL(42, b->getInt(10));
+    EXPECT_EQUAL(33, b->getInt(11));
+    EXPECT_TRUE(isFileMapped(datFile));
+    EXPECT_TRUE(saved == readFile(datFile));
+
+    AttributePtr d = createAttribute("lmint32_2", cfg);
+    EXPECT_TRUE(d->load());
+    EXPECT_EQUAL(30, d->getInt(10));
+
+    // Growing the lid space moves the data to ordinary memory
+    AttributeVector::DocId docId;
+    EXPECT_TRUE(b->addDoc(docId));
+    EXPECT_EQUAL(numDocs, docId);
+    EXPECT_TRUE(ib.update(docId, 7));
+    b->commit();
+    EXPECT_EQUAL(7, b->getInt(docId));
+    EXPECT_EQUAL(42, b->getInt(10));
+    EXPECT_TRUE(saved == readFile(datFile));
+}
+
 void AttributeTest::testReload()
 {
     // IntegerAttribute
@@ -513,6 +592,20 @@ void AttributeTest::testReload()
         testReloadInt(iv1, 0);
         testReloadInt(iv1, 100);
     }
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setLoadMapped(true);
+        AttributePtr iv1 = createAttribute("smint32_1", cfg);
+        testReloadInt(iv1, 0);
+        testReloadInt(iv1, 100);
+        testReloadInt(iv1, 5000);
+    }
+    {
+        Config cfg(BasicType::INT64, CollectionType::SINGLE);
+        cfg.setLoadMapped(true);
+        AttributePtr iv1 = createAttribute("smint64_1", cfg);
+        testReloadInt(iv1, 100);
+    }
     {
         AttributePtr iv1 = createAttribute("suint4_1", Config(BasicType::UINT4, CollectionType::SINGLE));
         testReloadInt(iv1, 0);
@@ -2287,6 +2380,7 @@ int AttributeTest::Main()
 
     testBaseName();
     testReload();
+    TEST_DO(testLoadMapped());
     testHasLoadData();
     testMemorySaver();
 
@@ -271,6 +271,15 @@ AttributeManagerTest::testConfigConvert()
         a.ismutable = true;
         EXPECT_TRUE(CC::convert(a).isMutable());
     }
+    { // compaction strategy
+        CACA a;
+        EXPECT_EQUAL(CompactionStrategy::DEFAULT_MAX_DOCS_PER_COMPACTION_STEP,
+                     CC::convert(a).getCompactionStrategy().getMaxDocsPerCompactionStep());
+        a.maxdocspercompactionstep = 1000;
+        EXPECT_EQUAL(1000u, CC::convert(a).getCompactionStrategy().getMaxDocsPerCompactionStep());
+        EXPECT_EQUAL(CompactionStrategy().getMaxDeadBytesRatio(),
+                     CC::convert(a).getCompactionStrategy().getMaxDeadBytesRatio());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
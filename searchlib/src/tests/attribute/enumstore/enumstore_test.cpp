@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/attribute/enumstore.hpp>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("enumstore_test");
@@ -499,6 +500,39 @@ TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader)
 
 #pragma GCC diagnostic pop
 
+namespace {
+
+attribute::LoadedEnumAttributeVector
+make_loaded_enums(uint32_t num_values)
+{
+    attribute::LoadedEnumAttributeVector loaded;
+    loaded.reserve(num_values);
+    for (uint32_t i = 0; i < num_values; ++i) {
+        uint32_t e = (i * 7919u) % 100003u;
+        loaded.push_back(attribute::LoadedEnumAttribute(e, num_values - i, 1));
+    }
+    return loaded;
+}
+
+}
+
+TEST(LoadedEnumSortTest, loaded_enums_are_sorted_in_parallel_when_executor_is_given)
+{
+    uint32_t num_values = 3000000;
+    auto expected = make_loaded_enums(num_values);
+    auto loaded = make_loaded_enums(num_values);
+    attribute::sortLoadedByEnum(expected);
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    attribute::sortLoadedByEnum(loaded, &executor);
+    ASSERT_EQ(expected.size(), loaded.size());
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        ASSERT_EQ(expected[i].getEnum(), loaded[i].getEnum());
+        ASSERT_EQ(expected[i].getDocId(), loaded[i].getDocId());
+    }
+    attribute::LoadedEnumAttribute::EnumCompare less;
+    EXPECT_TRUE(std::is_sorted(loaded.begin(), loaded.end(), less));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
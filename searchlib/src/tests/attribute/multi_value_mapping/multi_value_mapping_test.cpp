@@ -145,6 +145,16 @@ public:
         _attr->commit();
         _attr->incGeneration();
     }
+    void startCompactWorst(uint32_t maxDocsPerStep) {
+        _mvMapping->compactWorst(true, false, maxDocsPerStep);
+        _attr->commit();
+        _attr->incGeneration();
+    }
+    void compactStep(uint32_t maxDocs) {
+        _mvMapping->compactStep(maxDocs);
+        _attr->commit();
+        _attr->incGeneration();
+    }
 };
 
 using IntMappingTest = MappingTestBase<int>;
@@ -348,4 +358,53 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_compaction_reports_bytes_moved)
+{
+    setup(3, 64, 512, 129);
+    addRandomDocs(1000);
+    for (uint32_t docId = 0; docId < 500; ++docId) {
+        clearDoc(docId);
+    }
+    auto refsBefore = _mvMapping->getRefCopy(_mvMapping->size());
+    compactWorst();
+    auto refsAfter = _mvMapping->getRefCopy(_mvMapping->size());
+    size_t expBytesMoved = 0;
+    for (uint32_t docId = 0; docId < refsAfter.size(); ++docId) {
+        if (refsBefore[docId] != refsAfter[docId]) {
+            expBytesMoved += get(docId).size() * sizeof(int);
+        }
+    }
+    EXPECT_LT(0u, expBytesMoved);
+    EXPECT_EQ(expBytesMoved, _mvMapping->getCompactionStats().bytesMoved);
+}
+
+TEST_F(CompactionIntMappingTest, test_that_compaction_can_be_done_in_bounded_steps)
+{
+    setup(3, 64, 512, 129);
+    addRandomDocs(1000);
+    for (uint32_t docId = 0; docId < 500; ++docId) {
+        clearDoc(docId);
+    }
+    uint32_t bufferCountBefore = countBuffers();
+    startCompactWorst(100);
+    uint32_t steps = 1;
+    while (_mvMapping->isCompacting()) {
+        const auto &stats = _mvMapping->getCompactionStats();
+        EXPECT_LT(stats.progress, 1.0);
+        EXPECT_EQ(steps, stats.steps);
+        // Interleave writes with compaction steps
+        addRandomDoc();
+        checkRefMapping();
+        compactStep(100);
+        ++steps;
+    }
+    checkRefMapping();
+    const auto &stats = _mvMapping->getCompactionStats();
+    EXPECT_EQ(steps, stats.steps);
+    EXPECT_LT(10u, stats.steps);
+    EXPECT_EQ(1.0, stats.progress);
+    EXPECT_LT(0u, stats.bytesMoved);
+    EXPECT_LE(countBuffers(), bufferCountBefore);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -5,9 +5,15 @@
 #include <vespa/searchlib/docstore/cachestats.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <functional>
+#include <map>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
+using vespalib::make_string;
 
 document::DocumentTypeRepo repo;
 
@@ -45,6 +51,150 @@ struct NullDataStore : IDataStore {
     void shrinkLidSpace() override {}
 };
 
+struct MemoryDataStore : NullDataStore {
+    std::map<uint32_t, vespalib::string> _docs;
+    mutable uint32_t _singleReads;
+    mutable uint32_t _bulkReadLids;
+    std::function<void(uint32_t)> _onBulkRead;
+    MemoryDataStore() : NullDataStore(), _docs(), _singleReads(0), _bulkReadLids(0), _onBulkRead() {}
+    ssize_t read(uint32_t lid, vespalib::DataBuffer &buf) const override {
+        ++_singleReads;
+        auto itr = _docs.find(lid);
+        if (itr == _docs.end()) {
+            return 0;
+        }
+        buf.writeBytes(itr->second.data(), itr->second.size());
+        return itr->second.size();
+    }
+    void read(const LidVector &lids, IBufferVisitor &visitor) const override {
+        for (uint32_t lid : lids) {
+            ++_bulkReadLids;
+            auto itr = _docs.find(lid);
+            if (itr != _docs.end()) {
+                vespalib::string buf = itr->second;
+                if (_onBulkRead) {
+                    _onBulkRead(lid); // Simulates a write racing with the bulk read
+                }
+                visitor.visit(lid, vespalib::ConstBufferRef(buf.data(), buf.size()));
+            }
+        }
+    }
+    void write(uint64_t, uint32_t lid, const void *buf, size_t sz) override {
+        _docs[lid] = vespalib::string(static_cast<const char *>(buf), sz);
+    }
+    void remove(uint64_t, uint32_t lid) override {
+        _docs.erase(lid);
+    }
+};
+
+struct CollectingVisitor : IDocumentVisitor {
+    std::vector<uint32_t> _lids;
+    bool _populateCache;
+    CollectingVisitor(bool populateCache_) : _lids(), _populateCache(populateCache_) {}
+    void visit(uint32_t lid, DocumentUP doc) override {
+        EXPECT_TRUE(bool(doc));
+        _lids.push_back(lid);
+    }
+    bool allowVisitCaching() const override { return false; }
+    bool populateCache() const override { return _populateCache; }
+};
+
+void
+writeDocs(DocumentStore &store, uint32_t numDocs)
+{
+    for (uint32_t lid = 1; lid <= numDocs; ++lid) {
+        document::Document doc(*repo.getDocumentType("document"),
+                               document::DocumentId(make_string("id:ns:document::%u", lid)));
+        store.write(lid, lid, doc);
+    }
+}
+
+std::vector<uint32_t>
+visitLids(const DocumentStore &store, const IDocumentStore::LidVector &lids, bool populateCache)
+{
+    CollectingVisitor visitor(populateCache);
+    store.visit(lids, repo, visitor);
+    std::sort(visitor._lids.begin(), visitor._lids.end());
+    return visitor._lids;
+}
+
+TEST_FF("require that visit uses document cache and only bulk reads missing documents",
+        MemoryDataStore(), DocumentStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100), f1))
+{
+    writeDocs(f2, 3);
+    EXPECT_TRUE(f2.read(1, repo));
+    EXPECT_EQUAL(1u, f1._singleReads);
+    std::vector<uint32_t> expLids({1, 2, 3});
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2, 3}, true));
+    EXPECT_EQUAL(2u, f1._bulkReadLids);
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2, 3}, true));
+    EXPECT_EQUAL(2u, f1._bulkReadLids);
+    EXPECT_TRUE(f2.read(3, repo));
+    EXPECT_EQUAL(1u, f1._singleReads);
+}
+
+document::Document
+makeDoc(const vespalib::string &id)
+{
+    return document::Document(*repo.getDocumentType("document"), document::DocumentId(id));
+}
+
+TEST_FF("require that visit does not populate document cache with documents removed while read",
+        MemoryDataStore(), DocumentStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100), f1))
+{
+    writeDocs(f2, 3);
+    f1._onBulkRead = [&](uint32_t lid) {
+        if (lid == 2) {
+            f2.remove(10, lid);
+        }
+    };
+    std::vector<uint32_t> expLids({1, 2, 3});
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2, 3}, true));
+    f1._onBulkRead = std::function<void(uint32_t)>();
+    EXPECT_FALSE(f2.read(2, repo));
+    EXPECT_TRUE(f2.read(3, repo));
+    EXPECT_EQUAL(1u, f1._singleReads);
+}
+
+TEST_FF("require that visit does not populate document cache with documents written while read",
+        MemoryDataStore(), DocumentStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100), f1))
+{
+    writeDocs(f2, 3);
+    f1._onBulkRead = [&](uint32_t lid) {
+        if (lid == 2) {
+            f2.write(10, lid, makeDoc("id:ns:document::new"));
+        }
+    };
+    visitLids(f2, {1, 2, 3}, true);
+    f1._onBulkRead = std::function<void(uint32_t)>();
+    auto doc = f2.read(2, repo);
+    ASSERT_TRUE(doc);
+    EXPECT_EQUAL("id:ns:document::new", doc->getId().toString());
+    EXPECT_EQUAL(1u, f1._singleReads);
+}
+
+TEST_FF("require that visit does not populate document cache unless asked to",
+        MemoryDataStore(), DocumentStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100), f1))
+{
+    writeDocs(f2, 3);
+    std::vector<uint32_t> expLids({1, 2, 3});
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2, 3}, false));
+    EXPECT_EQUAL(3u, f1._bulkReadLids);
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2, 3}, false));
+    EXPECT_EQUAL(6u, f1._bulkReadLids);
+}
+
+TEST_FF("require that visit reads backing store when document cache is disabled",
+        MemoryDataStore(), DocumentStore(DocumentStore::Config(CompressionConfig::NONE, 0, 0), f1))
+{
+    writeDocs(f2, 2);
+    std::vector<uint32_t> expLids({1, 2});
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2}, true));
+    EXPECT_TRUE(expLids == visitLids(f2, {1, 2}, true));
+    EXPECT_EQUAL(4u, f1._bulkReadLids);
+    EXPECT_EQUAL(0u, f1._singleReads);
+}
+
 TEST_FFF("require that uncache docstore lookups are counted",
          DocumentStore::Config(CompressionConfig::NONE, 0, 0),
          NullDataStore(), DocumentStore(f1, f2))
@@ -17,6 +17,7 @@
 using namespace search::fef;
 using namespace search::fef::test;
 using namespace search::features;
+using search::feature_t;
 
 uint32_t default_docid = 1;
 
@@ -391,4 +392,53 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+void verify_batch(Fixture &f, const std::vector<uint32_t> &docs) {
+    auto seed = f.program.get_seeds().resolve(0);
+    FeatureExecutor *executor = seed.executor();
+    ASSERT_TRUE(executor != nullptr);
+    ASSERT_TRUE(executor->supports_batch());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        executor->gather_batch(docs[i], i);
+    }
+    std::vector<feature_t> results(docs.size(), 0.0);
+    executor->execute_batch(vespalib::ArrayRef<feature_t>(results));
+    for (size_t i = 0; i < docs.size(); ++i) {
+        EXPECT_EQUAL(results[i], f.get(docs[i]));
+    }
+}
+
+const vespalib::string batch_expr = "if(docid<10,1,2)+if(docid<20,10,20)";
+
+TEST_F("require that fast-forest gbdt evaluation supports batch evaluation", Fixture()) {
+    f1.use_fast_forest().add_expr("rank", batch_expr).compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
+    TEST_DO(verify_batch(f1, {25, 5, 15}));
+    std::vector<uint32_t> docs;
+    for (uint32_t i = 0; i < 40; ++i) {
+        docs.push_back((i * 7) % 30);
+    }
+    TEST_DO(verify_batch(f1, docs));
+}
+
+TEST_F("require that compiled ranking expressions do not support batch evaluation", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", batch_expr).compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::CompiledRankingExpressionExecutor");
+    auto seed = f1.program.get_seeds().resolve(0);
+    ASSERT_TRUE(seed.executor() != nullptr);
+    EXPECT_FALSE(seed.executor()->supports_batch());
+}
+
+TEST_F("require that lazy and interpreted ranking expressions do not support batch evaluation", Fixture()) {
+    f1.lazy_expressions(true).add_expr("lazy", batch_expr);
+    f1.add_expr("interpreted", "box(docid)+1");
+    f1.compile();
+    auto seeds = f1.program.get_seeds();
+    ASSERT_EQUAL(2u, seeds.num_features());
+    for (size_t i = 0; i < seeds.num_features(); ++i) {
+        FeatureExecutor *executor = seeds.resolve(i).executor();
+        ASSERT_TRUE(executor != nullptr);
+        EXPECT_FALSE(executor->supports_batch());
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
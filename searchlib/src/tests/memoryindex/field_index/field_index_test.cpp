@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/searchlib/diskindex/fieldreader.h>
 #include <vespa/searchlib/diskindex/fusion.h>
 #include <vespa/searchlib/diskindex/indexbuilder.h>
 #include <vespa/searchlib/diskindex/zcposoccrandread.h>
@@ -20,6 +21,8 @@
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("field_index_test");
@@ -864,6 +867,130 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_inde
 }
 
 
+TEST_F(FieldIndexCollectionTest, require_that_concurrent_dumping_falls_back_to_sequential_dumping)
+{
+    WrapInserter(fic, 1).word("a").add(5, getFeatures(2, 1)).
+            word("b").add(5, getFeatures(12, 2)).flush();
+    WrapInserter(fic, 3).word("c").add(7, getFeatures(3, 1)).flush();
+    vespalib::ThreadStackExecutor executor(2, 128 * 1024);
+    MyBuilder b(schema);
+    fic.dump(b, executor);
+    EXPECT_EQ("f=0[],"
+              "f=1[w=a[d=5[e=0,w=1,l=2[0]]],w=b[d=5[e=0,w=1,l=12[0,1]]]],"
+              "f=2[],"
+              "f=3[w=c[d=7[e=0,w=1,l=3[0]]]]",
+              b.toStr());
+}
+
+void
+dump_to_disk(FieldIndexCollection &fic, const Schema &schema, const vespalib::string &prefix,
+             vespalib::ThreadExecutor *executor)
+{
+    vespalib::rmdir(prefix, true);
+    search::diskindex::IndexBuilder b(schema);
+    b.setPrefix(prefix);
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    b.open(20, fic.getNumUniqueWords(), MockFieldLengthInspector(), tuneFileIndexing, fileHeaderContext);
+    if (executor != nullptr) {
+        fic.dump(b, *executor);
+    } else {
+        fic.dump(b);
+    }
+    b.close();
+}
+
+/*
+ * Reads back the posting lists of a dumped field as
+ * "w=<wordnum>[d=<docid>[e=<elementid>,w=<weight>,l=<elementlen>[<positions>]]]".
+ */
+vespalib::string
+read_field_dump(const vespalib::string &prefix, const vespalib::string &field_name, uint32_t &num_words)
+{
+    search::diskindex::WordNumMapping wmap;
+    search::diskindex::DocIdMapping dmap;
+    search::diskindex::FieldReader reader;
+    TuneFileSeqRead tuneFileRead;
+    std::stringstream ss;
+    num_words = 0;
+    if (!reader.open(prefix + "/" + field_name + "/", tuneFileRead)) {
+        return "open failed";
+    }
+    wmap.setup(1000);
+    dmap.setup(reader.getDocIdLimit());
+    reader.setup(wmap, dmap);
+    uint64_t last_word_num = 0;
+    for (reader.read(); reader.isValid(); reader.read()) {
+        if (reader._wordNum != last_word_num) {
+            if (last_word_num != 0) {
+                ss << "],";
+            }
+            ss << "w=" << reader._wordNum << "[";
+            last_word_num = reader._wordNum;
+            ++num_words;
+        } else {
+            ss << ",";
+        }
+        const auto &features = reader._docIdAndFeatures;
+        ss << "d=" << features.doc_id() << "[";
+        auto position = features.word_positions().begin();
+        for (const auto &element : features.elements()) {
+            ss << "e=" << element.getElementId() << ",w=" << element.getWeight() <<
+                ",l=" << element.getElementLen() << "[";
+            for (uint32_t i = 0; i < element.getNumOccs(); ++i, ++position) {
+                ss << (i > 0 ? "," : "") << position->getWordPos();
+            }
+            ss << "]";
+        }
+        ss << "]";
+    }
+    if (last_word_num != 0) {
+        ss << "]";
+    }
+    reader.close();
+    return ss.str();
+}
+
+TEST_F(FieldIndexCollectionTest, require_that_fields_can_be_dumped_concurrently_to_disk_index_builder)
+{
+    WrapInserter(fic, 0).word("a").add(2, getFeatures(2, 1)).add(9, getFeatures(6, 3)).
+            word("b").add(4, getFeatures(4, 1)).
+            word("c").add(11, getFeatures(7, 2)).flush();
+    WrapInserter(fic, 1).word("b").add(3, getFeatures(3, 2)).flush();
+    DocIdAndFeatures df = getFeatures(4, 1);
+    addElement(df, 5, 2);
+    WrapInserter(fic, 2).word("a").add(3, getFeatures(3, 2)).
+            word("d").add(5, df).flush();
+    df = getFeatures(8, 1, 12);
+    addElement(df, 9, 2, 13);
+    WrapInserter(fic, 3).word("a").add(7, df).
+            word("e").add(8, getFeatures(2, 1, -4)).flush();
+
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    dump_to_disk(fic, schema, "sequentialdump", nullptr);
+    dump_to_disk(fic, schema, "concurrentdump", &executor);
+
+    std::vector<uint32_t> exp_num_words = {3, 1, 2, 2};
+    for (uint32_t field_id = 0; field_id < schema.getNumIndexFields(); ++field_id) {
+        const vespalib::string &field_name = schema.getIndexField(field_id).getName();
+        uint32_t sequential_num_words = 0;
+        uint32_t concurrent_num_words = 0;
+        vespalib::string sequential = read_field_dump("sequentialdump", field_name, sequential_num_words);
+        vespalib::string concurrent = read_field_dump("concurrentdump", field_name, concurrent_num_words);
+        EXPECT_EQ(sequential, concurrent) << "field " << field_name;
+        EXPECT_EQ(exp_num_words[field_id], sequential_num_words) << "field " << field_name;
+        EXPECT_EQ(exp_num_words[field_id], concurrent_num_words) << "field " << field_name;
+    }
+    uint32_t num_words = 0;
+    EXPECT_EQ("w=1[d=2[e=0,w=1,l=2[0]],d=9[e=0,w=1,l=6[0,1,2]]],"
+              "w=2[d=4[e=0,w=1,l=4[0]]],"
+              "w=3[d=11[e=0,w=1,l=7[0,1]]]",
+              read_field_dump("concurrentdump", "f0", num_words));
+    vespalib::rmdir("sequentialdump", true);
+    vespalib::rmdir("concurrentdump", true);
+}
+
+
 struct FieldIndexCollectionTypeTest : public ::testing::Test {
     Schema schema;
     FieldIndexCollection fic;
@@ -0,0 +1,115 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for compressed_posting_list.
+
+#include <vespa/log/log.h>
+LOG_SETUP("compressed_posting_list_test");
+
+#include <vespa/searchlib/predicate/compressed_posting_list.h>
+#include <vespa/vespalib/datastore/entryref.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <algorithm>
+#include <vector>
+
+using namespace search::predicate;
+using std::vector;
+
+namespace {
+
+using Iterator = CompressedPostingListIterator<uint32_t>;
+
+struct Fixture {
+    vector<uint32_t> doc_ids;
+    vector<uint32_t> data;
+    Fixture(uint32_t num_docs, uint32_t doc_id_step, uint32_t data_mask) : doc_ids(), data() {
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            doc_ids.push_back(1 + i * doc_id_step + (i % 3));
+            data.push_back((i * 0x9e3779b9u) & data_mask);
+        }
+    }
+};
+
+void checkIterate(const Fixture &f) {
+    CompressedPostingList list(f.doc_ids, f.data);
+    EXPECT_EQUAL(f.doc_ids.size(), list.size());
+    Iterator it(list);
+    for (size_t i = 0; i < f.doc_ids.size(); ++i) {
+        ASSERT_TRUE(it.valid());
+        EXPECT_EQUAL(f.doc_ids[i], it.getKey());
+        EXPECT_EQUAL(f.data[i], it.getData());
+        ++it;
+    }
+    EXPECT_FALSE(it.valid());
+}
+
+TEST("require that empty posting list is not valid") {
+    CompressedPostingList list({}, {});
+    EXPECT_EQUAL(0u, list.size());
+    EXPECT_EQUAL(0u, list.numBlocks());
+    Iterator it(list);
+    EXPECT_FALSE(it.valid());
+    it.linearSeek(1);
+    EXPECT_FALSE(it.valid());
+}
+
+TEST("require that postings can be iterated") {
+    TEST_DO(checkIterate(Fixture(1, 1, 0xffffffff)));
+    TEST_DO(checkIterate(Fixture(128, 1, 0)));
+    TEST_DO(checkIterate(Fixture(129, 7, 0xff)));
+    TEST_DO(checkIterate(Fixture(1000, 1000, 0xffffffff)));
+    TEST_DO(checkIterate(Fixture(1000, 1, 0xffff)));
+}
+
+TEST("require that blocks use the smallest bit widths") {
+    Fixture f(256, 4, 0);
+    CompressedPostingList list(f.doc_ids, f.data);
+    ASSERT_EQUAL(2u, list.numBlocks());
+    EXPECT_EQUAL(3u, list.getBlock(0).doc_id_bits);
+    EXPECT_EQUAL(0u, list.getBlock(0).data_bits);
+    EXPECT_EQUAL(f.doc_ids[127], list.getBlock(0).last_doc_id);
+    EXPECT_EQUAL(f.doc_ids[255], list.getBlock(1).last_doc_id);
+}
+
+TEST("require that linearSeek skips to the first doc id not below target") {
+    Fixture f(1000, 10, 0xfff);
+    CompressedPostingList list(f.doc_ids, f.data);
+    for (uint32_t target = 0; target < 10020; target += 97) {
+        Iterator it(list);
+        it.linearSeek(target);
+        auto expected = std::lower_bound(f.doc_ids.begin(), f.doc_ids.end(), target);
+        if (expected == f.doc_ids.end()) {
+            EXPECT_FALSE(it.valid());
+        } else {
+            ASSERT_TRUE(it.valid());
+            EXPECT_EQUAL(*expected, it.getKey());
+            EXPECT_EQUAL(f.data[expected - f.doc_ids.begin()], it.getData());
+        }
+    }
+}
+
+TEST("require that linearSeek does not move backwards") {
+    Fixture f(1000, 10, 0xfff);
+    CompressedPostingList list(f.doc_ids, f.data);
+    Iterator it(list);
+    it.linearSeek(5000);
+    ASSERT_TRUE(it.valid());
+    uint32_t doc_id = it.getKey();
+    it.linearSeek(10);
+    ASSERT_TRUE(it.valid());
+    EXPECT_EQUAL(doc_id, it.getKey());
+}
+
+}  // namespace
+
+TEST("require that entry refs are stored by their representation") {
+    using search::datastore::EntryRef;
+    EntryRef ref(0x12345678);
+    EXPECT_EQUAL(0x12345678u, toCompressedPostingData(ref));
+    EXPECT_TRUE(ref == fromCompressedPostingData<EntryRef>(toCompressedPostingData(ref)));
+    CompressedPostingList list({ 3, 7 }, { 0, toCompressedPostingData(ref) });
+    CompressedPostingListIterator<EntryRef> it(list);
+    EXPECT_FALSE(it.getData().valid());
+    ++it;
+    EXPECT_TRUE(ref == it.getData());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -23,7 +23,7 @@ TEST("require that empty interval list gives invalid ref") {
     ASSERT_FALSE(ref.valid());
 }
 
-Interval single_buf;
+vector<Interval> interval_buf;
 
 template <typename IntervalT>
 void testInsertAndRetrieve(const std::vector<IntervalT> &interval_list) {
@@ -38,8 +38,8 @@ void testInsertAndRetrieve(const std::vector<IntervalT> &interval_list) {
     ASSERT_TRUE(ref.valid());
 
     uint32_t size;
-    IntervalT single;
-    const IntervalT *intervals = store.get(ref, size, &single);
+    vector<IntervalT> buf;
+    const IntervalT *intervals = store.get(ref, size, buf);
     EXPECT_EQUAL(interval_list.size(), size);
     ASSERT_TRUE(intervals);
     for (size_t i = 0; i < interval_list.size(); ++i) {
@@ -65,6 +65,20 @@ TEST("require that multi-interval entry can be inserted") {
     testInsertAndRetrieve<IntervalWithBounds>(
         {{0x00010001, 0x4}, {0x00020002, 0x10}, {0x00030003, 0x20},
          {0x00040004, 0x6}, {0x0005ffff, 0x7}});
+    testInsertAndRetrieve<IntervalWithBounds>(
+        {{0x00010001, 0x80000005}, {0xffffffff, 0xffffffff}});
+    testInsertAndRetrieve<Interval>({{0x01000001}});
+}
+
+TEST("require that multi-interval entries are varint encoded") {
+    PredicateIntervalStore store;
+    auto ref = store.insert<Interval>(
+        {{0x00010001}, {0x00020002}, {0x00030003}, {0x00040004},
+         {0x00050005}, {0x00060006}, {0x00070007}, {0x00080008},
+         {0x00090009}});
+    ASSERT_TRUE(ref.valid());
+    // 1 byte count + 9 * 2 bytes, padded to 5 words instead of 9.
+    EXPECT_EQUAL(5u, ref.ref() >> 24);
 }
 
 TEST("require that multiple multi-interval entries can be retrieved") {
@@ -75,7 +89,7 @@ TEST("require that multiple multi-interval entries can be retrieved") {
     ASSERT_TRUE(ref.valid());
 
     uint32_t size;
-    const Interval *intervals = store.get(ref, size, &single_buf);
+    const Interval *intervals = store.get(ref, size, interval_buf);
     EXPECT_EQUAL(2u, size);
     ASSERT_TRUE(intervals);
     EXPECT_EQUAL(3u, intervals[0].interval);
@@ -124,9 +138,9 @@ TEST("require that single interval entries are optimized") {
     ASSERT_EQUAL(0x0001ffffu, ref.ref());
 
     uint32_t size;
-    const Interval *intervals = store.get(ref, size, &single_buf);
-    ASSERT_EQUAL(intervals, &single_buf);
-    EXPECT_EQUAL(0x0001ffffu, single_buf.interval);
+    const Interval *intervals = store.get(ref, size, interval_buf);
+    EXPECT_EQUAL(1u, size);
+    EXPECT_EQUAL(0x0001ffffu, intervals[0].interval);
 
     store.remove(ref);  // Should do nothing
 }
@@ -141,7 +155,7 @@ TEST("require that interval refs are reused for identical data.") {
     EXPECT_EQUAL(ref.ref(), ref2.ref());
 
     uint32_t size;
-    const Interval *intervals = store.get(ref, size, &single_buf);
+    const Interval *intervals = store.get(ref, size, interval_buf);
     EXPECT_EQUAL(0x00010001u, intervals[0].interval);
     EXPECT_EQUAL(0x0002ffffu, intervals[1].interval);
 }
@@ -332,6 +332,91 @@ TEST_F("require that vector contains correct postings", Fixture) {
     EXPECT_FALSE(v.valid());
 }
 
+TEST_F("require that frozen posting lists are compressed", Fixture) {
+    for (uint32_t id = 1; id <= 300; ++id) {
+        f.addPosting(key, id * 10, {id});
+    }
+    f.addPosting(key + 1, 10, {1});
+    f.commit();
+    f.index().compressFrozenPostingLists();
+    EXPECT_FALSE(f.hasVectorPostingList(key));
+
+    auto it = f.lookup(key);
+    ASSERT_TRUE(it.valid());
+    EXPECT_FALSE(it.getData().valid());
+    EXPECT_EQUAL(300u, f.index().getPostingListSize(it));
+    EXPECT_TRUE(f.lookup(key + 1).getData().valid());
+    EXPECT_FALSE(f.index().getCompressedPostingList(key + 1).operator bool());
+
+    auto compressed = f.index().getCompressedPostingList(key);
+    ASSERT_TRUE(compressed.operator bool());
+    auto &posting_it = *compressed;
+    for (uint32_t id = 1; id <= 300; ++id) {
+        ASSERT_TRUE(posting_it.valid());
+        EXPECT_EQUAL(id * 10, posting_it.getKey());
+        EXPECT_EQUAL(id, posting_it.getData().data);
+        ++posting_it;
+    }
+    EXPECT_FALSE(posting_it.valid());
+
+    std::vector<uint32_t> doc_ids;
+    f.index().foreach_frozen_key(it.getData(), key, [&](uint32_t id) { doc_ids.push_back(id); });
+    EXPECT_EQUAL(300u, doc_ids.size());
+}
+
+TEST_F("require that compressed posting lists are decompressed when modified", Fixture) {
+    for (uint32_t id = 1; id <= 300; ++id) {
+        f.addPosting(key, id * 10, {id});
+        f.addPosting(key + 1, id * 10, {id});
+    }
+    f.commit();
+    f.index().compressFrozenPostingLists();
+
+    f.addPosting(key, 5, {1000});
+    auto result = f.removeFromPostingList(key + 1, 20);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQUAL(2u, result.first.data);
+    f.commit();
+
+    EXPECT_FALSE(f.index().getCompressedPostingList(key).operator bool());
+    EXPECT_FALSE(f.index().getCompressedPostingList(key + 1).operator bool());
+    auto it = f.lookup(key);
+    ASSERT_TRUE(it.valid());
+    EXPECT_EQUAL(301u, f.index().getPostingListSize(it.getData()));
+    auto posting_it = f.getBTreePostingList(it.getData());
+    ASSERT_TRUE(posting_it.valid());
+    EXPECT_EQUAL(5u, posting_it.getKey());
+    EXPECT_EQUAL(1000u, posting_it.getData().data);
+    it = f.lookup(key + 1);
+    ASSERT_TRUE(it.valid());
+    EXPECT_EQUAL(299u, f.index().getPostingListSize(it.getData()));
+}
+
+TEST_FF("require that compressed posting lists can be serialized", Fixture, Fixture) {
+    for (uint32_t id = 1; id <= 300; ++id) {
+        f1.addPosting(key, id * 10, {id});
+    }
+    f1.commit();
+    f1.index().compressFrozenPostingLists();
+    vespalib::DataBuffer buffer;
+    f1.index().serialize(buffer, MyDataSerializer());
+    MyObserver observer;
+    MyDataDeserializer deserializer;
+    f2.index().deserialize(buffer, deserializer, observer, PredicateAttribute::PREDICATE_ATTRIBUTE_VERSION);
+
+    auto it = f2.lookup(key);
+    ASSERT_TRUE(it.valid());
+    auto posting_it = f2.getBTreePostingList(it.getData());
+    for (uint32_t id = 1; id <= 300; ++id) {
+        ASSERT_TRUE(posting_it.valid());
+        EXPECT_EQUAL(id * 10, posting_it.getKey());
+        EXPECT_EQUAL(id, posting_it.getData().data);
+        EXPECT_TRUE(observer.hasSeenDoc(id * 10));
+        ++posting_it;
+    }
+    EXPECT_FALSE(posting_it.valid());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
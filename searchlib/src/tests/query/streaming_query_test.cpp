@@ -1,10 +1,12 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/query/streaming/query.h>
+#include <vespa/searchlib/query/streaming/term_summary.h>
 #include <vespa/searchlib/query/tree/querybuilder.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/query/tree/stackdumpcreator.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <limits>
 #include <cmath>
 
@@ -731,5 +733,52 @@ TEST("testSameElementEvaluate") {
     EXPECT_TRUE(sameElem->evaluate());
 }
 
+bool summaryMayContain(const TermSummary::Bits & bits, const vespalib::string & term) {
+    uint64_t hash(0);
+    ASSERT_TRUE(TermSummary::hashTerm(term, hash));
+    return TermSummary::mayContain(&bits[0], bits.size(), hash);
+}
+
+TEST("require that term summary contains all folded words") {
+    TermSummaryBuilder builder(16);
+    builder.addText("The quick, brown FOX jumps over the lazy dog");
+    builder.addText("\xc3\x85re tr\xc3\xa6 x42");
+    TermSummary::Bits bits = builder.build();
+    EXPECT_EQUAL(((11 * 16) + 63) / 64, bits.size());
+    for (const char * word : {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "\xc3\xa5re", "tr\xc3\xa6", "x42"}) {
+        EXPECT_TRUE(summaryMayContain(bits, word));
+    }
+    size_t falsePositives(0);
+    for (size_t i(0); i < 1000; i++) {
+        falsePositives += summaryMayContain(bits, vespalib::make_string("missing%zu", i)) ? 1 : 0;
+    }
+    EXPECT_LESS(falsePositives, 50u);
+    uint64_t the(0), dog(0), cat(0);
+    ASSERT_TRUE(TermSummary::hashTerm("the", the));
+    ASSERT_TRUE(TermSummary::hashTerm("dog", dog));
+    ASSERT_TRUE(TermSummary::hashTerm("missing", cat));
+    EXPECT_TRUE(TermSummary::mayContainAll(&bits[0], bits.size(), {the, dog}));
+    EXPECT_FALSE(TermSummary::mayContainAll(&bits[0], bits.size(), {the, dog, cat}));
+}
+
+TEST("require that only single folded words can be used as term summary terms") {
+    uint64_t hash(0);
+    EXPECT_TRUE(TermSummary::hashTerm("word42", hash));
+    EXPECT_FALSE(TermSummary::hashTerm("Word", hash));
+    EXPECT_FALSE(TermSummary::hashTerm("two words", hash));
+    EXPECT_FALSE(TermSummary::hashTerm("a.b", hash));
+    EXPECT_FALSE(TermSummary::hashTerm("", hash));
+    EXPECT_FALSE(TermSummary::hashTerm("\xc3\x85re", hash));
+}
+
+TEST("require that empty term summary contains nothing") {
+    TermSummaryBuilder builder(16);
+    builder.addText(" ... ");
+    TermSummary::Bits bits = builder.build();
+    EXPECT_EQUAL(1u, bits.size());
+    EXPECT_EQUAL(0u, bits[0]);
+    EXPECT_FALSE(summaryMayContain(bits, "word"));
+}
+
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,513 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fastos/app.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/dot_product_search.h>
+#include <vespa/searchlib/queryeval/multibitvectoriterator.h>
+#include <vespa/searchlib/queryeval/orsearch.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <vespa/searchlib/test/fakedata/fakeposting.h>
+#include <vespa/searchlib/test/fakedata/fakeword.h>
+#include <vespa/searchlib/test/fakedata/fakewordset.h>
+#include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/util/rand48.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cmath>
+
+#include <vespa/log/log.h>
+LOG_SETUP("iterator_benchmark");
+
+using search::BitVector;
+using search::BitVectorIterator;
+using search::fef::MatchData;
+using search::fef::MatchDataLayout;
+using search::fef::TermFieldHandle;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::queryeval::AndSearch;
+using search::queryeval::DotProductSearch;
+using search::queryeval::MultiBitVectorIteratorBase;
+using search::queryeval::OrSearch;
+using search::queryeval::SearchIterator;
+using search::queryeval::WeakAndSearch;
+using vespalib::slime::Cursor;
+
+namespace wand = search::queryeval::wand;
+
+using namespace search::fakedata;
+
+namespace iteratorbenchmark {
+
+const vespalib::string BITVECTOR("bitvector");
+
+const std::vector<vespalib::string> operatorTypes = { "term", "and", "or", "weakand", "dotproduct",
+                                                      "multibitvector-and", "multibitvector-or" };
+
+bool
+isMultiBitVector(const vespalib::string &operatorType)
+{
+    return operatorType.find("multibitvector") == 0;
+}
+
+/**
+ * The posting lists of the children of one benchmarked operator. Each
+ * child gets its own deterministic sequence of document ids, so that
+ * a given seed gives the same hits regardless of which cases are run.
+ */
+class Postings {
+private:
+    vespalib::string                          _postingType;
+    uint32_t                                  _numDocs;
+    std::vector<std::unique_ptr<FakeWord>>    _words;
+    std::vector<FakePosting::SP>              _postings;
+    std::vector<BitVector::UP>                _bitVectors;
+    std::vector<uint32_t>                     _numPostings;
+
+public:
+    Postings(const vespalib::string &postingType, const FakeWordSet &wordSet,
+             uint32_t numDocs, double density, uint32_t numChildren, long seed);
+    ~Postings();
+
+    bool isBitVector() const { return _postingType == BITVECTOR; }
+    uint64_t getNumPostings(uint32_t numChildren) const {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < numChildren; ++i) {
+            sum += _numPostings[i];
+        }
+        return sum;
+    }
+
+    SearchIterator *createChild(uint32_t idx, TermFieldMatchData &tfmd, bool strict, bool unpack) const;
+};
+
+Postings::Postings(const vespalib::string &postingType, const FakeWordSet &wordSet,
+                   uint32_t numDocs, double density, uint32_t numChildren, long seed)
+    : _postingType(postingType),
+      _numDocs(numDocs),
+      _words(),
+      _postings(),
+      _bitVectors(),
+      _numPostings()
+{
+    const long threshold = std::lround(density * 0x7fffffff);
+    for (uint32_t i = 0; i < numChildren; ++i) {
+        search::Rand48 rnd;
+        rnd.srand48(seed + i);
+        std::vector<uint32_t> docIds;
+        for (uint32_t docId = 1; docId < numDocs; ++docId) {
+            if ((rnd.lrand48() & 0x7fffffff) < threshold) {
+                docIds.push_back(docId);
+            }
+        }
+        _numPostings.push_back(docIds.size());
+        if (isBitVector()) {
+            BitVector::UP bv = BitVector::create(numDocs);
+            for (uint32_t docId : docIds) {
+                bv->setBit(docId);
+            }
+            bv->invalidateCachedCount();
+            _bitVectors.push_back(std::move(bv));
+        } else {
+            _words.push_back(std::make_unique<FakeWord>(numDocs, docIds, vespalib::make_string("word%u", i),
+                                                        wordSet.getFieldsParams(), wordSet.getPackedIndex()));
+        }
+    }
+    if (!isBitVector()) {
+        std::unique_ptr<FPFactory> factory(getFPFactory(postingType, wordSet.getSchema()));
+        std::vector<const FakeWord *> words;
+        for (const auto &word : _words) {
+            words.push_back(word.get());
+        }
+        factory->setup(words);
+        for (const auto &word : _words) {
+            _postings.push_back(factory->make(*word));
+        }
+    }
+}
+
+Postings::~Postings() = default;
+
+SearchIterator *
+Postings::createChild(uint32_t idx, TermFieldMatchData &tfmd, bool strict, bool unpack) const
+{
+    if (isBitVector()) {
+        return BitVectorIterator::create(_bitVectors[idx].get(), _numDocs, tfmd, strict).release();
+    }
+    const FakePosting &posting = *_postings[idx];
+    tfmd.setNeedNormalFeatures(unpack && posting.enable_unpack_normal_features());
+    tfmd.setNeedInterleavedFeatures(unpack && posting.enable_unpack_interleaved_features());
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    return posting.createIterator(tfmda);
+}
+
+/**
+ * An iterator tree to be benchmarked, owning the match data of its
+ * children.
+ */
+struct Tree {
+    MatchData::UP      md;
+    TermFieldMatchData tfmd;
+    SearchIterator::UP root;
+};
+
+std::unique_ptr<Tree>
+createTree(const vespalib::string &operatorType, const Postings &postings, uint32_t numChildren,
+           uint32_t heapSize, bool strict, bool unpack)
+{
+    auto tree = std::make_unique<Tree>();
+    MatchDataLayout layout;
+    std::vector<TermFieldHandle> handles;
+    for (uint32_t i = 0; i < numChildren; ++i) {
+        handles.push_back(layout.allocTermField(0));
+    }
+    tree->md = layout.createMatchData();
+    std::vector<SearchIterator *> children;
+    std::vector<TermFieldMatchData *> childMatch;
+    for (uint32_t i = 0; i < numChildren; ++i) {
+        childMatch.push_back(tree->md->resolveTermField(handles[i]));
+        children.push_back(postings.createChild(i, *childMatch.back(), strict, unpack));
+    }
+    if (operatorType == "term") {
+        tree->root.reset(children[0]);
+    } else if (operatorType == "and") {
+        tree->root.reset(AndSearch::create(children, strict));
+    } else if (operatorType == "or") {
+        tree->root.reset(OrSearch::create(children, strict));
+    } else if (operatorType == "weakand") {
+        wand::Terms terms;
+        for (uint32_t i = 0; i < numChildren; ++i) {
+            terms.emplace_back(children[i], 100, postings.getNumPostings(numChildren) / numChildren, childMatch[i]);
+        }
+        tree->root.reset(WeakAndSearch::create(terms, heapSize, strict));
+    } else if (operatorType == "dotproduct") {
+        std::vector<int32_t> weights(numChildren, 100);
+        tree->root = DotProductSearch::create(children, tree->tfmd, childMatch, weights, std::move(tree->md));
+    } else if (operatorType == "multibitvector-and") {
+        tree->root = MultiBitVectorIteratorBase::optimize(SearchIterator::UP(AndSearch::create(children, strict)));
+    } else if (operatorType == "multibitvector-or") {
+        tree->root = MultiBitVectorIteratorBase::optimize(SearchIterator::UP(OrSearch::create(children, strict)));
+    }
+    return tree;
+}
+
+/**
+ * Evaluates the tree over the whole document id range. Strict trees
+ * are driven by their own seeks, while non-strict trees are offered
+ * every stride'th document, as when used below a strict filter.
+ */
+uint32_t
+evaluate(SearchIterator &search, uint32_t numDocs, bool strict, bool unpack, uint32_t stride)
+{
+    uint32_t numHits = 0;
+    search.initRange(1, numDocs);
+    if (strict) {
+        for (search.seek(1); !search.isAtEnd(); search.seek(search.getDocId() + 1)) {
+            ++numHits;
+            if (unpack) {
+                search.unpack(search.getDocId());
+            }
+        }
+    } else {
+        for (uint32_t docId = 1; docId < numDocs; docId += stride) {
+            if (search.seek(docId)) {
+                ++numHits;
+                if (unpack) {
+                    search.unpack(docId);
+                }
+            }
+        }
+    }
+    return numHits;
+}
+
+class IteratorBenchmark : public FastOS_Application {
+private:
+    uint32_t                      _numDocs;
+    std::vector<double>           _densities;
+    std::vector<uint32_t>         _numChildren;
+    std::vector<vespalib::string> _operatorTypes;
+    std::vector<vespalib::string> _postingTypes;
+    std::vector<bool>             _strictModes;
+    std::vector<bool>             _unpackModes;
+    uint32_t                      _heapSize;
+    uint32_t                      _stride;
+    double                        _budget;
+    long                          _seed;
+    vespalib::string              _outputFile;
+    FakeWordSet                   _wordSet;
+
+    void runCase(Cursor &results, const vespalib::string &operatorType, const Postings &postings,
+                 const vespalib::string &postingType, double density, uint32_t numChildren,
+                 bool strict, bool unpack);
+    bool writeResults(const vespalib::Slime &slime) const;
+
+public:
+    IteratorBenchmark();
+    ~IteratorBenchmark();
+    int Main() override;
+};
+
+void
+usage()
+{
+    printf("Usage: iterator_benchmark "
+           "[-b <budgetSeconds>] "
+           "[-c <numChildren>] "
+           "[-d <numDocs>] "
+           "[-f <density>] "
+           "[-g <nonStrictStride>] "
+           "[-h <weakAndHeapSize>] "
+           "[-j <jsonOutputFile>] "
+           "[-o <operatorType>] "
+           "[-r <seed>] "
+           "[-s {strict, nonstrict, both}] "
+           "[-t <postingType>] "
+           "[-u {on, off, both}]\n");
+    printf("Operator types: ");
+    for (size_t i = 0; i < operatorTypes.size(); ++i) {
+        printf("%s%s", (i > 0) ? ", " : "", operatorTypes[i].c_str());
+    }
+    printf("\nPosting types: %s", BITVECTOR.c_str());
+    for (const auto &type : getPostingTypes()) {
+        printf(", %s", type.c_str());
+    }
+    printf("\n");
+}
+
+bool
+parseModes(const char *arg, std::vector<bool> &modes, const char *on, const char *off)
+{
+    vespalib::string mode(arg);
+    if (mode == on) {
+        modes = { true };
+    } else if (mode == off) {
+        modes = { false };
+    } else if (mode == "both") {
+        modes = { true, false };
+    } else {
+        return false;
+    }
+    return true;
+}
+
+IteratorBenchmark::IteratorBenchmark()
+    : _numDocs(10000000),
+      _densities(),
+      _numChildren(),
+      _operatorTypes(),
+      _postingTypes(),
+      _strictModes({ true, false }),
+      _unpackModes({ false, true }),
+      _heapSize(100),
+      _stride(1),
+      _budget(1.0),
+      _seed(42),
+      _outputFile(),
+      _wordSet()
+{
+}
+
+IteratorBenchmark::~IteratorBenchmark() = default;
+
+void
+IteratorBenchmark::runCase(Cursor &results, const vespalib::string &operatorType, const Postings &postings,
+                           const vespalib::string &postingType, double density, uint32_t numChildren,
+                           bool strict, bool unpack)
+{
+    vespalib::BenchmarkTimer timer(_budget);
+    uint32_t numHits = 0;
+    uint32_t numSamples = 0;
+    while (timer.has_budget()) {
+        auto tree = createTree(operatorType, postings, numChildren, _heapSize, strict, unpack);
+        timer.before();
+        uint32_t hits = evaluate(*tree->root, _numDocs, strict, unpack, _stride);
+        timer.after();
+        if (numSamples++ > 0 && hits != numHits) {
+            LOG(warning, "%s over %s: hit count changed from %u to %u",
+                operatorType.c_str(), postingType.c_str(), numHits, hits);
+        }
+        numHits = hits;
+    }
+    double ms = timer.min_time() * 1000.0;
+    Cursor &result = results.addObject();
+    result.setString("operator", operatorType);
+    result.setString("posting_type", postingType);
+    result.setLong("children", numChildren);
+    result.setDouble("density", density);
+    uint64_t numPostings = postings.getNumPostings(numChildren);
+    result.setLong("postings", numPostings);
+    result.setBool("strict", strict);
+    result.setBool("unpack", unpack);
+    result.setLong("hits", numHits);
+    result.setLong("samples", numSamples);
+    result.setDouble("min_time_ms", ms);
+    result.setDouble("ns_per_hit", (numHits > 0) ? (ms * 1e6 / numHits) : 0.0);
+    result.setDouble("ns_per_posting", (numPostings > 0) ? (ms * 1e6 / numPostings) : 0.0);
+    fprintf(stderr, "%s(%u x %s, density %g, %s, %s): %u hits, %.3f ms\n",
+            operatorType.c_str(), numChildren, postingType.c_str(), density,
+            strict ? "strict" : "nonstrict", unpack ? "unpack" : "nounpack", numHits, ms);
+}
+
+bool
+IteratorBenchmark::writeResults(const vespalib::Slime &slime) const
+{
+    vespalib::SimpleBuffer buf;
+    vespalib::slime::JsonFormat::encode(slime, buf, false);
+    FILE *file = _outputFile.empty() ? stdout : fopen(_outputFile.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "Could not open '%s' for writing\n", _outputFile.c_str());
+        return false;
+    }
+    vespalib::Memory json = buf.get();
+    bool ok = (fwrite(json.data, 1, json.size, file) == json.size);
+    if (file != stdout) {
+        ok = (fclose(file) == 0) && ok;
+    }
+    return ok;
+}
+
+int
+IteratorBenchmark::Main()
+{
+    int argi;
+    char c;
+    const char *optArg;
+
+    argi = 1;
+    while ((c = GetOpt("b:c:d:f:g:h:j:o:r:s:t:u:", optArg, argi)) != -1) {
+        switch(c) {
+        case 'b':
+            _budget = atof(optArg);
+            break;
+        case 'c':
+            _numChildren.push_back(atoi(optArg));
+            break;
+        case 'd':
+            _numDocs = atoi(optArg);
+            break;
+        case 'f':
+            _densities.push_back(atof(optArg));
+            break;
+        case 'g':
+            _stride = atoi(optArg);
+            break;
+        case 'h':
+            _heapSize = atoi(optArg);
+            break;
+        case 'j':
+            _outputFile = optArg;
+            break;
+        case 'o':
+            if (std::find(operatorTypes.begin(), operatorTypes.end(), optArg) == operatorTypes.end()) {
+                printf("Bad operator type: '%s'\n", optArg);
+                usage();
+                return 1;
+            }
+            _operatorTypes.push_back(optArg);
+            break;
+        case 'r':
+            _seed = atol(optArg);
+            break;
+        case 's':
+            if (!parseModes(optArg, _strictModes, "strict", "nonstrict")) {
+                usage();
+                return 1;
+            }
+            break;
+        case 't':
+            if (BITVECTOR != optArg) {
+                std::unique_ptr<FPFactory> ff(getFPFactory(optArg, _wordSet.getSchema()));
+                if (ff.get() == nullptr) {
+                    printf("Bad posting list type: '%s'\n", optArg);
+                    usage();
+                    return 1;
+                }
+            }
+            _postingTypes.push_back(optArg);
+            break;
+        case 'u':
+            if (!parseModes(optArg, _unpackModes, "off", "on")) {
+                usage();
+                return 1;
+            }
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (_numDocs < 2 || _stride == 0 || _heapSize == 0) {
+        usage();
+        return 1;
+    }
+    for (double density : _densities) {
+        if (density <= 0.0 || density > 1.0) {
+            printf("Bad density: %g\n", density);
+            return 1;
+        }
+    }
+    if (_densities.empty()) {
+        _densities = { 0.001, 0.01, 0.1 };
+    }
+    if (_numChildren.empty()) {
+        _numChildren = { 2, 16 };
+    }
+    if (_operatorTypes.empty()) {
+        _operatorTypes = operatorTypes;
+    }
+    if (_postingTypes.empty()) {
+        _postingTypes = { BITVECTOR, "Zc4SkipPosOccBE", "MemTreeOcc2" };
+    }
+
+    vespalib::Slime slime;
+    Cursor &top = slime.setObject();
+    Cursor &config = top.setObject("config");
+    config.setLong("docs", _numDocs);
+    config.setLong("seed", _seed);
+    config.setDouble("budget_s", _budget);
+    config.setLong("nonstrict_stride", _stride);
+    config.setLong("weakand_heap_size", _heapSize);
+    Cursor &results = top.setArray("results");
+    for (const auto &postingType : _postingTypes) {
+        for (double density : _densities) {
+            for (uint32_t numChildren : _numChildren) {
+                Postings postings(postingType, _wordSet, _numDocs, density, numChildren, _seed);
+                for (const auto &operatorType : _operatorTypes) {
+                    // plain operators also run over bitvectors, to compare with the optimized trees
+                    if ((isMultiBitVector(operatorType) && !postings.isBitVector()) ||
+                        (operatorType == "term" && numChildren != _numChildren[0]))
+                    {
+                        continue;
+                    }
+                    uint32_t children = (operatorType == "term") ? 1 : numChildren;
+                    for (bool strict : _strictModes) {
+                        for (bool unpack : _unpackModes) {
+                            runCase(results, operatorType, postings, postingType, density, children, strict, unpack);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return writeResults(slime) ? 0 : 1;
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    iteratorbenchmark::IteratorBenchmark app;
+
+    setvbuf(stdout, nullptr, _IOLBF, 32768);
+    return app.Entry(argc, argv);
+}
@@ -35,6 +35,7 @@ namespace document {
 }
 
 namespace vespalib {
+    class Executor;
     class GenericHeader;
 }
 
@@ -446,6 +447,11 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads the attribute.  If an executor is given, it may be used to
+     * parallelize the heavier parts of loading a large attribute.
+     */
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -567,7 +573,7 @@ private:
     void divideByZeroWarning();
     virtual bool applyWeight(DocId doc, const FieldValue &fv, const ArithmeticValueUpdate &wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
-    virtual bool onLoad();
+    virtual bool onLoad(vespalib::Executor *executor);
     std::unique_ptr<FastOS_FileInterface> openFile(const char *suffix);
     LoadedBufferUP loadFile(const char *suffix);
 
@@ -21,7 +21,7 @@ template <typename B>
 NumericDirectAttribute<B>::~NumericDirectAttribute() = default;
 
 template <typename B>
-bool NumericDirectAttribute<B>::onLoad()
+bool NumericDirectAttribute<B>::onLoad(vespalib::Executor *)
 {
     fileutil::LoadedBuffer::UP dataBuffer(B::loadDAT());
     bool rc(dataBuffer.get());
@@ -68,7 +68,12 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.setLoadMapped(cfg.loadmapped);
     retval.setMutable(cfg.ismutable);
+    CompactionStrategy compactionStrategy;
+    retval.setCompactionStrategy(CompactionStrategy(compactionStrategy.getMaxDeadBytesRatio(),
+                                                    compactionStrategy.getMaxDeadAddressSpaceRatio(),
+                                                    cfg.maxdocspercompactionstep));
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
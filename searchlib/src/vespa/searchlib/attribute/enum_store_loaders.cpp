@@ -31,9 +31,10 @@ EnumeratedLoader::set_ref_counts()
     _store.set_ref_counts(_enums_histogram);
 }
 
-EnumeratedPostingsLoader::EnumeratedPostingsLoader(IEnumStore& store)
+EnumeratedPostingsLoader::EnumeratedPostingsLoader(IEnumStore& store, vespalib::Executor* executor)
     : EnumeratedLoaderBase(store),
-      _loaded_enums()
+      _loaded_enums(),
+      _executor(executor)
 {
 }
 
@@ -2,21 +2,99 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+constexpr size_t MIN_VALUES_PER_PARTITION = 0x100000u;
+constexpr uint32_t MAX_PARTITIONS = 64u;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+radixSortLoaded(LoadedEnumAttribute *loaded, size_t size)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+                   loaded, size, 16);
+}
+
+/*
+ * Permute the loaded values in place so that all values for the same
+ * partition (a contiguous range of enum values) are adjacent, with
+ * partitions ordered by enum range.  Returns the partition boundaries.
+ */
+std::vector<size_t>
+partitionLoadedByEnum(LoadedEnumAttributeVector &loaded, uint32_t wantedPartitions)
+{
+    uint32_t maxEnum = 0;
+    for (const auto &elem : loaded) {
+        maxEnum = std::max(maxEnum, elem.getEnum());
+    }
+    std::vector<uint32_t> partitionOf(size_t(maxEnum) + 1, 0u);
+    for (const auto &elem : loaded) {
+        ++partitionOf[elem.getEnum()];
+    }
+    std::vector<size_t> start(1, 0u);
+    size_t valuesPerPartition = (loaded.size() + wantedPartitions - 1) / wantedPartitions;
+    size_t used = 0;
+    for (auto &count : partitionOf) {
+        size_t enumCount = count;
+        if (used >= start.back() + valuesPerPartition) {
+            start.push_back(used);
+        }
+        count = start.size() - 1;
+        used += enumCount;
+    }
+    start.push_back(used);
+    uint32_t numPartitions = start.size() - 1;
+    std::vector<size_t> next(start.begin(), start.end() - 1);
+    for (uint32_t partition = 0; partition < numPartitions; ++partition) {
+        while (next[partition] < start[partition + 1]) {
+            auto &elem = loaded[next[partition]];
+            uint32_t target = partitionOf[elem.getEnum()];
+            if (target == partition) {
+                ++next[partition];
+            } else {
+                std::swap(elem, loaded[next[target]++]);
+            }
+        }
+    }
+    return start;
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
+{
+    uint32_t wantedPartitions = std::min(MAX_PARTITIONS, uint32_t(loaded.size() / MIN_VALUES_PER_PARTITION));
+    if (executor == nullptr || wantedPartitions < 2) {
+        radixSortLoaded(&loaded[0], loaded.size());
+        return;
+    }
+    std::vector<size_t> start = partitionLoadedByEnum(loaded, wantedPartitions);
+    uint32_t numPartitions = start.size() - 1;
+    vespalib::CountDownLatch done(numPartitions);
+    for (uint32_t partition = 0; partition < numPartitions; ++partition) {
+        LoadedEnumAttribute *begin = &loaded[0] + start[partition];
+        size_t size = start[partition + 1] - start[partition];
+        auto rejected = executor->execute(vespalib::makeLambdaTask([begin, size, &done]() {
+            radixSortLoaded(begin, size);
+            done.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    done.await();
 }
 
 } // namespace attribute
 } // namespace search
-
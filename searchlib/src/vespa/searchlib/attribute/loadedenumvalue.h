@@ -7,6 +7,8 @@
 #include <vespa/vespalib/util/arrayref.h>
 #include <cassert>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -143,8 +145,13 @@ public:
     }
 };
 
+/**
+ * Sort loaded values by enum and docid.  If an executor is given and
+ * there are many values, the values are first partitioned into
+ * disjoint enum ranges that are sorted in parallel using the executor.
+ */
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor = nullptr);
 
 } // namespace attribute
 
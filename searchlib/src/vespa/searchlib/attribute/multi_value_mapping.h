@@ -23,11 +23,14 @@ private:
     using ConstArrayRef = vespalib::ConstArrayRef<EntryT>;
 
     ArrayStore _store;
+
+    datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) override;
 public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
     MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg,
-                      const vespalib::GrowStrategy &gs = vespalib::GrowStrategy());
+                      const vespalib::GrowStrategy &gs = vespalib::GrowStrategy(),
+                      const vespalib::alloc::Alloc &initialAlloc = vespalib::alloc::Alloc::alloc());
     ~MultiValueMapping() override;
     ConstArrayRef get(uint32_t docId) const { return _store.get(_indices[docId]); }
     ConstArrayRef getDataForIdx(EntryRef idx) const { return _store.get(idx); }
@@ -44,8 +47,6 @@ public:
 
     void doneLoadFromMultiValue() { _store.setInitializing(false); }
 
-    void compactWorst(bool compactMemory, bool compactAddressSpace) override;
-
     vespalib::AddressSpace getAddressSpaceUsage() const override;
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
     bool has_free_lists_enabled() const { return _store.has_free_lists_enabled(); }
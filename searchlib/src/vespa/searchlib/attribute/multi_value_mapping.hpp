@@ -10,12 +10,13 @@ namespace search::attribute {
 
 template <typename EntryT, typename RefT>
 MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg,
-                                                  const vespalib::GrowStrategy &gs)
+                                                  const vespalib::GrowStrategy &gs,
+                                                  const vespalib::alloc::Alloc &initialAlloc)
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wuninitialized"
 #endif
-    : MultiValueMappingBase(gs, _store.getGenerationHolder()),
+    : MultiValueMappingBase(gs, _store.getGenerationHolder(), initialAlloc),
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -24,7 +25,11 @@ MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreCon
 }
 
 template <typename EntryT, typename RefT>
-MultiValueMapping<EntryT,RefT>::~MultiValueMapping() = default;
+MultiValueMapping<EntryT,RefT>::~MultiValueMapping()
+{
+    // Ongoing compaction must be finished while the array store is still alive
+    _compactionContext.reset();
+}
 
 template <typename EntryT, typename RefT>
 void
@@ -52,13 +57,10 @@ MultiValueMapping<EntryT,RefT>::replace(uint32_t docId, ConstArrayRef values)
 }
 
 template <typename EntryT, typename RefT>
-void
-MultiValueMapping<EntryT,RefT>::compactWorst(bool compactMemory, bool compactAddressSpace)
+datastore::ICompactionContext::UP
+MultiValueMapping<EntryT,RefT>::startCompactWorst(bool compactMemory, bool compactAddressSpace)
 {
-    datastore::ICompactionContext::UP compactionContext(_store.compactWorst(compactMemory, compactAddressSpace));
-    if (compactionContext) {
-        compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[0], _indices.size()));
-    }
+    return _store.compactWorst(compactMemory, compactAddressSpace);
 }
 
 template <typename EntryT, typename RefT>
@@ -2,6 +2,7 @@
 
 #include "multi_value_mapping_base.h"
 #include <vespa/searchcommon/common/compaction_strategy.h>
+#include <algorithm>
 
 namespace search::attribute {
 
@@ -14,11 +15,15 @@ constexpr size_t DEAD_ARRAYS_SLACK = 0x10000u;
 }
 
 MultiValueMappingBase::MultiValueMappingBase(const vespalib::GrowStrategy &gs,
-                                             vespalib::GenerationHolder &genHolder)
-    : _indices(gs, genHolder),
+                                             vespalib::GenerationHolder &genHolder,
+                                             const vespalib::alloc::Alloc &initialAlloc)
+    : _indices(gs, genHolder, initialAlloc),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
-      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
+      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32)),
+      _compactionContext(),
+      _compactionDocId(0u),
+      _compactionStats()
 {
 }
 
@@ -49,6 +54,7 @@ MultiValueMappingBase::shrink(uint32_t docIdLimit)
 {
     assert(docIdLimit < _indices.size());
     _indices.shrink(docIdLimit);
+    _compactionDocId = std::min(_compactionDocId, docIdLimit);
 }
 
 void
@@ -81,9 +87,54 @@ MultiValueMappingBase::updateStat()
     return retval;
 }
 
+void
+MultiValueMappingBase::compactStep(uint32_t maxDocs)
+{
+    if (!_compactionContext) {
+        return;
+    }
+    vespalib::Timer timer;
+    size_t movedBytesBefore = _compactionContext->getMovedBytes();
+    uint32_t docIdLimit = _indices.size();
+    uint32_t begin = std::min(_compactionDocId, docIdLimit);
+    uint32_t end = ((maxDocs == 0u) || (docIdLimit - begin <= maxDocs)) ? docIdLimit : (begin + maxDocs);
+    if (begin < end) {
+        _compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[begin], end - begin));
+    }
+    _compactionStats.bytesMoved += _compactionContext->getMovedBytes() - movedBytesBefore;
+    _compactionDocId = end;
+    if (end >= docIdLimit) {
+        // Destroying the compaction context puts the compacted buffers on hold
+        _compactionContext.reset();
+        _compactionDocId = 0u;
+        _compactionStats.progress = 1.0;
+    } else {
+        _compactionStats.progress = static_cast<double>(end) / docIdLimit;
+    }
+    ++_compactionStats.steps;
+    _compactionStats.stallTime += timer.elapsed();
+}
+
+void
+MultiValueMappingBase::compactWorst(bool compactMemory, bool compactAddressSpace, uint32_t maxDocsPerStep)
+{
+    if (_compactionContext) {
+        compactStep(0u);
+    }
+    _compactionContext = startCompactWorst(compactMemory, compactAddressSpace);
+    _compactionDocId = 0u;
+    if (_compactionContext) {
+        compactStep(maxDocsPerStep);
+    }
+}
+
 bool
 MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrategy)
 {
+    if (_compactionContext) {
+        compactStep(compactionStrategy.getMaxDocsPerCompactionStep());
+        return true;
+    }
     size_t usedBytes = _cachedArrayStoreMemoryUsage.usedBytes();
     size_t deadBytes = _cachedArrayStoreMemoryUsage.deadBytes();
     size_t usedArrays = _cachedArrayStoreAddressSpaceUsage.used();
@@ -93,7 +144,7 @@ MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrat
     bool compactAddressSpace = ((deadArrays >= DEAD_ARRAYS_SLACK) &&
                                 (usedArrays * compactionStrategy.getMaxDeadAddressSpaceRatio() < deadArrays));
     if (compactMemory || compactAddressSpace) {
-        compactWorst(compactMemory, compactAddressSpace);
+        compactWorst(compactMemory, compactAddressSpace, compactionStrategy.getMaxDocsPerCompactionStep());
         return true;
     }
     return false;
@@ -3,8 +3,10 @@
 #pragma once
 
 #include <vespa/vespalib/datastore/entryref.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
 #include <vespa/vespalib/util/address_space.h>
 #include <vespa/vespalib/util/rcuvector.h>
+#include <vespa/vespalib/util/time.h>
 #include <functional>
 
 namespace search { class CompactionStrategy; }
@@ -20,18 +22,47 @@ public:
     using EntryRef = datastore::EntryRef;
     using RefVector = vespalib::RcuVectorBase<EntryRef>;
 
+    /**
+     * Statistics for compaction of the underlying array store.
+     * Compaction is performed in bounded steps, each step moving the
+     * arrays referenced by a limited range of documents.
+     */
+    struct CompactionStats {
+        uint64_t steps;
+        uint64_t bytesMoved;
+        vespalib::duration stallTime; // accumulated time spent in compaction steps
+        double progress;              // fraction of docs visited by ongoing compaction (1.0 if none)
+        CompactionStats()
+            : steps(0),
+              bytesMoved(0),
+              stallTime(vespalib::duration::zero()),
+              progress(1.0)
+        {
+        }
+    };
+
 protected:
     RefVector _indices;
     size_t    _totalValues;
     vespalib::MemoryUsage _cachedArrayStoreMemoryUsage;
     vespalib::AddressSpace _cachedArrayStoreAddressSpaceUsage;
+    datastore::ICompactionContext::UP _compactionContext;
+    uint32_t _compactionDocId; // next doc to visit in ongoing compaction
+    CompactionStats _compactionStats;
 
-    MultiValueMappingBase(const vespalib::GrowStrategy &gs, vespalib::GenerationHolder &genHolder);
+    MultiValueMappingBase(const vespalib::GrowStrategy &gs, vespalib::GenerationHolder &genHolder,
+                          const vespalib::alloc::Alloc &initialAlloc);
     virtual ~MultiValueMappingBase();
 
     void updateValueCount(size_t oldValues, size_t newValues) {
         _totalValues += newValues - oldValues;
     }
+
+    /**
+     * Start compaction of the worst buffers in the underlying array
+     * store. Returns an empty pointer if there is nothing to compact.
+     */
+    virtual datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) = 0;
 public:
     using RefCopyVector = vespalib::Array<EntryRef>;
 
@@ -51,8 +82,21 @@ public:
 
     uint32_t getNumKeys() const { return _indices.size(); }
     uint32_t getCapacityKeys() const { return _indices.capacity(); }
-    virtual void compactWorst(bool compatMemory, bool compactAddressSpace) = 0;
+    /**
+     * Start compaction of the worst buffers, finishing any ongoing
+     * compaction first, and perform the first compaction step. The
+     * compaction is done in one go if maxDocsPerStep is 0.
+     */
+    void compactWorst(bool compactMemory, bool compactAddressSpace, uint32_t maxDocsPerStep = 0u);
+    /**
+     * Perform one step of the ongoing compaction, visiting at most
+     * maxDocs documents (0 means all remaining documents). The
+     * compaction is finished when all documents have been visited.
+     */
+    void compactStep(uint32_t maxDocs);
     bool considerCompact(const CompactionStrategy &compactionStrategy);
+    bool isCompacting() const { return static_cast<bool>(_compactionContext); }
+    const CompactionStats &getCompactionStats() const { return _compactionStats; }
 };
 
 }
@@ -193,6 +193,7 @@ MultiValueEnumAttribute<B, M>::onUpdateStat()
     mergeMemoryStats(total);
     this->updateStatistics(this->_mvMapping.getTotalValueCnt(), this->_enumStore.get_num_uniques(), total.allocatedBytes(),
                      total.usedBytes(), total.deadBytes(), total.allocatedBytesOnHold());
+    this->updateCompactionStatistics();
 }
 
 template <typename B, typename M>
@@ -80,6 +80,7 @@ void MultiValueNumericAttribute<B, M>::onUpdateStat()
     usage.merge(this->getChangeVectorMemoryUsage());
     this->updateStatistics(this->_mvMapping.getTotalValueCnt(), this->_mvMapping.getTotalValueCnt(), usage.allocatedBytes(),
                            usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+    this->updateCompactionStatistics();
 }
 
 
@@ -128,7 +129,7 @@ MultiValueNumericAttribute<B, M>::onLoadEnumerated(ReaderBase & attrReader)
 
 template <typename B, typename M>
 bool
-MultiValueNumericAttribute<B, M>::onLoad()
+MultiValueNumericAttribute<B, M>::onLoad(vespalib::Executor *)
 {
     PrimitiveReader<MValueType> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -51,6 +51,12 @@ protected:
 
     vespalib::AddressSpace getMultiValueAddressSpaceUsage() const override;
 
+    /**
+     * Copy compaction statistics from the multi value mapping to the
+     * attribute status. Called as part of updating statistics.
+     **/
+    void updateCompactionStatistics();
+
 public:
     MultiValueAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & cfg);
     ~MultiValueAttribute() override;
@@ -25,8 +25,10 @@ MultiValueAttribute(const vespalib::string &baseFileName,
                                                                multivalueattribute::SMALL_MEMORY_PAGE_SIZE,
                                                                8 * 1024,
                                                                cfg.getGrowStrategy().getMultiValueAllocGrowFactor(),
-                                                               multivalueattribute::enable_free_lists),
-                 cfg.getGrowStrategy().to_generic_strategy())
+                                                               multivalueattribute::enable_free_lists)
+                         .huge_page_policy(cfg.getGrowStrategy().getHugePagePolicy()),
+                 cfg.getGrowStrategy().to_generic_strategy(),
+                 cfg.getGrowStrategy().initialDocsAlloc())
 {
 }
 
@@ -203,6 +205,15 @@ MultiValueAttribute<B, M>::getMultiValueAddressSpaceUsage() const
     return _mvMapping.getAddressSpaceUsage();
 }
 
+template <typename B, typename M>
+void
+MultiValueAttribute<B, M>::updateCompactionStatistics()
+{
+    const auto &stats = _mvMapping.getCompactionStats();
+    this->getStatus().updateCompactionStatistics(stats.steps, stats.bytesMoved,
+                                                 vespalib::count_us(stats.stallTime), stats.progress);
+}
+
 
 template <typename B, typename M>
 bool
@@ -181,7 +181,7 @@ struct DummyObserver : SimpleIndexDeserializeObserver<> {
 
 }
 
-bool PredicateAttribute::onLoad()
+bool PredicateAttribute::onLoad(vespalib::Executor *)
 {
     fileutil::LoadedBuffer::UP loaded_buffer = loadDAT();
     char *rawBuffer = const_cast<char *>(static_cast<const char *>(loaded_buffer->buffer()));
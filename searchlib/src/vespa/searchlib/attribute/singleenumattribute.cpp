@@ -15,7 +15,8 @@ SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder)
     : _enumIndices(c.getGrowStrategy().getDocsInitialCapacity(),
                    c.getGrowStrategy().getDocsGrowPercent(),
                    c.getGrowStrategy().getDocsGrowDelta(),
-                   genHolder)
+                   genHolder,
+                   c.getGrowStrategy().initialDocsAlloc())
 {
 }
 
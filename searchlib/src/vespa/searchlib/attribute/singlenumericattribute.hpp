@@ -9,6 +9,7 @@
 #include "attributeiterators.hpp"
 #include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <unistd.h>
 
 namespace search {
 
@@ -19,7 +20,8 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          c.getGrowStrategy().initialDocsAlloc())
 { }
 
 template <typename B>
@@ -123,10 +125,34 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
     return true;
 }
 
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::onLoadMapped(const ReaderBase &attrReader, size_t numDocs)
+{
+    size_t offset = attrReader.getDatHeaderLen();
+    if ((numDocs == 0) || ((offset % sysconf(_SC_PAGESIZE)) != 0)) {
+        return false;
+    }
+    vespalib::string fileName(this->getBaseFileName());
+    fileName += ".dat";
+    /*
+     * The saved data is used as initial backing store. Pages are
+     * copied when first written to, and the vector is moved to
+     * ordinary memory when it needs to grow.
+     */
+    auto mapped = vespalib::alloc::Alloc::allocMMapFile(fileName.c_str(), offset, numDocs * sizeof(T));
+    if (mapped.get() == nullptr) {
+        return false;
+    }
+    getGenerationHolder().clearHoldLists();
+    _data.reset();
+    _data.replaceVector(std::make_unique<vespalib::Array<T>>(std::move(mapped), numDocs));
+    return true;
+}
 
 template <typename B>
 bool
-SingleValueNumericAttribute<B>::onLoad()
+SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -140,11 +166,13 @@ SingleValueNumericAttribute<B>::onLoad()
         return onLoadEnumerated(attrReader);
     
     const size_t sz(attrReader.getDataCount());
-    getGenerationHolder().clearHoldLists();
-    _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    if (!(this->getConfig().loadMapped() && onLoadMapped(attrReader, sz))) {
+        getGenerationHolder().clearHoldLists();
+        _data.reset();
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
@@ -96,9 +96,9 @@ public:
     ~SingleValueNumericEnumAttribute();
 
     void onCommit() override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
-    bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor);
 
     AttributeVector::SearchContext::UP
     getSearch(QueryTermSimpleUP term, const attribute::SearchContextParams & params) const override;
@@ -66,9 +66,9 @@ protected:
     using EnumEntryType = const char*;
     ChangeVector _changes;
     Change _defaultValue;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
-    bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor);
 
     virtual bool onAddDoc(DocId doc) override;
 
@@ -195,6 +195,59 @@ IndexBuilder::FieldHandle::close()
     _file.close();
 }
 
+namespace {
+
+/**
+ * Builds the disk index for a single field, independent of other fields.
+ */
+class SingleFieldIndexBuilder : public index::FieldIndexBuilder {
+private:
+    IndexBuilder::FieldHandle &_field;
+    bool _inWord;
+
+public:
+    SingleFieldIndexBuilder(IndexBuilder::FieldHandle &field);
+    ~SingleFieldIndexBuilder() override;
+    void startWord(vespalib::stringref word) override;
+    void endWord() override;
+    void add_document(const index::DocIdAndFeatures &features) override;
+};
+
+SingleFieldIndexBuilder::SingleFieldIndexBuilder(IndexBuilder::FieldHandle &field)
+    : _field(field),
+      _inWord(false)
+{
+}
+
+SingleFieldIndexBuilder::~SingleFieldIndexBuilder()
+{
+    assert(!_inWord);
+}
+
+void
+SingleFieldIndexBuilder::startWord(vespalib::stringref word)
+{
+    assert(!_inWord);
+    _inWord = true;
+    _field.new_word(word);
+}
+
+void
+SingleFieldIndexBuilder::endWord()
+{
+    assert(_inWord);
+    _inWord = false;
+}
+
+void
+SingleFieldIndexBuilder::add_document(const index::DocIdAndFeatures &features)
+{
+    assert(_inWord);
+    _field.add_document(features);
+}
+
+}
+
 IndexBuilder::IndexBuilder(const Schema &schema)
     : index::IndexBuilder(schema),
       _currentField(nullptr),
@@ -244,6 +297,14 @@ IndexBuilder::endField()
     _currentField = nullptr;
 }
 
+std::unique_ptr<index::FieldIndexBuilder>
+IndexBuilder::make_field_index_builder(uint32_t fieldId)
+{
+    assert(_currentField == nullptr);
+    assert(fieldId < _fields.size());
+    return std::make_unique<SingleFieldIndexBuilder>(_fields[fieldId]);
+}
+
 void
 IndexBuilder::startWord(vespalib::stringref word)
 {
@@ -56,6 +56,7 @@ public:
 
     void startField(uint32_t fieldId) override;
     void endField() override;
+    std::unique_ptr<index::FieldIndexBuilder> make_field_index_builder(uint32_t fieldId) override;
     void startWord(vespalib::stringref word) override;
     void endWord() override;
     void add_document(const index::DocIdAndFeatures &features) override;
@@ -7,6 +7,7 @@
 #include "value.h"
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 
@@ -111,6 +112,49 @@ public:
 
 }
 
+namespace {
+
+/**
+ * Adds documents read from the backing store to the document cache before
+ * handing them to the visitor. The cache generation of each lid is taken
+ * before the bulk read, so a document written or removed while it is read
+ * is not put in the cache.
+ **/
+class CachePopulatingVisitor : public IBufferVisitor
+{
+public:
+    CachePopulatingVisitor(docstore::Cache & cache, const IDocumentStore::LidVector & lids,
+                           const CompressionConfig & compression,
+                           const DocumentTypeRepo & repo, IDocumentVisitor & visitor)
+        : _cache(cache),
+          _generations(lids.size()*2),
+          _compression(compression),
+          _adapter(repo, visitor)
+    {
+        for (uint32_t lid : lids) {
+            _generations[lid] = _cache.getGeneration(lid);
+        }
+    }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        auto found = _generations.find(lid);
+        if ((buf.size() > 0) && (found != _generations.end())) {
+            vespalib::DataBuffer data(buf.size());
+            data.writeBytes(buf.c_str(), buf.size());
+            docstore::Value value;
+            value.set(std::move(data), buf.size(), _compression);
+            _cache.populate(lid, std::move(value), found->second);
+        }
+        _adapter.visit(lid, buf);
+    }
+private:
+    docstore::Cache                       & _cache;
+    vespalib::hash_map<uint32_t, size_t>    _generations;
+    CompressionConfig                       _compression;
+    DocumentVisitorAdapter                  _adapter;
+};
+
+}
+
 using VisitCache = docstore::VisitCache;
 using docstore::Value;
 
@@ -155,14 +199,38 @@ DocumentStore::useCache() const {
 void
 DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
 {
-    if (useCache() && _config.allowVisitCaching() && visitor.allowVisitCaching()) {
-        docstore::BlobSet blobSet = _visitCache->read(lids).getBlobSet();
+    if ( ! useCache()) {
+        _store->visit(lids, repo, visitor);
+        return;
+    }
+    LidVector missing;
+    for (DocumentIdT lid : lids) {
+        Value value;
+        if (_cache->readIfCached(lid, value)) {
+            Value::Result result = value.decompressed();
+            if (result.second) {
+                visitor.visit(lid, std::make_unique<document::Document>(repo, std::move(result.first)));
+                continue;
+            }
+            LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
+            _cache->invalidate(lid);
+        }
+        missing.push_back(lid);
+    }
+    if (missing.empty()) {
+        return;
+    }
+    if (_config.allowVisitCaching() && visitor.allowVisitCaching()) {
+        docstore::BlobSet blobSet = _visitCache->read(missing).getBlobSet();
         DocumentVisitorAdapter adapter(repo, visitor);
-        for (DocumentIdT lid : lids) {
+        for (DocumentIdT lid : missing) {
             adapter.visit(lid, blobSet.get(lid));
         }
+    } else if (visitor.populateCache()) {
+        CachePopulatingVisitor populator(*_cache, missing, _store->getCompression(), repo, visitor);
+        _backingStore.read(missing, populator);
     } else {
-        _store->visit(lids, repo, visitor);
+        _store->visit(missing, repo, visitor);
     }
 }
 
@@ -218,6 +286,7 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
                     _cache->write(lid, std::move(value));
                 } else {
                     _backingStore.write(syncToken, lid, stream.peek(), stream.size());
+                    _cache->invalidate(lid); // Rejects any populate of what was read before this write.
                 }
                 break;
         }
@@ -50,6 +50,11 @@ public:
     virtual ~IDocumentVisitor() { }
     virtual void visit(uint32_t lid, DocumentUP doc) = 0;
     virtual bool allowVisitCaching() const = 0;
+    /**
+     * Whether documents read from the backing store should be added to the
+     * document cache, as is done when reading a single document.
+     */
+    virtual bool populateCache() const { return false; }
 private:
 };
 
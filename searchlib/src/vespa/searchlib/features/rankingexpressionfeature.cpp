@@ -52,10 +52,19 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    size_t _batch_stride;
+    std::vector<float> _batch_params; // parameter major; _batch_params[param * _batch_stride + slot]
+
+    void grow_batch(size_t min_slots);
+
+protected:
+    void handle_gather_batch(size_t slot) override;
+    void handle_execute_batch(ArrayRef<feature_t> results) override;
 
 public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
+    bool supports_batch() const override { return true; }
     void execute(uint32_t docId) override;
 };
 
@@ -132,10 +141,26 @@ public:
 FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_stride(0),
+      _batch_params()
 {
 }
 
+void
+FastForestExecutor::grow_batch(size_t min_slots)
+{
+    size_t num_params = _params.size();
+    size_t new_stride = std::max(min_slots, std::max(size_t(16), _batch_stride * 2));
+    std::vector<float> new_params(num_params * new_stride, 0.0f);
+    for (size_t i = 0; i < num_params; ++i) {
+        std::copy_n(_batch_params.data() + (i * _batch_stride), _batch_stride,
+                    new_params.data() + (i * new_stride));
+    }
+    _batch_params = std::move(new_params);
+    _batch_stride = new_stride;
+}
+
 void
 FastForestExecutor::execute(uint32_t)
 {
@@ -152,6 +177,25 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::handle_gather_batch(size_t slot)
+{
+    if (slot >= _batch_stride) {
+        grow_batch(slot + 1);
+    }
+    float *dst = _batch_params.data() + slot;
+    for (size_t i = 0; i < _params.size(); ++i) {
+        dst[i * _batch_stride] = inputs().get_number(i);
+    }
+}
+
+void
+FastForestExecutor::handle_execute_batch(ArrayRef<feature_t> results)
+{
+    assert(results.size() <= _batch_stride);
+    _forest.eval_batch(*_ctx, _batch_params.data(), _batch_stride, results.size(), results.begin());
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
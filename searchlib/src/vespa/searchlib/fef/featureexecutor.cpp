@@ -20,6 +20,24 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::handle_gather_batch(size_t)
+{
+    abort();
+}
+
+void
+FeatureExecutor::handle_execute_batch(vespalib::ArrayRef<feature_t>)
+{
+    abort();
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
@@ -28,6 +28,7 @@ public:
     LazyValue(const NumberOrObject *value, FeatureExecutor *executor)
         : _value(value), _executor(executor) {}
     bool is_const() const { return (_executor == nullptr); }
+    FeatureExecutor *executor() const { return _executor; }
     bool is_same(const LazyValue &rhs) const {
         return ((_value == rhs._value) && (_executor == rhs._executor));
     }
@@ -110,6 +111,24 @@ protected:
      **/
     virtual void execute(uint32_t docId) = 0;
 
+    /**
+     * Resolve and store the inputs needed to calculate the output for
+     * the current document (see inputs().get_docid()) in the given
+     * batch slot. Only called if supports_batch() returns true.
+     *
+     * @param slot batch slot for the current document
+     **/
+    virtual void handle_gather_batch(size_t slot);
+
+    /**
+     * Calculate output 0 for all documents gathered into the first
+     * results.size() batch slots. Only called if supports_batch()
+     * returns true.
+     *
+     * @param results where to store the result for each slot
+     **/
+    virtual void handle_execute_batch(vespalib::ArrayRef<feature_t> results);
+
 public:
     /**
      * Create a feature executor that has not yet been bound to neither
@@ -150,6 +169,43 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its
+     * (numeric) output for a batch of documents at a time. Batch
+     * evaluation is split in two steps; gather_batch is called for
+     * each document after match data has been unpacked for that
+     * document, then execute_batch calculates the output for all
+     * gathered documents in one go. This is used to reduce per
+     * document overhead when re-ranking hits.
+     *
+     * @return true if this feature executor supports batch evaluation
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Gather inputs for a single document into a batch slot. The
+     * batch slots must be filled in order starting at 0.
+     *
+     * @param docid the local document id being evaluated
+     * @param slot batch slot for the document
+     **/
+    void gather_batch(uint32_t docid, size_t slot) {
+        _inputs.set_docid(docid);
+        handle_gather_batch(slot);
+    }
+
+    /**
+     * Calculate the output for all gathered documents. The output
+     * value of this executor is not updated by batch evaluation, so
+     * any cached per-document result is invalidated.
+     *
+     * @param results where to store the result for each slot
+     **/
+    void execute_batch(vespalib::ArrayRef<feature_t> results) {
+        _inputs.set_docid(-1);
+        handle_execute_batch(results);
+    }
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -0,0 +1,24 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search::index {
+
+class DocIdAndFeatures;
+
+/**
+ * Interface used to build the index for a single index field.
+ *
+ * Words are added in sorted order, and for each word the set of document ids
+ * (with position information) is added in sorted order.
+ */
+class FieldIndexBuilder {
+public:
+    virtual ~FieldIndexBuilder() = default;
+    virtual void startWord(vespalib::stringref word) = 0;
+    virtual void endWord() = 0;
+    virtual void add_document(const DocIdAndFeatures &features) = 0;
+};
+
+}
@@ -1,11 +1,11 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include <vespa/vespalib/stllike/string.h>
+#include "field_index_builder.h"
+#include <memory>
 
 namespace search::index {
 
-class DocIdAndFeatures;
 class Schema;
 class WordDocElementWordPosFeatures;
 
@@ -16,20 +16,28 @@ class WordDocElementWordPosFeatures;
  *   For each field add the set of unique words in sorted order.
  *   For each word add the set of document ids in sorted order.
  *   For each document id add the position information for that document.
+ *
+ * Fields are either built sequentially through startField()/endField(), or
+ * concurrently through separate field index builders if supported by the
+ * implementation (see make_field_index_builder()).
  */
-class IndexBuilder {
+class IndexBuilder : public FieldIndexBuilder {
 protected:
     const Schema &_schema;
 
 public:
     IndexBuilder(const Schema &schema);
 
-    virtual ~IndexBuilder();
+    ~IndexBuilder() override;
     virtual void startField(uint32_t fieldId) = 0;
     virtual void endField() = 0;
-    virtual void startWord(vespalib::stringref word) = 0;
-    virtual void endWord() = 0;
-    virtual void add_document(const DocIdAndFeatures &features) = 0;
+
+    /**
+     * Returns a builder for the given field that can be used concurrently
+     * with builders for other fields, or nullptr if not supported.
+     * Destroying the returned builder ends the field.
+     */
+    virtual std::unique_ptr<FieldIndexBuilder> make_field_index_builder(uint32_t fieldId);
 };
 
 }
@@ -82,7 +82,7 @@ public:
 
     void compactFeatures() override;
 
-    void dump(search::index::IndexBuilder & indexBuilder) override;
+    void dump(search::index::FieldIndexBuilder & indexBuilder) override;
 
     vespalib::MemoryUsage getMemoryUsage() const override;
     PostingListStore &getPostingListStore() { return _postingListStore; }
@@ -5,6 +5,7 @@
 #include "ordered_field_index_inserter.h"
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/index/i_field_length_inspector.h>
+#include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/vespalib/btree/btree.hpp>
 #include <vespa/vespalib/btree/btreeiterator.hpp>
 #include <vespa/vespalib/btree/btreenode.hpp>
@@ -12,8 +13,11 @@
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/btree/btreestore.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.field_index_collection");
@@ -58,6 +62,35 @@ FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
     }
 }
 
+void
+FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor)
+{
+    std::vector<std::unique_ptr<search::index::FieldIndexBuilder>> fieldBuilders;
+    fieldBuilders.reserve(_numFields);
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        auto fieldBuilder = indexBuilder.make_field_index_builder(fieldId);
+        if (!fieldBuilder) {
+            fieldBuilders.clear();
+            dump(indexBuilder);
+            return;
+        }
+        fieldBuilders.push_back(std::move(fieldBuilder));
+    }
+    vespalib::CountDownLatch done(_numFields);
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        auto rejected = executor.execute(vespalib::makeLambdaTask([this, fieldId, &fieldBuilders, &done]() {
+            _fieldIndexes[fieldId]->dump(*fieldBuilders[fieldId]);
+            fieldBuilders[fieldId].reset();
+            done.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    LOG(debug, "Waiting for %u fields to be dumped", _numFields);
+    done.await();
+}
+
 vespalib::MemoryUsage
 FieldIndexCollection::getMemoryUsage() const
 {
@@ -9,8 +9,10 @@
 
 namespace search::index {
     class IFieldLengthInspector;
+    class IndexBuilder;
     class Schema;
 }
+namespace vespalib { class ThreadExecutor; }
 
 namespace search::memoryindex {
 
@@ -44,6 +46,12 @@ public:
 
     void dump(search::index::IndexBuilder & indexBuilder);
 
+    /**
+     * Dump the field indexes concurrently using the given executor if the index builder
+     * supports building fields concurrently, otherwise fall back to sequential dumping.
+     */
+    void dump(search::index::IndexBuilder & indexBuilder, vespalib::ThreadExecutor & executor);
+
     vespalib::MemoryUsage getMemoryUsage() const;
 
     IFieldIndex *getFieldIndex(uint32_t fieldId) const {
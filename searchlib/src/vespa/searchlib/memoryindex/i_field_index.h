@@ -7,8 +7,8 @@
 #include <vespa/vespalib/util/memoryusage.h>
 
 namespace search::index {
+class FieldIndexBuilder;
 class FieldLengthCalculator;
-class IndexBuilder;
 }
 
 namespace search::memoryindex {
@@ -33,7 +33,7 @@ public:
     virtual FieldIndexRemover& getDocumentRemover() = 0;
     virtual index::FieldLengthCalculator& get_calculator() = 0;
     virtual void compactFeatures() = 0;
-    virtual void dump(search::index::IndexBuilder& indexBuilder) = 0;
+    virtual void dump(search::index::FieldIndexBuilder& indexBuilder) = 0;
 
     virtual std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const vespalib::string& term,
                                                                                 const queryeval::FieldSpecBase& field,
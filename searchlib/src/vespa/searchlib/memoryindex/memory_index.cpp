@@ -133,6 +133,12 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
     _fieldIndexes->dump(indexBuilder);
 }
 
+void
+MemoryIndex::dump(IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor)
+{
+    _fieldIndexes->dump(indexBuilder, executor);
+}
+
 namespace {
 
 /**
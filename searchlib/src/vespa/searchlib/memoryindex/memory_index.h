@@ -18,6 +18,8 @@ namespace search { class ISequencedTaskExecutor; }
 
 namespace document { class Document; }
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search::memoryindex {
 
 class DocumentInverter;
@@ -139,6 +141,12 @@ public:
      */
     void dump(index::IndexBuilder &indexBuilder);
 
+    /**
+     * Dump the contents of this index into the given index builder,
+     * dumping the fields concurrently using the given executor when supported by the index builder.
+     */
+    void dump(index::IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor);
+
     // Implements Searchable
     queryeval::Blueprint::UP createBlueprint(const queryeval::IRequestContext & requestContext,
                                              const queryeval::FieldSpec &field,
@@ -0,0 +1,107 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_posting_list.h"
+#include <algorithm>
+#include <cassert>
+
+namespace search::predicate {
+
+namespace {
+
+uint32_t bitWidth(uint32_t value) {
+    return (value == 0) ? 0 : (32 - __builtin_clz(value));
+}
+
+void pack(const uint32_t *values, uint32_t count, uint32_t bits, std::vector<uint64_t> &words) {
+    if (bits == 0 || count == 0) {
+        return;
+    }
+    size_t first_word = words.size();
+    words.resize(first_word + (uint64_t(count) * bits + 63) / 64, 0);
+    uint64_t *dst = words.data() + first_word;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t bit_pos = uint64_t(i) * bits;
+        uint32_t shift = bit_pos & 63;
+        dst[bit_pos >> 6] |= uint64_t(values[i]) << shift;
+        if (shift + bits > 64) {
+            dst[(bit_pos >> 6) + 1] |= uint64_t(values[i]) >> (64 - shift);
+        }
+    }
+}
+
+}
+
+CompressedPostingList::CompressedPostingList(const std::vector<uint32_t> &doc_ids,
+                                             const std::vector<uint32_t> &data)
+    : _blocks(),
+      _words(),
+      _size(doc_ids.size())
+{
+    assert(doc_ids.size() == data.size());
+    _blocks.reserve((_size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    uint32_t deltas[BLOCK_SIZE];
+    uint32_t prev_doc_id = 0;
+    for (uint32_t start = 0; start < _size; start += BLOCK_SIZE) {
+        uint32_t count = std::min(BLOCK_SIZE, _size - start);
+        uint32_t max_delta = 0;
+        uint32_t max_data = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            assert(start + i == 0 || doc_ids[start + i] > prev_doc_id);
+            deltas[i] = doc_ids[start + i] - prev_doc_id;
+            prev_doc_id = doc_ids[start + i];
+            max_delta = std::max(max_delta, deltas[i]);
+            max_data = std::max(max_data, data[start + i]);
+        }
+        Block block;
+        block.last_doc_id = prev_doc_id;
+        block.offset = _words.size();
+        block.doc_id_bits = bitWidth(max_delta);
+        block.data_bits = bitWidth(max_data);
+        block.size = count;
+        pack(deltas, count, block.doc_id_bits, _words);
+        block.data_offset = _words.size();
+        pack(&data[start], count, block.data_bits, _words);
+        _blocks.push_back(block);
+    }
+    // Padding words, allowing extract() to always read two words, also
+    // for zero width data at the end.
+    _words.resize(_words.size() + 2, 0);
+    _words.shrink_to_fit();
+}
+
+CompressedPostingList::~CompressedPostingList() = default;
+
+uint32_t
+CompressedPostingList::decodeDocIds(uint32_t block, uint32_t *doc_ids) const
+{
+    const Block &b = _blocks[block];
+    const uint64_t *words = _words.data() + b.offset;
+    uint32_t bits = b.doc_id_bits;
+    for (uint32_t i = 0; i < b.size; ++i) {
+        doc_ids[i] = extract(words, uint64_t(i) * bits, bits);
+    }
+    uint32_t doc_id = (block == 0) ? 0 : _blocks[block - 1].last_doc_id;
+    for (uint32_t i = 0; i < b.size; ++i) {
+        doc_id += doc_ids[i];
+        doc_ids[i] = doc_id;
+    }
+    return b.size;
+}
+
+uint32_t
+CompressedPostingList::seekBlock(uint32_t block, uint32_t doc_id) const
+{
+    auto it = std::lower_bound(_blocks.begin() + std::min(block, numBlocks()), _blocks.end(), doc_id,
+                               [](const Block &b, uint32_t id) { return b.last_doc_id < id; });
+    return it - _blocks.begin();
+}
+
+vespalib::MemoryUsage
+CompressedPostingList::getMemoryUsage() const
+{
+    size_t allocated = sizeof(*this) + _blocks.capacity() * sizeof(Block) + _words.capacity() * sizeof(uint64_t);
+    size_t used = sizeof(*this) + _blocks.size() * sizeof(Block) + _words.size() * sizeof(uint64_t);
+    return vespalib::MemoryUsage(allocated, used, 0, 0);
+}
+
+}
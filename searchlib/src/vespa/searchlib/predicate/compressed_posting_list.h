@@ -0,0 +1,155 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/memoryusage.h>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace search::predicate {
+
+/**
+ * Immutable posting list of doc ids with 32 bit posting data, used by
+ * SimpleIndex for large posting lists that are not modified.
+ *
+ * Postings are grouped in blocks of BLOCK_SIZE. Within a block, doc id
+ * deltas and posting data are bit packed using the smallest width that
+ * fits the largest value in the block. Each block has a skip entry with
+ * its last doc id, so seeking only decodes the block containing the
+ * target doc id. Doc ids are decoded a block at a time using a branch
+ * free unpack loop followed by a prefix sum, while posting data is
+ * extracted on demand.
+ */
+class CompressedPostingList {
+public:
+    static constexpr uint32_t BLOCK_SIZE = 128;
+
+    struct Block {
+        uint32_t last_doc_id;
+        uint32_t offset;      // First word of the block in _words
+        uint32_t data_offset; // First word of the posting data in _words
+        uint8_t  doc_id_bits;
+        uint8_t  data_bits;
+        uint16_t size;
+    };
+
+private:
+    std::vector<Block>    _blocks;
+    std::vector<uint64_t> _words;
+    uint32_t              _size;
+
+    static uint32_t extract(const uint64_t *words, uint64_t bit_pos, uint32_t bits) {
+        const uint64_t *word = words + (bit_pos >> 6);
+        uint32_t shift = bit_pos & 63;
+        // The second word is always readable, as _words is padded at the end.
+        uint64_t value = (word[0] >> shift) | ((word[1] << 1) << (63 - shift));
+        return value & ((uint64_t(1) << bits) - 1);
+    }
+
+public:
+    /**
+     * Creates a posting list from sorted, unique doc ids with their posting data.
+     */
+    CompressedPostingList(const std::vector<uint32_t> &doc_ids, const std::vector<uint32_t> &data);
+    ~CompressedPostingList();
+
+    uint32_t size() const { return _size; }
+    uint32_t numBlocks() const { return _blocks.size(); }
+    const Block &getBlock(uint32_t block) const { return _blocks[block]; }
+
+    /**
+     * Decodes the doc ids of the given block into doc_ids, which must
+     * have room for BLOCK_SIZE entries. Returns the number of doc ids.
+     */
+    uint32_t decodeDocIds(uint32_t block, uint32_t *doc_ids) const;
+
+    uint32_t getData(uint32_t block, uint32_t index) const {
+        const Block &b = _blocks[block];
+        return extract(_words.data() + b.data_offset, uint64_t(index) * b.data_bits, b.data_bits);
+    }
+
+    /**
+     * Returns the first block starting from the given block that may
+     * contain doc ids >= doc_id, or numBlocks() if there is none.
+     */
+    uint32_t seekBlock(uint32_t block, uint32_t doc_id) const;
+
+    vespalib::MemoryUsage getMemoryUsage() const;
+};
+
+/**
+ * Posting data is stored as the 32 bit representation of the posting,
+ * and decoded by constructing the posting from that representation.
+ */
+template <typename Posting>
+uint32_t toCompressedPostingData(const Posting &posting) {
+    static_assert(sizeof(Posting) == sizeof(uint32_t) && std::is_trivially_copyable<Posting>::value,
+                  "Compressed posting lists require 32 bit posting data");
+    uint32_t data;
+    memcpy(&data, &posting, sizeof(data));
+    return data;
+}
+
+template <typename Posting>
+Posting fromCompressedPostingData(uint32_t data) {
+    static_assert(sizeof(Posting) == sizeof(uint32_t) && std::is_trivially_copyable<Posting>::value &&
+                  std::is_constructible<Posting, uint32_t>::value,
+                  "Compressed posting lists require 32 bit posting data constructible from its representation");
+    return Posting(data);
+}
+
+/**
+ * Iterator over a CompressedPostingList, with the same interface as the
+ * btree and vector posting list iterators used by SimpleIndex.
+ */
+template <typename Posting, typename DocId = uint32_t>
+class CompressedPostingListIterator {
+    const CompressedPostingList *_list;
+    uint32_t _block;
+    uint32_t _pos;
+    uint32_t _block_size;
+    uint32_t _doc_ids[CompressedPostingList::BLOCK_SIZE];
+
+    void loadBlock(uint32_t block) {
+        _block = block;
+        _pos = 0;
+        _block_size = (block < _list->numBlocks()) ? _list->decodeDocIds(block, _doc_ids) : 0;
+    }
+
+public:
+    explicit CompressedPostingListIterator(const CompressedPostingList &list)
+        : _list(&list), _block(0), _pos(0), _block_size(0)
+    {
+        loadBlock(0);
+    }
+
+    bool valid() const { return _pos < _block_size; }
+    DocId getKey() const { return _doc_ids[_pos]; }
+    Posting getData() const {
+        return fromCompressedPostingData<Posting>(_list->getData(_block, _pos));
+    }
+    void linearSeek(DocId doc_id) {
+        if (!valid()) {
+            return;
+        }
+        if (_doc_ids[_block_size - 1] < doc_id) {
+            loadBlock(_list->seekBlock(_block + 1, doc_id));
+            if (!valid()) {
+                return;
+            }
+        }
+        while (_doc_ids[_pos] < doc_id) {
+            ++_pos;
+        }
+    }
+    CompressedPostingListIterator & operator++() {
+        if (++_pos == _block_size) {
+            loadBlock(_block + 1);
+        }
+        return *this;
+    }
+};
+
+}
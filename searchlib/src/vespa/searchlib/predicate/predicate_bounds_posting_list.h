@@ -18,7 +18,7 @@ class PredicateBoundsPostingList : public PredicatePostingList {
     const IntervalWithBounds *_current_interval;
     uint32_t _interval_count;
     uint32_t _value_diff;
-    IntervalWithBounds _single_buf;
+    std::vector<IntervalWithBounds> _interval_buf;
 
 public:
     PredicateBoundsPostingList(const PredicateIntervalStore &interval_store,Iterator it,uint32_t value_diff);
@@ -37,7 +37,8 @@ PredicateBoundsPostingList<Iterator>::PredicateBoundsPostingList(
           _iterator(it),
           _current_interval(0),
           _interval_count(0),
-          _value_diff(value_diff) {
+          _value_diff(value_diff),
+          _interval_buf() {
 }
 
 namespace {
@@ -61,7 +62,7 @@ bool PredicateBoundsPostingList<Iterator>::next(uint32_t doc_id) {
         if (!_iterator.valid()) {
             return false;
         }
-        _current_interval = _interval_store.get(_iterator.getData(), _interval_count, &_single_buf);
+        _current_interval = _interval_store.get(_iterator.getData(), _interval_count, _interval_buf);
         if (checkBounds(_current_interval->bounds, _value_diff)) {
             break;
         }
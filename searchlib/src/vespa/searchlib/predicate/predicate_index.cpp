@@ -51,8 +51,8 @@ public:
     IntervalSerializer(const PredicateIntervalStore &store) : _store(store) {}
     void serialize(const EntryRef &ref, vespalib::DataBuffer &buffer) const override {
         uint32_t size;
-        IntervalT single_buf;
-        const IntervalT *interval = _store.get(ref, size, &single_buf);
+        std::vector<IntervalT> buf;
+        const IntervalT *interval = _store.get(ref, size, buf);
         buffer.writeInt16(size);
         for (uint32_t i = 0; i < size; ++i) {
             interval[i].serialize(buffer);
@@ -144,6 +144,8 @@ void PredicateIndex::serialize(DataBuffer &buffer) const {
 void PredicateIndex::onDeserializationCompleted() {
     _interval_index.promoteOverThresholdVectors();
     _bounds_index.promoteOverThresholdVectors();
+    _interval_index.compressFrozenPostingLists();
+    _bounds_index.compressFrozenPostingLists();
 }
 
 void PredicateIndex::indexDocument(uint32_t doc_id, const PredicateTreeAnnotations &annotations) {
@@ -169,11 +171,10 @@ void removeFromIndex(
     }
 }
 
+template <typename PostingIterator>
 class DocIdIterator : public PopulateInterface::Iterator {
 public:
-    using BTreeIterator = SimpleIndex<datastore::EntryRef>::BTreeIterator;
-
-    DocIdIterator(BTreeIterator it) : _it(it) { }
+    DocIdIterator(PostingIterator it) : _it(it) { }
     int32_t getNext() override {
         if (_it.valid()) {
             uint32_t docId = _it.getKey();
@@ -183,7 +184,7 @@ public:
         return -1;
     }
 private:
-    BTreeIterator _it;
+    PostingIterator _it;
 };
 
 }  // namespace
@@ -240,9 +241,16 @@ PredicateIndex::lookup(uint64_t key) const
 {
     auto dictIterator = _interval_index.lookup(key);
     if (dictIterator.valid()) {
+        auto compressed = _interval_index.getCompressedPostingList(key);
+        if (compressed) {
+            if (compressed->valid()) {
+                return PopulateInterface::Iterator::UP(new DocIdIterator<CompressedIterator>(*compressed));
+            }
+            return PopulateInterface::Iterator::UP();
+        }
         auto it = _interval_index.getBTreePostingList(dictIterator.getData());
         if (it.valid()) {
-            return PopulateInterface::Iterator::UP(new DocIdIterator(it));
+            return PopulateInterface::Iterator::UP(new DocIdIterator<BTreeIterator>(it));
         }
     }
     return PopulateInterface::Iterator::UP();
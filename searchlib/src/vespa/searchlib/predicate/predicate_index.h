@@ -37,6 +37,7 @@ public:
     typedef vespalib::GenerationHolder GenerationHolder;
     using BTreeIterator = SimpleIndex<datastore::EntryRef>::BTreeIterator;
     using VectorIterator = SimpleIndex<datastore::EntryRef>::VectorIterator;
+    using CompressedIterator = SimpleIndex<datastore::EntryRef>::CompressedIterator;
 private:
     uint32_t _arity;
     GenerationHandler &_generation_handler;
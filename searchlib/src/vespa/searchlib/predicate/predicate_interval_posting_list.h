@@ -17,7 +17,7 @@ class PredicateIntervalPostingList : public PredicatePostingList {
     Iterator _iterator;
     const Interval *_current_interval;
     uint32_t _interval_count;
-    Interval _single_buf;
+    std::vector<Interval> _interval_buf;
 
 public:
     PredicateIntervalPostingList(const PredicateIntervalStore &interval_store, Iterator it);
@@ -42,7 +42,8 @@ PredicateIntervalPostingList<Iterator>::PredicateIntervalPostingList(
         : _interval_store(interval_store),
           _iterator(it),
           _current_interval(nullptr),
-          _interval_count(0) {
+          _interval_count(0),
+          _interval_buf() {
 }
 
 template<typename Iterator>
@@ -56,7 +57,7 @@ bool PredicateIntervalPostingList<Iterator>::next(uint32_t doc_id) {
             return false;
         }
     }
-    _current_interval = _interval_store.get(_iterator.getData(), _interval_count, &_single_buf);
+    _current_interval = _interval_store.get(_iterator.getData(), _interval_count, _interval_buf);
     setDocId(_iterator.getKey());
     return true;
 }
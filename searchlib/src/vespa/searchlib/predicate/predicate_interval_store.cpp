@@ -33,34 +33,67 @@ PredicateIntervalStore::~PredicateIntervalStore() {
     _store.dropBuffers();
 }
 
+namespace {
+
+void encodeVarint(uint32_t value, vector<uint8_t> &bytes) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+// Encodes the intervals as described in the class comment, and
+// returns the encoded entry as zero padded uint32_t words.
+template <typename IntervalT>
+vector<uint32_t> encodeIntervals(const vector<IntervalT> &intervals, uint32_t entry_size) {
+    vector<uint8_t> bytes;
+    bytes.reserve(1 + intervals.size() * entry_size * 4);
+    encodeVarint(intervals.size(), bytes);
+    for (const auto &interval : intervals) {
+        const uint32_t *src = reinterpret_cast<const uint32_t *>(&interval);
+        for (uint32_t j = 0; j < entry_size; ++j) {
+            encodeVarint(src[j] >> 16, bytes);
+            encodeVarint(src[j] & 0xffff, bytes);
+        }
+    }
+    vector<uint32_t> words((bytes.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+    memcpy(&words[0], &bytes[0], bytes.size());
+    return words;
+}
+
+}
+
 //
-// NOTE: The allocated entries are arrays of type uint32_t, but the
-// entries are used as arrays of either Interval or IntervalWithBounds
-// objects (PODs). These objects are memcpy'ed into the uint32_t
-// arrays, and in the get() function they are typecast back to the
-// object expected by the caller. Which type an entry has cannot be
-// inferred from the EntryRef, but must be known by the caller.
+// NOTE: The entries are varint encoded Interval or IntervalWithBounds
+// objects (PODs), stored as arrays of uint32_t. In the get() function
+// they are decoded back to the objects expected by the caller. Which
+// type an entry has cannot be inferred from the EntryRef, but must be
+// known by the caller.
 //
 // This saves us from having separate buffers for Intervals and
 // IntervalWithBounds objects, since the caller knows the correct type
-// anyway.
+// anyway. The ref cache compares the encoded words, which are equal
+// exactly when the intervals are equal.
 //
 template <typename IntervalT>
 EntryRef PredicateIntervalStore::insert(const vector<IntervalT> &intervals) {
-    const uint32_t size = entrySize<IntervalT>() * intervals.size();
-    if (size == 0) {
+    if (intervals.empty()) {
         return EntryRef();
     }
-    uint32_t *buffer;
-    EntryRef ref;
-    if (size == 1 && intervals[0].interval <= RefCacheType::DATA_REF_MASK) {
+    if (entrySize<IntervalT>() == 1 && intervals.size() == 1 &&
+        intervals[0].interval <= RefCacheType::DATA_REF_MASK) {
         return EntryRef(intervals[0].interval);
     }
-    uint32_t cached_ref = _ref_cache.find(reinterpret_cast<const uint32_t *>(&intervals[0]), size);
+    vector<uint32_t> words = encodeIntervals(intervals, entrySize<IntervalT>());
+    const uint32_t size = words.size();
+    uint32_t cached_ref = _ref_cache.find(&words[0], size);
     if (cached_ref) {
         return EntryRef(cached_ref);
     }
 
+    uint32_t *buffer;
+    EntryRef ref;
     if (size < RefCacheType::MAX_SIZE) {
         auto entry = allocNewEntry<uint32_t>(0, size);
         buffer = entry.buffer;
@@ -71,7 +104,7 @@ EntryRef PredicateIntervalStore::insert(const vector<IntervalT> &intervals) {
         ref = EntryRef(entry.ref.ref() | RefCacheType::SIZE_MASK);
         *buffer++ = size;
     }
-    memcpy(buffer, &intervals[0], size * sizeof(uint32_t));
+    memcpy(buffer, &words[0], size * sizeof(uint32_t));
     _ref_cache.insert(ref.ref());
     return ref;
 }
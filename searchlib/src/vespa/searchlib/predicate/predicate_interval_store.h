@@ -13,6 +13,12 @@ struct Interval;
 /**
  * Stores interval entries in a memory-efficient way.
  * It works with both Interval and IntervalWithBounds entries.
+ *
+ * Entries with a single Interval are stored in the ref itself. Other
+ * entries are stored as the interval count followed by the 16 bit
+ * halves of each uint32_t in the entries, all varint encoded and
+ * padded to whole uint32_t words. Positions in predicate trees are
+ * usually small, so most intervals take two bytes instead of four.
  */
 class PredicateIntervalStore {
     class DataStoreAdapter;
@@ -50,6 +56,14 @@ class PredicateIntervalStore {
     template <typename IntervalT>
     static uint32_t entrySize() { return sizeof(IntervalT) / sizeof(uint32_t); }
 
+    static uint32_t decodeVarint(const uint8_t *&pos) {
+        uint32_t value = *pos & 0x7f;
+        for (uint32_t shift = 7; (*pos++ & 0x80) != 0; shift += 7) {
+            value |= static_cast<uint32_t>(*pos & 0x7f) << shift;
+        }
+        return value;
+    }
+
 public:
     PredicateIntervalStore();
     ~PredicateIntervalStore();
@@ -85,28 +99,39 @@ public:
     /**
      * Retrieves a list of intervals.
      * IntervalT is either Interval or IntervalWithBounds.
-     * single_buf is a pointer to a single IntervalT, used by the
-     * single interval optimization.
+     * Intervals are decoded into buf, which is reused between calls
+     * to avoid allocations. The returned pointer is valid until the
+     * next call using the same buffer.
      */
     template <typename IntervalT>
     const IntervalT *get(datastore::EntryRef btree_ref,
                          uint32_t &size_out,
-                         IntervalT *single_buf) const
+                         std::vector<IntervalT> &buf) const
     {
         uint32_t size = btree_ref.ref() >> RefCacheType::SIZE_SHIFT;
         RefType data_ref(datastore::EntryRef(btree_ref.ref() & RefCacheType::DATA_REF_MASK));
         if (__builtin_expect(size == 0, true)) {  // single-interval optimization
-            *single_buf = IntervalT();
-            single_buf->interval = data_ref.ref();
+            buf.resize(1);
+            buf[0] = IntervalT();
+            buf[0].interval = data_ref.ref();
             size_out = 1;
-            return single_buf;
+            return &buf[0];
         }
-        const uint32_t *buf = _store.getEntry<uint32_t>(data_ref);
+        const uint32_t *words = _store.getEntry<uint32_t>(data_ref);
         if (size == RefCacheType::MAX_SIZE) {
-            size = *buf++;
+            ++words;
+        }
+        const uint8_t *pos = reinterpret_cast<const uint8_t *>(words);
+        size_out = decodeVarint(pos);
+        buf.resize(size_out);
+        for (uint32_t i = 0; i < size_out; ++i) {
+            uint32_t *dst = reinterpret_cast<uint32_t *>(&buf[i]);
+            for (uint32_t j = 0; j < entrySize<IntervalT>(); ++j) {
+                uint32_t high = decodeVarint(pos);
+                dst[j] = (high << 16) | decodeVarint(pos);
+            }
         }
-        size_out = size / entrySize<IntervalT>();
-        return reinterpret_cast<const IntervalT *>(buf);
+        return &buf[0];
     }
 };
 
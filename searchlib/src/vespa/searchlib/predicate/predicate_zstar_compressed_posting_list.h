@@ -20,6 +20,7 @@ class PredicateZstarCompressedPostingList : public PredicatePostingList {
     uint32_t _interval_count;
     uint32_t _interval;
     uint32_t _prev_interval;
+    std::vector<Interval> _interval_buf;
 
     void setInterval(uint32_t interval) { _interval = interval; }
 public:
@@ -37,7 +38,8 @@ PredicateZstarCompressedPostingList<Iterator>::PredicateZstarCompressedPostingLi
           _current_interval(0),
           _interval_count(0),
           _interval(0),
-          _prev_interval(0) {
+          _prev_interval(0),
+          _interval_buf() {
 }
 
 template<typename Iterator>
@@ -48,8 +50,7 @@ bool PredicateZstarCompressedPostingList<Iterator>::next(uint32_t doc_id) {
     if (!_iterator.valid()) {
         return false;
     }
-    Interval single_buf;
-    _current_interval = _interval_store.get(_iterator.getData(), _interval_count, &single_buf);
+    _current_interval = _interval_store.get(_iterator.getData(), _interval_count, _interval_buf);
     setDocId(_iterator.getKey());
     setInterval(_current_interval[0].interval);
     _prev_interval = getInterval();
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "common.h"
+#include "compressed_posting_list.h"
 #include <vespa/vespalib/btree/btreestore.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/rcuvector.h>
@@ -35,6 +36,7 @@ struct SimpleIndexConfig {
     static constexpr size_t DEFAULT_LOWER_VECTOR_SIZE_THRESHOLD = static_cast<size_t>(0.8 * DEFAULT_UPPER_VECTOR_SIZE_THRESHOLD);
     static constexpr size_t DEFAULT_VECTOR_PRUNE_FREQUENCY = 20000;
     static constexpr double DEFAULT_FOREACH_VECTOR_THRESHOLD = 0.25;
+    static constexpr size_t DEFAULT_MIN_COMPRESSED_POSTING_LIST_SIZE = 256;
 
     // Create vector posting list if doc frequency is above
     double upper_docid_freq_threshold = DEFAULT_UPPER_DOCID_FREQ_THRESHOLD;
@@ -50,6 +52,8 @@ struct SimpleIndexConfig {
     double foreach_vector_threshold = DEFAULT_FOREACH_VECTOR_THRESHOLD;
     // Grow strategy for the posting vectors
     vespalib::GrowStrategy grow_strategy = vespalib::GrowStrategy();
+    // Compress frozen btree posting lists with at least this many documents (0 disables)
+    size_t min_compressed_posting_list_size = DEFAULT_MIN_COMPRESSED_POSTING_LIST_SIZE;
 
     SimpleIndexConfig() {}
     SimpleIndexConfig(double upper_docid_freq_threshold_,
@@ -134,6 +138,8 @@ public:
     using PostingVector = vespalib::RcuVectorBase<Posting>;
     using VectorStore = btree::BTree<Key, std::shared_ptr<PostingVector>, btree::NoAggregated>;
     using VectorIterator = PostingVectorIterator<Posting, Key, DocId>;
+    using CompressedStore = btree::BTree<Key, std::shared_ptr<CompressedPostingList>, btree::NoAggregated>;
+    using CompressedIterator = CompressedPostingListIterator<Posting, DocId>;
 
 private:
     using GenerationHolder = vespalib::GenerationHolder;
@@ -144,12 +150,14 @@ private:
     Dictionary _dictionary;
     BTreeStore _btree_posting_lists;
     VectorStore _vector_posting_lists;
+    CompressedStore _compressed_posting_lists;
     GenerationHolder &_generation_holder;
     uint32_t _insert_remove_counter = 0;
     const SimpleIndexConfig _config;
     const DocIdLimitProvider &_limit_provider;
 
     void insertIntoPosting(datastore::EntryRef &ref, Key key, DocId doc_id, const Posting &posting);
+    datastore::EntryRef decompressPostingList(typename Dictionary::Iterator &dict_it);
     void insertIntoVectorPosting(datastore::EntryRef ref, Key key, DocId doc_id, const Posting &posting);
     void removeFromVectorPostingList(datastore::EntryRef ref, Key key, DocId doc_id);
     void pruneBelowThresholdVectors();
@@ -186,6 +194,11 @@ public:
     // Call promoteOverThresholdVectors() after deserializing a SimpleIndex
     // (and after doc id limits values are determined) to promote posting lists to vectors.
     void promoteOverThresholdVectors();
+    // Call compressFrozenPostingLists() after promoteOverThresholdVectors() to replace
+    // large btree posting lists without a vector posting list with compressed posting
+    // lists. The dictionary then holds an invalid ref for the key, and the posting list
+    // is converted back to a btree posting list the first time it is modified.
+    void compressFrozenPostingLists();
     void commit();
     void trimHoldLists(generation_t used_generation);
     void transferHoldLists(generation_t generation);
@@ -201,6 +214,15 @@ public:
         return _btree_posting_lists.frozenSize(ref);
     }
 
+    size_t getPostingListSize(const DictionaryIterator &dict_it) const {
+        datastore::EntryRef ref = dict_it.getData();
+        if (ref.valid()) {
+            return getPostingListSize(ref);
+        }
+        auto it = _compressed_posting_lists.getFrozenView().find(dict_it.getKey());
+        return it.valid() ? it.getData()->size() : 0;
+    }
+
     BTreeIterator getBTreePostingList(datastore::EntryRef ref) const {
         return _btree_posting_lists.beginFrozen(ref);
     }
@@ -215,6 +237,14 @@ public:
         return optional<VectorIterator>();
 
     }
+
+    optional<CompressedIterator> getCompressedPostingList(Key key) const {
+        auto it = _compressed_posting_lists.getFrozenView().find(key);
+        if (it.valid()) {
+            return optional<CompressedIterator>(CompressedIterator(*it.getData()));
+        }
+        return optional<CompressedIterator>();
+    }
 };
 
 template<typename Posting, typename Key, typename DocId>
@@ -231,8 +261,15 @@ void SimpleIndex<Posting, Key, DocId>::foreach_frozen_key(
                 func(doc_id);
             }
         }
-    } else {
+    } else if (ref.valid()) {
         _btree_posting_lists.foreach_frozen_key(ref, func);
+    } else {
+        auto compressed_it = _compressed_posting_lists.getFrozenView().find(key);
+        if (compressed_it.valid()) {
+            for (CompressedIterator posting_it(*compressed_it.getData()); posting_it.valid(); ++posting_it) {
+                func(posting_it.getKey());
+            }
+        }
     }
 }
 
@@ -25,6 +25,26 @@ void SimpleIndex<Posting, Key, DocId>::insertIntoPosting(
     pruneBelowThresholdVectors();
 }
 
+template <typename Posting, typename Key, typename DocId>
+datastore::EntryRef SimpleIndex<Posting, Key, DocId>::decompressPostingList(
+        typename Dictionary::Iterator &dict_it) {
+    auto compressed_it = _compressed_posting_lists.find(dict_it.getKey());
+    assert(compressed_it.valid());
+    const CompressedPostingList &list = *compressed_it.getData();
+    std::vector<btree::BTreeKeyData<DocId, Posting>> postings;
+    postings.reserve(list.size());
+    for (CompressedIterator posting_it(list); posting_it.valid(); ++posting_it) {
+        postings.emplace_back(posting_it.getKey(), posting_it.getData());
+    }
+    datastore::EntryRef ref;
+    _btree_posting_lists.apply(ref, &postings[0], &postings[postings.size()], 0, 0);
+    // Readers must see the btree posting list before the compressed one is removed.
+    std::atomic_thread_fence(std::memory_order_release);
+    dict_it.writeData(ref);
+    _compressed_posting_lists.remove(compressed_it);
+    return ref;
+}
+
 template <typename Posting, typename Key, typename DocId>
 void SimpleIndex<Posting, Key, DocId>::insertIntoVectorPosting(
         datastore::EntryRef ref, Key key, DocId doc_id, const Posting &posting) {
@@ -57,6 +77,12 @@ SimpleIndex<Posting, Key, DocId>::~SimpleIndex() {
     _vector_posting_lists.getAllocator().freeze();
     _vector_posting_lists.getAllocator().clearHoldLists();
 
+    _compressed_posting_lists.disableFreeLists();
+    _compressed_posting_lists.disableElemHoldList();
+    _compressed_posting_lists.clear();
+    _compressed_posting_lists.getAllocator().freeze();
+    _compressed_posting_lists.getAllocator().clearHoldLists();
+
     _dictionary.disableFreeLists();
     _dictionary.disableElemHoldList();
     _dictionary.clear();
@@ -77,6 +103,19 @@ void SimpleIndex<Posting, Key, DocId>::serialize(
     buffer.writeInt32(_dictionary.size());
     for (auto it = _dictionary.begin(); it.valid(); ++it) {
         datastore::EntryRef ref = it.getData();
+        if (!ref.valid()) {
+            auto compressed_it = _compressed_posting_lists.find(it.getKey());
+            if (compressed_it.valid()) {
+                const CompressedPostingList &list = *compressed_it.getData();
+                buffer.writeInt32(list.size());
+                buffer.writeInt64(it.getKey());  // Key
+                for (CompressedIterator posting_it(list); posting_it.valid(); ++posting_it) {
+                    buffer.writeInt32(posting_it.getKey());  // DocId
+                    serializer.serialize(posting_it.getData(), buffer);
+                }
+                continue;
+            }
+        }
         buffer.writeInt32(_btree_posting_lists.size(ref));  // 0 if !valid()
         auto posting_it = _btree_posting_lists.begin(ref);
         if (!posting_it.valid())
@@ -134,6 +173,9 @@ void SimpleIndex<Posting, Key, DocId>::addPosting(Key key, DocId doc_id,
     datastore::EntryRef ref;
     if (iter.valid()) {
         ref = iter.getData();
+        if (!ref.valid()) {
+            ref = decompressPostingList(iter);
+        }
         insertIntoPosting(ref, key, doc_id, posting);
         if (ref != iter.getData()) {
             std::atomic_thread_fence(std::memory_order_release);
@@ -153,6 +195,9 @@ SimpleIndex<Posting, Key, DocId>::removeFromPostingList(Key key, DocId doc_id) {
         return std::make_pair(Posting(), false);
     }
     auto ref = dict_it.getData();
+    if (!ref.valid()) {
+        ref = decompressPostingList(dict_it);
+    }
     assert(ref.valid());
     auto posting_it = _btree_posting_lists.begin(ref);
     assert(posting_it.valid());
@@ -213,6 +258,49 @@ void SimpleIndex<Posting, Key, DocId>::promoteOverThresholdVectors() {
     }
 }
 
+template <typename Posting, typename Key, typename DocId>
+void SimpleIndex<Posting, Key, DocId>::compressFrozenPostingLists() {
+    if (_config.min_compressed_posting_list_size == 0) {
+        return;
+    }
+    std::vector<Key> keys;
+    std::vector<uint32_t> doc_ids;
+    std::vector<uint32_t> data;
+    for (auto it = _dictionary.begin(); it.valid(); ++it) {
+        Key key = it.getKey();
+        datastore::EntryRef ref = it.getData();
+        if (!ref.valid() || _vector_posting_lists.find(key).valid() ||
+            getDocumentCount(ref) < _config.min_compressed_posting_list_size) {
+            continue;
+        }
+        doc_ids.clear();
+        data.clear();
+        _btree_posting_lists.foreach_unfrozen(ref, [&](DocId d, const Posting &p) {
+            doc_ids.push_back(d);
+            data.push_back(toCompressedPostingData(p));
+        });
+        _compressed_posting_lists.insert(key, std::make_shared<CompressedPostingList>(doc_ids, data));
+        keys.push_back(key);
+    }
+    if (keys.empty()) {
+        return;
+    }
+    // Readers must see the compressed posting lists before the btree posting lists are dropped.
+    _compressed_posting_lists.getAllocator().freeze();
+    for (Key key : keys) {
+        auto it = _dictionary.find(key);
+        datastore::EntryRef ref = it.getData();
+        std::atomic_thread_fence(std::memory_order_release);
+        it.writeData(datastore::EntryRef());
+        _btree_posting_lists.clear(ref);
+    }
+    commit();
+    if (simpleindex::log_enabled()) {
+        auto msg = vespalib::make_string("Compressed %zu frozen posting lists", keys.size());
+        simpleindex::log_debug(msg);
+    }
+}
+
 template <typename Posting, typename Key, typename DocId>
 void SimpleIndex<Posting, Key, DocId>::logVector(
         const char *action, Key key, size_t document_count, double ratio, size_t vector_length) const {
@@ -283,6 +371,7 @@ void SimpleIndex<Posting, Key, DocId>::commit() {
     _dictionary.getAllocator().freeze();
     _btree_posting_lists.freeze();
     _vector_posting_lists.getAllocator().freeze();
+    _compressed_posting_lists.getAllocator().freeze();
 }
 
 template <typename Posting, typename Key, typename DocId>
@@ -290,6 +379,7 @@ void SimpleIndex<Posting, Key, DocId>::trimHoldLists(generation_t used_generatio
     _btree_posting_lists.trimHoldLists(used_generation);
     _dictionary.getAllocator().trimHoldLists(used_generation);
     _vector_posting_lists.getAllocator().trimHoldLists(used_generation);
+    _compressed_posting_lists.getAllocator().trimHoldLists(used_generation);
 
 }
 
@@ -298,6 +388,7 @@ void SimpleIndex<Posting, Key, DocId>::transferHoldLists(generation_t generation
     _dictionary.getAllocator().transferHoldLists(generation);
     _btree_posting_lists.transferHoldLists(generation);
     _vector_posting_lists.getAllocator().transferHoldLists(generation);
+    _compressed_posting_lists.getAllocator().transferHoldLists(generation);
 }
 
 template <typename Posting, typename Key, typename DocId>
@@ -309,6 +400,10 @@ vespalib::MemoryUsage SimpleIndex<Posting, Key, DocId>::getMemoryUsage() const {
     for (auto it = _vector_posting_lists.begin(); it.valid(); ++it) {
         combined.merge(it.getData()->getMemoryUsage());
     }
+    combined.merge(_compressed_posting_lists.getMemoryUsage());
+    for (auto it = _compressed_posting_lists.begin(); it.valid(); ++it) {
+        combined.merge(it.getData()->getMemoryUsage());
+    }
     return combined;
 };
 
@@ -0,0 +1,220 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "term_summary.h"
+#include <vespa/document/fieldvalue/arrayfieldvalue.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/fieldvaluevisitor.h>
+#include <vespa/document/fieldvalue/mapfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/fieldvalue/structfieldvalue.h>
+#include <vespa/document/fieldvalue/weightedsetfieldvalue.h>
+#include <vespa/vespalib/text/utf8.h>
+#include <xxhash.h>
+#include <algorithm>
+
+namespace search::streaming {
+
+namespace {
+
+/**
+ * Splits the utf8 text into folded words the same way as
+ * UTF8StringFieldSearcherBase::tokenize does it, calling onWord for each word.
+ * Zero bytes separate words, and the text must be zero terminated.
+ */
+template <typename OnWord>
+void
+tokenize(const vespalib::string &text, std::vector<ucs4_t> &token, OnWord onWord)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(text.c_str());
+    const unsigned char *end = p + text.size();
+    token.clear();
+    while (p < end) {
+        ucs4_t c = *p;
+        bool wordChar;
+        if (c < 128) {
+            p++;
+            wordChar = Fast_NormalizeWordFolder::_isWord[c];
+            if (wordChar) {
+                token.push_back(Fast_NormalizeWordFolder::_foldCase[c]);
+            }
+        } else {
+            c = Fast_UnicodeUtil::GetUTF8CharNonAscii(p);
+            wordChar = Fast_UnicodeUtil::IsWordChar(c);
+            if (wordChar) {
+                const char *repl = Fast_NormalizeWordFolder::ReplacementString(c);
+                if (repl != nullptr) {
+                    for (; *repl != '\0'; ++repl) {
+                        token.push_back(static_cast<unsigned char>(*repl));
+                    }
+                } else {
+                    token.push_back(Fast_NormalizeWordFolder::ToFold(c));
+                }
+            }
+        }
+        if (!wordChar && !token.empty()) {
+            onWord(token);
+            token.clear();
+        }
+    }
+    if (!token.empty()) {
+        onWord(token);
+        token.clear();
+    }
+}
+
+const Fast_NormalizeWordFolder &
+ensureFolderInitialized()
+{
+    static Fast_NormalizeWordFolder folder;
+    return folder;
+}
+
+class StringCollector : public document::ConstFieldValueVisitor
+{
+private:
+    TermSummaryBuilder &_builder;
+
+    void visit(const document::AnnotationReferenceFieldValue &) override { }
+    void visit(const document::ArrayFieldValue &value) override {
+        for (const auto &elem : value) {
+            elem.accept(*this);
+        }
+    }
+    void visit(const document::BoolFieldValue &) override { }
+    void visit(const document::ByteFieldValue &) override { }
+    void visit(const document::Document &value) override { value.getFields().accept(*this); }
+    void visit(const document::DoubleFieldValue &) override { }
+    void visit(const document::FloatFieldValue &) override { }
+    void visit(const document::IntFieldValue &) override { }
+    void visit(const document::LongFieldValue &) override { }
+    void visit(const document::MapFieldValue &value) override {
+        for (const auto &entry : value) {
+            entry.first->accept(*this);
+            entry.second->accept(*this);
+        }
+    }
+    void visit(const document::PredicateFieldValue &) override { }
+    void visit(const document::RawFieldValue &) override { }
+    void visit(const document::ShortFieldValue &) override { }
+    void visit(const document::StringFieldValue &value) override { _builder.addText(value.getValue()); }
+    void visit(const document::StructFieldValue &value) override {
+        for (auto itr = value.begin(); itr != value.end(); ++itr) {
+            document::FieldValue::UP fieldValue = value.getValue(itr.field());
+            if (fieldValue) {
+                fieldValue->accept(*this);
+            }
+        }
+    }
+    void visit(const document::WeightedSetFieldValue &value) override {
+        for (const auto &entry : value) {
+            entry.first->accept(*this);
+        }
+    }
+    void visit(const document::TensorFieldValue &) override { }
+    void visit(const document::ReferenceFieldValue &) override { }
+public:
+    StringCollector(TermSummaryBuilder &builder) : _builder(builder) { }
+};
+
+}
+
+uint64_t
+TermSummary::hashWord(const ucs4_t *word, size_t len)
+{
+    return XXH64(word, len * sizeof(ucs4_t), 0);
+}
+
+bool
+TermSummary::hashTerm(const vespalib::string &term, uint64_t &hash)
+{
+    ensureFolderInitialized();
+    std::vector<ucs4_t> original;
+    vespalib::Utf8Reader reader(term);
+    while (reader.hasMore()) {
+        original.push_back(reader.getChar());
+    }
+    std::vector<ucs4_t> token;
+    size_t numWords = 0;
+    bool unchanged = false;
+    tokenize(term, token, [&](const std::vector<ucs4_t> &word) {
+        ++numWords;
+        unchanged = (word == original);
+    });
+    if (numWords != 1 || !unchanged) {
+        return false;
+    }
+    hash = hashWord(original.data(), original.size());
+    return true;
+}
+
+bool
+TermSummary::mayContain(const uint64_t *bits, size_t numWords, uint64_t hash)
+{
+    uint64_t numBits = numWords * 64;
+    uint64_t h2 = (hash >> 32) | 1;
+    for (uint32_t i = 0; i < NUM_HASHES; ++i) {
+        uint64_t bit = (hash + i * h2) % numBits;
+        if ((bits[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+TermSummary::mayContainAll(const uint64_t *bits, size_t numWords, const std::vector<uint64_t> &hashes)
+{
+    for (uint64_t hash : hashes) {
+        if (!mayContain(bits, numWords, hash)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TermSummaryBuilder::TermSummaryBuilder(uint32_t bitsPerWord)
+    : _folder(),
+      _bitsPerWord(bitsPerWord),
+      _hashes(),
+      _token()
+{
+}
+
+TermSummaryBuilder::~TermSummaryBuilder() = default;
+
+void
+TermSummaryBuilder::addText(const vespalib::string &text)
+{
+    tokenize(text, _token, [this](const std::vector<ucs4_t> &word) {
+        _hashes.push_back(TermSummary::hashWord(word.data(), word.size()));
+    });
+}
+
+void
+TermSummaryBuilder::addDocument(const document::Document &doc)
+{
+    StringCollector collector(*this);
+    doc.accept(collector);
+    addText(doc.getId().toString());
+}
+
+TermSummary::Bits
+TermSummaryBuilder::build()
+{
+    std::sort(_hashes.begin(), _hashes.end());
+    _hashes.erase(std::unique(_hashes.begin(), _hashes.end()), _hashes.end());
+    size_t numBits = std::max(_hashes.size(), size_t(1)) * _bitsPerWord;
+    TermSummary::Bits bits(std::max((numBits + 63) / 64, size_t(1)), 0);
+    uint64_t totalBits = bits.size() * 64;
+    for (uint64_t hash : _hashes) {
+        uint64_t h2 = (hash >> 32) | 1;
+        for (uint32_t i = 0; i < TermSummary::NUM_HASHES; ++i) {
+            uint64_t bit = (hash + i * h2) % totalBits;
+            bits[bit >> 6] |= (uint64_t(1) << (bit & 63));
+        }
+    }
+    _hashes.clear();
+    return bits;
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/fastlib/text/normwordfolder.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace document { class Document; }
+
+namespace search::streaming {
+
+/**
+ * Compact bloom filter over the words of a document, used by streaming
+ * search to skip documents that cannot contain a required query term
+ * without fetching and deserializing them.
+ *
+ * Words are tokenized and folded the same way as the utf8 string field
+ * searchers in vsm do it, so a word term that matches a document as a
+ * regular (not prefix, substring, suffix or exact) term is always found
+ * in the summary built from that document. Lookups may give false
+ * positives, but never false negatives.
+ */
+class TermSummary
+{
+public:
+    using Bits = std::vector<uint64_t>;
+    static constexpr uint32_t NUM_HASHES = 3;
+
+    /**
+     * Returns the hash of the given folded word.
+     */
+    static uint64_t hashWord(const ucs4_t *word, size_t len);
+
+    /**
+     * Computes the hash of a query term if the term is a single word as
+     * seen by the tokenizer, i.e. it is not split into several words and
+     * is not changed by folding. Returns false otherwise, and the term
+     * must then not be used for filtering.
+     */
+    static bool hashTerm(const vespalib::string &term, uint64_t &hash);
+
+    static bool mayContain(const uint64_t *bits, size_t numWords, uint64_t hash);
+    static bool mayContainAll(const uint64_t *bits, size_t numWords, const std::vector<uint64_t> &hashes);
+};
+
+/**
+ * Builds the term summary of a document by visiting all string values,
+ * including those nested in structs, arrays, weighted sets and maps.
+ */
+class TermSummaryBuilder
+{
+private:
+    Fast_NormalizeWordFolder _folder;
+    uint32_t                 _bitsPerWord;
+    std::vector<uint64_t>    _hashes;
+    std::vector<ucs4_t>      _token;
+
+public:
+    TermSummaryBuilder(uint32_t bitsPerWord);
+    ~TermSummaryBuilder();
+    void addText(const vespalib::string &text);
+    void addDocument(const document::Document &doc);
+    /**
+     * Returns the summary of all text added since the last call,
+     * and resets the builder.
+     */
+    TermSummary::Bits build();
+};
+
+}
@@ -174,6 +174,14 @@ HitCollector::getSortedHitSequence(size_t max_hits)
     return SortedHitSequence(&_hits[0], &_scoreOrder[0], num_hits);
 }
 
+void
+HitCollector::DocumentScorer::scoreBatch(vespalib::ArrayRef<Hit> hits)
+{
+    for (auto &hit : hits) {
+        hit.second = score(hit.first);
+    }
+}
+
 size_t
 HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
     if (hits.empty()) { return 0; }
@@ -186,8 +194,8 @@ HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
                          -std::numeric_limits<feature_t>::max());
 
     std::sort(hits.begin(), hits.end()); // sort on docId
-    for (auto &hit : hits) {
-        hit.second = scorer.score(hit.first);
+    scorer.scoreBatch(hits);
+    for (const auto &hit : hits) {
         finalScores.low = std::min(finalScores.low, hit.second);
         finalScores.high = std::max(finalScores.high, hit.second);
     }
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <vector>
 #include <vespa/vespalib/util/sort.h>
+#include <vespa/vespalib/util/arrayref.h>
 #include <vespa/fastos/dynamiclibrary.h>
 #include "sorted_hit_sequence.h"
 
@@ -26,6 +27,13 @@ public:
     struct DocumentScorer {
         virtual ~DocumentScorer() {}
         virtual feature_t score(uint32_t docId) = 0;
+        /**
+         * Score all the given hits (sorted on doc id) by replacing
+         * their current score. The default implementation calls
+         * score() for each hit; override to score multiple
+         * documents in one go.
+         **/
+        virtual void scoreBatch(vespalib::ArrayRef<Hit> hits);
     };
 
 private:
@@ -40,7 +40,7 @@ void pushValueDictionaryEntry(const Entry &entry,
     uint64_t feature = PredicateHash::hash64(hash_str);
     auto iterator = interval_index.lookup(feature);
     if (iterator.valid()) {
-        size_t sz = interval_index.getPostingListSize(iterator.getData());
+        size_t sz = interval_index.getPostingListSize(iterator);
         LOG(debug, "postinglist(%s) = (%d).size = %ld", hash_str.c_str(), iterator.getData().ref(), sz);
         interval_entries.push_back({iterator.getData(), entry.getSubQueryBitmap(), sz, feature});
     }
@@ -57,7 +57,7 @@ struct MyRangeHandler {
         uint64_t feature = PredicateHash::hash64(label);
         auto iterator = interval_index.lookup(feature);
         if (iterator.valid()) {
-            size_t sz = interval_index.getPostingListSize(iterator.getData());
+            size_t sz = interval_index.getPostingListSize(iterator);
             interval_entries.push_back({iterator.getData(), subquery_bitmap, sz, feature});
         }
     }
@@ -65,7 +65,7 @@ struct MyRangeHandler {
         uint64_t feature = PredicateHash::hash64(label);
         auto iterator = bounds_index.lookup(feature);
         if (iterator.valid()) {
-            size_t sz = bounds_index.getPostingListSize(iterator.getData());
+            size_t sz = bounds_index.getPostingListSize(iterator);
             bounds_entries.push_back({iterator.getData(), value, subquery_bitmap, sz, feature});
         }
     }
@@ -88,7 +88,7 @@ void pushZStarPostingList(const SimpleIndex<datastore::EntryRef> &interval_index
     uint64_t feature = Constants::z_star_hash;
     auto iterator = interval_index.lookup(feature);
     if (iterator.valid()) {
-        size_t sz = interval_index.getPostingListSize(iterator.getData());
+        size_t sz = interval_index.getPostingListSize(iterator);
         interval_entries.push_back({iterator.getData(), UINT64_MAX, sz, feature});
     }
 }
@@ -160,10 +160,13 @@ PredicateBlueprint::PredicateBlueprint(const FieldSpecBase &field,
       _zstar_dict_entry(),
       _interval_btree_iterators(),
       _interval_vector_iterators(),
+      _interval_compressed_iterators(),
       _bounds_btree_iterators(),
       _bounds_vector_iterators(),
+      _bounds_compressed_iterators(),
       _zstar_btree_iterator(),
-      _zstar_vector_iterator()
+      _zstar_vector_iterator(),
+      _zstar_compressed_iterator()
 {
     const auto &interval_index = _index.getIntervalIndex();
     const auto zero_constraints_docs = _index.getZeroConstraintDocs();
@@ -202,7 +205,7 @@ PredicateBlueprint::PredicateBlueprint(const FieldSpecBase &field,
 
     if (zero_constraints_docs.size() == 0 &&
         _interval_dict_entries.empty() && _bounds_dict_entries.empty() &&
-        !_zstar_dict_entry.valid()) {
+        !_zstar_dict_entry) {
         setEstimate(HitEstimate(0, true));
     } else {
         setEstimate(HitEstimate(static_cast<uint32_t>(zero_constraints_docs.size()), false));
@@ -213,9 +216,26 @@ PredicateBlueprint::~PredicateBlueprint() {}
 
 namespace {
 
-    template<typename DictEntry, typename VectorIteratorEntry, typename BTreeIteratorEntry>
+    // The dictionary holds an invalid ref for compressed posting lists. If the
+    // compressed posting list has been converted back to a btree posting list
+    // after the dictionary lookup, the current ref is looked up again.
+    datastore::EntryRef
+    resolveBTreeRef(const SimpleIndex<datastore::EntryRef> &index, datastore::EntryRef ref, uint64_t feature)
+    {
+        if (!ref.valid()) {
+            auto it = index.lookup(feature);
+            if (it.valid()) {
+                ref = it.getData();
+            }
+        }
+        return ref;
+    }
+
+    template<typename DictEntry, typename VectorIteratorEntry,
+             typename CompressedIteratorEntry, typename BTreeIteratorEntry>
     void lookupPostingLists(const std::vector<DictEntry> &dict_entries,
                             std::vector<VectorIteratorEntry> &vector_iterators,
+                            std::vector<CompressedIteratorEntry> &compressed_iterators,
                             std::vector<BTreeIteratorEntry> &btree_iterators,
                             const SimpleIndex<datastore::EntryRef> &index)
     {
@@ -223,10 +243,17 @@ namespace {
             auto vector_iterator = index.getVectorPostingList(entry.feature);
             if (vector_iterator) {
                 vector_iterators.push_back(VectorIteratorEntry{*vector_iterator, entry});
-            } else {
-                auto btree_iterator = index.getBTreePostingList(entry.entry_ref);
-                btree_iterators.push_back(BTreeIteratorEntry{btree_iterator, entry});
+                continue;
+            }
+            if (!entry.entry_ref.valid()) {
+                auto compressed_iterator = index.getCompressedPostingList(entry.feature);
+                if (compressed_iterator) {
+                    compressed_iterators.push_back(CompressedIteratorEntry{*compressed_iterator, entry});
+                    continue;
+                }
             }
+            auto btree_iterator = index.getBTreePostingList(resolveBTreeRef(index, entry.entry_ref, entry.feature));
+            btree_iterators.push_back(BTreeIteratorEntry{btree_iterator, entry});
         }
 
     };
@@ -237,17 +264,23 @@ void PredicateBlueprint::fetchPostings(const ExecuteInfo &) {
     const auto &interval_index = _index.getIntervalIndex();
     const auto &bounds_index = _index.getBoundsIndex();
     lookupPostingLists(_interval_dict_entries, _interval_vector_iterators,
-                       _interval_btree_iterators, interval_index);
+                       _interval_compressed_iterators, _interval_btree_iterators, interval_index);
     lookupPostingLists(_bounds_dict_entries, _bounds_vector_iterators,
-                       _bounds_btree_iterators, bounds_index);
+                       _bounds_compressed_iterators, _bounds_btree_iterators, bounds_index);
 
     // Lookup zstar interval iterator
-    if (_zstar_dict_entry.valid()) {
+    if (_zstar_dict_entry) {
         auto vector_iterator = interval_index.getVectorPostingList(Constants::z_star_compressed_hash);
+        auto compressed_iterator = _zstar_dict_entry->valid()
+                                   ? optional<CompressedIterator>()
+                                   : interval_index.getCompressedPostingList(Constants::z_star_compressed_hash);
         if (vector_iterator) {
             _zstar_vector_iterator.emplace(std::move(*vector_iterator));
+        } else if (compressed_iterator) {
+            _zstar_compressed_iterator.emplace(std::move(*compressed_iterator));
         } else {
-            _zstar_btree_iterator.emplace(interval_index.getBTreePostingList(_zstar_dict_entry));
+            _zstar_btree_iterator.emplace(interval_index.getBTreePostingList(
+                    resolveBTreeRef(interval_index, *_zstar_dict_entry, Constants::z_star_compressed_hash)));
         }
     }
 
@@ -296,7 +329,8 @@ namespace {
 
 std::vector<PredicatePostingList::UP> PredicateBlueprint::createPostingLists() const {
     size_t total_size = _interval_btree_iterators.size() + _interval_vector_iterators.size() +
-                        _bounds_btree_iterators.size() + _bounds_vector_iterators.size() + 2;
+                        _interval_compressed_iterators.size() + _bounds_btree_iterators.size() +
+                        _bounds_vector_iterators.size() + _bounds_compressed_iterators.size() + 2;
     std::vector<PredicatePostingList::UP> posting_lists;
     posting_lists.reserve(total_size);
     const auto &interval_store = _index.getIntervalStore();
@@ -307,6 +341,12 @@ std::vector<PredicatePostingList::UP> PredicateBlueprint::createPostingLists() c
                 return new PredicateIntervalPostingList<VectorIterator>(interval_store, entry.iterator);
             });
 
+    createPredicatePostingLists(
+            _interval_compressed_iterators, posting_lists,
+            [&] (const IntervalIteratorEntry<CompressedIterator> &entry) {
+                return new PredicateIntervalPostingList<CompressedIterator>(interval_store, entry.iterator);
+            });
+
     createPredicatePostingLists(
             _interval_btree_iterators, posting_lists,
             [&] (const IntervalIteratorEntry<BTreeIterator> &entry) {
@@ -320,6 +360,13 @@ std::vector<PredicatePostingList::UP> PredicateBlueprint::createPostingLists() c
                                                                       entry.entry.value_diff);
             });
 
+    createPredicatePostingLists(
+            _bounds_compressed_iterators, posting_lists,
+            [&] (const BoundsIteratorEntry<CompressedIterator> &entry) {
+                return new PredicateBoundsPostingList<CompressedIterator>(interval_store, entry.iterator,
+                                                                          entry.entry.value_diff);
+            });
+
     createPredicatePostingLists(
             _bounds_btree_iterators, posting_lists,
             [&] (const BoundsIteratorEntry<BTreeIterator> &entry) {
@@ -331,6 +378,10 @@ std::vector<PredicatePostingList::UP> PredicateBlueprint::createPostingLists() c
         auto posting_list = PredicatePostingList::UP(
                 new PredicateZstarCompressedPostingList<VectorIterator>(interval_store, *_zstar_vector_iterator));
         posting_lists.emplace_back(std::move(posting_list));
+    } else if (_zstar_compressed_iterator && _zstar_compressed_iterator->valid()) {
+        auto posting_list = PredicatePostingList::UP(
+                new PredicateZstarCompressedPostingList<CompressedIterator>(interval_store, *_zstar_compressed_iterator));
+        posting_lists.emplace_back(std::move(posting_list));
     } else if (_zstar_btree_iterator && _zstar_btree_iterator->valid()) {
         auto posting_list = PredicatePostingList::UP(
                 new PredicateZstarCompressedPostingList<BTreeIterator>(interval_store, *_zstar_btree_iterator));
@@ -55,6 +55,7 @@ public:
 private:
     using BTreeIterator = predicate::SimpleIndex<datastore::EntryRef>::BTreeIterator;
     using VectorIterator = predicate::SimpleIndex<datastore::EntryRef>::VectorIterator;
+    using CompressedIterator = predicate::SimpleIndex<datastore::EntryRef>::CompressedIterator;
     template <typename T>
     using optional = std::optional<T>;
     using Alloc = vespalib::alloc::Alloc;
@@ -78,15 +79,18 @@ private:
 
     std::vector<IntervalEntry> _interval_dict_entries;
     std::vector<BoundsEntry> _bounds_dict_entries;
-    datastore::EntryRef _zstar_dict_entry;
+    optional<datastore::EntryRef> _zstar_dict_entry;
 
     std::vector<IntervalIteratorEntry<BTreeIterator>> _interval_btree_iterators;
     std::vector<IntervalIteratorEntry<VectorIterator>> _interval_vector_iterators;
+    std::vector<IntervalIteratorEntry<CompressedIterator>> _interval_compressed_iterators;
     std::vector<BoundsIteratorEntry<BTreeIterator>> _bounds_btree_iterators;
     std::vector<BoundsIteratorEntry<VectorIterator>> _bounds_vector_iterators;
-    // The zstar iterator is either a vector or a btree iterator.
+    std::vector<BoundsIteratorEntry<CompressedIterator>> _bounds_compressed_iterators;
+    // The zstar iterator is either a vector, a compressed or a btree iterator.
     optional<BTreeIterator> _zstar_btree_iterator;
     optional<VectorIterator> _zstar_vector_iterator;
+    optional<CompressedIterator> _zstar_compressed_iterator;
 };
 
 }
@@ -102,7 +102,7 @@ DenseTensorAttribute::getTensor(DocId docId, MutableDenseTensorView &tensor) con
 }
 
 bool
-DenseTensorAttribute::onLoad()
+DenseTensorAttribute::onLoad(vespalib::Executor *)
 {
     TensorReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -26,6 +26,8 @@ size_t size_of(CellType type) {
     switch (type) {
     case CellType::DOUBLE: return sizeof(double);
     case CellType::FLOAT: return sizeof(float);
+    case CellType::BFLOAT16: return sizeof(vespalib::BFloat16);
+    case CellType::INT8: return sizeof(vespalib::Int8Float);
     }
     abort();
 }
@@ -3,19 +3,17 @@
 #include "tensor_attribute.h"
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/tensor_data_type.h>
-#include <vespa/eval/eval/simple_tensor.h>
 #include <vespa/eval/tensor/dense/typed_dense_tensor_builder.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor_builder.h>
 #include <vespa/eval/tensor/sparse/sparse_tensor.h>
-#include <vespa/eval/tensor/wrapped_simple_tensor.h>
 #include <vespa/vespalib/util/rcuvector.hpp>
 
-using vespalib::eval::SimpleTensor;
 using vespalib::eval::ValueType;
 using vespalib::tensor::Tensor;
+using vespalib::tensor::MixedTensorBuilder;
 using vespalib::tensor::TypedDenseTensorBuilder;
 using vespalib::tensor::dispatch_0;
 using vespalib::tensor::SparseTensor;
-using vespalib::tensor::WrappedSimpleTensor;
 using document::TensorDataType;
 using document::WrongTensorTypeException;
 
@@ -46,7 +44,7 @@ createEmptyTensor(const ValueType &type)
     } else if (type.is_dense()) {
         return dispatch_0<CallMakeEmptyTensor>(type.cell_type(), type);
     } else {
-        return std::make_unique<WrappedSimpleTensor>(std::make_unique<SimpleTensor>(type, SimpleTensor::Cells()));
+        return MixedTensorBuilder(type).build();
     }
 }
 
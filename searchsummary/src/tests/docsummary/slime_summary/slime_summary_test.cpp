@@ -29,10 +29,18 @@ struct FieldBlock {
     size_t dataLen() const { return binary.GetUsedLen(); }
 };
 
+struct DocidDFW : ISimpleDFW {
+    bool IsGenerated() const override { return true; }
+    void insertField(uint32_t docid, GetDocsumsState *, ResType, Inserter &target) override {
+        target.insertLong(docid);
+    }
+};
+
 struct DocsumFixture : IDocsumStore, GetDocsumsStateCallback {
     std::unique_ptr<DynamicDocsumWriter> writer;
     std::unique_ptr<ResultPacker> packer;
     GetDocsumsState state;
+    size_t store_reads;
     DocsumFixture();
     ~DocsumFixture();
     void getDocsum(Slime &slime) {
@@ -46,8 +54,15 @@ struct DocsumFixture : IDocsumStore, GetDocsumsStateCallback {
         EXPECT_GREATER(vespalib::slime::BinaryFormat
                        ::decode(Memory(buf.GetDrainPos(), buf.GetUsedLen()), slime), 0u);
     }
+    void getGeneratedDocsum(uint32_t docid, Slime &slime) {
+        auto rci = writer->resolveClassInfo("generated", getSummaryClassId());
+        EXPECT_TRUE(rci.allGenerated);
+        SlimeInserter inserter(slime);
+        writer->insertDocsum(rci, docid, &state, this, slime, inserter);
+    }
     uint32_t getNumDocs() const override { return 2; }
     DocsumStoreValue getMappedDocsum(uint32_t docid) override {
+        ++store_reads;
         EXPECT_EQUAL(1u, docid);
         EXPECT_TRUE(packer->Init(0));
         EXPECT_TRUE(packer->AddInteger(4));
@@ -83,7 +98,7 @@ struct DocsumFixture : IDocsumStore, GetDocsumsStateCallback {
 
 
 DocsumFixture::DocsumFixture()
-    : writer(), packer(), state(*this)
+    : writer(), packer(), state(*this), store_reads(0)
 {
     ResultConfig *config = new ResultConfig();
     ResultClass *cfg = config->AddResultClass("default", 0);
@@ -101,8 +116,12 @@ DocsumFixture::DocsumFixture()
     EXPECT_TRUE(cfg->AddConfigEntry("xmlstring_field", RES_XMLSTRING));
     EXPECT_TRUE(cfg->AddConfigEntry("jsonstring_field", RES_JSONSTRING));
     EXPECT_TRUE(cfg->AddConfigEntry("bad_jsonstring_field", RES_JSONSTRING));
+    ResultClass *gen_cfg = config->AddResultClass("generated", 1);
+    EXPECT_TRUE(gen_cfg != 0);
+    EXPECT_TRUE(gen_cfg->AddConfigEntry("docid_field", RES_INT));
     config->CreateEnumMaps();
     writer.reset(new DynamicDocsumWriter(config, 0));
+    EXPECT_TRUE(writer->Override("docid_field", new DocidDFW()));
     packer.reset(new ResultPacker(writer->GetResultConfig()));
 }
 DocsumFixture::~DocsumFixture() {}
@@ -125,6 +144,13 @@ TEST_FF("require that docsum can be written as slime", DocsumFixture(), Slime())
     EXPECT_EQUAL(f2.get()["jsonstring_field"]["foo"].asLong(), 1u);
     EXPECT_EQUAL(f2.get()["jsonstring_field"]["bar"].asLong(), 2u);
     EXPECT_EQUAL(f2.get()["bad_jsonstring_field"].type().getId(), 0u);
+    EXPECT_EQUAL(f1.store_reads, 1u);
+}
+
+TEST_FF("require that docsum with only generated fields does not use the docsum store", DocsumFixture(), Slime()) {
+    f1.getGeneratedDocsum(7, f2);
+    EXPECT_EQUAL(f2.get()["docid_field"].asLong(), 7);
+    EXPECT_EQUAL(f1.store_reads, 0u);
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
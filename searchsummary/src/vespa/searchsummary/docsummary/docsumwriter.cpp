@@ -297,6 +297,18 @@ DynamicDocsumWriter::Override(const char *fieldName, IDocsumFieldWriter *writer)
 }
 
 
+bool
+DynamicDocsumWriter::isGenerated(const vespalib::string &fieldName) const
+{
+    uint32_t fieldEnumValue = _resultConfig->GetFieldNameEnum().Lookup(fieldName.c_str());
+    if (fieldEnumValue >= _numEnumValues) {
+        return false;
+    }
+    const IDocsumFieldWriter *writer = _overrideTable[fieldEnumValue];
+    return (writer != nullptr) && writer->IsGenerated();
+}
+
+
 void
 DynamicDocsumWriter::InitState(IAttributeManager & attrMan, GetDocsumsState *state)
 {
@@ -23,6 +23,8 @@ class IDocsumWriter
 public:
     struct ResolveClassInfo {
         bool mustSkip;
+        // all fields are generated by docsum field writers (e.g. from
+        // attributes); the docsum store is not used for this class
         bool allGenerated;
         uint32_t outputClassId;
         const ResultClass *outputClass;
@@ -74,6 +76,11 @@ public:
 
     bool SetDefaultOutputClass(uint32_t classID);
     bool Override(const char *fieldName, IDocsumFieldWriter *writer);
+    /**
+     * Returns true if the given field is overridden by a writer that
+     * generates its value without using the document summary store.
+     **/
+    bool isGenerated(const vespalib::string &fieldName) const;
     void InitState(IAttributeManager & attrMan, GetDocsumsState *state) override;
     uint32_t WriteDocsum(uint32_t docid, GetDocsumsState *state,
                          IDocsumStore *docinfos, search::RawBuf *target) override;
@@ -48,6 +48,56 @@ TEST("testCache") {
     EXPECT_TRUE(cache.size() == 1);
 }
 
+TEST("testReadIfCachedDoesNotUseBackingStore") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    m[1] = "String inserted beneath";
+    string value;
+    EXPECT_FALSE(cache.readIfCached(1, value));
+    EXPECT_FALSE(cache.hasKey(1));
+    EXPECT_EQUAL(1u, cache.getMiss());
+    EXPECT_EQUAL("String inserted beneath", cache.read(1));
+    EXPECT_TRUE(cache.readIfCached(1, value));
+    EXPECT_EQUAL("String inserted beneath", value);
+    EXPECT_EQUAL(1u, cache.getHit());
+}
+
+TEST("testPopulateDoesNotWriteToBackingStore") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    cache.populate(1, "First populated string", cache.getGeneration(1));
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_TRUE(m.find(1) == m.end());
+    EXPECT_EQUAL("First populated string", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getInsert());
+    cache.populate(1, "Second populated string", cache.getGeneration(1));
+    EXPECT_EQUAL("First populated string", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getInsert());
+    EXPECT_EQUAL(1u, cache.size());
+}
+
+TEST("testPopulateIsRejectedAfterWriteOrInvalidate") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    size_t generation = cache.getGeneration(1);
+    cache.invalidate(1);
+    cache.populate(1, "Stale string", generation);
+    EXPECT_FALSE(cache.hasKey(1));
+
+    generation = cache.getGeneration(1);
+    cache.write(1, "Written string");
+    cache.invalidate(1);
+    cache.populate(1, "Stale string", generation);
+    EXPECT_FALSE(cache.hasKey(1));
+    EXPECT_EQUAL(0u, cache.getInsert());
+    EXPECT_EQUAL(2u, cache.getRace());
+
+    cache.populate(1, "Written string", cache.getGeneration(1));
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_EQUAL("Written string", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getInsert());
+}
+
 TEST("testCacheSize")
 {
     B m;
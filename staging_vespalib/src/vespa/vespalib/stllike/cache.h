@@ -97,6 +97,26 @@ public:
      */
     V read(const K & key);
 
+    /**
+     * Look up the object with the given key without consulting the backing store on a miss.
+     * Returns true and sets value if found. Object is then put at head of LRU list.
+     */
+    bool readIfCached(const K & key, V & value);
+
+    /**
+     * Returns the invalidation generation for the given key. Take it before reading
+     * the object from the backing store by other means, and hand it to populate().
+     */
+    size_t getGeneration(const K & key) const;
+
+    /**
+     * Insert an object that has been read from the backing store by other means.
+     * It is not written to the backing store, and an object already in the cache is kept.
+     * The object is dropped if the key has been written or invalidated since the
+     * given generation was taken, as it may then be stale.
+     */
+    void populate(const K & key, V value, size_t generation);
+
     /**
      * Update the cache and write through to backing store.
      * Object is then put at head of LRU list.
@@ -133,9 +153,12 @@ private:
      */
     bool removeOldest(const value_type & v) override;
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
-    vespalib::Lock & getLock(const K & k) {
+    size_t getStripe(const K & k) const {
         size_t h(_hasher(k));
-        return _addLocks[h%(sizeof(_addLocks)/sizeof(_addLocks[0]))];
+        return h%(sizeof(_addLocks)/sizeof(_addLocks[0]));
+    }
+    vespalib::Lock & getLock(const K & k) {
+        return _addLocks[getStripe(k)];
     }
     Hash                _hasher;
     SizeK               _sizeK;
@@ -156,6 +179,8 @@ private:
     vespalib::Lock      _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
     vespalib::Lock      _addLocks[113];
+    /// Bumped under _hashLock each time a key in the stripe is written or invalidated.
+    size_t              _generations[113];
 };
 
 }
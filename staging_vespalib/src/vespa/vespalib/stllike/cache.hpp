@@ -65,7 +65,8 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _erase(0),
     _invalidate(0),
     _lookup(0),
-    _store(b)
+    _store(b),
+    _generations()
 { }
 
 template< typename P >
@@ -99,6 +100,7 @@ cache<P>::read(const K & key)
     }
 
     vespalib::LockGuard storeGuard(getLock(key));
+    size_t generation;
     {
         vespalib::LockGuard guard(_hashLock);
         if (Lru::hasKey(key)) {
@@ -106,19 +108,63 @@ cache<P>::read(const K & key)
             _race++;
             return (*this)[key];
         }
+        generation = _generations[getStripe(key)];
     }
     V value;
     if (_store.read(key, value)) {
         vespalib::LockGuard guard(_hashLock);
-        Lru::insert(key, value);
-        _sizeBytes += calcSize(key, value);
-        _insert++;
+        if (_generations[getStripe(key)] == generation) {
+            Lru::insert(key, value);
+            _sizeBytes += calcSize(key, value);
+            _insert++;
+        } else {
+            // Invalidated while reading, what was read may be stale.
+            _race++;
+        }
     } else {
         _noneExisting.fetch_add(1);
     }
     return value;
 }
 
+template< typename P >
+bool
+cache<P>::readIfCached(const K & key, V & value)
+{
+    vespalib::LockGuard guard(_hashLock);
+    if (Lru::hasKey(key)) {
+        _hit++;
+        value = V((*this)[key]);
+        return true;
+    }
+    _miss++;
+    return false;
+}
+
+template< typename P >
+size_t
+cache<P>::getGeneration(const K & key) const
+{
+    vespalib::LockGuard guard(_hashLock);
+    return _generations[getStripe(key)];
+}
+
+template< typename P >
+void
+cache<P>::populate(const K & key, V value, size_t generation)
+{
+    size_t newSize = calcSize(key, value);
+    vespalib::LockGuard storeGuard(getLock(key));
+    vespalib::LockGuard guard(_hashLock);
+    if (Lru::hasKey(key) || (_generations[getStripe(key)] != generation)) {
+        _race++;
+    } else {
+        Lru::insert(key, std::move(value));
+        _sizeBytes += newSize;
+        _insert++;
+    }
+}
+
 template< typename P >
 void
 cache<P>::write(const K & key, V value)
@@ -139,6 +185,7 @@ cache<P>::write(const K & key, V value)
         (*this)[key] = std::move(value);
         _sizeBytes += newSize;
         _write++;
+        _generations[getStripe(key)]++;
     }
 }
 
@@ -157,6 +204,7 @@ cache<P>::invalidate(const vespalib::LockGuard & guard, const K & key)
 {
     assert(guard.locks(_hashLock));
     (void) guard;
+    _generations[getStripe(key)]++;
     if (Lru::hasKey(key)) {
         _sizeBytes -= calcSize(key, (*this)[key]);
         _invalidate++;
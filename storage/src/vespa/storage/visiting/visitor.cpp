@@ -166,7 +166,8 @@ Visitor::VisitorOptions::VisitorOptions()
       _maxParallelOneBucket(2),
       _maxPending(1),
       _fieldSet("[all]"),
-      _visitRemoves(false)
+      _visitRemoves(false),
+      _requiredTermHashes()
 {
 }
 
@@ -1183,6 +1184,7 @@ Visitor::getIterators()
                 spi::Timestamp(_visitorOptions._fromTime.getTime()));
         selection.setToTimestamp(
                 spi::Timestamp(_visitorOptions._toTime.getTime()));
+        selection.setRequiredTermHashes(_visitorOptions._requiredTermHashes);
 
         std::shared_ptr<CreateIteratorCommand> cmd(
                 new CreateIteratorCommand(bucket,
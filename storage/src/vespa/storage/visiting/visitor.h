@@ -197,6 +197,9 @@ private:
 
         std::string _fieldSet;
         bool _visitRemoves;
+        // Hashes of words that visited documents must contain, passed on to
+        // the persistence provider as a hint (see spi::Selection).
+        std::vector<uint64_t> _requiredTermHashes;
 
         VisitorOptions();
     };
@@ -365,6 +368,7 @@ public:
 
     void setFieldSet(const std::string& fieldSet) { _visitorOptions._fieldSet = fieldSet; }
     void visitRemoves() { _visitorOptions._visitRemoves = true; }
+    void setRequiredTermHashes(const std::vector<uint64_t>& hashes) { _visitorOptions._requiredTermHashes = hashes; }
     void setDocBlockSize(uint32_t size) { _docBlockSize = size; }
     uint32_t getDocBlockSize() const { return _docBlockSize; }
     void setMemoryUsageLimit(uint32_t limit) noexcept {
@@ -2,7 +2,9 @@
 
 #include "servicelayerprocess.h"
 #include <vespa/storage/storageserver/servicelayernode.h>
+#include <vespa/storage/visiting/config-stor-visitor.h>
 #include <vespa/searchvisitor/searchvisitor.h>
+#include <vespa/config/helper/configgetter.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".storageserver.service_layer_process");
@@ -26,7 +28,9 @@ ServiceLayerProcess::shutdown()
 void
 ServiceLayerProcess::createNode()
 {
-    _externalVisitors["searchvisitor"].reset(new streaming::SearchVisitorFactory(_configUri));
+    using vespa::config::content::core::StorVisitorConfig;
+    auto visitorConfig = config::ConfigGetter<StorVisitorConfig>::getConfig(_configUri.getConfigId(), _configUri.getContext());
+    _externalVisitors["searchvisitor"].reset(new streaming::SearchVisitorFactory(_configUri, visitorConfig->searchvisitorMatchthreads));
     setupProvider();
     _node = std::make_unique<ServiceLayerNode>(_configUri, _context, *this, getProvider(), _externalVisitors);
     _node->init();
@@ -1,8 +1,17 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutorbase.h>
+#include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <vespa/searchlib/expression/constantnode.h>
 #include <vespa/searchlib/query/tree/querybuilder.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/query/tree/stackdumpcreator.h>
@@ -15,6 +24,8 @@
 LOG_SETUP("searchvisitor_test");
 
 using namespace document;
+using namespace search::aggregation;
+using namespace search::expression;
 using namespace search::query;
 using namespace search;
 using namespace storage;
@@ -29,8 +40,11 @@ private:
     std::unique_ptr<StorageComponent> _component;
     SearchEnvironment                 _env;
     void testSearchVisitor();
+    void testSearchVisitorWithMatchThreads();
     void testSearchEnvironment();
-    void testCreateSearchVisitor(const vespalib::string & dir, const vdslib::Parameters & parameters);
+    void testCreateSearchVisitor(const vespalib::string & dir, const vdslib::Parameters & parameters,
+                                 SearchEnvironment & env, size_t numDocuments);
+    std::unique_ptr<documentapi::QueryResultMessage> searchMatchingDocuments(SearchEnvironment & env, size_t numDocuments);
     void testOnlyRequireWeakReadConsistency();
 
 public:
@@ -54,29 +68,128 @@ SearchVisitorTest::SearchVisitorTest() :
 SearchVisitorTest::~SearchVisitorTest() = default;
 
 std::vector<spi::DocEntry::UP>
-createDocuments(const vespalib::string & dir)
+createDocuments(const vespalib::string & dir, size_t numDocuments)
 {
     (void) dir;
     std::vector<spi::DocEntry::UP> documents;
     spi::Timestamp ts;
-    document::Document::UP doc(new document::Document());
-    spi::DocEntry::UP e(new spi::DocEntry(ts, 0, std::move(doc)));
-    documents.push_back(std::move(e));
+    for (size_t i = 0; i < numDocuments; ++i) {
+        document::Document::UP doc(new document::Document());
+        spi::DocEntry::UP e(new spi::DocEntry(ts, 0, std::move(doc)));
+        documents.push_back(std::move(e));
+    }
     return documents;
 }
 
 void
-SearchVisitorTest::testCreateSearchVisitor(const vespalib::string & dir, const vdslib::Parameters & params)
+SearchVisitorTest::testCreateSearchVisitor(const vespalib::string & dir, const vdslib::Parameters & params,
+                                           SearchEnvironment & env, size_t numDocuments)
 {
     SearchVisitorFactory sFactory(dir);
     VisitorFactory & factory(sFactory);
-    std::unique_ptr<Visitor> sv(static_cast<SearchVisitor *>(factory.makeVisitor(*_component, _env, params)));
+    std::unique_ptr<Visitor> sv(static_cast<SearchVisitor *>(factory.makeVisitor(*_component, env, params)));
     document::BucketId bucketId;
-    std::vector<spi::DocEntry::UP> documents(createDocuments(dir));
+    std::vector<spi::DocEntry::UP> documents(createDocuments(dir, numDocuments));
     Visitor::HitCounter hitCounter;
     sv->handleDocuments(bucketId, documents, hitCounter);
 }
 
+bool
+isMatchingDocument(size_t docNo)
+{
+    return (docNo % 3) == 0;
+}
+
+size_t
+numMatchingDocuments(size_t numDocuments)
+{
+    return (numDocuments + 2) / 3;
+}
+
+std::vector<spi::DocEntry::UP>
+createMatchingDocuments(const DocumentTypeRepo & repo, size_t numDocuments)
+{
+    const DocumentType * type = repo.getDocumentType("maptest");
+    std::vector<spi::DocEntry::UP> documents;
+    spi::Timestamp ts;
+    for (size_t i = 0; i < numDocuments; ++i) {
+        auto doc = std::make_unique<document::Document>(*type, DocumentId(vespalib::make_string("id:test:maptest::%zu", i)));
+        doc->setValue("name", StringFieldValue(isMatchingDocument(i) ? "foo" : "bar"));
+        documents.push_back(std::make_unique<spi::DocEntry>(ts, 0, std::move(doc)));
+    }
+    return documents;
+}
+
+Grouping
+createCountGrouping(uint32_t id, bool all)
+{
+    Grouping grouping;
+    grouping.setId(id).setAll(all)
+        .setRoot(Group().addResult(CountAggregationResult().setExpression(std::make_unique<ConstantNode>(std::make_unique<Int64ResultNode>(0)))));
+    return grouping;
+}
+
+vdslib::Parameters
+createMatchParameters(size_t numDocuments)
+{
+    vdslib::Parameters params;
+    params.set("searchcluster", "aaa");
+    params.set("summarycount", vespalib::make_string("%zu", numDocuments));
+    params.set("rankprofile", "default");
+
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    builder.addStringTerm("foo", "name", 0, Weight(100));
+    Node::UP node = builder.build();
+    params.set("query", StackDumpCreator::create(*node));
+
+    vespalib::nbostream os;
+    vespalib::NBOSerializer nos(os);
+    nos << uint32_t(2);
+    createCountGrouping(1, false).serialize(nos);
+    createCountGrouping(2, true).serialize(nos);
+    params.set("aggregation", vespalib::stringref(os.data(), os.size()));
+    return params;
+}
+
+std::unique_ptr<documentapi::QueryResultMessage>
+SearchVisitorTest::searchMatchingDocuments(SearchEnvironment & env, size_t numDocuments)
+{
+    SearchVisitorFactory sFactory("dir:" + TEST_PATH("cfg"));
+    VisitorFactory & factory(sFactory);
+    std::unique_ptr<SearchVisitor> sv(static_cast<SearchVisitor *>(factory.makeVisitor(*_component, env, createMatchParameters(numDocuments))));
+    document::BucketId bucketId;
+    std::vector<spi::DocEntry::UP> documents(createMatchingDocuments(*_component->getTypeRepo(), numDocuments));
+    Visitor::HitCounter hitCounter;
+    static_cast<Visitor &>(*sv).handleDocuments(bucketId, documents, hitCounter);
+    return sv->generateQueryResult(hitCounter);
+}
+
+uint64_t
+getGroupCount(const vdslib::SearchResult & result, uint32_t groupingId)
+{
+    auto itr = result.getGroupingList().find(groupingId);
+    ASSERT_TRUE(itr != result.getGroupingList().end());
+    vespalib::nbostream is(itr->second.c_str(), itr->second.size());
+    vespalib::NBOSerializer nis(is);
+    Grouping grouping;
+    grouping.deserialize(nis);
+    const auto & count = static_cast<const CountAggregationResult &>(grouping.getRoot().getAggregationResult(0));
+    return count.getCount();
+}
+
+std::vector<std::pair<vespalib::string, vdslib::SearchResult::RankType>>
+getHits(vdslib::SearchResult & result)
+{
+    std::vector<std::pair<vespalib::string, vdslib::SearchResult::RankType>> hits;
+    for (size_t i = 0; i < result.getHitCount(); ++i) {
+        const char * docId;
+        vdslib::SearchResult::RankType rank;
+        result.getHit(i, docId, rank);
+        hits.emplace_back(docId, rank);
+    }
+    return hits;
+}
+
 void
 SearchVisitorTest::testSearchEnvironment()
 {
@@ -84,8 +197,8 @@ SearchVisitorTest::testSearchEnvironment()
     EXPECT_TRUE(_env.getRankManager("simple") != NULL);
 }
 
-void
-SearchVisitorTest::testSearchVisitor()
+vdslib::Parameters
+createParameters()
 {
     vdslib::Parameters params;
     params.set("searchcluster", "aaa");
@@ -100,7 +213,49 @@ SearchVisitorTest::testSearchVisitor()
     vespalib::string stackDump = StackDumpCreator::create(*node);
 
     params.set("query", stackDump);
-    testCreateSearchVisitor("dir:" + TEST_PATH("cfg"), params);
+    return params;
+}
+
+void
+SearchVisitorTest::testSearchVisitor()
+{
+    testCreateSearchVisitor("dir:" + TEST_PATH("cfg"), createParameters(), _env, 1);
+}
+
+void
+SearchVisitorTest::testSearchVisitorWithMatchThreads()
+{
+    const size_t numDocuments = 1000;
+    SearchEnvironment env1("dir:" + TEST_PATH("cfg"), 1);
+    SearchEnvironment env4("dir:" + TEST_PATH("cfg"), 4);
+    EXPECT_EQUAL(4u, env4.getMatchThreads());
+    testCreateSearchVisitor("dir:" + TEST_PATH("cfg"), createParameters(), env4, 1);
+
+    auto expected = searchMatchingDocuments(_env, numDocuments);
+    vdslib::SearchResult & expectedResult = expected->getSearchResult();
+    EXPECT_EQUAL(numMatchingDocuments(numDocuments), expectedResult.getTotalHitCount());
+    auto expectedHits = getHits(expectedResult);
+    EXPECT_EQUAL(numMatchingDocuments(numDocuments), expectedHits.size());
+    for (const auto & hit : expectedHits) {
+        size_t docNo = strtoul(hit.first.c_str() + strlen("id:test:maptest::"), nullptr, 10);
+        EXPECT_TRUE(isMatchingDocument(docNo));
+    }
+    EXPECT_EQUAL(numMatchingDocuments(numDocuments), getGroupCount(expectedResult, 1));
+    EXPECT_EQUAL(numDocuments, getGroupCount(expectedResult, 2));
+
+    for (SearchEnvironment * env : {&env1, &env4}) {
+        auto & matchExecutor = dynamic_cast<vespalib::ThreadStackExecutorBase &>(*env->getMatchExecutor());
+        matchExecutor.getStats();
+        auto actual = searchMatchingDocuments(*env, numDocuments);
+        // One prefilter task per match thread
+        EXPECT_EQUAL(env->getMatchThreads(), matchExecutor.getStats().acceptedTasks);
+        vdslib::SearchResult & actualResult = actual->getSearchResult();
+        EXPECT_EQUAL(expectedResult.getTotalHitCount(), actualResult.getTotalHitCount());
+        EXPECT_TRUE(expectedHits == getHits(actualResult));
+        EXPECT_EQUAL(numMatchingDocuments(numDocuments), getGroupCount(actualResult, 1));
+        EXPECT_EQUAL(numDocuments, getGroupCount(actualResult, 2));
+        EXPECT_EQUAL(expected->getDocumentSummary().getSummaryCount(), actual->getDocumentSummary().getSummaryCount());
+    }
 }
 
 void
@@ -119,6 +274,7 @@ SearchVisitorTest::Main()
     TEST_INIT("searchvisitor_test");
 
     testSearchVisitor(); TEST_FLUSH();
+    testSearchVisitorWithMatchThreads(); TEST_FLUSH();
     testSearchEnvironment(); TEST_FLUSH();
     testOnlyRequireWeakReadConsistency(); TEST_FLUSH();
 
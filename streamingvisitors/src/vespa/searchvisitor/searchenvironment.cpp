@@ -11,6 +11,12 @@ using vsm::VSMAdapter;
 
 namespace streaming {
 
+namespace {
+
+constexpr uint32_t match_thread_stack_size = 256 * 1024;
+
+}
+
 __thread SearchEnvironment::EnvMap * SearchEnvironment::_localEnvMap=0;
 
 SearchEnvironment::Env::Env(const vespalib::string & muffens, const config::ConfigUri & configUri, Fast_NormalizeWordFolder & wf) :
@@ -49,14 +55,22 @@ SearchEnvironment::Env::~Env()
     _configurer.close();
 }
 
-SearchEnvironment::SearchEnvironment(const config::ConfigUri & configUri) :
+SearchEnvironment::SearchEnvironment(const config::ConfigUri & configUri, uint32_t matchThreads) :
     VisitorEnvironment(),
     _envMap(),
-    _configUri(configUri)
-{ }
+    _configUri(configUri),
+    _matchExecutor()
+{
+    if (matchThreads > 0) {
+        _matchExecutor = std::make_unique<vespalib::ThreadStackExecutor>(matchThreads, match_thread_stack_size);
+    }
+}
 
 SearchEnvironment::~SearchEnvironment()
 {
+    if (_matchExecutor) {
+        _matchExecutor->shutdown().sync();
+    }
     vespalib::LockGuard guard(_lock);
     _threadLocals.clear();
 }
@@ -9,6 +9,7 @@
 #include <vespa/config/subscription/configuri.h>
 #include <vespa/vsm/vsm/vsm-adapter.h>
 #include <vespa/fastlib/text/normwordfolder.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 namespace streaming {
 
@@ -41,14 +42,21 @@ private:
     vespalib::Lock           _lock;
     Fast_NormalizeWordFolder _wordFolder;
     config::ConfigUri        _configUri;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _matchExecutor;
 
     Env & getEnv(const vespalib::string & searchcluster);
 
 public:
-    SearchEnvironment(const config::ConfigUri & configUri);
+    SearchEnvironment(const config::ConfigUri & configUri, uint32_t matchThreads = 0);
     ~SearchEnvironment();
     const vsm::VSMAdapter * getVSMAdapter(const vespalib::string & searchcluster) { return getEnv(searchcluster).getVSMAdapter(); }
     const RankManager * getRankManager(const vespalib::string & searchcluster)    { return getEnv(searchcluster).getRankManager(); }
+    /**
+     * Returns the executor shared by all search visitors for matching blocks of
+     * documents in parallel, or nullptr if matching is done on the visitor thread only.
+     **/
+    vespalib::Executor * getMatchExecutor() { return _matchExecutor.get(); }
+    size_t getMatchThreads() const { return _matchExecutor ? _matchExecutor->getNumThreads() : 0u; }
 };
 
 }
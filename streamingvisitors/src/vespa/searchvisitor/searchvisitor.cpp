@@ -9,11 +9,16 @@
 #include <vespa/document/datatype/mapdatatype.h>
 #include <vespa/searchlib/aggregation/modifiers.h>
 #include <vespa/searchlib/common/packets.h>
+#include <vespa/searchlib/query/streaming/term_summary.h>
 #include <vespa/searchlib/uca/ucaconverter.h>
 #include <vespa/searchlib/features/setup.h>
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vsm/searcher/utf8flexiblestringfieldsearcher.h>
+#include <vespa/vsm/searcher/utf8strchrfieldsearcher.h>
 #include <vespa/fnet/databuffer.h>
 #include "matching_elements_filler.h"
 
@@ -60,6 +65,9 @@ enum queryflags {
     QFLAG_DUMP_FEATURES        = 0x00040000
 };
 
+// Smallest number of documents worth handing off to a match thread.
+constexpr size_t MIN_DOCUMENTS_PER_PREFILTER_TASK = 32;
+
 
 AttributeVector::SP
 createMultiValueAttribute(const vespalib::string & name, const document::FieldValue & fv, bool arrayType)
@@ -164,8 +172,36 @@ void SearchVisitor::GroupingEntry::aggregate(const document::Document & doc, sea
     }
 }
 
+SearchVisitor::PrefilterMatcher::PrefilterMatcher(const search::QueryPacketT & queryBlob,
+                                                  vsm::FieldSearchSpecMap & fieldSearchSpecMap) :
+    _query(),
+    _fieldSearcherMap(),
+    _searchBuffer(new vsm::SearcherBuf())
+{
+    QueryTermDataFactory addOnFactory;
+    _query = Query(addOnFactory, queryBlob);
+    _searchBuffer->reserve(0x10000);
+    StringFieldIdTMap fieldsInQuery;
+    fieldSearchSpecMap.buildFieldsInQuery(_query, fieldsInQuery);
+    fieldSearchSpecMap.buildSearcherMap(fieldsInQuery.map(), _fieldSearcherMap);
+    _fieldSearcherMap.prepare(fieldSearchSpecMap.documentTypeMap(), _searchBuffer, _query);
+}
+
+SearchVisitor::PrefilterMatcher::~PrefilterMatcher() = default;
+
+bool
+SearchVisitor::PrefilterMatcher::match(const StorageDocument & doc)
+{
+    for (vsm::FieldSearcherContainer & fSearch : _fieldSearcherMap) {
+        fSearch->search(doc);
+    }
+    bool hit(_query.evaluate());
+    _query.reset();
+    return hit;
+}
+
 SearchVisitor::~SearchVisitor() {
-    if (! isCompletedCalled()) {
+    if (! isCompletedCalled() && _queryResult) {
         HitCounter hc;
         completedVisitingInternal(hc);
     }
@@ -202,7 +238,8 @@ SearchVisitor::SearchVisitor(StorageComponent& component,
     _rankAttribute(dynamic_cast<search::SingleFloatExtAttribute &>(*_rankAttributeBacking)),
     _shouldFillRankAttribute(false),
     _syntheticFieldsController(),
-    _rankController()
+    _rankController(),
+    _prefilterMatchers()
 {
     LOG(debug, "Created SearchVisitor");
 }
@@ -352,15 +389,16 @@ void SearchVisitor::init(const Parameters & params)
     VISITOR_TRACE(6, "Completed lazy VSM adapter initialization");
 }
 
-SearchVisitorFactory::SearchVisitorFactory(const config::ConfigUri & configUri)
+SearchVisitorFactory::SearchVisitorFactory(const config::ConfigUri & configUri, uint32_t matchThreads)
     : VisitorFactory(),
-      _configUri(configUri)
+      _configUri(configUri),
+      _matchThreads(matchThreads)
 {}
 
 VisitorEnvironment::UP
 SearchVisitorFactory::makeVisitorEnvironment(StorageComponent&)
 {
-    return VisitorEnvironment::UP(new SearchEnvironment(_configUri));
+    return VisitorEnvironment::UP(new SearchEnvironment(_configUri, _matchThreads));
 }
 
 storage::Visitor*
@@ -869,6 +907,81 @@ SearchVisitor::compatibleDocumentTypes(const document::DocumentType& typeA,
     }
 }
 
+bool
+SearchVisitor::isRequiredTermCandidate(const search::streaming::QueryTerm & term) const
+{
+    if ( ! term.isWord() || ! term.isValid()) {
+        return false;
+    }
+    vespalib::string index(vsm::FieldSearchSpecMap::stripNonFields(term.index()));
+    bool found(false);
+    for (const auto & docTypeEntry : _fieldSearchSpecMap.documentTypeMap()) {
+        auto fIt = docTypeEntry.second.find(index);
+        if (fIt == docTypeEntry.second.end()) {
+            return false;
+        }
+        for (vsm::FieldIdT fid : fIt->second) {
+            auto specIt = _fieldSearchSpecMap.specMap().find(fid);
+            if ((specIt == _fieldSearchSpecMap.specMap().end()) || ! specIt->second.valid()) {
+                return false;
+            }
+            const vsm::FieldSearcher & searcher = specIt->second.searcher();
+            bool regularUtf8 = (dynamic_cast<const vsm::UTF8StrChrFieldSearcher *>(&searcher) != nullptr) ||
+                               (dynamic_cast<const vsm::UTF8FlexibleStringFieldSearcher *>(&searcher) != nullptr);
+            if ( ! regularUtf8 || searcher.prefix() || searcher.substring() || searcher.suffix() || searcher.exact()) {
+                return false;
+            }
+            found = true;
+        }
+    }
+    return found;
+}
+
+void
+SearchVisitor::collectRequiredTermHashes(const search::streaming::QueryNode & node, std::vector<uint64_t> & hashes) const
+{
+    using namespace search::streaming;
+    if (const auto * term = dynamic_cast<const QueryTerm *>(&node)) {
+        uint64_t hash(0);
+        if (isRequiredTermCandidate(*term) && TermSummary::hashTerm(term->getTerm(), hash)) {
+            hashes.push_back(hash);
+        }
+    } else if (dynamic_cast<const SameElementQueryNode *>(&node) != nullptr) {
+        // Children are relative to the struct field, and can not be resolved here.
+    } else if (const auto * andNot = dynamic_cast<const AndNotQueryNode *>(&node)) {
+        if ( ! andNot->empty()) {
+            collectRequiredTermHashes(*andNot->front(), hashes);
+        }
+    } else if (const auto * andNode = dynamic_cast<const AndQueryNode *>(&node)) {
+        for (const auto & child : *andNode) {
+            collectRequiredTermHashes(*child, hashes);
+        }
+    }
+}
+
+void
+SearchVisitor::startingVisitor(const std::vector<document::BucketId>&)
+{
+    if (_vsmAdapter == nullptr) {
+        init(_params);
+    }
+    if ( ! _rankController.valid() || ! _query.valid()) {
+        return;
+    }
+    for (const GroupingEntry & grouping : _groupingList) {
+        if (grouping->getAll()) {
+            // Non-matching documents are needed for grouping over all documents.
+            return;
+        }
+    }
+    std::vector<uint64_t> hashes;
+    collectRequiredTermHashes(_query.getRoot(), hashes);
+    if ( ! hashes.empty()) {
+        LOG(debug, "SearchVisitor '%s' requires %zu terms to be present in visited documents", _id.c_str(), hashes.size());
+        setRequiredTermHashes(hashes);
+    }
+}
+
 void
 SearchVisitor::handleDocuments(const document::BucketId&,
                                std::vector<storage::spi::DocEntry::UP>& entries,
@@ -888,19 +1001,32 @@ SearchVisitor::handleDocuments(const document::BucketId&,
 
     const document::DocumentType* defaultDocType = _docTypeMapping.getDefaultDocumentType();
     assert(defaultDocType);
+    std::vector<StorageDocument::UP> documents;
+    documents.reserve(entries.size());
     for (const auto & entry : entries) {
         StorageDocument::UP document(new StorageDocument(entry->releaseDocument(), _fieldPathMap, highestFieldNo));
+        if (defaultDocType != nullptr
+            && !compatibleDocumentTypes(*defaultDocType, document->docDoc().getType()))
+        {
+            LOG(debug, "Skipping document of type '%s' when handling only documents of type '%s'",
+                document->docDoc().getType().getName().c_str(), defaultDocType->getName().c_str());
+        } else {
+            documents.push_back(std::move(document));
+        }
+    }
 
+    std::vector<uint8_t> matched;
+    vespalib::Executor * matchExecutor = _env.getMatchExecutor();
+    if ((matchExecutor != nullptr) && (documents.size() >= 2 * MIN_DOCUMENTS_PER_PREFILTER_TASK)) {
+        matched = prefilterDocuments(documents, *matchExecutor);
+    }
+    for (size_t i = 0; i < documents.size(); ++i) {
+        StorageDocument::UP & document = documents[i];
         try {
-            if (defaultDocType != nullptr
-                && !compatibleDocumentTypes(*defaultDocType, document->docDoc().getType()))
-            {
-                LOG(debug, "Skipping document of type '%s' when handling only documents of type '%s'",
-                    document->docDoc().getType().getName().c_str(), defaultDocType->getName().c_str());
-            } else {
-                if (handleDocument(*document)) {
-                    _backingDocuments.push_back(std::move(document));
-                }
+            if ( ! matched.empty() && ! matched[i]) {
+                handleNonMatchingDocument(*document);
+            } else if (handleDocument(*document)) {
+                _backingDocuments.push_back(std::move(document));
             }
         } catch (const std::exception & e) {
             LOG(warning, "Caught exception handling document '%s'. Exception='%s'",
@@ -909,6 +1035,52 @@ SearchVisitor::handleDocuments(const document::BucketId&,
     }
 }
 
+std::vector<uint8_t>
+SearchVisitor::prefilterDocuments(const std::vector<StorageDocument::UP> & documents, vespalib::Executor & executor)
+{
+    if (_prefilterMatchers.empty()) {
+        Parameters::ValueRef queryBlob;
+        _params.lookup("query", queryBlob);
+        for (size_t i = 0; i < _env.getMatchThreads(); ++i) {
+            _prefilterMatchers.push_back(std::make_unique<PrefilterMatcher>(search::QueryPacketT(queryBlob.data(), queryBlob.size()),
+                                                                            _fieldSearchSpecMap));
+        }
+    }
+    // Documents that are not matched by a task are handled as possible matches.
+    std::vector<uint8_t> matched(documents.size(), 1u);
+    size_t numTasks = std::min(_prefilterMatchers.size(), documents.size() / MIN_DOCUMENTS_PER_PREFILTER_TASK);
+    vespalib::CountDownLatch done(numTasks);
+    for (size_t task = 0; task < numTasks; ++task) {
+        size_t begin = documents.size() * task / numTasks;
+        size_t end = documents.size() * (task + 1) / numTasks;
+        PrefilterMatcher & matcher = *_prefilterMatchers[task];
+        auto rejected = executor.execute(vespalib::makeLambdaTask([&documents, &matched, &matcher, &done, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    matched[i] = matcher.match(*documents[i]) ? 1u : 0u;
+                } catch (const std::exception &) {
+                    // Reported when the document is matched again in the sequential pass.
+                }
+            }
+            done.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    done.await();
+    return matched;
+}
+
+void
+SearchVisitor::handleNonMatchingDocument(StorageDocument & document)
+{
+    _syntheticFieldsController.onDocument(document);
+    group(document.docDoc(), 0, true);
+    _docSearchedCount++;
+    LOG(debug, "Did not match document with id '%s'", document.docDoc().getId().getScheme().toString().c_str());
+}
+
 bool
 SearchVisitor::handleDocument(StorageDocument & document)
 {
@@ -1087,10 +1259,16 @@ void SearchVisitor::completedVisitingInternal(HitCounter& hitCounter)
     LOG(debug, "Docsum count: %lu", documentSummary.getSummaryCount());
 }
 
-void SearchVisitor::completedVisiting(HitCounter& hitCounter)
+std::unique_ptr<documentapi::QueryResultMessage>
+SearchVisitor::generateQueryResult(HitCounter& hitCounter)
 {
     completedVisitingInternal(hitCounter);
-    sendMessage(documentapi::DocumentMessage::UP(_queryResult.release()));
+    return std::move(_queryResult);
+}
+
+void SearchVisitor::completedVisiting(HitCounter& hitCounter)
+{
+    sendMessage(generateQueryResult(hitCounter));
 }
 
 void
@@ -45,6 +45,12 @@ public:
                   const vdslib::Parameters & params);
 
     ~SearchVisitor();
+
+    /**
+     * Complete visiting and return the query result instead of sending it.
+     * Used by completedVisiting(), and by tests inspecting the result.
+     */
+    std::unique_ptr<documentapi::QueryResultMessage> generateQueryResult(HitCounter& counter);
 private:
     /**
      * This struct wraps an attribute vector.
@@ -296,6 +302,21 @@ private:
      **/
     void setupGrouping(const std::vector<char> & groupingBlob);
 
+    /**
+     * Returns true if the given word term can only match documents that contain
+     * the term as a folded word in one of the fields searched by the term.
+     **/
+    bool isRequiredTermCandidate(const search::streaming::QueryTerm & term) const;
+
+    /**
+     * Collects the hashes of terms that must be present in a document for
+     * the query to match. Only and-like nodes propagate the requirement.
+     **/
+    void collectRequiredTermHashes(const search::streaming::QueryNode & node, std::vector<uint64_t> & hashes) const;
+
+    // Inherit doc from Visitor
+    void startingVisitor(const std::vector<document::BucketId>&) override;
+
     // Inherit doc from Visitor
     void handleDocuments(const document::BucketId&,
                          std::vector<storage::spi::DocEntry::UP>& entries,
@@ -311,6 +332,26 @@ private:
      */
     bool handleDocument(vsm::StorageDocument & document);
 
+    /**
+     * Process one document that is known not to match the query.
+     * Only grouping over all documents is affected.
+     *
+     * @param document Document to process.
+     */
+    void handleNonMatchingDocument(vsm::StorageDocument & document);
+
+    /**
+     * Match the given documents against the query using the match executor.
+     * This is done before the sequential pass over the documents, which then
+     * only needs to rerun matching, ranking and grouping for the documents that matched.
+     *
+     * @param documents the documents to prefilter.
+     * @param executor the executor used to run the match tasks.
+     * @return one flag per document telling whether it matched the query.
+     */
+    std::vector<uint8_t> prefilterDocuments(const std::vector<vsm::StorageDocument::UP> & documents,
+                                            vespalib::Executor & executor);
+
     /**
      * Collect the given document for grouping.
      *
@@ -402,6 +443,23 @@ private:
         search::RawBuf                          _rawBuf;
     };
 
+    /**
+     * Matches documents against a private copy of the query and the field searchers.
+     * Used to match separate parts of a block of documents in parallel.
+     **/
+    class PrefilterMatcher
+    {
+    public:
+        using UP = std::unique_ptr<PrefilterMatcher>;
+        PrefilterMatcher(const search::QueryPacketT & queryBlob, vsm::FieldSearchSpecMap & fieldSearchSpecMap);
+        ~PrefilterMatcher();
+        bool match(const vsm::StorageDocument & doc);
+    private:
+        search::streaming::Query _query;
+        vsm::FieldIdTSearcherMap _fieldSearcherMap;
+        vsm::SharedSearcherBuf   _searchBuffer;
+    };
+
     class HitsResultPreparator : public vespalib::ObjectOperation, public vespalib::ObjectPredicate
     {
     public:
@@ -450,18 +508,20 @@ private:
     RankController                          _rankController;
     DocumentVector                          _backingDocuments;
     vsm::StringFieldIdTMapT                 _fieldsUnion;
+    std::vector<PrefilterMatcher::UP>       _prefilterMatchers;
 
     void setupAttributeVector(const vsm::FieldPath &fieldPath);
 };
 
 class SearchVisitorFactory : public storage::VisitorFactory {
     config::ConfigUri _configUri;
+    uint32_t          _matchThreads;
     storage::VisitorEnvironment::UP makeVisitorEnvironment(storage::StorageComponent&) override;
 
     storage::Visitor* makeVisitor(storage::StorageComponent&, storage::VisitorEnvironment&env,
                          const vdslib::Parameters& params) override;
 public:
-    SearchVisitorFactory(const config::ConfigUri & configUri);
+    SearchVisitorFactory(const config::ConfigUri & configUri, uint32_t matchThreads = 0);
 };
 
 }
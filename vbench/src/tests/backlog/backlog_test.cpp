@@ -0,0 +1,75 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+struct MyHandler : public Handler<int> {
+    int value;
+    MyHandler() : value(-1) {}
+    void handle(std::unique_ptr<int> v) override { value = (v.get() != 0) ? *v : 0; }
+};
+
+struct Fetcher : public vespalib::Runnable {
+    Provider<int> &provider;
+    Handler<int> &handler;
+    Fetcher(Provider<int> &p, Handler<int> &h) : provider(p), handler(h) {}
+    void run() override { handler.handle(provider.provide()); }
+};
+
+TEST_F("backlog keeps objects in order until provided", Backlog<int>()) {
+    f1.handle(std::unique_ptr<int>(new int(1)));
+    f1.handle(std::unique_ptr<int>(new int(2)));
+    f1.handle(std::unique_ptr<int>(new int(3)));
+    EXPECT_EQUAL(3u, f1.maxSize());
+    EXPECT_EQUAL(1, *f1.provide());
+    EXPECT_EQUAL(2, *f1.provide());
+    f1.handle(std::unique_ptr<int>(new int(4)));
+    EXPECT_EQUAL(3, *f1.provide());
+    EXPECT_EQUAL(4, *f1.provide());
+    EXPECT_EQUAL(3u, f1.maxSize());
+}
+
+TEST_F("waiting thread gets object handled later", Backlog<int>()) {
+    MyHandler handler;
+    Fetcher fetcher(f1, handler);
+    vespalib::Thread thread(fetcher);
+    thread.start();
+    EXPECT_TRUE(f1.waitForThreads(1, 512));
+    f1.handle(std::unique_ptr<int>(new int(5)));
+    thread.join();
+    EXPECT_EQUAL(5, handler.value);
+    EXPECT_EQUAL(0u, f1.maxSize());
+}
+
+TEST_F("backlog poll timeout", Backlog<int>()) {
+    EXPECT_FALSE(f1.waitForThreads(1, 2));
+}
+
+TEST_F("closed backlog drains queued objects before providing nil", Backlog<int>()) {
+    f1.handle(std::unique_ptr<int>(new int(1)));
+    f1.close();
+    f1.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(1, *f1.provide());
+    EXPECT_TRUE(f1.provide().get() == 0);
+}
+
+TEST_F("close wakes up waiting threads", Backlog<int>()) {
+    MyHandler handler;
+    Fetcher fetcher(f1, handler);
+    vespalib::Thread thread(fetcher);
+    thread.start();
+    f1.close();
+    thread.join();
+    EXPECT_EQUAL(0, handler.value);
+}
+
+TEST_F("discarded objects are not provided", Backlog<int>()) {
+    f1.handle(std::unique_ptr<int>(new int(1)));
+    f1.handle(std::unique_ptr<int>(new int(2)));
+    f1.close();
+    f1.discard();
+    EXPECT_TRUE(f1.provide().get() == 0);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
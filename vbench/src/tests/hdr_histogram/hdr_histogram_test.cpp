@@ -0,0 +1,70 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST_F("empty histogram", HdrHistogram(3600000000, 3)) {
+    EXPECT_EQUAL(0u, f1.count());
+    EXPECT_EQUAL(0u, f1.valueAtPercentile(50.0));
+    EXPECT_EQUAL(0.0, f1.mean());
+}
+
+TEST_F("small values are recorded exactly", HdrHistogram(3600000000, 3)) {
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        f1.record(i);
+    }
+    EXPECT_EQUAL(1000u, f1.count());
+    EXPECT_EQUAL(1u, f1.min());
+    EXPECT_EQUAL(1000u, f1.max());
+    EXPECT_APPROX(500.5, f1.mean(), 10e-6);
+    EXPECT_EQUAL(500u, f1.valueAtPercentile(50.0));
+    EXPECT_EQUAL(990u, f1.valueAtPercentile(99.0));
+    EXPECT_EQUAL(1000u, f1.valueAtPercentile(100.0));
+}
+
+TEST_F("large values keep three significant digits", HdrHistogram(3600000000, 3)) {
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        f1.record(i * 1000);
+    }
+    EXPECT_EQUAL(10000000u, f1.max());
+    EXPECT_APPROX(5000000.0, f1.valueAtPercentile(50.0), 5000.0);
+    EXPECT_APPROX(9900000.0, f1.valueAtPercentile(99.0), 9900.0);
+    EXPECT_APPROX(9990000.0, f1.valueAtPercentile(99.9), 9990.0);
+    EXPECT_EQUAL(10000000u, f1.valueAtPercentile(99.99));
+}
+
+TEST_F("values above the trackable range are clamped", HdrHistogram(1000000, 3)) {
+    f1.record(10);
+    f1.record(5000000);
+    EXPECT_EQUAL(2u, f1.count());
+    EXPECT_EQUAL(5000000u, f1.max());
+    EXPECT_EQUAL(10u, f1.valueAtPercentile(50.0));
+    EXPECT_EQUAL(5000000u, f1.valueAtPercentile(100.0));
+}
+
+TEST_FF("histograms can be added", HdrHistogram(3600000000, 3), HdrHistogram(3600000000, 3)) {
+    f1.record(10);
+    f1.record(20);
+    f2.record(5);
+    f2.record(30);
+    f1.add(f2);
+    EXPECT_EQUAL(4u, f1.count());
+    EXPECT_EQUAL(5u, f1.min());
+    EXPECT_EQUAL(30u, f1.max());
+    EXPECT_EQUAL(10u, f1.valueAtPercentile(50.0));
+    EXPECT_APPROX(16.25, f1.mean(), 10e-6);
+}
+
+TEST_F("percentile distribution uses the HdrHistogram format", HdrHistogram(3600000000, 3)) {
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        f1.record(i * 1000);
+    }
+    string dist = f1.percentileDistribution(1000.0, 5);
+    fprintf(stderr, "%s", dist.c_str());
+    EXPECT_TRUE(dist.find("Value     Percentile TotalCount 1/(1-Percentile)") != string::npos);
+    EXPECT_TRUE(dist.find("1000.000 1.000000000000       1000\n") != string::npos);
+    EXPECT_TRUE(dist.find("#[Max     =     1000.000, Total count    =         1000]") != string::npos);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
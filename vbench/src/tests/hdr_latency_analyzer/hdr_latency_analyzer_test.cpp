@@ -0,0 +1,65 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+void post(double latency, Handler<Request> &handler, double scheduledTime = 0.0, double startTime = 0.0,
+          const string &tag = "", Request::Status status = Request::STATUS_OK)
+{
+    Request::UP req(new Request());
+    req->scheduledTime(scheduledTime).tag(tag).status(status).startTime(startTime).endTime(startTime + latency);
+    handler.handle(std::move(req));
+}
+
+TEST_FF("require that only OK requests are counted", RequestSink(), HdrLatencyAnalyzer(false, "", f1)) {
+    post(1.0, f2);
+    post(2.0, f2, 3.0, 3.0);
+    post(10.0, f2, 0.0, 0.0, "", Request::STATUS_DROPPED);
+    post(20.0, f2, 0.0, 0.0, "", Request::STATUS_FAILED);
+    HdrLatencyAnalyzer::Stats stats = f2.getStats();
+    EXPECT_EQUAL(2u, stats.count);
+    EXPECT_APPROX(1.0, stats.min, 10e-6);
+    EXPECT_APPROX(1.5, stats.avg, 10e-6);
+    EXPECT_APPROX(2.0, stats.max, 10e-6);
+}
+
+TEST_FF("require that latency is measured from intended start", RequestSink(), HdrLatencyAnalyzer(true, "", f1)) {
+    post(1.0, f2, 2.0, 4.0);
+    post(1.0, f2, 3.0, 3.0);
+    HdrLatencyAnalyzer::Stats stats = f2.getStats();
+    EXPECT_APPROX(1.0, stats.min, 10e-6);
+    EXPECT_APPROX(3.0, stats.max, 10e-6);
+}
+
+TEST_FF("verify percentiles", RequestSink(), HdrLatencyAnalyzer(false, "", f1)) {
+    for (size_t i = 1; i <= 10000; ++i) {
+        post(0.001 * i, f2);
+    }
+    HdrLatencyAnalyzer::Stats stats = f2.getStats();
+    EXPECT_APPROX(5.0, stats.per50, 0.005);
+    EXPECT_APPROX(9.0, stats.per90, 0.009);
+    EXPECT_APPROX(9.9, stats.per99, 0.0099);
+    EXPECT_APPROX(9.99, stats.per999, 0.00999);
+    EXPECT_APPROX(9.999, stats.per9999, 0.009999);
+    fprintf(stderr, "%s", stats.toString("all").c_str());
+}
+
+TEST_FF("require that percentiles are kept per tag", RequestSink(), HdrLatencyAnalyzer(false, "", f1)) {
+    for (size_t i = 0; i < 100; ++i) {
+        post(0.010, f2, 0.0, 0.0, "fast");
+        post(0.500, f2, 0.0, 0.0, "slow");
+        post(0.100, f2);
+    }
+    std::vector<string> tags = f2.getTags();
+    ASSERT_EQUAL(2u, tags.size());
+    EXPECT_EQUAL("fast", tags[0]);
+    EXPECT_EQUAL("slow", tags[1]);
+    EXPECT_EQUAL(300u, f2.getStats().count);
+    EXPECT_EQUAL(100u, f2.getStats("fast").count);
+    EXPECT_APPROX(0.010, f2.getStats("fast").per99, 10e-6);
+    EXPECT_APPROX(0.500, f2.getStats("slow").per50, 0.0005);
+    EXPECT_EQUAL(0u, f2.getStats("unknown").count);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,37 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST_FF("poisson tagger", RequestReceptor(), PoissonTagger(100.0, 42, f1)) {
+    double prev = -1.0;
+    bool burst = false;
+    for (size_t i = 0; i < 10000; ++i) {
+        f2.handle(Request::UP(new Request()));
+        ASSERT_TRUE(f1.request.get() != 0);
+        double time = f1.request->scheduledTime();
+        if (i == 0) {
+            EXPECT_APPROX(0.0, time, 10e-6);
+        }
+        EXPECT_TRUE(time >= prev);
+        burst = burst || ((time - prev) < 0.001);
+        prev = time;
+    }
+    EXPECT_APPROX(100.0, prev, 5.0);
+    EXPECT_TRUE(burst);
+}
+
+TEST("poisson tagger is deterministic for a given seed") {
+    RequestReceptor r1;
+    RequestReceptor r2;
+    PoissonTagger t1(10.0, 7, r1);
+    PoissonTagger t2(10.0, 7, r2);
+    for (size_t i = 0; i < 10; ++i) {
+        t1.handle(Request::UP(new Request()));
+        t2.handle(Request::UP(new Request()));
+        EXPECT_EQUAL(r1.request->scheduledTime(), r2.request->scheduledTime());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
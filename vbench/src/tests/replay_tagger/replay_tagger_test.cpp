@@ -0,0 +1,49 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+void post(const string &line, Handler<Request> &handler) {
+    Request::UP req(new Request());
+    req->url(line);
+    handler.handle(std::move(req));
+}
+
+TEST_FF("replay tagger", RequestReceptor(), ReplayTagger(1.0, f1)) {
+    post("1000.5 /search/?query=a", f2);
+    ASSERT_TRUE(f1.request.get() != 0);
+    EXPECT_EQUAL("/search/?query=a", f1.request->url());
+    EXPECT_APPROX(0.0, f1.request->scheduledTime(), 10e-6);
+    post("1001.25\t/search/?query=b", f2);
+    EXPECT_EQUAL("/search/?query=b", f1.request->url());
+    EXPECT_APPROX(0.75, f1.request->scheduledTime(), 10e-6);
+    post("1003 /search/?query=c", f2);
+    EXPECT_APPROX(2.5, f1.request->scheduledTime(), 10e-6);
+    EXPECT_EQUAL(0u, f2.invalid());
+}
+
+TEST_FF("replay tagger never goes back in time", RequestReceptor(), ReplayTagger(1.0, f1)) {
+    post("10 /a", f2);
+    post("12 /b", f2);
+    post("11 /c", f2);
+    EXPECT_EQUAL("/c", f1.request->url());
+    EXPECT_APPROX(2.0, f1.request->scheduledTime(), 10e-6);
+}
+
+TEST_FF("replay tagger speedup", RequestReceptor(), ReplayTagger(2.0, f1)) {
+    post("10 /a", f2);
+    post("14 /b", f2);
+    EXPECT_APPROX(2.0, f1.request->scheduledTime(), 10e-6);
+}
+
+TEST_FF("lines without timestamp are kept as is", RequestReceptor(), ReplayTagger(1.0, f1)) {
+    post("10 /a", f2);
+    post("12 /b", f2);
+    post("/search/?query=c d", f2);
+    EXPECT_EQUAL("/search/?query=c d", f1.request->url());
+    EXPECT_APPROX(2.0, f1.request->scheduledTime(), 10e-6);
+    EXPECT_EQUAL(1u, f2.invalid());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,15 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST_FF("tag tagger", RequestReceptor(), TagTagger("search", f1)) {
+    Request::UP req(new Request());
+    EXPECT_EQUAL("", req->tag());
+    f2.handle(std::move(req));
+    ASSERT_TRUE(f1.request.get() != 0);
+    EXPECT_EQUAL("search", f1.request->tag());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,53 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "handler.h"
+#include "provider.h"
+#include "closeable.h"
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/arrayqueue.hpp>
+#include <vespa/vespalib/util/thread.h>
+#include <algorithm>
+
+namespace vbench {
+
+/**
+ * Queue objects between threads. Unlike the Dispatcher, objects that
+ * arrive while no component is waiting for them are kept in order
+ * until requested through the Provider interface, so that nothing is
+ * dropped when the consumers fall behind. A closed backlog will
+ * still provide the objects already queued before it starts handing
+ * out nil objects, and will delete incoming objects.
+ **/
+template <typename T>
+class Backlog : public Handler<T>,
+                public Provider<T>,
+                public Closeable
+{
+private:
+    vespalib::Monitor                         _monitor;
+    vespalib::ArrayQueue<std::unique_ptr<T> > _queue;
+    size_t                                    _waiting;
+    size_t                                    _maxSize;
+    bool                                      _closed;
+
+public:
+    Backlog();
+    ~Backlog();
+    bool waitForThreads(size_t threads, size_t pollCnt) const;
+
+    /**
+     * The largest number of objects seen queued beyond the number of
+     * components waiting for them, that is, objects that had to wait.
+     **/
+    size_t maxSize() const;
+    void discard();
+    void close() override;
+    void handle(std::unique_ptr<T> obj) override;
+    std::unique_ptr<T> provide() override;
+};
+
+} // namespace vbench
+
+#include "backlog.hpp"
@@ -0,0 +1,95 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+namespace vbench {
+
+template <typename T>
+Backlog<T>::Backlog()
+    : _monitor(),
+      _queue(),
+      _waiting(0),
+      _maxSize(0),
+      _closed(false)
+{
+}
+
+template <typename T>
+Backlog<T>::~Backlog() {}
+
+template <typename T>
+bool
+Backlog<T>::waitForThreads(size_t threads, size_t pollCnt) const
+{
+    for (size_t i = 0; i < pollCnt; ++i) {
+        if (i != 0) {
+            vespalib::Thread::sleep(20);
+        }
+        {
+            vespalib::MonitorGuard guard(_monitor);
+            if (_waiting >= threads) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T>
+size_t
+Backlog<T>::maxSize() const
+{
+    vespalib::MonitorGuard guard(_monitor);
+    return _maxSize;
+}
+
+template <typename T>
+void
+Backlog<T>::discard()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    while (!_queue.empty()) {
+        _queue.pop();
+    }
+}
+
+template <typename T>
+void
+Backlog<T>::close()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    _closed = true;
+    guard.broadcast();
+}
+
+template <typename T>
+void
+Backlog<T>::handle(std::unique_ptr<T> obj)
+{
+    vespalib::MonitorGuard guard(_monitor);
+    if (!_closed) {
+        _queue.push(std::move(obj));
+        if (_queue.size() > _waiting) {
+            _maxSize = std::max(_maxSize, _queue.size() - _waiting);
+        }
+        guard.signal();
+    }
+}
+
+template <typename T>
+std::unique_ptr<T>
+Backlog<T>::provide()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    ++_waiting;
+    while (!_closed && _queue.empty()) {
+        guard.wait();
+    }
+    --_waiting;
+    if (_queue.empty()) {
+        return std::unique_ptr<T>();
+    }
+    std::unique_ptr<T> obj(std::move(_queue.access(0)));
+    _queue.pop();
+    return obj;
+}
+
+} // namespace vbench
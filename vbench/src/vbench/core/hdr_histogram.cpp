@@ -0,0 +1,184 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cmath>
+
+namespace vbench {
+
+namespace {
+
+uint32_t log2Ceil(uint64_t value) {
+    uint32_t bits = 0;
+    while ((uint64_t(1) << bits) < value) {
+        ++bits;
+    }
+    return bits;
+}
+
+} // namespace vbench::<unnamed>
+
+size_t
+HdrHistogram::countsIndex(uint64_t value) const
+{
+    uint32_t pow2Ceiling = 64 - __builtin_clzll(value | _subBucketMask);
+    uint32_t bucketIdx = pow2Ceiling - (_subBucketHalfCountMagnitude + 1);
+    uint64_t subBucketIdx = value >> bucketIdx;
+    return ((size_t(bucketIdx) + 1) << _subBucketHalfCountMagnitude) + (subBucketIdx - _subBucketHalfCount);
+}
+
+uint64_t
+HdrHistogram::valueFromIndex(size_t index) const
+{
+    int64_t bucketIdx = int64_t(index >> _subBucketHalfCountMagnitude) - 1;
+    uint64_t subBucketIdx = (index & (_subBucketHalfCount - 1)) + _subBucketHalfCount;
+    if (bucketIdx < 0) {
+        subBucketIdx -= _subBucketHalfCount;
+        bucketIdx = 0;
+    }
+    return subBucketIdx << bucketIdx;
+}
+
+uint64_t
+HdrHistogram::sizeOfEquivalentRange(uint64_t value) const
+{
+    uint32_t pow2Ceiling = 64 - __builtin_clzll(value | _subBucketMask);
+    uint32_t bucketIdx = pow2Ceiling - (_subBucketHalfCountMagnitude + 1);
+    return (uint64_t(1) << bucketIdx);
+}
+
+uint64_t
+HdrHistogram::highestEquivalentValue(uint64_t value) const
+{
+    uint64_t size = sizeOfEquivalentRange(value);
+    return (value & ~(size - 1)) + size - 1;
+}
+
+HdrHistogram::HdrHistogram(uint64_t highestTrackableValue, uint32_t significantDigits)
+    : _highestTrackableValue(std::max(highestTrackableValue, uint64_t(2))),
+      _significantDigits(std::max(1u, std::min(significantDigits, 5u))),
+      _subBucketHalfCountMagnitude(0),
+      _subBucketHalfCount(0),
+      _subBucketMask(0),
+      _counts(),
+      _totalCount(0),
+      _min(0),
+      _max(0),
+      _sum(0.0),
+      _sumSquares(0.0)
+{
+    uint64_t largestValueWithSingleUnitResolution = 2;
+    for (uint32_t i = 0; i < _significantDigits; ++i) {
+        largestValueWithSingleUnitResolution *= 10;
+    }
+    uint32_t subBucketCountMagnitude = log2Ceil(largestValueWithSingleUnitResolution);
+    _subBucketHalfCountMagnitude = subBucketCountMagnitude - 1;
+    _subBucketHalfCount = (uint64_t(1) << _subBucketHalfCountMagnitude);
+    _subBucketMask = (uint64_t(1) << subBucketCountMagnitude) - 1;
+    _highestTrackableValue = std::min(_highestTrackableValue, uint64_t(1) << 62);
+    _counts.resize(countsIndex(_highestTrackableValue) + 1, 0);
+}
+
+void
+HdrHistogram::record(uint64_t value)
+{
+    if (_totalCount == 0 || value < _min) {
+        _min = value;
+    }
+    if (_totalCount == 0 || value > _max) {
+        _max = value;
+    }
+    ++_totalCount;
+    _sum += value;
+    _sumSquares += double(value) * value;
+    ++_counts[countsIndex(std::min(value, _highestTrackableValue))];
+}
+
+void
+HdrHistogram::add(const HdrHistogram &rhs)
+{
+    assert(_counts.size() == rhs._counts.size());
+    if (rhs._totalCount == 0) {
+        return;
+    }
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        _counts[i] += rhs._counts[i];
+    }
+    _min = (_totalCount == 0) ? rhs._min : std::min(_min, rhs._min);
+    _max = (_totalCount == 0) ? rhs._max : std::max(_max, rhs._max);
+    _totalCount += rhs._totalCount;
+    _sum += rhs._sum;
+    _sumSquares += rhs._sumSquares;
+}
+
+double
+HdrHistogram::mean() const
+{
+    return (_totalCount > 0) ? (_sum / _totalCount) : 0.0;
+}
+
+double
+HdrHistogram::stddev() const
+{
+    if (_totalCount == 0) {
+        return 0.0;
+    }
+    double avg = mean();
+    return std::sqrt(std::max(0.0, (_sumSquares / _totalCount) - (avg * avg)));
+}
+
+uint64_t
+HdrHistogram::valueAtPercentile(double percentile) const
+{
+    if (_totalCount == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = std::max(uint64_t(1), uint64_t((percentile / 100.0) * _totalCount + 0.5));
+    uint64_t acc = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        acc += _counts[i];
+        if (acc >= target) {
+            return std::min(highestEquivalentValue(valueFromIndex(i)), _max);
+        }
+    }
+    return _max;
+}
+
+string
+HdrHistogram::percentileDistribution(double valueScale, uint32_t ticksPerHalfDistance) const
+{
+    string str = strfmt("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    ticksPerHalfDistance = std::max(ticksPerHalfDistance, 1u);
+    double level = 0.0;
+    uint64_t acc = 0;
+    for (size_t i = 0; (i < _counts.size()) && (acc < _totalCount); ++i) {
+        if (_counts[i] == 0) {
+            continue;
+        }
+        acc += _counts[i];
+        double reached = (100.0 * acc) / _totalCount;
+        double value = std::min(highestEquivalentValue(valueFromIndex(i)), _max) / valueScale;
+        while (level <= reached) {
+            double percentile = std::min(level, reached);
+            if (acc == _totalCount) {
+                str += strfmt("%12.3f %2.12f %10" PRIu64 "\n", value, 1.0, acc);
+                break;
+            }
+            str += strfmt("%12.3f %2.12f %10" PRIu64 " %14.2f\n", value, percentile / 100.0, acc,
+                          1.0 / (1.0 - (percentile / 100.0)));
+            // halve the distance to 100% for every ticksPerHalfDistance reported levels
+            double halfDistances = std::floor(std::log2(100.0 / (100.0 - level))) + 1;
+            level += 100.0 / (ticksPerHalfDistance * std::pow(2.0, halfDistances));
+        }
+    }
+    str += strfmt("#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / valueScale, stddev() / valueScale);
+    str += strfmt("#[Max     = %12.3f, Total count    = %12" PRIu64 "]\n", _max / valueScale, _totalCount);
+    str += strfmt("#[Buckets = %12zu, SubBuckets     = %12" PRIu64 "]\n",
+                  (_counts.size() >> _subBucketHalfCountMagnitude) - 1, _subBucketHalfCount * 2);
+    return str;
+}
+
+} // namespace vbench
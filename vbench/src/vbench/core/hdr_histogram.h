@@ -0,0 +1,64 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "string.h"
+#include <vector>
+
+namespace vbench {
+
+/**
+ * A histogram of integer values with a fixed number of significant
+ * digits across its entire range, using the bucket layout of
+ * HdrHistogram. Values are grouped in buckets covering ranges that
+ * double in size, each split into the same number of sub-buckets, so
+ * that memory use is logarithmic in the largest trackable value.
+ * Values above the trackable range are recorded as the largest
+ * trackable value.
+ **/
+class HdrHistogram
+{
+private:
+    uint64_t              _highestTrackableValue;
+    uint32_t              _significantDigits;
+    uint32_t              _subBucketHalfCountMagnitude;
+    uint64_t              _subBucketHalfCount;
+    uint64_t              _subBucketMask;
+    std::vector<uint64_t> _counts;
+    uint64_t              _totalCount;
+    uint64_t              _min;
+    uint64_t              _max;
+    double                _sum;
+    double                _sumSquares;
+
+    size_t countsIndex(uint64_t value) const;
+    uint64_t valueFromIndex(size_t index) const;
+    uint64_t sizeOfEquivalentRange(uint64_t value) const;
+    uint64_t highestEquivalentValue(uint64_t value) const;
+
+public:
+    HdrHistogram(uint64_t highestTrackableValue, uint32_t significantDigits);
+    void record(uint64_t value);
+    void add(const HdrHistogram &rhs);
+    uint64_t count() const { return _totalCount; }
+    uint64_t min() const { return _min; }
+    uint64_t max() const { return _max; }
+    double mean() const;
+    double stddev() const;
+
+    /**
+     * Returns the value below or at which the given percentage of the
+     * recorded values are, as the highest value equivalent to it.
+     **/
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * Renders the percentile distribution in the text format of
+     * HdrHistogram, which may be plotted with the tools that come
+     * with it. Values are divided by the given scale, and the
+     * percentiles are reported with finer steps towards 100%.
+     **/
+    string percentileDistribution(double valueScale, uint32_t ticksPerHalfDistance) const;
+};
+
+} // namespace vbench
@@ -9,6 +9,9 @@
 #include <vbench/vbench/request_scheduler.h>
 #include <vbench/vbench/request_sink.h>
 #include <vbench/vbench/qps_tagger.h>
+#include <vbench/vbench/poisson_tagger.h>
+#include <vbench/vbench/replay_tagger.h>
+#include <vbench/vbench/tag_tagger.h>
 #include <vbench/vbench/dropped_tagger.h>
 #include <vbench/vbench/worker.h>
 #include <vbench/vbench/vbench.h>
@@ -16,6 +19,7 @@
 #include <vbench/vbench/server_tagger.h>
 #include <vbench/vbench/request.h>
 #include <vbench/vbench/latency_analyzer.h>
+#include <vbench/vbench/hdr_latency_analyzer.h>
 #include <vbench/core/input_file_reader.h>
 #include <vbench/core/line_reader.h>
 #include <vbench/core/string.h>
@@ -36,6 +40,8 @@
 #include <vbench/core/provider.h>
 #include <vespa/vespalib/data/input_reader.h>
 #include <vbench/core/dispatcher.h>
+#include <vbench/core/backlog.h>
+#include <vbench/core/hdr_histogram.h>
 #include <vbench/core/stream.h>
 #include <vespa/vespalib/data/input.h>
 #include <vbench/test/simple_http_result_handler.h>
@@ -0,0 +1,138 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_latency_analyzer.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace vbench {
+
+namespace {
+
+// latencies are recorded in microseconds, up to an hour
+constexpr double   MICROS_PER_SECOND = 1000000.0;
+constexpr uint64_t MAX_LATENCY_MICROS = 3600 * 1000000ul;
+constexpr uint32_t SIGNIFICANT_DIGITS = 3;
+
+double seconds(uint64_t micros) { return (micros / MICROS_PER_SECOND); }
+
+} // namespace vbench::<unnamed>
+
+HdrLatencyAnalyzer::Stats::Stats(const HdrHistogram &histogram)
+    : count(histogram.count()),
+      min(seconds(histogram.min())),
+      avg(histogram.mean() / MICROS_PER_SECOND),
+      max(seconds(histogram.max())),
+      per50(seconds(histogram.valueAtPercentile(50.0))),
+      per90(seconds(histogram.valueAtPercentile(90.0))),
+      per99(seconds(histogram.valueAtPercentile(99.0))),
+      per999(seconds(histogram.valueAtPercentile(99.9))),
+      per9999(seconds(histogram.valueAtPercentile(99.99)))
+{
+}
+
+string
+HdrLatencyAnalyzer::Stats::toString(const string &tag) const
+{
+    string str = strfmt("Latency [%s] {\n", tag.c_str());
+    str += strfmt("  count: %zu\n", count);
+    str += strfmt("  min: %g\n", min);
+    str += strfmt("  avg: %g\n", avg);
+    str += strfmt("  max: %g\n", max);
+    str += strfmt("  50%%: %g\n", per50);
+    str += strfmt("  90%%: %g\n", per90);
+    str += strfmt("  99%%: %g\n", per99);
+    str += strfmt("  99.9%%: %g\n", per999);
+    str += strfmt("  99.99%%: %g\n", per9999);
+    str += "}\n";
+    return str;
+}
+
+HdrHistogram
+HdrLatencyAnalyzer::createHistogram()
+{
+    return HdrHistogram(MAX_LATENCY_MICROS, SIGNIFICANT_DIGITS);
+}
+
+void
+HdrLatencyAnalyzer::save(const string &fileName, const HdrHistogram &histogram) const
+{
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "could not write latency histogram to '%s'\n", fileName.c_str());
+        return;
+    }
+    // the percentile distribution is reported in milliseconds
+    string distribution = histogram.percentileDistribution(1000.0, 5);
+    fwrite(distribution.data(), 1, distribution.size(), file);
+    fclose(file);
+}
+
+HdrLatencyAnalyzer::HdrLatencyAnalyzer(bool intended, const string &file, Handler<Request> &next)
+    : _next(next),
+      _intended(intended),
+      _file(file),
+      _total(createHistogram()),
+      _tags()
+{
+}
+
+HdrLatencyAnalyzer::~HdrLatencyAnalyzer() {}
+
+void
+HdrLatencyAnalyzer::handle(Request::UP request)
+{
+    if (request->status() == Request::STATUS_OK) {
+        addLatency(request->tag(), _intended ? request->intendedLatency() : request->latency());
+    }
+    _next.handle(std::move(request));
+}
+
+void
+HdrLatencyAnalyzer::report()
+{
+    const char *from = _intended ? "intended start" : "actual start";
+    fprintf(stdout, "latency measured from %s\n", from);
+    fprintf(stdout, "%s\n", getStats().toString("all").c_str());
+    for (const auto &entry : _tags) {
+        fprintf(stdout, "%s\n", Stats(entry.second).toString(entry.first).c_str());
+    }
+    if (!_file.empty()) {
+        save(_file + ".hgrm", _total);
+        for (const auto &entry : _tags) {
+            save(_file + "." + entry.first + ".hgrm", entry.second);
+        }
+    }
+}
+
+void
+HdrLatencyAnalyzer::addLatency(const string &tag, double latency)
+{
+    uint64_t micros = (uint64_t)(std::max(latency, 0.0) * MICROS_PER_SECOND + 0.5);
+    _total.record(micros);
+    if (!tag.empty()) {
+        auto pos = _tags.find(tag);
+        if (pos == _tags.end()) {
+            pos = _tags.emplace(tag, createHistogram()).first;
+        }
+        pos->second.record(micros);
+    }
+}
+
+HdrLatencyAnalyzer::Stats
+HdrLatencyAnalyzer::getStats(const string &tag) const
+{
+    auto pos = _tags.find(tag);
+    return (pos != _tags.end()) ? Stats(pos->second) : Stats();
+}
+
+std::vector<string>
+HdrLatencyAnalyzer::getTags() const
+{
+    std::vector<string> tags;
+    for (const auto &entry : _tags) {
+        tags.push_back(entry.first);
+    }
+    return tags;
+}
+
+} // namespace vbench
@@ -0,0 +1,57 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "analyzer.h"
+#include <vbench/core/hdr_histogram.h>
+#include <map>
+
+namespace vbench {
+
+/**
+ * Component picking up the latency of successful requests into HDR
+ * histograms, both in total and for each request tag. By default the
+ * latency is measured from the time the request was scheduled to
+ * start rather than from when it was actually sent, so that time
+ * spent waiting for a free connection counts against the server
+ * (avoiding coordinated omission). The percentile distributions may
+ * be saved in the HdrHistogram text format.
+ **/
+class HdrLatencyAnalyzer : public Analyzer
+{
+private:
+    Handler<Request>               &_next;
+    bool                            _intended;
+    string                          _file;
+    HdrHistogram                    _total;
+    std::map<string, HdrHistogram>  _tags;
+
+    static HdrHistogram createHistogram();
+    void save(const string &fileName, const HdrHistogram &histogram) const;
+
+public:
+    struct Stats {
+        size_t count;
+        double min;
+        double avg;
+        double max;
+        double per50;
+        double per90;
+        double per99;
+        double per999;
+        double per9999;
+        Stats() : count(0), min(0), avg(0), max(0), per50(0), per90(0), per99(0), per999(0), per9999(0) {}
+        explicit Stats(const HdrHistogram &histogram);
+        string toString(const string &tag) const;
+    };
+    HdrLatencyAnalyzer(bool intended, const string &file, Handler<Request> &next);
+    ~HdrLatencyAnalyzer();
+    void handle(Request::UP request) override;
+    void report() override;
+    void addLatency(const string &tag, double latency);
+    Stats getStats() const { return Stats(_total); }
+    Stats getStats(const string &tag) const;
+    std::vector<string> getTags() const;
+};
+
+} // namespace vbench
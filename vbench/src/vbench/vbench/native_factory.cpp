@@ -5,7 +5,11 @@
 #include "request_generator.h"
 #include "server_tagger.h"
 #include "qps_tagger.h"
+#include "poisson_tagger.h"
+#include "replay_tagger.h"
+#include "tag_tagger.h"
 #include "latency_analyzer.h"
+#include "hdr_latency_analyzer.h"
 #include "qps_analyzer.h"
 #include "request_dumper.h"
 #include "ignore_before.h"
@@ -35,6 +39,17 @@ NativeFactory::createTagger(const vespalib::slime::Inspector &spec,
     if (type == "QpsTagger") {
         return Tagger::UP(new QpsTagger(spec["qps"].asLong(), next));
     }
+    if (type == "PoissonTagger") {
+        uint64_t seed = spec["seed"].valid() ? spec["seed"].asLong() : 42;
+        return Tagger::UP(new PoissonTagger(spec["qps"].asDouble(), seed, next));
+    }
+    if (type == "ReplayTagger") {
+        double speedup = spec["speedup"].valid() ? spec["speedup"].asDouble() : 1.0;
+        return Tagger::UP(new ReplayTagger(speedup, next));
+    }
+    if (type == "TagTagger") {
+        return Tagger::UP(new TagTagger(spec["tag"].asString().make_string(), next));
+    }
     return Tagger::UP();
 }
 
@@ -46,6 +61,10 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
     if (type == "LatencyAnalyzer") {
         return Analyzer::UP(new LatencyAnalyzer(next));
     }
+    if (type == "HdrLatencyAnalyzer") {
+        bool intended = spec["intended"].valid() ? spec["intended"].asBool() : true;
+        return Analyzer::UP(new HdrLatencyAnalyzer(intended, spec["file"].asString().make_string(), next));
+    }
     if (type == "QpsAnalyzer") {
         return Analyzer::UP(new QpsAnalyzer(next));
     }
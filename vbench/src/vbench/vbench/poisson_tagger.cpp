@@ -0,0 +1,23 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "poisson_tagger.h"
+
+namespace vbench {
+
+PoissonTagger::PoissonTagger(double qps, uint64_t seed, Handler<Request> &next)
+    : _rnd(seed),
+      _interval(qps),
+      _time(0.0),
+      _next(next)
+{
+}
+
+void
+PoissonTagger::handle(Request::UP request)
+{
+    request->scheduledTime(_time);
+    _time += _interval(_rnd);
+    _next.handle(std::move(request));
+}
+
+} // namespace vbench
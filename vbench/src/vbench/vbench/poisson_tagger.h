@@ -0,0 +1,30 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tagger.h"
+#include "request.h"
+#include <random>
+
+namespace vbench {
+
+/**
+ * Sets the start time of requests based on a Poisson arrival process
+ * with a given average qps. The time between requests is drawn from
+ * an exponential distribution, so that requests will sometimes
+ * arrive in bursts, as they do from independent clients.
+ **/
+class PoissonTagger : public Tagger
+{
+private:
+    std::mt19937_64                  _rnd;
+    std::exponential_distribution<>  _interval;
+    double                           _time;
+    Handler<Request>                &_next;
+
+public:
+    PoissonTagger(double qps, uint64_t seed, Handler<Request> &next);
+    void handle(Request::UP request) override;
+};
+
+} // namespace vbench
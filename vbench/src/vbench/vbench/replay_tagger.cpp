@@ -0,0 +1,54 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "replay_tagger.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace vbench {
+
+namespace {
+
+bool isSpace(char c) { return (c == ' ' || c == '\t'); }
+
+} // namespace vbench::<unnamed>
+
+ReplayTagger::ReplayTagger(double speedup, Handler<Request> &next)
+    : _speedup((speedup > 0.0) ? speedup : 1.0),
+      _first(true),
+      _firstTime(0.0),
+      _time(0.0),
+      _invalid(0),
+      _next(next)
+{
+}
+
+void
+ReplayTagger::handle(Request::UP request)
+{
+    const string &line = request->url();
+    size_t sep = 0;
+    while (sep < line.size() && !isSpace(line[sep])) {
+        ++sep;
+    }
+    char *end = nullptr;
+    double timestamp = strtod(line.c_str(), &end);
+    if ((sep > 0) && (sep < line.size()) && (end == line.c_str() + sep)) {
+        if (_first) {
+            _firstTime = timestamp;
+            _first = false;
+        }
+        // never go back in time, the scheduler would send such requests at once anyway
+        _time = std::max(_time, (timestamp - _firstTime) / _speedup);
+        size_t url = sep;
+        while (url < line.size() && isSpace(line[url])) {
+            ++url;
+        }
+        request->url(line.substr(url));
+    } else {
+        ++_invalid;
+    }
+    request->scheduledTime(_time);
+    _next.handle(std::move(request));
+}
+
+} // namespace vbench
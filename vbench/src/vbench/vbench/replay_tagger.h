@@ -0,0 +1,34 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tagger.h"
+#include "request.h"
+
+namespace vbench {
+
+/**
+ * Sets the start time of requests from timestamps recorded in the
+ * input, used to replay a query log with its original arrival
+ * pattern. Each url is expected to be prefixed by a timestamp in
+ * seconds followed by a space or tab. Start times are relative to the
+ * first timestamp and divided by the given speedup. Requests without
+ * a valid timestamp are scheduled at the time of the previous one.
+ **/
+class ReplayTagger : public Tagger
+{
+private:
+    double            _speedup;
+    bool              _first;
+    double            _firstTime;
+    double            _time;
+    size_t            _invalid;
+    Handler<Request> &_next;
+
+public:
+    ReplayTagger(double speedup, Handler<Request> &next);
+    void handle(Request::UP request) override;
+    size_t invalid() const { return _invalid; }
+};
+
+} // namespace vbench
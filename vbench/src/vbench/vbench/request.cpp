@@ -8,6 +8,7 @@ Request::Request()
     : _url(),
       _server(),
       _scheduledTime(),
+      _tag(),
       _status(STATUS_OK),
       _startTime(),
       _endTime(),
@@ -42,6 +43,7 @@ Request::toString() const
     str += strfmt("  server.host: %s\n", _server.host.c_str());
     str += strfmt("  server.port: %d\n", _server.port);
     str += strfmt("  scheduledTime: %g\n", _scheduledTime);
+    str += strfmt("  tag: %s\n", _tag.c_str());
     str += strfmt("  status: %s\n",
                   ((_status == STATUS_OK) ? "OK"
                    : (_status == STATUS_DROPPED) ? "DROPPED"
@@ -50,6 +52,7 @@ Request::toString() const
     str += strfmt("  startTime: %g\n", _startTime);
     str += strfmt("  endTime: %g\n", _endTime);
     str += strfmt("  latency: %g\n", latency());
+    str += strfmt("  intendedLatency: %g\n", intendedLatency());
     str += strfmt("  size: %zu\n", _size);
     str += _headers.toString();
     str += "}\n";
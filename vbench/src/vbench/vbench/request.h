@@ -30,6 +30,7 @@ private:
     string     _url;
     ServerSpec _server;
     double     _scheduledTime;
+    string     _tag;
 
     // results filled in by request scheduler
     Status     _status;
@@ -54,6 +55,9 @@ public:
     double scheduledTime() const { return _scheduledTime; }
     Request &scheduledTime(double value) { _scheduledTime = value; return *this; }
 
+    const string &tag() const { return _tag; }
+    Request &tag(const string &value) { _tag = value; return *this; }
+
     //--- results
 
     Status status() const { return _status; }
@@ -67,6 +71,9 @@ public:
 
     double latency() const { return (_endTime - _startTime); }
 
+    // latency including the time spent waiting to be sent after the scheduled time
+    double intendedLatency() const { return (_endTime - _scheduledTime); }
+
     void handleHeader(const string &name, const string &value) override;
     void handleContent(const Memory &data) override;
     void handleFailure(const string &reason) override;
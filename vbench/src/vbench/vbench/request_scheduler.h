@@ -5,6 +5,7 @@
 #include "worker.h"
 #include "dropped_tagger.h"
 #include <vbench/core/time_queue.h>
+#include <vbench/core/backlog.h>
 #include <vbench/core/dispatcher.h>
 #include <vbench/core/handler_thread.h>
 #include <vespa/vespalib/util/sync.h>
@@ -15,7 +16,11 @@ namespace vbench {
 /**
  * Component responsible for dispatching requests to workers at the
  * appropriate time based on what start time the requests are tagged
- * with.
+ * with. By default, requests that find no idle worker are dropped.
+ * In open loop mode they are queued until a worker is available
+ * instead, so that the load offered stays the same when the server
+ * falls behind, and the time spent waiting shows up in the latency
+ * measured from the scheduled start time.
  **/
 class RequestScheduler : public Handler<Request>,
                          public vespalib::Runnable,
@@ -27,6 +32,8 @@ private:
     TimeQueue<Request>      _queue;
     DroppedTagger           _droppedTagger;
     Dispatcher<Request>     _dispatcher;
+    Backlog<Request>        _backlog;
+    bool                    _openLoop;
     vespalib::Thread        _thread;
     HttpConnectionPool      _connectionPool;
     std::vector<Worker::UP> _workers;
@@ -35,7 +42,8 @@ private:
 public:
     typedef std::unique_ptr<RequestScheduler> UP;
     using CryptoEngine = vespalib::CryptoEngine;
-    RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers);
+    RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers, bool openLoop = false);
+    size_t maxBacklog() const { return _backlog.maxSize(); }
     void abort();
     void handle(Request::UP request) override;
     void start() override;
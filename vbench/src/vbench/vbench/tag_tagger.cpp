@@ -0,0 +1,20 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tag_tagger.h"
+
+namespace vbench {
+
+TagTagger::TagTagger(const string &tag, Handler<Request> &next)
+    : _tag(tag),
+      _next(next)
+{
+}
+
+void
+TagTagger::handle(Request::UP request)
+{
+    request->tag(_tag);
+    _next.handle(std::move(request));
+}
+
+} // namespace vbench
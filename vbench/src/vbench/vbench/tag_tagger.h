@@ -0,0 +1,24 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tagger.h"
+
+namespace vbench {
+
+/**
+ * Sets the tag of requests, used to group them when analyzing the
+ * results.
+ **/
+class TagTagger : public Tagger
+{
+private:
+    string            _tag;
+    Handler<Request> &_next;
+
+public:
+    TagTagger(const string &tag, Handler<Request> &next);
+    void handle(Request::UP request) override;
+};
+
+} // namespace vbench
@@ -56,7 +56,8 @@ VBench::VBench(const vespalib::Slime &cfg)
     }
     _scheduler.reset(new RequestScheduler(crypto,
                                           *_analyzers.back(),
-                                          cfg.get()["http_threads"].asLong()));
+                                          cfg.get()["http_threads"].asLong(),
+                                          cfg.get()["open_loop"].asBool()));
     vespalib::slime::Inspector &inputs = cfg.get()["inputs"];
     for (size_t i = inputs.children(); i-- > 0; ) {
         vespalib::slime::Inspector &input = inputs[i];
@@ -103,6 +104,10 @@ VBench::run()
         _inputs[i]->thread->join();
     }
     _scheduler->stop().join();
+    if (_scheduler->maxBacklog() > 0) {
+        fprintf(stdout, "open loop: up to %zu requests waited for a free connection\n",
+                _scheduler->maxBacklog());
+    }
     for (size_t i = 0; i < _inputs.size(); ++i) {
         if (_inputs[i]->generator->tainted()) {
             _taint = _inputs[i]->generator->tainted();
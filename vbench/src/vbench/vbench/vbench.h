@@ -4,14 +4,18 @@
 
 #include "analyzer.h"
 #include "generator.h"
+#include "hdr_latency_analyzer.h"
 #include "latency_analyzer.h"
 #include "native_factory.h"
+#include "poisson_tagger.h"
 #include "qps_analyzer.h"
 #include "qps_tagger.h"
+#include "replay_tagger.h"
 #include "request_generator.h"
 #include "request_scheduler.h"
 #include "request_sink.h"
 #include "server_tagger.h"
+#include "tag_tagger.h"
 #include "tagger.h"
 #include <vbench/core/taintable.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -4,6 +4,9 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -261,4 +264,83 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("mmaped file alloc is copied on write") {
+    const char *fileName = "mmap_file_alloc_test.dat";
+    std::vector<char> content(8192 + 100);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 101);
+    }
+    {
+        FILE *fp = fopen(fileName, "w");
+        ASSERT_TRUE(fp != nullptr);
+        ASSERT_EQUAL(content.size(), fwrite(&content[0], 1, content.size(), fp));
+        fclose(fp);
+    }
+    {
+        Alloc buf = Alloc::allocMMapFile(fileName, 4096, 4196);
+        ASSERT_TRUE(buf.get() != nullptr);
+        EXPECT_EQUAL(8192ul, buf.size());
+        char *p = static_cast<char *>(buf.get());
+        EXPECT_EQUAL(0, memcmp(p, &content[4096], 4196));
+        p[0] = 42;
+        EXPECT_EQUAL(42, p[0]);
+        Alloc extra = buf.create(100);
+        EXPECT_EQUAL(4096ul, extra.size());
+    }
+    {
+        Alloc buf = Alloc::allocMMapFile(fileName, 4096, 4196);
+        EXPECT_EQUAL(content[4096], static_cast<char *>(buf.get())[0]);
+    }
+    EXPECT_EXCEPTION(Alloc::allocMMapFile(fileName, 100, 4096), IllegalArgumentException, "page aligned offset");
+    EXPECT_TRUE(Alloc::allocMMapFile("no_such_file.dat", 0, 4096).get() == nullptr);
+    unlink(fileName);
+}
+
+TEST("transparent huge page alloc is huge page aligned and accounted") {
+    static constexpr size_t SZ = MemoryAllocator::HUGEPAGE_SIZE;
+    HugePageStats before = getHugePageStats();
+    {
+        Alloc buf = Alloc::alloc(SZ + 1, SZ, 0, HugePagePolicy::TRANSPARENT);
+        EXPECT_EQUAL(2 * SZ, buf.size());
+        EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(buf.get()) % SZ);
+        memset(buf.get(), 1, buf.size());
+        EXPECT_EQUAL(before.transparentBytes + 2 * SZ, getHugePageStats().transparentBytes);
+        EXPECT_TRUE(buf.resize_inplace(SZ));
+        EXPECT_EQUAL(SZ, buf.size());
+        EXPECT_EQUAL(before.transparentBytes + SZ, getHugePageStats().transparentBytes);
+        Alloc other = buf.create(3 * SZ);
+        EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(other.get()) % SZ);
+        EXPECT_EQUAL(before.transparentBytes + 4 * SZ, getHugePageStats().transparentBytes);
+    }
+    EXPECT_EQUAL(before.transparentBytes, getHugePageStats().transparentBytes);
+}
+
+TEST("transparent huge page policy does not affect heap allocations") {
+    HugePageStats before = getHugePageStats();
+    Alloc buf = Alloc::alloc(100, MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::TRANSPARENT);
+    EXPECT_EQUAL(100u, buf.size());
+    EXPECT_EQUAL(before.transparentBytes, getHugePageStats().transparentBytes);
+}
+
+TEST("explicit huge page alloc falls back to transparent huge pages") {
+    static constexpr size_t SZ = MemoryAllocator::HUGEPAGE_SIZE;
+    HugePageStats before = getHugePageStats();
+    {
+        Alloc buf = Alloc::alloc(SZ, SZ, 0, HugePagePolicy::EXPLICIT);
+        EXPECT_EQUAL(SZ, buf.size());
+        EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(buf.get()) % SZ);
+        memset(buf.get(), 1, buf.size());
+        HugePageStats after = getHugePageStats();
+        if (after.fallbacks == before.fallbacks) {
+            EXPECT_EQUAL(before.explicitBytes + SZ, after.explicitBytes);
+            EXPECT_FALSE(buf.resize_inplace(2 * SZ));
+        } else {
+            EXPECT_EQUAL(before.fallbacks + 1, after.fallbacks);
+            EXPECT_EQUAL(before.transparentBytes + SZ, after.transparentBytes);
+        }
+    }
+    EXPECT_EQUAL(before.explicitBytes, getHugePageStats().explicitBytes);
+    EXPECT_EQUAL(before.transparentBytes, getHugePageStats().transparentBytes);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +69,60 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+std::vector<vespalib::string> make_samples(size_t count) {
+    std::vector<vespalib::string> samples;
+    for (size_t i = 0; i < count; ++i) {
+        samples.push_back(make_string("{\"route\":\"default/chain.indexing\",\"session\":\"chain.indexing\","
+                                      "\"id\":\"id:music:music::%zu\",\"title\":\"title number %zu\","
+                                      "\"artist\":\"artist %zu\",\"year\":%zu,\"timeleft\":%zu}",
+                                      i * 7919, i, i % 97, 1950 + (i % 70), 180000 - i));
+    }
+    return samples;
+}
+
+TEST("require that zstd dictionary can be trained and used for compression/decompression") {
+    auto samples = make_samples(2000);
+    std::vector<ConstBufferRef> refs;
+    for (const auto & sample : samples) {
+        refs.emplace_back(sample.data(), sample.size());
+    }
+    ZStdDictionary::SP dict = ZStdDictionary::train(refs, 4096);
+    ASSERT_TRUE(dict);
+    EXPECT_TRUE(dict->valid());
+    EXPECT_NOT_EQUAL(0u, dict->id());
+    EXPECT_GREATER_EQUAL(4096u, dict->content().size());
+
+    ZStdDictionary copy(dict->content().c_str(), dict->content().size());
+    EXPECT_EQUAL(dict->id(), copy.id());
+
+    vespalib::string input = make_samples(2001).back();
+    std::vector<char> compressed(ZStdCompressor().adjustProcessLen(0, input.size()));
+    size_t compressedLen = compressed.size();
+    ASSERT_TRUE(dict->process(3, input.data(), input.size(), compressed.data(), compressedLen));
+    EXPECT_EQUAL(dict->id(), ZStdDictionary::frameDictId(compressed.data(), compressedLen));
+
+    DataBuffer plain;
+    ConstBufferRef ref(input.data(), input.size());
+    compress(CompressionConfig(CompressionConfig::ZSTD, 3, 100), ref, plain, false);
+    EXPECT_LESS(compressedLen, plain.getDataLen());
+
+    std::vector<char> decompressed(input.size());
+    size_t decompressedLen = decompressed.size();
+    ASSERT_TRUE(copy.unprocess(compressed.data(), compressedLen, decompressed.data(), decompressedLen));
+    EXPECT_EQUAL(input, vespalib::string(decompressed.data(), decompressedLen));
+
+    std::vector<char> small(compressedLen - 1);
+    size_t smallLen = small.size();
+    EXPECT_FALSE(dict->process(3, input.data(), input.size(), small.data(), smallLen));
+    EXPECT_EQUAL(compressedLen - 1, smallLen);
+}
+
+TEST("require that invalid zstd dictionary content is detected") {
+    ZStdDictionary dict("not a dictionary", 16);
+    EXPECT_FALSE(dict.valid());
+    EXPECT_EQUAL(0u, ZStdDictionary::frameDictId(_G_compressableText.c_str(), _G_compressableText.size()));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
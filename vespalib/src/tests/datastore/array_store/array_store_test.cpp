@@ -112,7 +112,7 @@ struct Fixture
         store.transferHoldLists(generation++);
         store.trimHoldLists(generation);
     }
-    void compactWorst(bool compactMemory, bool compactAddressSpace) {
+    size_t compactWorst(bool compactMemory, bool compactAddressSpace) {
         ICompactionContext::UP ctx = store.compactWorst(compactMemory, compactAddressSpace);
         std::vector<EntryRef> refs;
         for (auto itr = refStore.begin(); itr != refStore.end(); ++itr) {
@@ -127,6 +127,7 @@ struct Fixture
             compactedRefStore.insert(std::make_pair(compactedRefs[i], refStore[refs[i]]));
         }
         refStore = compactedRefStore;
+        return ctx->getMovedBytes();
     }
     size_t entrySize() const { return sizeof(EntryT); }
     size_t largeArraySize() const { return sizeof(LargeArray); }
@@ -250,7 +251,7 @@ TEST_F("require that the buffer with most dead space is compacted", NumberFixtur
     uint32_t size3BufferId = f.getBufferId(size3Ref);
 
     EXPECT_EQUAL(3u, f.refStore.size());
-    f.compactWorst(true, false);
+    EXPECT_EQUAL(2 * f.entrySize(), f.compactWorst(true, false));
     EXPECT_EQUAL(3u, f.refStore.size());
     f.assertStoreContent();
 
@@ -283,7 +284,8 @@ void testCompaction(NumberFixture &f, bool compactMemory, bool compactAddressSpa
     uint32_t size3BufferId = f.getBufferId(size3Ref);
 
     EXPECT_EQUAL(3u, f.refStore.size());
-    f.compactWorst(compactMemory, compactAddressSpace);
+    size_t expMovedBytes = ((compactMemory ? 3 : 0) + (compactAddressSpace ? 1 : 0)) * f.entrySize();
+    EXPECT_EQUAL(expMovedBytes, f.compactWorst(compactMemory, compactAddressSpace));
     EXPECT_EQUAL(3u, f.refStore.size());
     f.assertStoreContent();
 
@@ -14,6 +14,7 @@
 #include <vespa/vespalib/test/make_tls_options_for_testing.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 
 using namespace vespalib;
@@ -69,6 +70,22 @@ void write(CryptoSocket &socket, SmartBuffer &buffer) {
     }
 }
 
+void write_vector(CryptoSocket &socket, SmartBuffer &buffer) {
+    auto chunk = buffer.obtain();
+    size_t half = chunk.size / 2;
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<char *>(chunk.data);
+    iov[0].iov_len = half;
+    iov[1].iov_base = const_cast<char *>(chunk.data + half);
+    iov[1].iov_len = chunk.size - half;
+    auto res = socket.write_vector(iov, 2);
+    if (res > 0) {
+        buffer.evict(res);
+    } else {
+        ASSERT_TRUE(is_blocked(res));
+    }
+}
+
 void flush(CryptoSocket &socket) {
     int res = 1;
     while (res > 0) {
@@ -115,7 +132,7 @@ void read_EOF(CryptoSocket &socket, SmartBuffer &read_buffer) {
 
 //-----------------------------------------------------------------------------
 
-void write_bytes(CryptoSocket &socket, const vespalib::string &message) {
+void write_bytes(CryptoSocket &socket, const vespalib::string &message, bool use_vector = false) {
     SmartBuffer write_buffer(message.size());
     SingleFdSelector selector(socket.get_fd());
     auto data = write_buffer.reserve(message.size());
@@ -123,7 +140,11 @@ void write_bytes(CryptoSocket &socket, const vespalib::string &message) {
     write_buffer.commit(message.size());
     while (write_buffer.obtain().size > 0) {
         ASSERT_TRUE(selector.wait_writable());
-        write(socket, write_buffer);
+        if (use_vector) {
+            write_vector(socket, write_buffer);
+        } else {
+            write(socket, write_buffer);
+        }
         flush(socket);
     }
 }
@@ -167,7 +188,7 @@ void verify_socket_io(CryptoSocket &socket, SmartBuffer &read_buffer, bool is_se
         write_bytes(socket, server_message);
         EXPECT_EQUAL(client_message, read);
     } else {
-        write_bytes(socket, client_message);
+        write_bytes(socket, client_message, true);
         vespalib::string read = read_bytes(socket, read_buffer, server_message.size());
         EXPECT_EQUAL(server_message, read);
     }
@@ -52,6 +52,7 @@ ArrayStore<EntryT, RefT>::ArrayStore(const ArrayStoreConfig &cfg)
       _largeArrayType(cfg.specForSize(0))
 {
     initArrayTypes(cfg);
+    _store.setHugePagePolicy(cfg.huge_page_policy());
     _store.initActiveBuffers();
     if (cfg.enable_free_lists()) {
         _store.enableFreeLists();
@@ -125,6 +126,7 @@ private:
     DataStoreBase &_dataStore;
     ArrayStoreType &_store;
     std::vector<uint32_t> _bufferIdsToCompact;
+    size_t _movedBytes;
 
     bool compactingBuffer(uint32_t bufferId) {
         return std::find(_bufferIdsToCompact.begin(), _bufferIdsToCompact.end(),
@@ -136,7 +138,8 @@ public:
                       std::vector<uint32_t> bufferIdsToCompact)
         : _dataStore(dataStore),
           _store(store),
-          _bufferIdsToCompact(std::move(bufferIdsToCompact))
+          _bufferIdsToCompact(std::move(bufferIdsToCompact)),
+          _movedBytes(0)
     {}
     ~CompactionContext() override {
         _dataStore.finishCompact(_bufferIdsToCompact);
@@ -147,7 +150,9 @@ public:
                 if (ref.valid()) {
                     RefT internalRef(ref);
                     if (compactingBuffer(internalRef.bufferId())) {
-                        EntryRef newRef = _store.add(_store.get(ref));
+                        auto array = _store.get(ref);
+                        _movedBytes += array.size() * sizeof(EntryT);
+                        EntryRef newRef = _store.add(array);
                         std::atomic_thread_fence(std::memory_order_release);
                         ref = newRef;
                     }
@@ -155,6 +160,7 @@ public:
             }
         }
     }
+    size_t getMovedBytes() const override { return _movedBytes; }
 };
 
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/alloc.h>
 #include <cstddef>
 #include <vector>
 
@@ -40,6 +41,7 @@ public:
 private:
     AllocSpecVector _allocSpecs;
     bool _enable_free_lists;
+    vespalib::alloc::HugePagePolicy _huge_page_policy;
 
     /**
      * Setup an array store with arrays of size [1-(allocSpecs.size()-1)] allocated in buffers and
@@ -66,6 +68,15 @@ public:
         return std::move(*this);
     }
     [[nodiscard]] bool enable_free_lists() const noexcept { return _enable_free_lists; }
+    ArrayStoreConfig& huge_page_policy(vespalib::alloc::HugePagePolicy policy) & noexcept {
+        _huge_page_policy = policy;
+        return *this;
+    }
+    ArrayStoreConfig&& huge_page_policy(vespalib::alloc::HugePagePolicy policy) && noexcept {
+        _huge_page_policy = policy;
+        return std::move(*this);
+    }
+    [[nodiscard]] vespalib::alloc::HugePagePolicy huge_page_policy() const noexcept { return _huge_page_policy; }
 
     /**
      * Generate a config that is optimized for the given memory huge page size.
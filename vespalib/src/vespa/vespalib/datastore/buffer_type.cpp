@@ -35,7 +35,8 @@ BufferTypeBase::BufferTypeBase(uint32_t arraySize,
       _holdBuffers(0),
       _activeUsedElems(0),
       _holdUsedElems(0),
-      _lastUsedElems(nullptr)
+      _lastUsedElems(nullptr),
+      _hugePagePolicy(vespalib::alloc::HugePagePolicy::DEFAULT)
 {
 }
 
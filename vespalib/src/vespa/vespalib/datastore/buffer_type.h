@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/alloc.h>
 #include <cstdint>
 #include <cstddef>
 
@@ -28,6 +29,7 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    vespalib::alloc::HugePagePolicy _hugePagePolicy;
 
 public:
     class CleanContext {
@@ -71,6 +73,9 @@ public:
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     size_t getMaxArrays() const { return _maxArrays; }
     uint32_t getNumArraysForNewBuffer() const { return _numArraysForNewBuffer; }
+    vespalib::alloc::HugePagePolicy getHugePagePolicy() const { return _hugePagePolicy; }
+    // Only affects buffers allocated after this call.
+    void setHugePagePolicy(vespalib::alloc::HugePagePolicy policy) { _hugePagePolicy = policy; }
 };
 
 /**
@@ -116,7 +116,7 @@ BufferState::onActive(uint32_t bufferId, uint32_t typeId,
     (void) reservedElements;
     AllocResult alloc = calcAllocation(bufferId, *typeHandler, elementsNeeded, false);
     assert(alloc.elements >= reservedElements + elementsNeeded);
-    _buffer.create(alloc.bytes).swap(_buffer);
+    Alloc::alloc(alloc.bytes, MemoryAllocator::HUGEPAGE_SIZE, 0, typeHandler->getHugePagePolicy()).swap(_buffer);
     buffer = _buffer.get();
     assert(buffer != NULL || alloc.elements == 0u);
     _allocElems = alloc.elements;
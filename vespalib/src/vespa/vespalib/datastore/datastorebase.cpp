@@ -271,6 +271,14 @@ DataStoreBase::disableElemHoldList()
     }
 }
 
+void
+DataStoreBase::setHugePagePolicy(vespalib::alloc::HugePagePolicy policy)
+{
+    for (BufferTypeBase *typeHandler : _typeHandlers) {
+        typeHandler->setHugePagePolicy(policy);
+    }
+}
+
 
 DataStoreBase::MemStats
 DataStoreBase::getMemStats() const
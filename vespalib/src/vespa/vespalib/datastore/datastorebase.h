@@ -316,6 +316,11 @@ public:
     void disableFreeList(uint32_t bufferId);
     void disableElemHoldList();
 
+    /**
+     * Set the huge page policy used when allocating new buffers for all registered types.
+     */
+    void setHugePagePolicy(vespalib::alloc::HugePagePolicy policy);
+
     bool has_free_lists_enabled() const { return _freeListsEnabled; }
 
     /**
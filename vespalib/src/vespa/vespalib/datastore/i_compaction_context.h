@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "entryref.h"
 #include <vespa/vespalib/util/array.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <memory>
 
 namespace search::datastore {
 
@@ -16,6 +19,10 @@ struct ICompactionContext {
     using UP = std::unique_ptr<ICompactionContext>;
     virtual ~ICompactionContext() {}
     virtual void compact(vespalib::ArrayRef<EntryRef> refs) = 0;
+    /**
+     * Returns the number of bytes of entry data moved out of the compacted buffers so far.
+     */
+    virtual size_t getMovedBytes() const = 0;
 };
 
 }
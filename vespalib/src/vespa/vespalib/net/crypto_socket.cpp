@@ -1,9 +1,21 @@
 // Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "crypto_socket.h"
+#include <sys/uio.h>
 
 namespace vespalib {
 
 CryptoSocket::~CryptoSocket() = default;
 
+ssize_t
+CryptoSocket::write_vector(const struct iovec *iov, int iovcnt)
+{
+    for (int i = 0; i < iovcnt; ++i) {
+        if (iov[i].iov_len > 0) {
+            return write(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        }
+    }
+    return 0;
+}
+
 } // namespace vespalib
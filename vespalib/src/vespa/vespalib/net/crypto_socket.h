@@ -5,6 +5,8 @@
 #include <memory>
 #include <cstdlib>
 
+struct iovec;
+
 namespace vespalib {
 
 /**
@@ -85,6 +87,22 @@ struct CryptoSocket {
      **/
     virtual ssize_t write(const char *buf, size_t len) = 0;
 
+    /**
+     * Will write_vector pass the application buffers directly to the
+     * underlying socket? Sockets transforming the written data (like
+     * tls) need to copy it anyway, making it pointless for the
+     * application to avoid copying data into a single buffer.
+     **/
+    virtual bool supports_write_vector() const { return false; }
+
+    /**
+     * Write data gathered from multiple buffers. The semantics are
+     * the same as with a normal socket writev (errno, partial
+     * writes, etc.). The default implementation only writes the first
+     * non-empty buffer.
+     **/
+    virtual ssize_t write_vector(const struct iovec *iov, int iovcnt);
+
     /**
      * Try to flush data in the write pipeline that is not dependent
      * on data not yet written by the application into the underlying
@@ -5,6 +5,8 @@
 #include "socket_options.h"
 #include <unistd.h>
 
+struct iovec;
+
 namespace vespalib {
 
 /**
@@ -57,6 +59,7 @@ public:
 
     ssize_t read(char *buf, size_t len);
     ssize_t write(const char *buf, size_t len);
+    ssize_t writev(const struct iovec *iov, int iovcnt);
     SocketHandle accept();
     void shutdown();
     int half_close();
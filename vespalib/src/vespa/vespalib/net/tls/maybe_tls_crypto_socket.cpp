@@ -80,6 +80,8 @@ public:
         return frame;
     }
     ssize_t write(const char *buf, size_t len) override { return _socket.write(buf, len); }
+    bool supports_write_vector() const override { return true; }
+    ssize_t write_vector(const struct iovec *iov, int iovcnt) override { return _socket.writev(iov, iovcnt); }
     ssize_t flush() override { return 0; }
     ssize_t half_close() override { return _socket.half_close(); }
 };
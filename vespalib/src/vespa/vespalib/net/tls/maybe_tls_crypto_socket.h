@@ -30,6 +30,8 @@ public:
     ssize_t read(char *buf, size_t len) override { return _socket->read(buf, len); }
     ssize_t drain(char *buf, size_t len) override { return _socket->drain(buf, len); }
     ssize_t write(const char *buf, size_t len) override { return _socket->write(buf, len); }
+    bool supports_write_vector() const override { return _socket->supports_write_vector(); }
+    ssize_t write_vector(const struct iovec *iov, int iovcnt) override { return _socket->write_vector(iov, iovcnt); }
     ssize_t flush() override { return _socket->flush(); }
     ssize_t half_close() override { return _socket->half_close(); }
 };
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/int8float.h>
 #include "nbo.h"
 
 namespace vespalib {
@@ -58,6 +60,10 @@ public:
     nbostream & operator >> (char & v)     { read1(&v); return *this; }
     nbostream & operator << (bool v)       { write1(&v); return *this; }
     nbostream & operator >> (bool & v)     { read1(&v); return *this; }
+    nbostream & operator << (BFloat16 v)   { return (*this) << v.get_bits(); }
+    nbostream & operator >> (BFloat16 & v) { uint16_t n; (*this) >> n; v = BFloat16::from_bits(n); return *this; }
+    nbostream & operator << (Int8Float v)  { return (*this) << v.get_bits(); }
+    nbostream & operator >> (Int8Float & v) { int8_t n; (*this) >> n; v = Int8Float::from_bits(n); return *this; }
     nbostream & operator << (const std::string & v)      { uint32_t sz(v.size()); (*this) << sz; write(v.c_str(), sz); return *this; }
     nbostream & operator >> (std::string & v) {
         uint32_t sz;
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vespa/fastos/file.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.alloc");
@@ -26,6 +27,11 @@ size_t _G_MMapLogLimit = std::numeric_limits<size_t>::max();
 size_t _G_MMapNoCoreLimit = std::numeric_limits<size_t>::max();
 Lock _G_lock;
 std::atomic<size_t> _G_mmapCount(0);
+volatile bool _G_hasExplicitHugePageFailureJustHappened(false);
+std::atomic<size_t> _G_explicitHugePageBytes(0);
+std::atomic<size_t> _G_transparentHugePageBytes(0);
+std::atomic<size_t> _G_hugePageFallbacks(0);
+std::map<const void *, size_t> _G_explicitHugePageMappings;
 
 size_t
 roundUp2PageSize(size_t sz) {
@@ -90,7 +96,7 @@ size_t sum(const MMapStore & s)
 
 class MMapLimitAndAlignment {
 public:
-    MMapLimitAndAlignment(size_t mmapLimit, size_t alignment);
+    MMapLimitAndAlignment(size_t mmapLimit, size_t alignment, alloc::HugePagePolicy hugePagePolicy);
     uint32_t hash() const { return _key; }
     bool operator == (MMapLimitAndAlignment rhs) const { return _key == rhs._key; }
 private:
@@ -108,11 +114,25 @@ void verifyMMapLimitAndAlignment(size_t mmapLimit, size_t alignment) {
     }
 }
 
-MMapLimitAndAlignment::MMapLimitAndAlignment(size_t mmapLimit, size_t alignment) :
-    _key(Optimized::msbIdx(mmapLimit) | Optimized::msbIdx(alignment) << 6)
+MMapLimitAndAlignment::MMapLimitAndAlignment(size_t mmapLimit, size_t alignment,
+                                             alloc::HugePagePolicy hugePagePolicy) :
+    _key(Optimized::msbIdx(mmapLimit) | Optimized::msbIdx(alignment) << 6 | uint32_t(hugePagePolicy) << 12)
 {
     verifyMMapLimitAndAlignment(mmapLimit, alignment);
 }
+
+void throwOOM(const string & msg) __attribute__((noinline, noreturn));
+
+void throwOOM(const string & msg) {
+    if (_G_SilenceCoreOnOOM) {
+        OOMException oom(msg);
+        oom.setPayload(std::make_unique<SilenceUncaughtException>(oom));
+        throw oom;
+    } else {
+        throw OOMException(msg);
+    }
+}
+
 }
 
 namespace alloc {
@@ -146,6 +166,7 @@ public:
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static size_t sresize_inplace(PtrAndSize current, size_t newSize);
     static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static PtrAndSize smapFile(const char *fileName, size_t offset, size_t sz);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
@@ -153,14 +174,33 @@ private:
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
 };
 
+/**
+ * Anonymous memory mappings backed by huge pages as given by a
+ * TRANSPARENT or EXPLICIT huge page policy. Sizes are multiples of the
+ * huge page size. Only transparent huge page mappings can be resized.
+ */
+class HugePageMMapAllocator {
+public:
+    using PtrAndSize = MemoryAllocator::PtrAndSize;
+    static PtrAndSize salloc(size_t sz, HugePagePolicy hugePagePolicy);
+    static void sfree(PtrAndSize alloc);
+    static size_t sresize_inplace(PtrAndSize current, size_t newSize);
+private:
+    static void * mapExplicit(size_t sz);
+    static void * mapTransparent(size_t sz);
+    static void adviseTransparent(void * buf, size_t sz);
+    static bool isExplicit(const void * buf);
+};
+
 class AutoAllocator : public MemoryAllocator {
 public:
-    AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
+    AutoAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy)
+        : _mmapLimit(mmapLimit), _alignment(alignment), _hugePagePolicy(hugePagePolicy) { }
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
-    static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
+    static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy);
 private:
     size_t roundUpToHugePages(size_t sz) const {
         return (_mmapLimit >= MemoryAllocator::HUGEPAGE_SIZE)
@@ -177,6 +217,7 @@ private:
     }
     size_t _mmapLimit;
     size_t _alignment;
+    HugePagePolicy _hugePagePolicy;
 };
 
 
@@ -187,10 +228,10 @@ struct MMapLimitAndAlignmentHash {
 using AutoAllocatorsMap = std::unordered_map<MMapLimitAndAlignment, AutoAllocator::UP, MMapLimitAndAlignmentHash>;
 using AutoAllocatorsMapWithDefault = std::pair<AutoAllocatorsMap, alloc::MemoryAllocator *>;
 
-void createAlignedAutoAllocators(AutoAllocatorsMap & map, size_t mmapLimit) {
+void createAlignedAutoAllocators(AutoAllocatorsMap & map, size_t mmapLimit, HugePagePolicy hugePagePolicy) {
     for (size_t alignment : {0,0x200, 0x400, 0x1000}) {
-        MMapLimitAndAlignment key(mmapLimit, alignment);
-        auto result = map.emplace(key, AutoAllocator::UP(new AutoAllocator(mmapLimit, alignment)));
+        MMapLimitAndAlignment key(mmapLimit, alignment, hugePagePolicy);
+        auto result = map.emplace(key, AutoAllocator::UP(new AutoAllocator(mmapLimit, alignment, hugePagePolicy)));
         (void) result;
         assert( result.second );
 
@@ -200,17 +241,19 @@ void createAlignedAutoAllocators(AutoAllocatorsMap & map, size_t mmapLimit) {
 AutoAllocatorsMap
 createAutoAllocators() {
     AutoAllocatorsMap map;
-    map.reserve(3*5);
-    for (size_t pages : {1,2,4,8,16}) {
-        size_t mmapLimit = pages * MemoryAllocator::HUGEPAGE_SIZE;
-        createAlignedAutoAllocators(map, mmapLimit);
+    map.reserve(3*4*5);
+    for (HugePagePolicy hugePagePolicy : {HugePagePolicy::DEFAULT, HugePagePolicy::TRANSPARENT, HugePagePolicy::EXPLICIT}) {
+        for (size_t pages : {1,2,4,8,16}) {
+            size_t mmapLimit = pages * MemoryAllocator::HUGEPAGE_SIZE;
+            createAlignedAutoAllocators(map, mmapLimit, hugePagePolicy);
+        }
     }
     return map;
 }
 
 MemoryAllocator &
-getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment) {
-    MMapLimitAndAlignment key(mmapLimit, alignment);
+getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy) {
+    MMapLimitAndAlignment key(mmapLimit, alignment, hugePagePolicy);
     auto found = map.find(key);
     if (found == map.end()) {
         throw IllegalArgumentException(make_string("We currently have no support for mmapLimit(%0lx) and alignment(%0lx)", mmapLimit, alignment));
@@ -220,7 +263,7 @@ getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment) {
 
 MemoryAllocator &
 getDefaultAutoAllocator(AutoAllocatorsMap & map) {
-    return getAutoAllocator(map, 1 * MemoryAllocator::HUGEPAGE_SIZE, 0);
+    return getAutoAllocator(map, 1 * MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::DEFAULT);
 }
 
 AutoAllocatorsMapWithDefault
@@ -268,8 +311,8 @@ AutoAllocator::getDefault() {
 }
 
 MemoryAllocator &
-AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment) {
-    return getAutoAllocator(_G_availableAutoAllocators.first, mmapLimit, alignment);
+AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy) {
+    return getAutoAllocator(_G_availableAutoAllocators.first, mmapLimit, alignment, hugePagePolicy);
 }
 
 MemoryAllocator::PtrAndSize
@@ -336,14 +379,7 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             buf = mmap(wantedAddress, sz, prot, flags, -1, 0);
             if (buf == MAP_FAILED) {
                 stackTrace = getStackTrace(1);
-                string msg = make_string("Failed mmaping anonymous of size %ld errno(%d) from %s", sz, errno, stackTrace.c_str());
-                if (_G_SilenceCoreOnOOM) {
-                    OOMException oom(msg);
-                    oom.setPayload(std::make_unique<SilenceUncaughtException>(oom));
-                    throw oom;
-                } else {
-                    throw OOMException(msg);
-                }
+                throwOOM(make_string("Failed mmaping anonymous of size %ld errno(%d) from %s", sz, errno, stackTrace.c_str()));
             }
         } else {
             if (_G_hasHugePageFailureJustHappened) {
@@ -364,6 +400,45 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
     return PtrAndSize(buf, sz);
 }
 
+MemoryAllocator::PtrAndSize
+MMapAllocator::smapFile(const char *fileName, size_t offset, size_t sz)
+{
+    if ((offset % _G_pageSize) != 0) {
+        throw IllegalArgumentException(make_string("Alloc::allocMMapFile(%s, %zu, %zu) requires page aligned offset",
+                                                   fileName, offset, sz));
+    }
+    sz = roundUp2PageSize(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) {
+        LOG(warning, "Failed opening '%s' for mmap: %s", fileName, FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    ::close(fd);
+    if (buf == MAP_FAILED) {
+        LOG(warning, "Failed mmaping %zu bytes at offset %zu of '%s': %s",
+            sz, offset, fileName, FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
+    }
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+    if (sz >= _G_MMapLogLimit) {
+        string stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of size %ld from file '%s' from %s", mmapId, sz, fileName, stackTrace.c_str());
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+    return PtrAndSize(buf, sz);
+}
+
 size_t
 MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
     newSize = roundUp2PageSize(newSize);
@@ -416,11 +491,146 @@ void MMapAllocator::sfree(PtrAndSize alloc)
     }
 }
 
+bool
+HugePageMMapAllocator::isExplicit(const void * buf) {
+    LockGuard guard(_G_lock);
+    return _G_explicitHugePageMappings.find(buf) != _G_explicitHugePageMappings.end();
+}
+
+void *
+HugePageMMapAllocator::mapExplicit(size_t sz) {
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    if (buf == MAP_FAILED) {
+        _G_hugePageFallbacks++;
+        if ( ! _G_hasExplicitHugePageFailureJustHappened ) {
+            _G_hasExplicitHugePageFailureJustHappened = true;
+            LOG(info, "Failed allocating %ld bytes with hugetlbfs pages due too '%s'."
+                      " Will resort to transparent huge pages until it works again.",
+                sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+        return nullptr;
+    }
+    _G_hasExplicitHugePageFailureJustHappened = false;
+    _G_explicitHugePageBytes += sz;
+    LockGuard guard(_G_lock);
+    _G_explicitHugePageMappings[buf] = sz;
+    return buf;
+}
+
+void
+HugePageMMapAllocator::adviseTransparent(void * buf, size_t sz) {
+    if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+        LOG(debug, "Failed madvise(%p, %ld, MADV_HUGEPAGE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+    }
+    _G_transparentHugePageBytes += sz;
+}
+
+void *
+HugePageMMapAllocator::mapTransparent(size_t sz) {
+    // Map an extra huge page to be able to align the start of the mapping.
+    size_t mapSize = sz + MemoryAllocator::HUGEPAGE_SIZE;
+    void * buf = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+    if (buf == MAP_FAILED) {
+        throwOOM(make_string("Failed mmaping anonymous of size %ld errno(%d) from %s", mapSize, errno, getStackTrace(1).c_str()));
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(buf);
+    uintptr_t aligned = (start + MemoryAllocator::HUGEPAGE_SIZE - 1) & ~uintptr_t(MemoryAllocator::HUGEPAGE_SIZE - 1);
+    if (aligned > start) {
+        munmap(buf, aligned - start);
+    }
+    size_t tail = (start + mapSize) - (aligned + sz);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void *>(aligned + sz), tail);
+    }
+    buf = reinterpret_cast<void *>(aligned);
+    adviseTransparent(buf, sz);
+    return buf;
+}
+
+MemoryAllocator::PtrAndSize
+HugePageMMapAllocator::salloc(size_t sz, HugePagePolicy hugePagePolicy) {
+    sz = MemoryAllocator::roundUpToHugePages(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    void * buf = nullptr;
+    if (hugePagePolicy == HugePagePolicy::EXPLICIT) {
+        buf = mapExplicit(sz);
+    }
+    if (buf == nullptr) {
+        buf = mapTransparent(sz);
+    }
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+    return PtrAndSize(buf, sz);
+}
+
+void
+HugePageMMapAllocator::sfree(PtrAndSize alloc) {
+    if (alloc.first == nullptr) {
+        return;
+    }
+    bool wasExplicit = false;
+    {
+        LockGuard guard(_G_lock);
+        auto found = _G_explicitHugePageMappings.find(alloc.first);
+        if (found != _G_explicitHugePageMappings.end()) {
+            assert(found->second == alloc.second);
+            _G_explicitHugePageMappings.erase(found);
+            wasExplicit = true;
+        }
+    }
+    int retval = munmap(alloc.first, alloc.second);
+    assert(retval == 0);
+    (void) retval;
+    if (wasExplicit) {
+        _G_explicitHugePageBytes -= alloc.second;
+    } else {
+        _G_transparentHugePageBytes -= alloc.second;
+    }
+}
+
+size_t
+HugePageMMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
+    newSize = MemoryAllocator::roundUpToHugePages(newSize);
+    if ((newSize == 0) || isExplicit(current.first)) {
+        return 0;
+    }
+    char * end = static_cast<char *>(current.first) + current.second;
+    if (newSize > current.second) {
+        size_t extra = newSize - current.second;
+        void * buf = mmap(end, extra, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+        if (buf == MAP_FAILED) {
+            return 0;
+        }
+        if (buf != end) {
+            munmap(buf, extra);
+            return 0;
+        }
+        adviseTransparent(buf, extra);
+        if (newSize >= _G_MMapNoCoreLimit) {
+            madvise(current.first, newSize, MADV_DONTDUMP);
+        }
+    } else if (newSize < current.second) {
+        size_t excess = current.second - newSize;
+        int retval = munmap(end - excess, excess);
+        assert(retval == 0);
+        (void) retval;
+        _G_transparentHugePageBytes -= excess;
+    }
+    return newSize;
+}
+
 size_t
 AutoAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
     if (isMMapped(current.second) && useMMap(newSize)) {
         newSize = roundUpToHugePages(newSize);
-        return MMapAllocator::sresize_inplace(current, newSize);
+        return (_hugePagePolicy == HugePagePolicy::DEFAULT)
+            ? MMapAllocator::sresize_inplace(current, newSize)
+            : HugePageMMapAllocator::sresize_inplace(current, newSize);
     } else {
         return 0;
     }
@@ -430,7 +640,9 @@ MMapAllocator::PtrAndSize
 AutoAllocator::alloc(size_t sz) const {
     if (useMMap(sz)) {
         sz = roundUpToHugePages(sz);
-        return MMapAllocator::salloc(sz, nullptr);
+        return (_hugePagePolicy == HugePagePolicy::DEFAULT)
+            ? MMapAllocator::salloc(sz, nullptr)
+            : HugePageMMapAllocator::salloc(sz, _hugePagePolicy);
     } else {
         if (_alignment == 0) {
             return HeapAllocator::salloc(sz);
@@ -443,7 +655,9 @@ AutoAllocator::alloc(size_t sz) const {
 void
 AutoAllocator::free(PtrAndSize alloc) const {
     if (isMMapped(alloc.second)) {
-        return MMapAllocator::sfree(alloc);
+        return (_hugePagePolicy == HugePagePolicy::DEFAULT)
+            ? MMapAllocator::sfree(alloc)
+            : HugePageMMapAllocator::sfree(alloc);
     } else {
         return HeapAllocator::sfree(alloc);
     }
@@ -491,6 +705,12 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::allocMMapFile(const char *fileName, size_t offset, size_t sz)
+{
+    return Alloc(&MMapAllocator::getDefault(), MMapAllocator::smapFile(fileName, offset, sz));
+}
+
 Alloc
 Alloc::alloc()
 {
@@ -500,7 +720,21 @@ Alloc::alloc()
 Alloc
 Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
 {
-    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
+    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment, HugePagePolicy::DEFAULT), sz);
+}
+
+Alloc
+Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy)
+{
+    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment, hugePagePolicy), sz);
+}
+
+HugePageStats
+getHugePageStats()
+{
+    return HugePageStats{_G_explicitHugePageBytes.load(std::memory_order_relaxed),
+                         _G_transparentHugePageBytes.load(std::memory_order_relaxed),
+                         _G_hugePageFallbacks.load(std::memory_order_relaxed)};
 }
 
 }
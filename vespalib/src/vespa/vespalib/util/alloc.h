@@ -2,10 +2,33 @@
 #pragma once
 
 #include <vespa/vespalib/util/optimized.h>
+#include <cstdint>
 #include <memory>
 
 namespace vespalib::alloc {
 
+/**
+ * How large anonymous memory mappings are backed by huge pages.
+ *
+ * DEFAULT:     Hugetlbfs pages if VESPA_USE_HUGEPAGES is set for the process.
+ * TRANSPARENT: Mappings are 2MB aligned and advised with MADV_HUGEPAGE.
+ * EXPLICIT:    Hugetlbfs pages (MAP_HUGETLB), falling back to TRANSPARENT
+ *              when no more huge pages are available.
+ */
+enum class HugePagePolicy : uint8_t { DEFAULT, TRANSPARENT, EXPLICIT };
+
+/**
+ * Process wide accounting of memory mapped by allocators with a
+ * TRANSPARENT or EXPLICIT huge page policy.
+ */
+struct HugePageStats {
+    size_t explicitBytes;    // Currently mapped with hugetlbfs pages
+    size_t transparentBytes; // Currently mapped and advised for transparent huge pages
+    size_t fallbacks;        // Explicit allocations that fell back to transparent huge pages
+};
+
+HugePageStats getHugePageStats();
+
 class MemoryAllocator {
 public:
     enum {HUGEPAGE_SIZE=0x200000u};
@@ -94,15 +117,31 @@ public:
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
     static Alloc allocMMap(size_t sz=0);
+    /**
+     * Map sz bytes of the given file, starting at offset, privately
+     * into memory. The offset must be page aligned. Pages are copied
+     * when first written to, so changes never reach the file. New
+     * allocations created from the returned one are anonymous mmaps.
+     * The file must not be truncated or rewritten in place while it is
+     * mapped. Returns an empty allocation if the file could not be mapped.
+     */
+    static Alloc allocMMapFile(const char *fileName, size_t offset, size_t sz);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
      */
     static Alloc alloc(size_t sz, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    /**
+     * As above, but memory mapped allocations are backed by huge pages
+     * according to the given policy. New allocations created from the
+     * returned one use the same policy.
+     */
+    static Alloc alloc(size_t sz, size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy);
     static Alloc alloc();
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     Alloc(const MemoryAllocator * allocator) : _alloc(nullptr, 0), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) : _alloc(alloc), _allocator(allocator) { }
     void clear() {
         _alloc.first = nullptr;
         _alloc.second = 0;
@@ -0,0 +1,54 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace vespalib {
+
+/**
+ * 16-bit floating point value with the same exponent range as a
+ * 32-bit float, but only 7 bits of mantissa. Stored as the upper 16
+ * bits of the corresponding float. All arithmetic is done by
+ * converting to float; conversion from float rounds to nearest even.
+ **/
+class BFloat16 {
+private:
+    uint16_t _bits;
+
+    static uint32_t float_bits(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    static uint16_t round_to_bits(float value) {
+        uint32_t bits = float_bits(value);
+        if ((bits & 0x7fffffff) > 0x7f800000) {
+            // NaN; keep it quiet and make sure it stays a NaN
+            return ((bits >> 16) | 0x0040);
+        }
+        uint32_t rounding_bias = 0x7fff + ((bits >> 16) & 1);
+        return ((bits + rounding_bias) >> 16);
+    }
+public:
+    constexpr BFloat16() noexcept : _bits(0) {}
+    BFloat16(float value) noexcept : _bits(round_to_bits(value)) {}
+    static BFloat16 from_bits(uint16_t bits) noexcept {
+        BFloat16 result;
+        result._bits = bits;
+        return result;
+    }
+    uint16_t get_bits() const noexcept { return _bits; }
+    float to_float() const noexcept {
+        uint32_t bits = (uint32_t(_bits) << 16);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    operator float() const noexcept { return to_float(); }
+};
+
+static_assert(sizeof(BFloat16) == sizeof(uint16_t));
+
+}
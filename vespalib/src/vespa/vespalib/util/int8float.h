@@ -0,0 +1,48 @@
+// Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace vespalib {
+
+/**
+ * Signed 8-bit integer that behaves like a float in arithmetic
+ * expressions. Used as a compact cell type for quantized tensors;
+ * conversion from float rounds to the nearest integer (halfway cases
+ * away from zero) and saturates to the [-128, 127] range (NaN
+ * becomes 0).
+ **/
+class Int8Float {
+private:
+    int8_t _bits;
+
+    static int8_t to_bits(float value) {
+        if (value >= 127.0f) {
+            return 127;
+        }
+        if (value <= -128.0f) {
+            return -128;
+        }
+        if (value != value) {
+            return 0;
+        }
+        return static_cast<int8_t>(std::lround(value));
+    }
+public:
+    constexpr Int8Float() noexcept : _bits(0) {}
+    Int8Float(float value) noexcept : _bits(to_bits(value)) {}
+    static Int8Float from_bits(int8_t bits) noexcept {
+        Int8Float result;
+        result._bits = bits;
+        return result;
+    }
+    int8_t get_bits() const noexcept { return _bits; }
+    float to_float() const noexcept { return _bits; }
+    operator float() const noexcept { return _bits; }
+};
+
+static_assert(sizeof(Int8Float) == sizeof(int8_t));
+
+}
@@ -4,6 +4,8 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
 #include <zstd.h>
+#include <zdict.h>
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -62,4 +64,94 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     return ! ZSTD_isError(sz);
 }
 
+ZStdDictionary::ZStdDictionary(const void * content, size_t contentLen)
+    : _content(static_cast<const char *>(content), static_cast<const char *>(content) + contentLen),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _ddict(),
+      _lock(),
+      _cdicts()
+{
+    if (_id != 0) {
+        _ddict.reset(ZSTD_createDDict(_content.data(), _content.size()));
+        if ( ! _ddict) {
+            _id = 0;
+        }
+    }
+}
+
+ZStdDictionary::~ZStdDictionary() = default;
+
+void ZStdDictionary::CDictDeleter::operator()(void * cdict) const { ZSTD_freeCDict(static_cast<ZSTD_CDict *>(cdict)); }
+void ZStdDictionary::DDictDeleter::operator()(void * ddict) const { ZSTD_freeDDict(static_cast<ZSTD_DDict *>(ddict)); }
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize)
+{
+    std::vector<char> flat;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        flat.insert(flat.end(), sample.c_str(), sample.c_str() + sample.size());
+        sizes.push_back(sample.size());
+    }
+    std::vector<char> dict(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dict.data(), dict.size(), flat.data(), sizes.data(), sizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    auto result = std::make_shared<ZStdDictionary>(dict.data(), sz);
+    return result->valid() ? result : SP();
+}
+
+uint32_t
+ZStdDictionary::frameDictId(const void * input, size_t inputLen)
+{
+    return ZSTD_getDictID_fromFrame(input, inputLen);
+}
+
+const void *
+ZStdDictionary::getCDict(int level) const
+{
+    level = std::max(1, std::min(level, MAX_LEVEL));
+    std::lock_guard guard(_lock);
+    CDictUP & cdict = _cdicts[level - 1];
+    if ( ! cdict) {
+        cdict.reset(ZSTD_createCDict(_content.data(), _content.size(), level));
+    }
+    return cdict.get();
+}
+
+bool
+ZStdDictionary::process(int level, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV) const
+{
+    const auto * cdict = static_cast<const ZSTD_CDict *>(getCDict(level));
+    if (cdict == nullptr) {
+        return false;
+    }
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    size_t sz = ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, outputLenV, inputV, inputLen, cdict);
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
+bool
+ZStdDictionary::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV) const
+{
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    size_t sz = ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                           static_cast<const ZSTD_DDict *>(_ddict.get()));
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
 }
@@ -2,6 +2,10 @@
 #pragma once
 
 #include "compressor.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace vespalib::compression {
 
@@ -13,5 +17,64 @@ public:
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
 };
 
+/**
+ * A zstd dictionary, either trained from a set of sample buffers or
+ * reconstructed from the content of a dictionary trained elsewhere.
+ * Small buffers that share structure (like serialized messages of the
+ * same type) compress far better with a dictionary than without one.
+ * Frames compressed with a dictionary carry its id, which is also what
+ * the receiving side must use to select the dictionary to decompress
+ * with. Instances are immutable and safe to share between threads.
+ **/
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+
+    ZStdDictionary(const void * content, size_t contentLen);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if the samples are unsuitable for training.
+     **/
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize);
+
+    /**
+     * The id of the dictionary used to compress the given frame, 0 if
+     * it was compressed without one.
+     **/
+    static uint32_t frameDictId(const void * input, size_t inputLen);
+
+    uint32_t id() const { return _id; }
+    bool valid() const { return _id != 0; }
+    ConstBufferRef content() const { return ConstBufferRef(_content.data(), _content.size()); }
+
+    /**
+     * Compress or decompress with this dictionary. outputLen is the size of the
+     * output buffer on entry and the size of the result on return. Fails if the
+     * result does not fit.
+     **/
+    bool process(int level, const void * input, size_t inputLen, void * output, size_t & outputLen) const;
+    bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) const;
+private:
+    struct CDictDeleter { void operator()(void * cdict) const; };
+    struct DDictDeleter { void operator()(void * ddict) const; };
+    using CDictUP = std::unique_ptr<void, CDictDeleter>;
+    using DDictUP = std::unique_ptr<void, DDictDeleter>;
+
+    const void * getCDict(int level) const;
+
+    static constexpr int MAX_LEVEL = 22;
+
+    std::vector<char>                     _content;
+    uint32_t                              _id;
+    DDictUP                               _ddict;
+    mutable std::mutex                    _lock;
+    mutable std::array<CDictUP, MAX_LEVEL> _cdicts;
+};
+
 }
 
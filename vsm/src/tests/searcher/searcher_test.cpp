@@ -537,6 +537,57 @@ TEST("utf8 substring search") {
     }
 }
 
+TEST("utf8 substring search in long ascii fields") {
+    UTF8SubStringFieldSearcher fs(0);
+    std::string field = "OPERATORS and  operator,\toverloading operators and operator ,, overloading";
+    // Same field on the ucs4 path, forced by a non-ascii character or a separator character.
+    std::string nonAscii = field + " \xc3\xa4";
+    std::string separator = "oper\x01" + field.substr(4);
+    for (const std::string & f : {field, nonAscii, separator}) {
+        TEST_DO(assertString(fs, "ato",  f, Hits().add(0).add(2).add(4).add(6)));
+        TEST_DO(assertString(fs, "load", f, Hits().add(3).add(7)));
+        TEST_DO(assertString(fs, "o",    f, Hits().add(0).add(0).add(2).add(2).add(3).add(3).add(4).add(4).add(6).add(6).add(7).add(7)));
+        TEST_DO(assertString(fs, "operators", f, Hits().add(0).add(4)));
+        TEST_DO(assertString(fs, "xyz",  f, Hits()));
+    }
+    assertString(fs, StringList().add("ato").add("load"), field, HitsList().add(Hits().add(0).add(2).add(4).add(6)).add(Hits().add(3).add(7)));
+    TEST_DO(assertFieldInfo(fs, "ato", field, QTFieldInfo(0, 4, 8)));
+    // The word count does not depend on the term size, also with a run of non-word characters close to the end.
+    std::string tail = field + " foo  ,  ab";
+    for (const std::string & f : {tail, "oper\x01" + tail.substr(4)}) {
+        TEST_DO(assertFieldInfo(fs, "xyz", f, QTFieldInfo(0, 0, 10)));
+        TEST_DO(assertFieldInfo(fs, "overloading", f, QTFieldInfo(0, 2, 10)));
+        TEST_DO(assertString(fs, "overloading", f, Hits().add(3).add(7)));
+        TEST_DO(assertString(fs, "ab", f, Hits().add(9)));
+    }
+}
+
+TEST("utf8 word search in long ascii fields") {
+    UTF8StrChrFieldSearcher fs(0);
+    std::string field = "OPERATORS and  operator,\toverloading operators and operator ,, overloading";
+    // Same field on the tokenizing path, forced by a non-ascii word at the end.
+    std::string nonAscii = field + " \xc3\xa4";
+    for (const std::string & f : {field, nonAscii}) {
+        TEST_DO(assertString(fs, "operators",   f, Hits().add(0).add(4)));
+        TEST_DO(assertString(fs, "operator",    f, Hits().add(2).add(6)));
+        TEST_DO(assertString(fs, "oper*",       f, Hits().add(0).add(2).add(4).add(6)));
+        TEST_DO(assertString(fs, "overloading", f, Hits().add(3).add(7)));
+        TEST_DO(assertString(fs, "ato",         f, Hits()));
+        TEST_DO(assertString(fs, "xyz",         f, Hits()));
+    }
+    fs.setMatchType(FieldSearcher::PREFIX);
+    TEST_DO(assertString(fs, "over", field, Hits().add(3).add(7)));
+    TEST_DO(assertString(fs, "over", nonAscii, Hits().add(3).add(7)));
+    fs.setMatchType(FieldSearcher::REGULAR);
+    TEST_DO(assertFieldInfo(fs, "and", field, QTFieldInfo(0, 2, 8)));
+    TEST_DO(assertFieldInfo(fs, "and", nonAscii, QTFieldInfo(0, 2, 9)));
+    TEST_DO(assertFieldInfo(fs, "and", "  " + field, QTFieldInfo(0, 2, 8)));
+    // An empty token follows the last word when more than one non-word character comes after it.
+    TEST_DO(assertFieldInfo(fs, "and", field + " ", QTFieldInfo(0, 2, 8)));
+    TEST_DO(assertFieldInfo(fs, "and", field + " ,", QTFieldInfo(0, 2, 9)));
+    TEST_DO(assertFieldInfo(fs, "and", std::string(70, ','), QTFieldInfo(0, 0, 1)));
+}
+
 TEST("utf8 substring search with empty term")
 {
     UTF8SubStringFieldSearcher fs(0);
@@ -42,6 +42,8 @@ private:
     void testAnsiFold();
     void test_lfoldua();
     void test_sse2_foldua();
+    void assertFoldKernels(const FoldKernels & kernels);
+    void testFoldKernels();
 
 public:
     int Main() override;
@@ -256,6 +258,60 @@ TextUtilTest::test_sse2_foldua()
     }
 }
 
+void
+TextUtilTest::assertFoldKernels(const FoldKernels & kernels)
+{
+    TEST_STATE(kernels.name);
+    std::string toFold;
+    for (size_t i = 0; i < 200; ++i) {
+        toFold += "Ab1 c-D2,,e"[i % 11];
+    }
+    std::vector<unsigned char> buf(toFold.size() + FoldKernels::FOLD_PADDING + 16);
+    unsigned char * folded = &buf[0] + (0xF - (size_t(&buf[0] + 0xF) % 0x10));
+    const unsigned char * toFoldOrg = reinterpret_cast<const unsigned char *>(toFold.c_str());
+    size_t alignsz16 = toFold.size() & ~size_t(0xF);
+    EXPECT_EQUAL(kernels.foldua(toFoldOrg, alignsz16, folded), toFoldOrg + alignsz16);
+    for (size_t i = alignsz16; i < toFold.size(); ++i) {
+        folded[i] = FieldSearcher::fold(toFoldOrg[i]);
+    }
+    memset(folded + toFold.size(), 0, FoldKernels::FOLD_PADDING);
+    for (size_t i = 0; i < toFold.size(); ++i) {
+        EXPECT_EQUAL((int32_t)folded[i], (int32_t)FieldSearcher::fold(toFoldOrg[i]));
+    }
+
+    size_t end = toFold.size() - 1;
+    for (size_t pos = 0; pos < end; ++pos) {
+        size_t exp = pos;
+        for (; (exp < end) && !((folded[exp] == 'c') && (folded[exp + 1] == 'd')); ++exp);
+        EXPECT_EQUAL(kernels.find(folded, pos, end, 'c', 'd', 1), exp);
+        size_t expCount = 0;
+        for (size_t i = pos; i < end; ++i) {
+            expCount += ((folded[i] == 0) && ((i == 0) || (folded[i - 1] != 0))) ? 1 : 0;
+        }
+        EXPECT_EQUAL(kernels.countNonWordRuns(folded, pos, end), expCount);
+    }
+    EXPECT_EQUAL(kernels.find(folded, 0, end, 'x', 'y', 1), end);
+
+    std::string nonAscii(toFold);
+    nonAscii[100] = (char)0xc3;
+    toFoldOrg = reinterpret_cast<const unsigned char *>(nonAscii.c_str());
+    EXPECT_EQUAL(kernels.foldua(toFoldOrg, alignsz16, folded), toFoldOrg + 96);
+}
+
+void
+TextUtilTest::testFoldKernels()
+{
+    __builtin_cpu_init();
+    assertFoldKernels(FoldKernels::sse2());
+    if (__builtin_cpu_supports("avx2")) {
+        assertFoldKernels(FoldKernels::avx2());
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        assertFoldKernels(FoldKernels::avx512());
+    }
+    EXPECT_TRUE(FoldKernels::get().name != nullptr);
+}
+
 int
 TextUtilTest::Main()
 {
@@ -266,6 +322,7 @@ TextUtilTest::Main()
     testAnsiFold();
     test_lfoldua();
     test_sse2_foldua();
+    testFoldKernels();
 
     TEST_DONE();
 }
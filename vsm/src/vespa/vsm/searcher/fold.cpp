@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 //
 #include "fold.h"
+#include <emmintrin.h>
+#include <algorithm>
 
 namespace vsm {
 
@@ -150,4 +152,68 @@ const unsigned char * sse2_foldua(const unsigned char * toFoldOrg, size_t sz, un
   return toFoldOrg+i*16;
 }
 
+size_t sse2_find(const unsigned char * folded, size_t pos, size_t end, unsigned char first, unsigned char last, size_t lastOffset)
+{
+    const __m128i vfirst = _mm_set1_epi8(first);
+    const __m128i vlast = _mm_set1_epi8(last);
+    for (; pos < end; pos += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(folded + pos));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(folded + pos + lastOffset));
+        uint32_t candidates = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, vfirst), _mm_cmpeq_epi8(b, vlast)));
+        if (candidates != 0) {
+            return std::min(pos + __builtin_ctz(candidates), end);
+        }
+    }
+    return end;
+}
+
+size_t sse2_countNonWordRuns(const unsigned char * folded, size_t pos, size_t end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t count = 0;
+    uint32_t prevZero = ((pos > 0) && (folded[pos - 1] == 0)) ? 1u : 0u;
+    for (; pos < end; pos += 16) {
+        __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(folded + pos));
+        uint32_t zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(current, zero));
+        uint32_t starts = zeros & ~((zeros << 1) | prevZero);
+        if (end - pos < 16) {
+            starts &= (1u << (end - pos)) - 1;
+        }
+        count += __builtin_popcount(starts);
+        prevZero = (zeros >> 15) & 1u;
+    }
+    return count;
+}
+
+namespace {
+
+const FoldKernels _G_sse2Kernels = { "sse2", sse2_foldua, sse2_find, sse2_countNonWordRuns };
+const FoldKernels _G_avx2Kernels = { "avx2", avx2_foldua, avx2_find, avx2_countNonWordRuns };
+const FoldKernels _G_avx512Kernels = { "avx512", avx512_foldua, avx512_find, avx512_countNonWordRuns };
+
+const FoldKernels &
+selectKernels()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        return _G_avx512Kernels;
+    } else if (__builtin_cpu_supports("avx2")) {
+        return _G_avx2Kernels;
+    }
+    return _G_sse2Kernels;
+}
+
+}
+
+const FoldKernels & FoldKernels::sse2() { return _G_sse2Kernels; }
+const FoldKernels & FoldKernels::avx2() { return _G_avx2Kernels; }
+const FoldKernels & FoldKernels::avx512() { return _G_avx512Kernels; }
+
+const FoldKernels &
+FoldKernels::get()
+{
+    static const FoldKernels & kernels = selectKernels();
+    return kernels;
+}
+
 }
@@ -7,6 +7,55 @@ namespace vsm {
 
 const search::byte * sse2_foldaa(const search::byte * toFoldOrg, size_t sz, search::byte * foldedOrg);
 const search::byte * sse2_foldua(const search::byte * toFoldOrg, size_t sz, search::byte * foldedOrg);
+const search::byte * avx2_foldua(const search::byte * toFoldOrg, size_t sz, search::byte * foldedOrg);
+const search::byte * avx512_foldua(const search::byte * toFoldOrg, size_t sz, search::byte * foldedOrg);
 
-}
+size_t sse2_find(const search::byte * folded, size_t pos, size_t end, search::byte first, search::byte last, size_t lastOffset);
+size_t avx2_find(const search::byte * folded, size_t pos, size_t end, search::byte first, search::byte last, size_t lastOffset);
+size_t avx512_find(const search::byte * folded, size_t pos, size_t end, search::byte first, search::byte last, size_t lastOffset);
+
+size_t sse2_countNonWordRuns(const search::byte * folded, size_t pos, size_t end);
+size_t avx2_countNonWordRuns(const search::byte * folded, size_t pos, size_t end);
+size_t avx512_countNonWordRuns(const search::byte * folded, size_t pos, size_t end);
+
+/**
+ * Kernels working on ascii text folded by one of the foldua functions, where word
+ * characters are lowercased and all other characters are 0. The widest implementation
+ * supported by the cpu is selected at startup.
+ **/
+struct FoldKernels
+{
+    /**
+     * Folds sz bytes (a multiple of 16) into folded, which must be 16 byte aligned.
+     * Stops at the first 16 byte block containing non-ascii characters.
+     * Returns the end of the folded input.
+     **/
+    using FoldFunction = const search::byte * (*)(const search::byte * toFold, size_t sz, search::byte * folded);
+    /**
+     * Returns the first position p in [pos, end) where folded[p] == first and
+     * folded[p + lastOffset] == last, or end if there is none.
+     * The buffer must be readable for FOLD_PADDING bytes after end + lastOffset.
+     **/
+    using FindFunction = size_t (*)(const search::byte * folded, size_t pos, size_t end,
+                                    search::byte first, search::byte last, size_t lastOffset);
+    /**
+     * Returns the number of positions p in [pos, end) where a run of non-word
+     * characters starts, i.e. folded[p] == 0 and p is 0 or folded[p - 1] != 0.
+     * The buffer must be readable for FOLD_PADDING bytes after end.
+     **/
+    using CountFunction = size_t (*)(const search::byte * folded, size_t pos, size_t end);
+
+    static constexpr size_t FOLD_PADDING = 64;
 
+    const char    * name;
+    FoldFunction    foldua;
+    FindFunction    find;
+    CountFunction   countNonWordRuns;
+
+    static const FoldKernels & sse2();
+    static const FoldKernels & avx2();
+    static const FoldKernels & avx512();
+    static const FoldKernels & get();
+};
+
+}
@@ -0,0 +1,79 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fold.h"
+#include <immintrin.h>
+#include <algorithm>
+
+namespace vsm {
+
+namespace {
+
+inline __m256i
+fold32(__m256i c)
+{
+    const __m256i zeroM1 = _mm256_set1_epi8('0' - 1);
+    const __m256i nine = _mm256_set1_epi8('9');
+    const __m256i aM1 = _mm256_set1_epi8('a' - 1);
+    const __m256i z = _mm256_set1_epi8('z');
+    const __m256i lowCase = _mm256_set1_epi8(0x20);
+    // Signed compares; bytes >= 0x80 are negative and never inside the ranges.
+    __m256i inRange = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, z), _mm256_cmpgt_epi8(c, zeroM1));
+    __m256i low = _mm256_or_si256(_mm256_and_si256(c, inRange), lowCase);
+    __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(low, nine), _mm256_cmpgt_epi8(low, zeroM1));
+    __m256i alpha = _mm256_andnot_si256(_mm256_cmpgt_epi8(low, z), _mm256_cmpgt_epi8(low, aM1));
+    return _mm256_and_si256(low, _mm256_or_si256(digit, alpha));
+}
+
+}
+
+const unsigned char * avx2_foldua(const unsigned char * toFoldOrg, size_t sz, unsigned char * foldedOrg)
+{
+    size_t i(0);
+    for (; i + 32 <= sz; i += 32) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(toFoldOrg + i));
+        if (_mm256_movemask_epi8(c) != 0) {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(foldedOrg + i), fold32(c));
+    }
+    if (i < sz) {
+        // Remaining 16 byte block or a block with non-ascii characters.
+        return sse2_foldua(toFoldOrg + i, sz - i, foldedOrg + i);
+    }
+    return toFoldOrg + i;
+}
+
+size_t avx2_find(const unsigned char * folded, size_t pos, size_t end, unsigned char first, unsigned char last, size_t lastOffset)
+{
+    const __m256i vfirst = _mm256_set1_epi8(first);
+    const __m256i vlast = _mm256_set1_epi8(last);
+    for (; pos < end; pos += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(folded + pos));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(folded + pos + lastOffset));
+        uint32_t candidates = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, vfirst), _mm256_cmpeq_epi8(b, vlast)));
+        if (candidates != 0) {
+            return std::min(pos + __builtin_ctz(candidates), end);
+        }
+    }
+    return end;
+}
+
+size_t avx2_countNonWordRuns(const unsigned char * folded, size_t pos, size_t end)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t count = 0;
+    uint32_t prevZero = ((pos > 0) && (folded[pos - 1] == 0)) ? 1u : 0u;
+    for (; pos < end; pos += 32) {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(folded + pos));
+        uint32_t zeros = _mm256_movemask_epi8(_mm256_cmpeq_epi8(current, zero));
+        uint32_t starts = zeros & ~((zeros << 1) | prevZero);
+        if (end - pos < 32) {
+            starts &= (1u << (end - pos)) - 1;
+        }
+        count += __builtin_popcount(starts);
+        prevZero = zeros >> 31;
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,74 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fold.h"
+#include <immintrin.h>
+#include <algorithm>
+
+namespace vsm {
+
+namespace {
+
+inline __m512i
+fold64(__m512i c)
+{
+    const __m512i lowCase = _mm512_set1_epi8(0x20);
+    __mmask64 inRange = _mm512_cmpge_epu8_mask(c, _mm512_set1_epi8('0')) & _mm512_cmple_epu8_mask(c, _mm512_set1_epi8('z'));
+    __m512i low = _mm512_or_si512(_mm512_maskz_mov_epi8(inRange, c), lowCase);
+    __mmask64 digit = _mm512_cmpge_epu8_mask(low, _mm512_set1_epi8('0')) & _mm512_cmple_epu8_mask(low, _mm512_set1_epi8('9'));
+    __mmask64 alpha = _mm512_cmpge_epu8_mask(low, _mm512_set1_epi8('a')) & _mm512_cmple_epu8_mask(low, _mm512_set1_epi8('z'));
+    return _mm512_maskz_mov_epi8(digit | alpha, low);
+}
+
+}
+
+const unsigned char * avx512_foldua(const unsigned char * toFoldOrg, size_t sz, unsigned char * foldedOrg)
+{
+    size_t i(0);
+    for (; i + 64 <= sz; i += 64) {
+        __m512i c = _mm512_loadu_si512(toFoldOrg + i);
+        if (_mm512_movepi8_mask(c) != 0) {
+            break;
+        }
+        _mm512_storeu_si512(foldedOrg + i, fold64(c));
+    }
+    if (i < sz) {
+        // Remaining 16 byte blocks or a block with non-ascii characters.
+        return avx2_foldua(toFoldOrg + i, sz - i, foldedOrg + i);
+    }
+    return toFoldOrg + i;
+}
+
+size_t avx512_find(const unsigned char * folded, size_t pos, size_t end, unsigned char first, unsigned char last, size_t lastOffset)
+{
+    const __m512i vfirst = _mm512_set1_epi8(first);
+    const __m512i vlast = _mm512_set1_epi8(last);
+    for (; pos < end; pos += 64) {
+        __m512i a = _mm512_loadu_si512(folded + pos);
+        __m512i b = _mm512_loadu_si512(folded + pos + lastOffset);
+        uint64_t candidates = _mm512_cmpeq_epi8_mask(a, vfirst) & _mm512_cmpeq_epi8_mask(b, vlast);
+        if (candidates != 0) {
+            return std::min(pos + __builtin_ctzll(candidates), end);
+        }
+    }
+    return end;
+}
+
+size_t avx512_countNonWordRuns(const unsigned char * folded, size_t pos, size_t end)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    size_t count = 0;
+    uint64_t prevZero = ((pos > 0) && (folded[pos - 1] == 0)) ? 1u : 0u;
+    for (; pos < end; pos += 64) {
+        __m512i current = _mm512_loadu_si512(folded + pos);
+        uint64_t zeros = _mm512_cmpeq_epi8_mask(current, zero);
+        uint64_t starts = zeros & ~((zeros << 1) | prevZero);
+        if (end - pos < 64) {
+            starts &= (uint64_t(1) << (end - pos)) - 1;
+        }
+        count += __builtin_popcountll(starts);
+        prevZero = zeros >> 63;
+    }
+    return count;
+}
+
+}
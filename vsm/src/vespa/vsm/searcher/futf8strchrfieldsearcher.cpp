@@ -77,7 +77,7 @@ FUTF8StrChrFieldSearcher::lfoldua(const char * toFold, size_t sz, char * folded,
   size_t rest = sz - alignsz16;
 
   if (alignsz16) {
-    const byte * end = sse2_foldua(reinterpret_cast<const byte *>(toFold), alignsz16, reinterpret_cast<byte *>(folded+alignedStart));
+    const byte * end = FoldKernels::get().foldua(reinterpret_cast<const byte *>(toFold), alignsz16, reinterpret_cast<byte *>(folded+alignedStart));
     retval = (end == reinterpret_cast<const byte *>(toFold+alignsz16));
   }
   if(rest && retval) {
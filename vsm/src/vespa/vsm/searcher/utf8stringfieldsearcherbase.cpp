@@ -1,7 +1,10 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "utf8stringfieldsearcherbase.h"
+#include "fold.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 using search::streaming::QueryTerm;
 using search::streaming::QueryTermList;
@@ -9,6 +12,45 @@ using search::byte;
 
 namespace vsm {
 
+namespace {
+
+bool
+isFoldedAsciiWord(const cmptype_t * term, size_t tsz)
+{
+    if (tsz == 0) {
+        return false;
+    }
+    for (size_t i(0); i < tsz; i++) {
+        if ((term[i] >= 0x80) || (term[i] == 0) || (FieldSearcher::fold(term[i]) != term[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checked in blocks of 16 bytes, giving up at the first block with a non-ascii
+ * or separator character.
+ **/
+bool
+isAsciiWithoutSeparators(const byte * p, size_t sz)
+{
+    for (size_t i(0); i < sz; i += 16) {
+        const size_t blockEnd = std::min(i + 16, sz);
+        uint32_t rejected(0);
+        for (size_t j(i); j < blockEnd; j++) {
+            byte c = p[j];
+            rejected |= (c >= 0x80) | ((c < 0x20) & (c != '\n') & (c != '\t'));
+        }
+        if (rejected != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
 const byte *
 UTF8StringFieldSearcherBase::tokenize(const byte * p, size_t maxSz, cmptype_t * dstbuf, size_t & tokenlen)
 {
@@ -103,6 +145,11 @@ UTF8StringFieldSearcherBase::tokenize(const byte * p, size_t maxSz, cmptype_t *
 size_t
 UTF8StringFieldSearcherBase::matchTermRegular(const FieldRef & f, QueryTerm & qt)
 {
+    size_t asciiWords(0);
+    if (matchTermRegularAscii(f, qt, asciiWords)) {
+        NEED_CHAR_STAT(addAnyUtf8Field(f.size()));
+        return asciiWords;
+    }
     termcount_t words(0);
     const byte * n = reinterpret_cast<const byte *> (f.data());
     // __builtin_prefetch(n, 0, 0);
@@ -164,6 +211,11 @@ UTF8StringFieldSearcherBase::matchTermSubstring(const FieldRef & f, QueryTerm &
     const byte * n = reinterpret_cast<const byte *> (f.data());
     const cmptype_t * term;
     termsize_t tsz = qt.term(term);
+    size_t asciiWords(0);
+    if (matchTermSubstringAscii(f, qt, asciiWords)) {
+        NEED_CHAR_STAT(addAnyUtf8Field(f.size()));
+        return asciiWords;
+    }
     if ( f.size() >= _buf->size()) {
         _buf->reserve(f.size() + 1);
     }
@@ -180,17 +232,146 @@ UTF8StringFieldSearcherBase::matchTermSubstring(const FieldRef & f, QueryTerm &
         if (tt == et) {
             fn = fnt;
             addHit(qt, words);
+        } else if ( ! Fast_UnicodeUtil::IsWordChar(*fn) ) {
+            words += countNonWordRuns(fntemp, fn, fn + 1);
+            for(fn++; (fn < fre) && ! Fast_UnicodeUtil::IsWordChar(*fn) ; fn++ );
         } else {
-            if ( ! Fast_UnicodeUtil::IsWordChar(*fn++) ) {
-                words++;
-                for(; (fn < fre) && ! Fast_UnicodeUtil::IsWordChar(*fn) ; fn++ );
-            }
+            fn++;
         }
     }
+    words += countNonWordRuns(fntemp, fn, fe);
     NEED_CHAR_STAT(addAnyUtf8Field(f.size()));
     return words + 1; // we must also count the last word
 }
 
+size_t
+UTF8StringFieldSearcherBase::countNonWordRuns(const cmptype_t * b, const cmptype_t * p, const cmptype_t * e)
+{
+    size_t count(0);
+    bool prevWord = (p == b) || Fast_UnicodeUtil::IsWordChar(p[-1]);
+    for (; p < e; p++) {
+        bool word = Fast_UnicodeUtil::IsWordChar(*p);
+        count += (prevWord && !word) ? 1 : 0;
+        prevWord = word;
+    }
+    return count;
+}
+
+const byte *
+UTF8StringFieldSearcherBase::foldAsciiField(const FieldRef & f)
+{
+    size_t sz = f.size();
+    const byte * n = reinterpret_cast<const byte *> (f.data());
+    if ((sz < FoldKernels::FOLD_PADDING) || !isAsciiWithoutSeparators(n, sz)) {
+        return nullptr;
+    }
+    if ( sz + FoldKernels::FOLD_PADDING >= _buf->size()) {
+        _buf->reserve(sz + FoldKernels::FOLD_PADDING);
+    }
+    // The byte view of the ucs4 buffer leaves room for alignment and padding.
+    byte * folded = reinterpret_cast<byte *>(&(*_buf.get())[0]);
+    folded += 0xF - (size_t(folded + 0xF) % 0x10);
+    size_t alignsz16 = sz & ~size_t(0xF);
+    // Never stops early as the field is known to be ascii only.
+    FoldKernels::get().foldua(n, alignsz16, folded);
+    for (size_t i(alignsz16); i < sz; i++) {
+        folded[i] = FieldSearcher::fold(n[i]);
+    }
+    memset(folded + sz, 0, FoldKernels::FOLD_PADDING);
+    return folded;
+}
+
+bool
+UTF8StringFieldSearcherBase::matchTermRegularAscii(const FieldRef & f, QueryTerm & qt, size_t & words)
+{
+    const cmptype_t * term;
+    size_t tsz = qt.term(term);
+    if (!isFoldedAsciiWord(term, tsz)) {
+        return false;
+    }
+    const byte * folded = foldAsciiField(f);
+    if (folded == nullptr) {
+        return false;
+    }
+    const FoldKernels & kernels = FoldKernels::get();
+    const size_t sz = f.size();
+    const bool matchPrefix = prefix() || qt.isPrefix();
+    // Words are the runs of non-zero bytes. A word starting at p > 0 follows the run of
+    // zero bytes containing p - 1, so the words before it are the runs of zero bytes
+    // before it, plus the first word if the field starts with one, minus one.
+    const size_t leadingWord = (folded[0] != 0) ? 1 : 0;
+    size_t nonWordRuns(0);
+    size_t counted(0);
+    if (tsz <= sz) {
+        const size_t end = sz - tsz + 1;
+        const byte first = term[0];
+        const byte last = term[tsz - 1];
+        for (size_t p = kernels.find(folded, 0, end, first, last, tsz - 1); p < end; p = kernels.find(folded, p, end, first, last, tsz - 1)) {
+            size_t i(1);
+            for (; (i + 1 < tsz) && (folded[p + i] == term[i]); i++);
+            if ((i + 1 >= tsz) && ((p == 0) || (folded[p - 1] == 0)) && (matchPrefix || (folded[p + tsz] == 0))) {
+                nonWordRuns += kernels.countNonWordRuns(folded, counted, p);
+                counted = p;
+                addHit(qt, (p == 0) ? 0 : leadingWord + nonWordRuns - 1);
+                p += tsz;
+            } else {
+                p++;
+            }
+        }
+    }
+    nonWordRuns += kernels.countNonWordRuns(folded, counted, sz);
+    size_t trailing(0);
+    for (; (trailing < sz) && (folded[sz - 1 - trailing] == 0); trailing++);
+    const size_t wordCount = leadingWord + nonWordRuns - ((trailing > 0) ? 1 : 0);
+    if (wordCount == 0) {
+        words = 1; // tokenize() gives a single empty token
+    } else {
+        // tokenize() gives an empty token after the last word when more than one non-word character follows it.
+        words = wordCount + ((trailing > 1) ? 1 : 0);
+    }
+    return true;
+}
+
+bool
+UTF8StringFieldSearcherBase::matchTermSubstringAscii(const FieldRef & f, QueryTerm & qt, size_t & words)
+{
+    const cmptype_t * term;
+    size_t tsz = qt.term(term);
+    if (!isFoldedAsciiWord(term, tsz)) {
+        return false;
+    }
+    const byte * folded = foldAsciiField(f);
+    if (folded == nullptr) {
+        return false;
+    }
+    const FoldKernels & kernels = FoldKernels::get();
+    const size_t sz = f.size();
+    // Same non-overlapping matches as the ucs4 loop in matchTermSubstring(), where every
+    // run of non-word characters starts a new word.
+    size_t nonWordRuns(0);
+    size_t counted(0);
+    if (tsz <= sz) {
+        const size_t end = sz - tsz + 1;
+        const byte first = term[0];
+        const byte last = term[tsz - 1];
+        for (size_t p = kernels.find(folded, 0, end, first, last, tsz - 1); p < end; p = kernels.find(folded, p, end, first, last, tsz - 1)) {
+            size_t i(1);
+            for (; (i + 1 < tsz) && (folded[p + i] == term[i]); i++);
+            if (i + 1 >= tsz) {
+                nonWordRuns += kernels.countNonWordRuns(folded, counted, p);
+                counted = p;
+                addHit(qt, nonWordRuns);
+                p += tsz;
+            } else {
+                p++;
+            }
+        }
+    }
+    nonWordRuns += kernels.countNonWordRuns(folded, counted, sz);
+    words = nonWordRuns + 1; // we must also count the last word
+    return true;
+}
+
 size_t
 UTF8StringFieldSearcherBase::matchTermSuffix(const FieldRef & f, QueryTerm & qt)
 {
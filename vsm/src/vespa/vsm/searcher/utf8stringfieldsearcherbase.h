@@ -83,6 +83,43 @@ protected:
      **/
     size_t matchTermSubstring(const FieldRef & f, search::streaming::QueryTerm & qt);
 
+    /**
+     * Folds the given field into the shared buffer using the widest fold kernels supported
+     * by the cpu, followed by FoldKernels::FOLD_PADDING zero bytes.
+     * Only done for fields long enough to benefit that are ascii only without separator
+     * characters, nullptr is returned for all other fields.
+     **/
+    const search::byte * foldAsciiField(const FieldRef & f);
+
+    /**
+     * Exact or prefix match of words on ascii only fields, done on the folded field.
+     * Gives the same hits and word count as the tokenizing loop in matchTermRegular().
+     *
+     * @param f     the field reference to match against.
+     * @param qt    the query term trying to match.
+     * @param words set to the number of words in the field ref.
+     * @return      false if the fast path was not applicable and nothing was matched.
+     **/
+    bool matchTermRegularAscii(const FieldRef & f, search::streaming::QueryTerm & qt, size_t & words);
+
+    /**
+     * Substring match on ascii only fields, done on the folded field.
+     * Gives the same hits and word count as the ucs4 loop in matchTermSubstring().
+     *
+     * @param f     the field reference to match against.
+     * @param qt    the query term trying to match.
+     * @param words set to the number of words in the field ref.
+     * @return      false if the fast path was not applicable and nothing was matched.
+     **/
+    bool matchTermSubstringAscii(const FieldRef & f, search::streaming::QueryTerm & qt, size_t & words);
+
+    /**
+     * Returns the number of runs of non-word characters starting in [p, e) of the
+     * ucs4 buffer starting at b. Used for word positions in substring matching, where
+     * every such run starts a new word.
+     **/
+    static size_t countNonWordRuns(const cmptype_t * b, const cmptype_t * p, const cmptype_t * e);
+
     /**
      * Matches the given query term against the words in the given field reference
      * using suffix match strategy.
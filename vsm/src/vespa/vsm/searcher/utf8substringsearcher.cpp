@@ -40,11 +40,14 @@ UTF8SubStringFieldSearcher::matchTerms(const FieldRef & f, const size_t mintsz)
                 addHit(qt, words);
             }
         }
-        if ( ! Fast_UnicodeUtil::IsWordChar(*fn++) ) {
-            words++;
-            for(; (fn < fre) && ! Fast_UnicodeUtil::IsWordChar(*fn); fn++ );
+        if ( ! Fast_UnicodeUtil::IsWordChar(*fn) ) {
+            words += countNonWordRuns(fntemp, fn, fn + 1);
+            for(fn++; (fn < fre) && ! Fast_UnicodeUtil::IsWordChar(*fn); fn++ );
+        } else {
+            fn++;
         }
     }
+    words += countNonWordRuns(fntemp, fn, fe);
 
     NEED_CHAR_STAT(addAnyUtf8Field(f.size()));
     return words + 1; // we must also count the last word